@@ -123,6 +123,9 @@ LOCAL_SRC_FILES := $(LOCAL_SRC_FILES) \
 	dom/DeviceMotionEvent.cpp \
 	dom/Document.cpp \
 	dom/DocumentFragment.cpp \
+	dom/DOMArena.cpp \
+	dom/DocumentElementIndex.cpp \
+	dom/SharedAttributeCache.cpp \
 	dom/DocumentMarkerController.cpp \
 	dom/DocumentParser.cpp \
 	dom/DocumentType.cpp \
@@ -235,6 +238,7 @@ LOCAL_SRC_FILES := $(LOCAL_SRC_FILES) \
 	editing/SplitTextNodeCommand.cpp \
 	editing/SplitTextNodeContainingElementCommand.cpp \
 	editing/TextIterator.cpp \
+	editing/TextSearchIndex.cpp \
 	editing/TypingCommand.cpp \
 	editing/UnlinkCommand.cpp \
 	editing/VisiblePosition.cpp \
@@ -264,6 +268,7 @@ LOCAL_SRC_FILES := $(LOCAL_SRC_FILES) \
 	html/FileList.cpp \
 	html/FormDataList.cpp \
 	html/HTMLEntityParser.cpp \
+	html/HTMLFastFragmentParser.cpp \
 	html/HTMLTokenizer.cpp \
 	html/HTMLDocumentParser.cpp \
 	html/HTMLPreloadScanner.cpp \
@@ -333,6 +338,7 @@ LOCAL_SRC_FILES := $(LOCAL_SRC_FILES) \
 	loader/ProgressTracker.cpp \
 	loader/RedirectScheduler.cpp \
 	loader/Request.cpp \
+	loader/ResourceDiskCache.cpp \
 	loader/ResourceLoadNotifier.cpp \
 	loader/ResourceLoader.cpp \
 	loader/SubframeLoader.cpp \
@@ -352,6 +358,7 @@ LOCAL_SRC_FILES := $(LOCAL_SRC_FILES) \
 	loader/icon/IconDatabase.cpp \
 	loader/icon/IconFetcher.cpp \
 	loader/icon/IconLoader.cpp \
+	loader/icon/IconMappingSnapshot.cpp \
 	loader/icon/IconRecord.cpp \
 	loader/icon/PageURLRecord.cpp \
 	\
@@ -424,6 +431,7 @@ LOCAL_SRC_FILES := $(LOCAL_SRC_FILES) \
 	platform/LinkHash.cpp \
 	platform/Logging.cpp \
 	platform/MIMETypeRegistry.cpp \
+	platform/PhaseTracer.cpp \
 	platform/ScrollView.cpp \
 	platform/Scrollbar.cpp \
 	platform/ScrollbarThemeComposite.cpp \
@@ -538,11 +546,14 @@ LOCAL_SRC_FILES := $(LOCAL_SRC_FILES) \
 	platform/network/FormData.cpp \
 	platform/network/FormDataBuilder.cpp \
 	platform/network/HTTPHeaderMap.cpp \
+	platform/network/HTTPHeaderNames.cpp \
 	platform/network/HTTPParsers.cpp \
 	platform/network/NetworkStateNotifier.cpp \
 	platform/network/ProtectionSpace.cpp \
+	platform/network/ReplayResourceHandle.cpp \
 	platform/network/ResourceErrorBase.cpp \
 	platform/network/ResourceHandle.cpp \
+	platform/network/ResourceReplayArchive.cpp \
 	platform/network/ResourceRequestBase.cpp \
 	platform/network/ResourceResponseBase.cpp \
 	platform/network/SocketStreamHandleBase.cpp \
@@ -738,6 +749,7 @@ LOCAL_SRC_FILES := $(LOCAL_SRC_FILES) \
 	rendering/style/StyleBackgroundData.cpp \
 	rendering/style/StyleBoxData.cpp \
 	rendering/style/StyleCachedImage.cpp \
+	rendering/style/StyleDataInterner.cpp \
 	rendering/style/StyleFlexibleBoxData.cpp \
 	rendering/style/StyleGeneratedImage.cpp \
 	rendering/style/StyleInheritedData.cpp \
@@ -756,6 +768,7 @@ LOCAL_SRC_FILES := $(LOCAL_SRC_FILES) \
 	storage/DatabaseThread.cpp \
 	storage/DatabaseTracker.cpp \
 	storage/IDBAny.cpp \
+	storage/IDBBTree.cpp \
 	storage/IDBCursor.cpp \
 	storage/IDBCursorBackendImpl.cpp \
 	storage/IDBDatabase.cpp \
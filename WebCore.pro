@@ -495,6 +495,9 @@ SOURCES += \
     dom/DeviceOrientationEvent.cpp \
     dom/Document.cpp \
     dom/DocumentFragment.cpp \
+    dom/DOMArena.cpp \
+    dom/DocumentElementIndex.cpp \
+    dom/SharedAttributeCache.cpp \
     dom/DocumentMarkerController.cpp \
     dom/DocumentParser.cpp \
     dom/DocumentType.cpp \
@@ -612,6 +615,7 @@ SOURCES += \
     editing/SplitTextNodeCommand.cpp \
     editing/SplitTextNodeContainingElementCommand.cpp \
     editing/TextIterator.cpp \
+    editing/TextSearchIndex.cpp \
     editing/TypingCommand.cpp \
     editing/UnlinkCommand.cpp \
     editing/VisiblePosition.cpp \
@@ -650,6 +654,7 @@ SOURCES += \
     html/FileWriter.cpp \
     html/FormDataList.cpp \
     html/HTMLEntityParser.cpp \
+    html/HTMLFastFragmentParser.cpp \
     html/HTMLTokenizer.cpp \
     html/HTMLDocumentParser.cpp \
     html/HTMLPreloadScanner.cpp \
@@ -794,6 +799,7 @@ SOURCES += \
     loader/FTPDirectoryDocument.cpp \
     loader/FTPDirectoryParser.cpp \
     loader/icon/IconLoader.cpp \
+    loader/icon/IconMappingSnapshot.cpp \
     loader/ImageDocument.cpp \
     loader/ImageLoader.cpp \
     loader/loader.cpp \
@@ -809,6 +815,7 @@ SOURCES += \
     loader/ProgressTracker.cpp \
     loader/RedirectScheduler.cpp \
     loader/Request.cpp \
+    loader/ResourceDiskCache.cpp \
     loader/ResourceLoader.cpp \
     loader/ResourceLoadNotifier.cpp \
     loader/SinkDocument.cpp \
@@ -935,6 +942,7 @@ SOURCES += \
     platform/LinkHash.cpp \
     platform/Logging.cpp \
     platform/MIMETypeRegistry.cpp \
+    platform/PhaseTracer.cpp \
     platform/mock/DeviceOrientationClientMock.cpp \
     platform/mock/GeolocationServiceMock.cpp \
     platform/mock/SpeechInputClientMock.cpp \
@@ -946,11 +954,14 @@ SOURCES += \
     platform/network/FormData.cpp \
     platform/network/FormDataBuilder.cpp \
     platform/network/HTTPHeaderMap.cpp \
+    platform/network/HTTPHeaderNames.cpp \
     platform/network/HTTPParsers.cpp \
     platform/network/NetworkStateNotifier.cpp \
     platform/network/ProtectionSpace.cpp \
+    platform/network/ReplayResourceHandle.cpp \
     platform/network/ResourceErrorBase.cpp \
     platform/network/ResourceHandle.cpp \
+    platform/network/ResourceReplayArchive.cpp \
     platform/network/ResourceRequestBase.cpp \
     platform/network/ResourceResponseBase.cpp \
     platform/text/RegularExpression.cpp \
@@ -1072,6 +1083,7 @@ SOURCES += \
     rendering/style/StyleBackgroundData.cpp \
     rendering/style/StyleBoxData.cpp \
     rendering/style/StyleCachedImage.cpp \
+    rendering/style/StyleDataInterner.cpp \
     rendering/style/StyleFlexibleBoxData.cpp \
     rendering/style/StyleGeneratedImage.cpp \
     rendering/style/StyleInheritedData.cpp \
@@ -1279,6 +1291,9 @@ HEADERS += \
     dom/DeviceOrientationEvent.h \
     dom/Document.h \
     dom/DocumentFragment.h \
+    dom/DOMArena.h \
+    dom/DocumentElementIndex.h \
+    dom/SharedAttributeCache.h \
     dom/DocumentMarker.h \
     dom/DocumentMarkerController.h \
     dom/DocumentType.h \
@@ -1306,6 +1321,7 @@ HEADERS += \
     dom/MouseEvent.h \
     dom/MouseRelatedEvent.h \
     dom/MutationEvent.h \
+    dom/MutationEventBatch.h \
     dom/NamedNodeMap.h \
     dom/NameNodeList.h \
     dom/NodeFilterCondition.h \
@@ -1391,6 +1407,7 @@ HEADERS += \
     editing/SplitTextNodeCommand.h \
     editing/SplitTextNodeContainingElementCommand.h \
     editing/TextIterator.h \
+    editing/TextSearchIndex.h \
     editing/TypingCommand.h \
     editing/UnlinkCommand.h \
     editing/VisiblePosition.h \
@@ -1571,6 +1588,7 @@ HEADERS += \
     loader/FTPDirectoryParser.h \
     loader/icon/IconDatabase.h \
     loader/icon/IconLoader.h \
+    loader/icon/IconMappingSnapshot.h \
     loader/icon/IconRecord.h \
     loader/icon/PageURLRecord.h \
     loader/ImageDocument.h \
@@ -1584,6 +1602,7 @@ HEADERS += \
     loader/PluginDocument.h \
     loader/ProgressTracker.h \
     loader/Request.h \
+    loader/ResourceDiskCache.h \
     loader/ResourceLoader.h \
     loader/SubresourceLoader.h \
     loader/TextDocument.h \
@@ -1749,16 +1768,20 @@ HEADERS += \
     platform/network/FormDataBuilder.h \
     platform/network/FormData.h \
     platform/network/HTTPHeaderMap.h \
+    platform/network/HTTPHeaderNames.h \
     platform/network/HTTPParsers.h \
     platform/network/NetworkingContext.h \
     platform/network/NetworkStateNotifier.h \
     platform/network/ProtectionSpace.h \
     platform/network/qt/QNetworkReplyHandler.h \
+    platform/network/ReplayResourceHandle.h \
     platform/network/ResourceErrorBase.h \
     platform/network/ResourceHandle.h \
     platform/network/ResourceLoadTiming.h \
+    platform/network/ResourceReplayArchive.h \
     platform/network/ResourceRequestBase.h \
     platform/network/ResourceResponseBase.h \
+    platform/PhaseTracer.h \
     platform/PlatformTouchEvent.h \
     platform/PlatformTouchPoint.h \
     platform/PopupMenu.h \
@@ -1931,6 +1954,7 @@ HEADERS += \
     rendering/style/StyleBackgroundData.h \
     rendering/style/StyleBoxData.h \
     rendering/style/StyleCachedImage.h \
+    rendering/style/StyleDataInterner.h \
     rendering/style/StyleFlexibleBoxData.h \
     rendering/style/StyleGeneratedImage.h \
     rendering/style/StyleInheritedData.h \
@@ -2480,6 +2504,7 @@ contains(DEFINES, ENABLE_INDEXED_DATABASE=1) {
     HEADERS += \
         bindings/js/IDBBindingUtilities.h \
         storage/IDBAny.h \
+        storage/IDBBTree.h \
         storage/IDBCallbacks.h \
         storage/IDBCursor.h \
         storage/IDBCursorBackendImpl.h \
@@ -2512,6 +2537,7 @@ contains(DEFINES, ENABLE_INDEXED_DATABASE=1) {
         bindings/js/JSIDBAnyCustom.cpp \
         bindings/js/JSIDBKeyCustom.cpp \
         storage/IDBAny.cpp \
+        storage/IDBBTree.cpp \
         storage/IDBCursor.cpp \
         storage/IDBCursorBackendImpl.cpp \
         storage/IDBDatabase.cpp \
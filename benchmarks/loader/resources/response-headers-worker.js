@@ -0,0 +1,38 @@
+// Runs one round of response-headers.html from a worker, so that every response is copied
+// from the main thread before the headers are read.
+onmessage = function(event) {
+    var url = event.data.url;
+    var loads = event.data.loads;
+    var headerNames = event.data.headerNames;
+    var started = 0;
+    var finished = 0;
+    var failed = 0;
+    var start = new Date();
+
+    function loadFinished() {
+        if (++finished == loads)
+            postMessage({ time: new Date() - start, failed: failed });
+        else if (started < loads)
+            startLoad();
+    }
+
+    function startLoad() {
+        var xhr = new XMLHttpRequest();
+        xhr.open("GET", url, true);
+        xhr.onload = function() {
+            xhr.getAllResponseHeaders();
+            for (var i = 0; i < headerNames.length; ++i)
+                xhr.getResponseHeader(headerNames[i]);
+            loadFinished();
+        };
+        xhr.onerror = function() {
+            failed++;
+            loadFinished();
+        };
+        started++;
+        xhr.send();
+    }
+
+    for (var i = 0; i < 6 && i < loads; ++i)
+        startLoad();
+};
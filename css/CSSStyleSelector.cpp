@@ -71,6 +71,7 @@
 #include "PageGroup.h"
 #include "Pair.h"
 #include "PerspectiveTransformOperation.h"
+#include "PhaseTracer.h"
 #include "Rect.h"
 #include "RenderScrollbar.h"
 #include "RenderScrollbarTheme.h"
@@ -83,6 +84,7 @@
 #include "ShadowValue.h"
 #include "SkewTransformOperation.h"
 #include "StyleCachedImage.h"
+#include "StyleDataInterner.h"
 #include "StylePendingImage.h"
 #include "StyleGeneratedImage.h"
 #include "StyleSheetList.h"
@@ -1149,6 +1151,8 @@ PassRefPtr<RenderStyle> CSSStyleSelector::styleForDocument(Document* document)
 
 PassRefPtr<RenderStyle> CSSStyleSelector::styleForElement(Element* e, RenderStyle* defaultParent, bool allowSharing, bool resolveForRootDefault, bool matchVisitedPseudoClass)
 {
+    PhaseTracer::increment(PhaseTracer::ElementsStyledCounter);
+
     // Once an element has a renderer, we don't try to destroy it, since otherwise the renderer
     // will vanish if a style recalc happens during loading.
     if (allowSharing && !e->document()->haveStylesheetsLoaded() && !e->renderer()) {
@@ -1380,6 +1384,9 @@ PassRefPtr<RenderStyle> CSSStyleSelector::styleForElement(Element* e, RenderStyl
         m_style->addCachedPseudoStyle(visitedStyle.release());
     }
 
+    // The style is complete; share its data groups with equal ones computed for other elements.
+    e->document()->styleDataInterner()->intern(m_style.get());
+
     if (!matchVisitedPseudoClass)
         initElement(0); // Clear out for the next resolve.
 
@@ -46,7 +46,7 @@ inline Attr::Attr(Element* element, Document* document, PassRefPtr<Attribute> at
 
 PassRefPtr<Attr> Attr::create(Element* element, Document* document, PassRefPtr<Attribute> attribute)
 {
-    RefPtr<Attr> attr = adoptRef(new Attr(element, document, attribute));
+    RefPtr<Attr> attr = adoptRef(new (document) Attr(element, document, attribute));
     attr->createTextChild();
     return attr.release();
 }
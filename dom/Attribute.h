@@ -26,6 +26,7 @@
 #define Attribute_h
 
 #include "CSSMappedAttributeDeclaration.h"
+#include "DOMArena.h"
 #include "QualifiedName.h"
 
 namespace WebCore {
@@ -41,23 +42,30 @@ class NamedNodeMap;
 class Attribute : public RefCounted<Attribute> {
     friend class Attr;
     friend class NamedNodeMap;
+    friend class SharedAttributeCache;
 public:
-    static PassRefPtr<Attribute> create(const QualifiedName& name, const AtomicString& value)
+    static PassRefPtr<Attribute> create(const QualifiedName& name, const AtomicString& value, DOMArena* arena = 0)
     {
-        return adoptRef(new Attribute(name, value, false, 0));
+        return adoptRef(new (arena) Attribute(name, value, false, 0));
     }
-    static PassRefPtr<Attribute> createMapped(const QualifiedName& name, const AtomicString& value)
+    static PassRefPtr<Attribute> createMapped(const QualifiedName& name, const AtomicString& value, DOMArena* arena = 0)
     {
-        return adoptRef(new Attribute(name, value, true, 0));
+        return adoptRef(new (arena) Attribute(name, value, true, 0));
     }
-    static PassRefPtr<Attribute> createMapped(const AtomicString& name, const AtomicString& value)
+    static PassRefPtr<Attribute> createMapped(const AtomicString& name, const AtomicString& value, DOMArena* arena = 0)
     {
-        return adoptRef(new Attribute(name, value, true, 0));
+        return adoptRef(new (arena) Attribute(name, value, true, 0));
     }
 	static PassRefPtr<Attribute> createMapped(const AtomicString& name, const AtomicString& value, bool zycReadOnly)
 	{
 		return adoptRef(new Attribute(name, value, true, 0, zycReadOnly));
 	}
+
+    // Attributes created without an arena come from the malloc heap.
+    void* operator new(size_t size) { return DOMArena::allocate(0, DOMArena::AttributeObject, size); }
+    void* operator new(size_t size, DOMArena* arena) { return DOMArena::allocate(arena, DOMArena::AttributeObject, size); }
+    void operator delete(void* p, size_t size) { DOMArena::free(DOMArena::AttributeObject, size, p); }
+
     const AtomicString& value() const { return m_value; }
     const AtomicString& prefix() const { return m_name.prefix(); }
     const AtomicString& localName() const { return m_name.localName(); }
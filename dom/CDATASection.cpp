@@ -33,7 +33,7 @@ inline CDATASection::CDATASection(Document* document, const String& data)
 
 PassRefPtr<CDATASection> CDATASection::create(Document* document, const String& data)
 {
-    return adoptRef(new CDATASection(document, data));
+    return adoptRef(new (document) CDATASection(document, data));
 }
 
 String CDATASection::nodeName() const
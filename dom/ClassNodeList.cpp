@@ -31,12 +31,13 @@
 #include "ClassNodeList.h"
 
 #include "Document.h"
+#include "DocumentElementIndex.h"
 #include "StyledElement.h"
 
 namespace WebCore {
 
 ClassNodeList::ClassNodeList(PassRefPtr<Node> rootNode, const String& classNames)
-    : DynamicNodeList(rootNode)
+    : DynamicNodeList(rootNode, InvalidateOnClassAttrChange)
     , m_classNames(classNames, m_rootNode->document()->inCompatMode())
     , m_originalClassNames(classNames)
 {
@@ -57,4 +58,28 @@ bool ClassNodeList::nodeMatches(Element* testNode) const
     return static_cast<StyledElement*>(testNode)->classNames().containsAll(m_classNames);
 }
 
+const Vector<Element*>* ClassNodeList::indexedCandidates(bool& allMatch) const
+{
+    size_t classCount = m_classNames.size();
+    if (!classCount)
+        return 0;
+    DocumentElementIndex* index = m_rootNode->document()->elementIndex();
+    if (!index)
+        return 0;
+
+    // Elements must have every class, so start from the one with the fewest elements.
+    size_t rarest = 0;
+    size_t rarestCount = index->classNameCount(m_classNames[0]);
+    for (size_t i = 1; i < classCount && rarestCount; ++i) {
+        size_t count = index->classNameCount(m_classNames[i]);
+        if (count < rarestCount) {
+            rarest = i;
+            rarestCount = count;
+        }
+    }
+
+    allMatch = classCount == 1;
+    return &index->elementsWithClassName(m_classNames[rarest]);
+}
+
 } // namespace WebCore
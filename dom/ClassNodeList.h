@@ -48,6 +48,7 @@ namespace WebCore {
         ClassNodeList(PassRefPtr<Node> rootNode, const String& classNames);
 
         virtual bool nodeMatches(Element*) const;
+        virtual const Vector<Element*>* indexedCandidates(bool& allMatch) const;
 
         SpaceSplitString m_classNames;
         String m_originalClassNames;
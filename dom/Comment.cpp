@@ -33,7 +33,7 @@ inline Comment::Comment(Document* document, const String& text)
 
 PassRefPtr<Comment> Comment::create(Document* document, const String& text)
 {
-    return adoptRef(new Comment(document, text));
+    return adoptRef(new (document) Comment(document, text));
 }
 
 String Comment::nodeName() const
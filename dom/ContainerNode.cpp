@@ -986,6 +986,9 @@ static void dispatchChildInsertionEvents(Node* child)
 {
     ASSERT(!eventDispatchForbidden());
 
+    if (!child->document()->hasMutationListeners())
+        return;
+
     RefPtr<Node> c = child;
     RefPtr<Document> document = child->document();
 
@@ -1010,6 +1013,9 @@ static void dispatchChildRemovalEvents(Node* child)
     }
 #endif
 
+    if (!child->document()->hasMutationListeners())
+        return;
+
     RefPtr<Node> c = child;
     RefPtr<Document> document = child->document();
 
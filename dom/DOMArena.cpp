@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2026 The WebKit Authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.h"
+#include "DOMArena.h"
+
+#include "PlatformString.h"
+#include "StringBuilder.h"
+#include <string.h>
+#include <wtf/Assertions.h>
+#include <wtf/FastMalloc.h>
+#include <wtf/MainThread.h>
+
+#define ROUNDUP(x, y) ((((x)+((y)-1))/(y))*(y))
+
+namespace WebCore {
+
+static const unsigned arenaChunkSize = 64 * 1024;
+
+static const char* const objectTypeNames[DOMArena::NumberOfObjectTypes] = { "Node", "Attribute", "NodeRareData" };
+
+struct DOMArenaHeader {
+    DOMArena* arena;
+#ifndef NDEBUG
+    size_t size;
+    unsigned signature;
+#endif
+};
+
+static const size_t headerSize = ARENA_ALIGN(sizeof(DOMArenaHeader));
+
+#ifndef NDEBUG
+static const unsigned signature = 0xDBA00D0A;
+static const unsigned signatureDead = 0xDBA00D0D;
+
+// Written over every object that goes back on a free list, so stale pointers read garbage and
+// writes through them are caught when the block is handed out again.
+static const unsigned char freedObjectPattern = 0xDB;
+
+static bool isPoisoned(const void* block, size_t size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(block);
+    for (size_t i = sizeof(void*); i < size; ++i) {
+        if (bytes[i] != freedObjectPattern)
+            return false;
+    }
+    return true;
+}
+#endif
+
+struct TypeStatistics {
+    unsigned liveObjects;
+    size_t liveBytes;
+    unsigned peakObjects;
+    size_t peakBytes;
+    unsigned long long totalAllocations;
+};
+
+static TypeStatistics typeStatistics[DOMArena::NumberOfObjectTypes];
+static unsigned liveArenas;
+static size_t totalArenaBytes;
+static size_t totalRecycledBytes;
+
+DOMArena::DOMArena()
+    : m_arenaBytes(0)
+    , m_recycledBytes(0)
+{
+    ASSERT(isMainThread());
+    INIT_ARENA_POOL(&m_pool, "DOMArena", arenaChunkSize);
+    memset(m_recyclers, 0, sizeof(m_recyclers));
+    ++liveArenas;
+}
+
+DOMArena::~DOMArena()
+{
+    ASSERT(isMainThread());
+    FinishArenaPool(&m_pool);
+    ASSERT(liveArenas);
+    --liveArenas;
+    totalArenaBytes -= m_arenaBytes;
+    totalRecycledBytes -= m_recycledBytes;
+}
+
+void* DOMArena::allocate(DOMArena* arena, ObjectType type, size_t size)
+{
+    ASSERT(isMainThread());
+
+    // Ensure we have correct alignment for pointers.
+    size = ROUNDUP(size, sizeof(void*));
+
+    TypeStatistics& statistics = typeStatistics[type];
+    ++statistics.liveObjects;
+    statistics.liveBytes += size;
+    ++statistics.totalAllocations;
+    if (statistics.liveBytes > statistics.peakBytes) {
+        statistics.peakObjects = statistics.liveObjects;
+        statistics.peakBytes = statistics.liveBytes;
+    }
+
+    const size_t blockSize = headerSize + size;
+    void* block;
+    if (arena && blockSize <= maxRecycledSize) {
+        block = arena->allocateBlock(blockSize);
+        arena->ref();
+    } else {
+        block = fastMalloc(blockSize);
+        arena = 0;
+    }
+
+    DOMArenaHeader* header = static_cast<DOMArenaHeader*>(block);
+    header->arena = arena;
+#ifndef NDEBUG
+    header->size = size;
+    header->signature = signature;
+#endif
+    return static_cast<char*>(block) + headerSize;
+}
+
+void DOMArena::free(ObjectType type, size_t size, void* ptr)
+{
+    ASSERT(isMainThread());
+
+    size = ROUNDUP(size, sizeof(void*));
+
+    TypeStatistics& statistics = typeStatistics[type];
+    ASSERT(statistics.liveObjects);
+    ASSERT(statistics.liveBytes >= size);
+    --statistics.liveObjects;
+    statistics.liveBytes -= size;
+
+    void* block = static_cast<char*>(ptr) - headerSize;
+    DOMArenaHeader* header = static_cast<DOMArenaHeader*>(block);
+    ASSERT(header->signature == signature);
+    ASSERT(header->size == size);
+#ifndef NDEBUG
+    header->signature = signatureDead;
+#endif
+
+    DOMArena* arena = header->arena;
+    if (!arena) {
+        fastFree(block);
+        return;
+    }
+
+    arena->freeBlock(headerSize + size, block);
+    arena->deref();
+}
+
+void* DOMArena::allocateBlock(size_t size)
+{
+    const size_t index = size / sizeof(void*);
+    void* result = m_recyclers[index];
+    if (result) {
+        ASSERT(isPoisoned(result, size));
+        m_recyclers[index] = *static_cast<void**>(result);
+        m_recycledBytes -= size;
+        totalRecycledBytes -= size;
+        return result;
+    }
+
+    ARENA_ALLOCATE(result, &m_pool, size);
+    m_arenaBytes += size;
+    totalArenaBytes += size;
+    return result;
+}
+
+void DOMArena::freeBlock(size_t size, void* block)
+{
+#ifndef NDEBUG
+    memset(block, freedObjectPattern, size);
+#endif
+
+    const size_t index = size / sizeof(void*);
+    *static_cast<void**>(block) = m_recyclers[index];
+    m_recyclers[index] = block;
+    m_recycledBytes += size;
+    totalRecycledBytes += size;
+}
+
+String DOMArena::statistics()
+{
+    StringBuilder report;
+    for (int type = 0; type < NumberOfObjectTypes; ++type) {
+        const TypeStatistics& statistics = typeStatistics[type];
+        report.append(String::format("%s: %u live (%lu bytes), peak %u (%lu bytes), %llu allocated in total\n",
+            objectTypeNames[type], statistics.liveObjects, static_cast<unsigned long>(statistics.liveBytes),
+            statistics.peakObjects, static_cast<unsigned long>(statistics.peakBytes), statistics.totalAllocations));
+    }
+    report.append(String::format("Arenas: %u live, %lu bytes handed out, %lu bytes waiting for reuse\n",
+        liveArenas, static_cast<unsigned long>(totalArenaBytes), static_cast<unsigned long>(totalRecycledBytes)));
+    return report.toString();
+}
+
+} // namespace WebCore
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026 The WebKit Authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef DOMArena_h
+#define DOMArena_h
+
+#include "Arena.h"
+#include <wtf/PassRefPtr.h>
+#include <wtf/RefCounted.h>
+
+namespace WebCore {
+
+class String;
+
+// Size-class allocator for the small, numerous DOM objects: nodes, attributes and node rare
+// data. Each document owns an arena, so its objects sit close together in large chunks and
+// are recycled through per-size free lists instead of being scattered over the malloc heap.
+//
+// Objects remember the arena they were carved from, because a node can be adopted into
+// another document and outlive the one that created it. Every live object holds a reference
+// to its arena, so the chunks are freed with the document once none of its objects remain.
+class DOMArena : public RefCounted<DOMArena> {
+public:
+    enum ObjectType {
+        NodeObject,
+        AttributeObject,
+        NodeRareDataObject,
+        NumberOfObjectTypes
+    };
+
+    static PassRefPtr<DOMArena> create() { return adoptRef(new DOMArena); }
+    ~DOMArena();
+
+    // A null arena allocates from the malloc heap; objects created before their document has
+    // an arena, like the document itself, take that path.
+    static void* allocate(DOMArena*, ObjectType, size_t);
+    static void free(ObjectType, size_t, void*);
+
+    // Live object counts and bytes per type, and how much arena memory is in use or recycled.
+    static String statistics();
+
+private:
+    DOMArena();
+
+    void* allocateBlock(size_t);
+    void freeBlock(size_t, void*);
+
+    static const size_t maxRecycledSize = 512;
+
+    ArenaPool m_pool;
+    void* m_recyclers[maxRecycledSize / sizeof(void*) + 1];
+    size_t m_arenaBytes;
+    size_t m_recycledBytes;
+};
+
+} // namespace WebCore
+
+#endif // DOMArena_h
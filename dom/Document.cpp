@@ -48,6 +48,7 @@
 #include "DeviceMotionEvent.h"
 #include "DeviceOrientationEvent.h"
 #include "DocLoader.h"
+#include "DocumentElementIndex.h"
 #include "DocumentFragment.h"
 #include "DocumentLoader.h"
 #include "DocumentType.h"
@@ -102,10 +103,12 @@
 #include "Page.h"
 #include "PageGroup.h"
 #include "PageTransitionEvent.h"
+#include "PhaseTracer.h"
 #include "PlatformKeyboardEvent.h"
 #include "PopStateEvent.h"
 #include "ProcessingInstruction.h"
 #include "ProgressEvent.h"
+#include "Range.h"
 #include "RegisteredEventListener.h"
 #include "RenderArena.h"
 #include "RenderLayer.h"
@@ -119,10 +122,13 @@
 #include "SegmentedString.h"
 #include "SelectionController.h"
 #include "Settings.h"
+#include "SharedAttributeCache.h"
 #include "StaticHashSetNodeList.h"
+#include "StyleDataInterner.h"
 #include "StyleSheetList.h"
 #include "TextEvent.h"
 #include "TextResourceDecoder.h"
+#include "TextSearchIndex.h"
 #include "Timer.h"
 #include "TransformSource.h"
 #include "TreeWalker.h"
@@ -366,6 +372,7 @@ Document::Document(Frame* frame, const KURL& url, bool isXHTML, bool isHTML)
     , m_title("")
     , m_rawTitle("")
     , m_titleSetExplicitly(false)
+    , m_domArena(DOMArena::create())
     , m_updateFocusAppearanceTimer(this, &Document::updateFocusAppearanceTimerFired)
     , m_startTime(currentTime())
     , m_overMinimumLayoutThreshold(false)
@@ -420,6 +427,9 @@ Document::Document(Frame* frame, const KURL& url, bool isXHTML, bool isHTML)
 
     m_markers = new DocumentMarkerController();
 
+    for (int i = 0; i < numNodeListInvalidationTypes; ++i)
+        m_nodeListCounts[i] = 0;
+
     m_docLoader = new DocLoader(this);
 
     m_visuallyOrdered = false;
@@ -430,6 +440,7 @@ Document::Document(Frame* frame, const KURL& url, bool isXHTML, bool isHTML)
 
     m_textColor = Color::black;
     m_listenerTypes = 0;
+    m_mutationEventBatchDepth = 0;
     setInDocument();
     m_inStyleRecalc = false;
     m_closeAfterStyleRecalc = false;
@@ -489,6 +500,8 @@ void Document::removedLastRef()
 
         // removeAllChildren() doesn't always unregister IDs, do it upfront to avoid having stale references in the map.
         m_elementsById.clear();
+        m_elementIndex.clear();
+        m_textSearchIndex.clear();
 
         removeAllChildren();
 
@@ -907,6 +920,39 @@ PassRefPtr<Element> Document::createElementNS(const String& namespaceURI, const
     return createElement(qName, false);
 }
 
+DocumentElementIndex* Document::elementIndex()
+{
+    if (m_elementIndex)
+        return m_elementIndex.get();
+    Settings* settings = this->settings();
+    if (!settings || !settings->documentElementIndexEnabled())
+        return 0;
+    m_elementIndex = DocumentElementIndex::create(this);
+    return m_elementIndex.get();
+}
+
+SharedAttributeCache* Document::sharedAttributeCache()
+{
+    if (m_sharedAttributeCache)
+        return m_sharedAttributeCache.get();
+    Settings* settings = this->settings();
+    if (!settings || !settings->sharedParserAttributesEnabled())
+        return 0;
+    m_sharedAttributeCache.set(new SharedAttributeCache);
+    return m_sharedAttributeCache.get();
+}
+
+TextSearchIndex* Document::textSearchIndex()
+{
+    if (m_textSearchIndex)
+        return m_textSearchIndex.get();
+    Settings* settings = this->settings();
+    if (!settings || !settings->textSearchIndexEnabled())
+        return 0;
+    m_textSearchIndex = TextSearchIndex::create(this);
+    return m_textSearchIndex.get();
+}
+
 Element* Document::getElementById(const AtomicString& elementId) const
 {
     if (elementId.isEmpty())
@@ -1419,6 +1465,8 @@ void Document::recalcStyle(StyleChange change)
     if (m_inStyleRecalc)
         return; // Guard against re-entrancy. -dwh
 
+    PhaseTraceScope traceScope(PhaseTracer::StyleRecalcPhase);
+
 #if ENABLE(INSPECTOR)
     if (InspectorTimelineAgent* timelineAgent = inspectorTimelineAgent())
         timelineAgent->willRecalculateStyle();
@@ -1448,6 +1496,10 @@ void Document::recalcStyle(StyleChange change)
         if (change >= Inherit || n->childNeedsStyleRecalc() || n->needsStyleRecalc())
             n->recalcStyle(change);
 
+    // Style changes such as visibility can change the text without a layout.
+    if (m_textSearchIndex)
+        m_textSearchIndex->invalidate();
+
 #if USE(ACCELERATED_COMPOSITING)
     if (view()) {
         bool layoutPending = view()->layoutPending() || renderer()->needsLayout();
@@ -1555,6 +1607,10 @@ void Document::updateLayoutIgnorePendingStylesheets()
 
     updateLayout();
 
+    // Callers want real geometry, which blocks whose layout was deferred don't have.
+    if (FrameView* frameView = view())
+        frameView->layoutDeferredContent();
+
     m_ignorePendingStylesheets = oldIgnore;
 }
 
@@ -1709,6 +1765,7 @@ void Document::detach()
     // callers of Document::detach().
     m_frame = 0;
     m_renderArena.clear();
+    m_styleDataInterner.clear();
 }
 
 void Document::removeAllEventListeners()
@@ -1721,6 +1778,13 @@ void Document::removeAllEventListeners()
         node->removeAllEventListeners();
 }
 
+StyleDataInterner* Document::styleDataInterner()
+{
+    if (!m_styleDataInterner)
+        m_styleDataInterner.set(new StyleDataInterner);
+    return m_styleDataInterner.get();
+}
+
 RenderView* Document::renderView() const
 {
     return toRenderView(renderer());
@@ -3493,6 +3557,46 @@ void Document::addListenerTypeIfNeeded(const AtomicString& eventType)
 #endif
 }
 
+void Document::deferSubtreeModifiedEvent(Node* target)
+{
+    ASSERT(m_mutationEventBatchDepth);
+    // Editing commands mostly change the same few nodes over and over.
+    if (!m_deferredSubtreeModifiedTargets.isEmpty() && m_deferredSubtreeModifiedTargets.last() == target)
+        return;
+    m_deferredSubtreeModifiedTargets.append(target);
+}
+
+void Document::endMutationEventBatch()
+{
+    ASSERT(m_mutationEventBatchDepth);
+    if (--m_mutationEventBatchDepth || m_deferredSubtreeModifiedTargets.isEmpty())
+        return;
+
+    Vector<RefPtr<Node> > targets;
+    targets.swap(m_deferredSubtreeModifiedTargets);
+
+    // One event per tree that changed, targeted at the lowest common parent of the changes.
+    Vector<RefPtr<Node> > coalescedTargets;
+    size_t targetCount = targets.size();
+    for (size_t i = 0; i < targetCount; ++i) {
+        Node* target = targets[i].get();
+        size_t coalescedCount = coalescedTargets.size();
+        size_t j = 0;
+        for (; j < coalescedCount; ++j) {
+            if (Node* ancestor = Range::commonAncestorContainer(coalescedTargets[j].get(), target)) {
+                coalescedTargets[j] = ancestor;
+                break;
+            }
+        }
+        if (j == coalescedCount)
+            coalescedTargets.append(target);
+    }
+
+    size_t coalescedCount = coalescedTargets.size();
+    for (size_t i = 0; i < coalescedCount; ++i)
+        coalescedTargets[i]->dispatchEvent(MutationEvent::create(eventNames().DOMSubtreeModifiedEvent, true));
+}
+
 CSSStyleDeclaration* Document::getOverrideStyle(Element*, const String&)
 {
     return 0;
@@ -4095,6 +4199,10 @@ CollectionCache* Document::nameCollectionInfo(CollectionType type, const AtomicS
 void Document::finishedParsing()
 {
     setParsing(false);
+    if (m_sharedAttributeCache)
+        LOG(Loading, "Shared attributes of %s:\n%s", url().string().utf8().data(), m_sharedAttributeCache->memoryReport().utf8().data());
+    if (m_styleDataInterner)
+        LOG(Loading, "Interned style data of %s:\n%s", url().string().utf8().data(), m_styleDataInterner->memoryReport().utf8().data());
     dispatchEvent(Event::create(eventNames().DOMContentLoadedEvent, true, false));
 
     if (Frame* f = frame()) {
@@ -4314,6 +4422,15 @@ bool Document::useSecureKeyboardEntryWhenActive() const
     return m_useSecureKeyboardEntryWhenActive;
 }
 
+bool Document::shouldInvalidateDynamicNodeListCaches(const QualifiedName& attrName)
+{
+    for (int type = DoNotInvalidateOnAttributeChange + 1; type < numNodeListInvalidationTypes; ++type) {
+        if (m_nodeListCounts[type] && DynamicNodeList::invalidationTypeDependsOnAttribute(static_cast<NodeListInvalidationType>(type), attrName, this))
+            return true;
+    }
+    return false;
+}
+
 void Document::initSecurityContext()
 {
     if (securityOrigin() && !securityOrigin()->isEmpty())
@@ -33,6 +33,7 @@
 #include "Color.h"
 #include "ContainerNode.h"
 #include "DocumentMarkerController.h"
+#include "DynamicNodeList.h"
 #include "QualifiedName.h"
 #include "ScriptExecutionContext.h"
 #include "Timer.h"
@@ -65,6 +66,7 @@ class DOMSelection;
 class DOMWindow;
 class DatabaseThread;
 class DocLoader;
+class DocumentElementIndex;
 class DocumentFragment;
 class DocumentType;
 class DocumentWeakReference;
@@ -107,12 +109,15 @@ class ScriptableDocumentParser;
 class ScriptElementData;
 class SecurityOrigin;
 class SerializedScriptValue;
+class SharedAttributeCache;
 class SegmentedString;
 class Settings;
+class StyleDataInterner;
 class StyleSheet;
 class StyleSheetList;
 class Text;
 class TextResourceDecoder;
+class TextSearchIndex;
 class DocumentParser;
 class TreeWalker;
 class XMLHttpRequest;
@@ -301,6 +306,15 @@ public:
     bool hasElementWithId(AtomicStringImpl* id) const;
     bool containsMultipleElementsWithId(const AtomicString& elementId) { return m_duplicateIds.contains(elementId.impl()); }
 
+    // Tag and class name lookups for document-wide queries. The index is built on first use;
+    // returns 0 unless Settings::documentElementIndexEnabled() is set.
+    DocumentElementIndex* elementIndex();
+    DocumentElementIndex* existingElementIndex() const { return m_elementIndex.get(); }
+
+    // Shares equal attributes between parser-created elements; returns 0 unless
+    // Settings::sharedParserAttributesEnabled() is set.
+    SharedAttributeCache* sharedAttributeCache();
+
     /**
      * Retrieve all nodes that intersect a rect in the window's document, until it is fully enclosed by
      * the boundaries of node.
@@ -514,6 +528,9 @@ public:
 
     RenderArena* renderArena() { return m_renderArena.get(); }
 
+    // Nodes, attributes and node rare data created for this document are allocated here.
+    DOMArena* domArena() const { return m_domArena.get(); }
+
     RenderView* renderView() const;
 
     void clearAXObjectCache();
@@ -698,6 +715,19 @@ public:
     void addListenerType(ListenerType listenerType) { m_listenerTypes = m_listenerTypes | listenerType; }
     void addListenerTypeIfNeeded(const AtomicString& eventType);
 
+    bool hasMutationListeners() const
+    {
+        return m_listenerTypes & (DOMSUBTREEMODIFIED_LISTENER | DOMNODEINSERTED_LISTENER | DOMNODEREMOVED_LISTENER
+            | DOMNODEREMOVEDFROMDOCUMENT_LISTENER | DOMNODEINSERTEDINTODOCUMENT_LISTENER | DOMATTRMODIFIED_LISTENER
+            | DOMCHARACTERDATAMODIFIED_LISTENER);
+    }
+
+    // Used by MutationEventBatch.
+    void beginMutationEventBatch() { ++m_mutationEventBatchDepth; }
+    void endMutationEventBatch();
+    bool inMutationEventBatch() const { return m_mutationEventBatchDepth; }
+    void deferSubtreeModifiedEvent(Node*);
+
     CSSStyleDeclaration* getOverrideStyle(Element*, const String& pseudoElt);
 
     /**
@@ -811,6 +841,12 @@ public:
 
     DocumentMarkerController* markers() const { return m_markers.get(); }
 
+    // Cached document text for find-in-page; returns 0 unless Settings::textSearchIndexEnabled() is set.
+    TextSearchIndex* textSearchIndex();
+
+    // Shares equal RenderStyle data groups between the elements of this document.
+    StyleDataInterner* styleDataInterner();
+
     bool execCommand(const String& command, bool userInterface = false, const String& value = String());
     bool queryCommandEnabled(const String& command);
     bool queryCommandIndeterm(const String& command);
@@ -875,6 +911,10 @@ public:
     void removeNodeListCache() { ASSERT(m_numNodeListCaches > 0); --m_numNodeListCaches; }
     bool hasNodeListCaches() const { return m_numNodeListCaches; }
 
+    void registerDynamicNodeList(DynamicNodeList* list) { ++m_nodeListCounts[list->invalidationType()]; }
+    void unregisterDynamicNodeList(DynamicNodeList* list) { ASSERT(m_nodeListCounts[list->invalidationType()] > 0); --m_nodeListCounts[list->invalidationType()]; }
+    bool shouldInvalidateDynamicNodeListCaches(const QualifiedName& attrName);
+
     void updateFocusAppearanceSoon(bool restorePreviousSelection);
     void cancelFocusAppearanceUpdate();
         
@@ -1119,6 +1159,9 @@ private:
 
     unsigned short m_listenerTypes;
 
+    unsigned m_mutationEventBatchDepth;
+    Vector<RefPtr<Node> > m_deferredSubtreeModifiedTargets;
+
     RefPtr<StyleSheetList> m_styleSheets; // All of the stylesheets that are currently in effect for our media type and stylesheet set.
     
     typedef ListHashSet<Node*, 32> StyleSheetCandidateListHashSet;
@@ -1169,9 +1212,11 @@ private:
     RefPtr<Element> m_titleElement;
 
     OwnPtr<RenderArena> m_renderArena;
+    RefPtr<DOMArena> m_domArena;
 
     mutable AXObjectCache* m_axObjectCache;
     OwnPtr<DocumentMarkerController> m_markers;
+    OwnPtr<StyleDataInterner> m_styleDataInterner;
     
     Timer<Document> m_updateFocusAppearanceTimer;
 
@@ -1217,6 +1262,10 @@ private:
     // when the first node with a given ID is cached, otherwise the same as the total count.
     mutable HashMap<AtomicStringImpl*, Element*> m_elementsById;
     mutable HashCountedSet<AtomicStringImpl*> m_duplicateIds;
+
+    OwnPtr<DocumentElementIndex> m_elementIndex;
+    OwnPtr<SharedAttributeCache> m_sharedAttributeCache;
+    OwnPtr<TextSearchIndex> m_textSearchIndex;
     
     mutable HashMap<StringImpl*, Element*, CaseFoldingHash> m_elementsByAccessKey;
     
@@ -1260,6 +1309,7 @@ private:
     bool m_isHTML;
 
     unsigned m_numNodeListCaches;
+    unsigned m_nodeListCounts[numNodeListInvalidationTypes];
 
 #if USE(JSC)
     JSWrapperCacheMap m_wrapperCacheMap;
@@ -0,0 +1,247 @@
+/*
+ * Copyright (C) 2026 The WebKit Authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.h"
+#include "DocumentElementIndex.h"
+
+#include "Document.h"
+#include "Element.h"
+#include "StyledElement.h"
+#include <algorithm>
+
+namespace WebCore {
+
+// Lists holding less than this fraction of the document's elements are put back in order by
+// sorting; larger ones by walking the document, which is cheaper than that many comparisons.
+static const unsigned sortedListFraction = 64;
+
+static bool precedesInDocumentOrder(Element* a, Element* b)
+{
+    return a->compareDocumentPosition(b) & Node::DOCUMENT_POSITION_FOLLOWING;
+}
+
+static const Vector<Element*>& emptyElementVector()
+{
+    DEFINE_STATIC_LOCAL(Vector<Element*>, emptyVector, ());
+    return emptyVector;
+}
+
+static const SpaceSplitString* classNamesOf(Element* element)
+{
+    if (!element->hasClass() || !element->isStyledElement() || !element->attributeMap())
+        return 0;
+    return &static_cast<StyledElement*>(element)->classNames();
+}
+
+PassOwnPtr<DocumentElementIndex> DocumentElementIndex::create(Document* document)
+{
+    return adoptPtr(new DocumentElementIndex(document));
+}
+
+DocumentElementIndex::DocumentElementIndex(Document* document)
+    : m_document(document)
+    , m_elementCount(0)
+{
+    for (Node* node = document->firstChild(); node; node = node->traverseNextNode()) {
+        if (node->isElementNode())
+            addElement(static_cast<Element*>(node), true);
+    }
+}
+
+DocumentElementIndex::~DocumentElementIndex()
+{
+    deleteAllValues(m_tagNameMap);
+    deleteAllValues(m_classNameMap);
+}
+
+bool DocumentElementIndex::contains(Element* element) const
+{
+    ElementListMap::const_iterator it = m_tagNameMap.find(element->localName().impl());
+    return it != m_tagNameMap.end() && it->second->members.contains(element);
+}
+
+bool DocumentElementIndex::isInDocumentTree(Element* element) const
+{
+    // Shadow trees are marked as being in the document too, but document-wide queries never see them.
+    ContainerNode* parent = element->parentNode();
+    if (!parent)
+        return false;
+    if (parent->isDocumentNode())
+        return true;
+    if (parent->isElementNode())
+        return contains(static_cast<Element*>(parent));
+    for (Node* ancestor = parent; ancestor; ancestor = ancestor->parentNode()) {
+        if (ancestor->isDocumentNode())
+            return true;
+    }
+    return false;
+}
+
+void DocumentElementIndex::addElement(Element* element)
+{
+    if (isInDocumentTree(element))
+        addElement(element, false);
+}
+
+void DocumentElementIndex::addElement(Element* element, bool inDocumentOrder)
+{
+    ++m_elementCount;
+    add(m_tagNameMap, element->localName().impl(), element, inDocumentOrder);
+    if (const SpaceSplitString* classNames = classNamesOf(element)) {
+        for (size_t i = 0; i < classNames->size(); ++i)
+            add(m_classNameMap, (*classNames)[i].impl(), element, inDocumentOrder);
+    }
+}
+
+void DocumentElementIndex::removeElement(Element* element)
+{
+    if (!contains(element))
+        return;
+
+    ASSERT(m_elementCount);
+    --m_elementCount;
+    remove(m_tagNameMap, element->localName().impl(), element);
+    if (const SpaceSplitString* classNames = classNamesOf(element)) {
+        for (size_t i = 0; i < classNames->size(); ++i)
+            remove(m_classNameMap, (*classNames)[i].impl(), element);
+    }
+}
+
+void DocumentElementIndex::classNamesChanged(Element* element, const Vector<AtomicString, 8>& oldClassNames)
+{
+    if (!contains(element))
+        return;
+
+    // Only touch the classes that were actually added or removed, so the lists of classes
+    // the element keeps stay in order.
+    const SpaceSplitString* classNames = classNamesOf(element);
+    for (size_t i = 0; i < oldClassNames.size(); ++i) {
+        if (!classNames || !classNames->contains(oldClassNames[i]))
+            remove(m_classNameMap, oldClassNames[i].impl(), element);
+    }
+    if (!classNames)
+        return;
+    for (size_t i = 0; i < classNames->size(); ++i) {
+        const AtomicString& className = (*classNames)[i];
+        if (oldClassNames.find(className) == notFound)
+            add(m_classNameMap, className.impl(), element, false);
+    }
+}
+
+const Vector<Element*>& DocumentElementIndex::elementsWithTagName(const AtomicString& localName)
+{
+    return orderedElements(m_tagNameMap, localName.impl());
+}
+
+const Vector<Element*>& DocumentElementIndex::elementsWithClassName(const AtomicString& className)
+{
+    return orderedElements(m_classNameMap, className.impl());
+}
+
+size_t DocumentElementIndex::tagNameCount(const AtomicString& localName) const
+{
+    ElementListMap::const_iterator it = m_tagNameMap.find(localName.impl());
+    return it == m_tagNameMap.end() ? 0 : it->second->members.size();
+}
+
+size_t DocumentElementIndex::classNameCount(const AtomicString& className) const
+{
+    ElementListMap::const_iterator it = m_classNameMap.find(className.impl());
+    return it == m_classNameMap.end() ? 0 : it->second->members.size();
+}
+
+void DocumentElementIndex::add(ElementListMap& map, AtomicStringImpl* key, Element* element, bool inDocumentOrder)
+{
+    pair<ElementListMap::iterator, bool> result = map.add(key, 0);
+    if (result.second)
+        result.first->second = new ElementList;
+    ElementList* list = result.first->second;
+
+    if (!list->members.add(element).second || !list->orderedIsValid)
+        return;
+
+    if (inDocumentOrder || list->ordered.isEmpty() || precedesInDocumentOrder(list->ordered.last(), element))
+        list->ordered.append(element);
+    else {
+        list->ordered.clear();
+        list->orderedIsValid = false;
+    }
+}
+
+void DocumentElementIndex::remove(ElementListMap& map, AtomicStringImpl* key, Element* element)
+{
+    ElementListMap::iterator it = map.find(key);
+    if (it == map.end())
+        return;
+    ElementList* list = it->second;
+
+    HashSet<Element*>::iterator member = list->members.find(element);
+    if (member == list->members.end())
+        return;
+    list->members.remove(member);
+
+    if (list->members.isEmpty()) {
+        delete list;
+        map.remove(it);
+        return;
+    }
+
+    if (!list->orderedIsValid)
+        return;
+
+    if (list->ordered.last() == element)
+        list->ordered.removeLast();
+    else {
+        list->ordered.clear();
+        list->orderedIsValid = false;
+    }
+}
+
+const Vector<Element*>& DocumentElementIndex::orderedElements(const ElementListMap& map, AtomicStringImpl* key)
+{
+    ElementListMap::const_iterator it = map.find(key);
+    if (it == map.end())
+        return emptyElementVector();
+    ElementList* list = it->second;
+
+    if (!list->orderedIsValid) {
+        ASSERT(list->ordered.isEmpty());
+        list->ordered.reserveCapacity(list->members.size());
+        if (list->members.size() < m_elementCount / sortedListFraction) {
+            copyToVector(list->members, list->ordered);
+            std::sort(list->ordered.begin(), list->ordered.end(), precedesInDocumentOrder);
+        } else {
+            for (Node* node = m_document->firstChild(); node; node = node->traverseNextNode()) {
+                if (node->isElementNode() && list->members.contains(static_cast<Element*>(node)))
+                    list->ordered.append(static_cast<Element*>(node));
+            }
+        }
+        ASSERT(list->ordered.size() == list->members.size());
+        list->orderedIsValid = true;
+    }
+    return list->ordered;
+}
+
+} // namespace WebCore
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 The WebKit Authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef DocumentElementIndex_h
+#define DocumentElementIndex_h
+
+#include <wtf/HashMap.h>
+#include <wtf/HashSet.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/PassOwnPtr.h>
+#include <wtf/Vector.h>
+#include <wtf/text/AtomicString.h>
+
+namespace WebCore {
+
+class Document;
+class Element;
+
+// Maps tag local names and class names to the elements in a document that have them, in
+// document order. The index is built the first time a document-wide query asks for it and
+// is kept current from then on by Element::insertedIntoDocument, Element::removedFromDocument
+// and StyledElement::classAttributeChanged.
+class DocumentElementIndex : public Noncopyable {
+public:
+    static PassOwnPtr<DocumentElementIndex> create(Document*);
+    ~DocumentElementIndex();
+
+    void addElement(Element*);
+    void removeElement(Element*);
+    void classNamesChanged(Element*, const Vector<AtomicString, 8>& oldClassNames);
+
+    // The returned vectors stay valid until the next mutation of the document.
+    const Vector<Element*>& elementsWithTagName(const AtomicString& localName);
+    const Vector<Element*>& elementsWithClassName(const AtomicString& className);
+
+    size_t tagNameCount(const AtomicString& localName) const;
+    size_t classNameCount(const AtomicString& className) const;
+
+private:
+    DocumentElementIndex(Document*);
+
+    // Membership is tracked in a hash set so removals stay cheap; the ordered vector is
+    // extended while elements are appended in document order and rebuilt otherwise.
+    struct ElementList : Noncopyable {
+        ElementList() : orderedIsValid(true) { }
+
+        HashSet<Element*> members;
+        Vector<Element*> ordered;
+        bool orderedIsValid;
+    };
+    typedef HashMap<AtomicStringImpl*, ElementList*> ElementListMap;
+
+    bool contains(Element*) const;
+    bool isInDocumentTree(Element*) const;
+    void add(ElementListMap&, AtomicStringImpl*, Element*, bool inDocumentOrder);
+    void remove(ElementListMap&, AtomicStringImpl*, Element*);
+    const Vector<Element*>& orderedElements(const ElementListMap&, AtomicStringImpl*);
+    void addElement(Element*, bool inDocumentOrder);
+
+    Document* m_document;
+    ElementListMap m_tagNameMap;
+    ElementListMap m_classNameMap;
+    unsigned m_elementCount;
+};
+
+} // namespace WebCore
+
+#endif // DocumentElementIndex_h
@@ -39,7 +39,7 @@ inline DocumentFragment::DocumentFragment(Document* document)
 
 PassRefPtr<DocumentFragment> DocumentFragment::create(Document* document)
 {
-    return adoptRef(new DocumentFragment(document));
+    return adoptRef(new (document) DocumentFragment(document));
 }
 
 String DocumentFragment::nodeName() const
@@ -29,17 +29,95 @@
 
 #include "Node.h"
 #include "Range.h"
+#include "RenderObject.h"
 #include "TextIterator.h"
+#include <wtf/HashSet.h>
+
+using namespace std;
 
 namespace WebCore {
 
+// The side of a rect grid cell, in pixels.
+static const int rectGridCellSize = 128;
+
+// The rect grid is rebuilt from the markers once it holds this many more entries than it did
+// after the last rebuild, which bounds the number of stale entries.
+static const unsigned minimumRectGridRebuildThreshold = 1024;
+
 static IntRect placeholderRectForMarker()
 {
     return IntRect(-1, -1, -1, -1);
 }
 
+static inline bool markerTypeMatches(unsigned type, DocumentMarker::MarkerType markerType)
+{
+    return markerType == DocumentMarker::AllMarkers || static_cast<unsigned>(markerType) == type;
+}
+
+// Index of the first marker that ends at or after the given offset.
+static size_t firstMarkerEndingAtOrAfter(const Vector<DocumentMarker>& markers, unsigned offset)
+{
+    size_t low = 0;
+    size_t high = markers.size();
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (markers[middle].endOffset < offset)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+// Index of the first marker that starts at or after the given offset.
+static size_t firstMarkerStartingAtOrAfter(const Vector<DocumentMarker>& markers, unsigned offset)
+{
+    size_t low = 0;
+    size_t high = markers.size();
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (markers[middle].startOffset < offset)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+static inline int rectGridCell(int coordinate)
+{
+    return coordinate >= 0 ? coordinate / rectGridCellSize : -((-coordinate - 1) / rectGridCellSize) - 1;
+}
+
+static inline unsigned long long rectGridKey(int column, int row)
+{
+    // Biased so that no cell maps to the hash table's empty or deleted values.
+    return (static_cast<unsigned long long>(static_cast<unsigned>(column) + 0x40000000u) << 32) | (static_cast<unsigned>(row) + 0x40000000u);
+}
+
+static inline IntRect rectGridCellRect(int column, int row)
+{
+    return IntRect(column * rectGridCellSize, row * rectGridCellSize, rectGridCellSize, rectGridCellSize);
+}
+
+bool DocumentMarkerController::NodeMarkers::isEmpty() const
+{
+    for (unsigned type = 0; type < markerTypeCount; ++type) {
+        if (!lists[type].markers.isEmpty())
+            return false;
+    }
+    return true;
+}
+
+DocumentMarkerController::DocumentMarkerController()
+    : m_rectGridEntryCount(0)
+    , m_rectGridRebuildThreshold(minimumRectGridRebuildThreshold)
+{
+}
+
 void DocumentMarkerController::detach()
 {
+    clearRectGrid();
     if (m_markers.isEmpty())
         return;
     deleteAllValues(m_markers);
@@ -57,6 +135,34 @@ void DocumentMarkerController::addMarker(Range* range, DocumentMarker::MarkerTyp
     }
 }
 
+// Find-in-page adds thousands of markers at once. Every node is repainted once rather than
+// once per marker.
+void DocumentMarkerController::addMarkers(const Vector<RefPtr<Range> >& ranges, DocumentMarker::MarkerType type)
+{
+    HashSet<Node*> markedNodes;
+
+    size_t rangeCount = ranges.size();
+    for (size_t i = 0; i < rangeCount; ++i) {
+        for (TextIterator markedText(ranges[i].get()); !markedText.atEnd(); markedText.advance()) {
+            RefPtr<Range> textPiece = markedText.range();
+            int exception = 0;
+            DocumentMarker marker = {type, textPiece->startOffset(exception), textPiece->endOffset(exception), String(), false};
+            if (marker.endOffset == marker.startOffset)
+                continue;
+
+            Node* node = textPiece->startContainer(exception);
+            insertMarker(node, marker);
+            markedNodes.add(node);
+        }
+    }
+
+    HashSet<Node*>::iterator end = markedNodes.end();
+    for (HashSet<Node*>::iterator it = markedNodes.begin(); it != end; ++it) {
+        if ((*it)->renderer())
+            (*it)->renderer()->repaint();
+    }
+}
+
 void DocumentMarkerController::removeMarkers(Range* range, DocumentMarker::MarkerType markerType)
 {
     if (m_markers.isEmpty())
@@ -84,63 +190,42 @@ void DocumentMarkerController::addMarker(Node* node, DocumentMarker newMarker)
     if (newMarker.endOffset == newMarker.startOffset)
         return;
 
-    MarkerMapVectorPair* vectorPair = m_markers.get(node);
-
-    if (!vectorPair) {
-        vectorPair = new MarkerMapVectorPair;
-        vectorPair->first.append(newMarker);
-        vectorPair->second.append(placeholderRectForMarker());
-        m_markers.set(node, vectorPair);
-    } else {
-        Vector<DocumentMarker>& markers = vectorPair->first;
-        Vector<IntRect>& rects = vectorPair->second;
-        size_t numMarkers = markers.size();
-        ASSERT(numMarkers == rects.size());
-        size_t i;
-        // Iterate over all markers whose start offset is less than or equal to the new marker's.
-        // If one of them is of the same type as the new marker and touches it or intersects with it
-        // (there is at most one), remove it and adjust the new marker's start offset to encompass it.
-        for (i = 0; i < numMarkers; ++i) {
-            DocumentMarker marker = markers[i];
-            if (marker.startOffset > newMarker.startOffset)
-                break;
-            if (marker.type == newMarker.type && marker.endOffset >= newMarker.startOffset) {
-                newMarker.startOffset = marker.startOffset;
-                markers.remove(i);
-                rects.remove(i);
-                numMarkers--;
-                break;
-            }
-        }
-        size_t j = i;
-        // Iterate over all markers whose end offset is less than or equal to the new marker's,
-        // removing markers of the same type as the new marker which touch it or intersect with it,
-        // adjusting the new marker's end offset to cover them if necessary.
-        while (j < numMarkers) {
-            DocumentMarker marker = markers[j];
-            if (marker.startOffset > newMarker.endOffset)
-                break;
-            if (marker.type == newMarker.type) {
-                markers.remove(j);
-                rects.remove(j);
-                if (newMarker.endOffset <= marker.endOffset) {
-                    newMarker.endOffset = marker.endOffset;
-                    break;
-                }
-                numMarkers--;
-            } else
-                j++;
-        }
-        // At this point i points to the node before which we want to insert.
-        markers.insert(i, newMarker);
-        rects.insert(i, placeholderRectForMarker());
-    }
+    insertMarker(node, newMarker);
 
     // repaint the affected node
     if (node->renderer())
         node->renderer()->repaint();
 }
 
+void DocumentMarkerController::insertMarker(Node* node, DocumentMarker newMarker)
+{
+    NodeMarkers* nodeMarkers = m_markers.get(node);
+    if (!nodeMarkers) {
+        nodeMarkers = new NodeMarkers;
+        m_markers.set(node, nodeMarkers);
+    }
+
+    MarkerList& list = nodeMarkers->lists[newMarker.type];
+    Vector<DocumentMarker>& markers = list.markers;
+    ASSERT(markers.size() == list.rects.size());
+
+    // Markers of the same type that touch or intersect the new marker are merged into it.
+    size_t first = firstMarkerEndingAtOrAfter(markers, newMarker.startOffset);
+    size_t last = first;
+    while (last < markers.size() && markers[last].startOffset <= newMarker.endOffset) {
+        newMarker.startOffset = min(newMarker.startOffset, markers[last].startOffset);
+        newMarker.endOffset = max(newMarker.endOffset, markers[last].endOffset);
+        ++last;
+    }
+    if (last > first) {
+        markers.remove(first, last - first);
+        list.rects.remove(first, last - first);
+    }
+
+    markers.insert(first, newMarker);
+    list.rects.insert(first, placeholderRectForMarker());
+}
+
 // copies markers from srcNode to dstNode, applying the specified shift delta to the copies.  The shift is
 // useful if, e.g., the caller has created the dstNode from a non-prefix substring of the srcNode.
 void DocumentMarkerController::copyMarkers(Node* srcNode, unsigned startOffset, int length, Node* dstNode, int delta, DocumentMarker::MarkerType markerType)
@@ -148,40 +233,38 @@ void DocumentMarkerController::copyMarkers(Node* srcNode, unsigned startOffset,
     if (length <= 0)
         return;
 
-    MarkerMapVectorPair* vectorPair = m_markers.get(srcNode);
-    if (!vectorPair)
+    NodeMarkers* nodeMarkers = m_markers.get(srcNode);
+    if (!nodeMarkers)
         return;
 
-    ASSERT(vectorPair->first.size() == vectorPair->second.size());
-
-    bool docDirty = false;
     unsigned endOffset = startOffset + length - 1;
-    Vector<DocumentMarker>& markers = vectorPair->first;
-    for (size_t i = 0; i != markers.size(); ++i) {
-        DocumentMarker marker = markers[i];
-
-        // stop if we are now past the specified range
-        if (marker.startOffset > endOffset)
-            break;
-
-        // skip marker that is before the specified range or is the wrong type
-        if (marker.endOffset < startOffset || (marker.type != markerType && markerType != DocumentMarker::AllMarkers))
+    Vector<DocumentMarker> copies;
+    for (unsigned type = 0; type < markerTypeCount; ++type) {
+        if (!markerTypeMatches(type, markerType))
             continue;
 
-        // pin the marker to the specified range and apply the shift delta
-        docDirty = true;
-        if (marker.startOffset < startOffset)
-            marker.startOffset = startOffset;
-        if (marker.endOffset > endOffset)
-            marker.endOffset = endOffset;
-        marker.startOffset += delta;
-        marker.endOffset += delta;
-
-        addMarker(dstNode, marker);
+        const Vector<DocumentMarker>& markers = nodeMarkers->lists[type].markers;
+        for (size_t i = firstMarkerEndingAtOrAfter(markers, startOffset); i < markers.size() && markers[i].startOffset <= endOffset; ++i) {
+            // pin the marker to the specified range and apply the shift delta
+            DocumentMarker marker = markers[i];
+            if (marker.startOffset < startOffset)
+                marker.startOffset = startOffset;
+            if (marker.endOffset > endOffset)
+                marker.endOffset = endOffset;
+            marker.startOffset += delta;
+            marker.endOffset += delta;
+            if (marker.endOffset != marker.startOffset)
+                copies.append(marker);
+        }
     }
 
+    // Copy only after the search, since srcNode's lists may be dstNode's too.
+    size_t copyCount = copies.size();
+    for (size_t i = 0; i < copyCount; ++i)
+        insertMarker(dstNode, copies[i]);
+
     // repaint the affected node
-    if (docDirty && dstNode->renderer())
+    if (copyCount && dstNode->renderer())
         dstNode->renderer()->repaint();
 }
 
@@ -190,92 +273,92 @@ void DocumentMarkerController::removeMarkers(Node* node, unsigned startOffset, i
     if (length <= 0)
         return;
 
-    MarkerMapVectorPair* vectorPair = m_markers.get(node);
-    if (!vectorPair)
+    NodeMarkers* nodeMarkers = m_markers.get(node);
+    if (!nodeMarkers)
         return;
 
-    Vector<DocumentMarker>& markers = vectorPair->first;
-    Vector<IntRect>& rects = vectorPair->second;
-    ASSERT(markers.size() == rects.size());
     bool docDirty = false;
     unsigned endOffset = startOffset + length;
-    for (size_t i = 0; i < markers.size();) {
-        DocumentMarker marker = markers[i];
+    for (unsigned type = 0; type < markerTypeCount; ++type) {
+        if (!markerTypeMatches(type, markerType))
+            continue;
 
-        // markers are returned in order, so stop if we are now past the specified range
-        if (marker.startOffset >= endOffset)
-            break;
+        MarkerList& list = nodeMarkers->lists[type];
+        Vector<DocumentMarker>& markers = list.markers;
+        ASSERT(markers.size() == list.rects.size());
 
-        // skip marker that is wrong type or before target
-        if (marker.endOffset < startOffset || (marker.type != markerType && markerType != DocumentMarker::AllMarkers)) {
-            i++;
+        size_t first = firstMarkerEndingAtOrAfter(markers, startOffset);
+        size_t last = first;
+        while (last < markers.size() && markers[last].startOffset < endOffset)
+            ++last;
+        if (last == first)
             continue;
-        }
 
-        // at this point we know that marker and target intersect in some way
+        // at this point we know that the markers in [first, last) and target intersect in some way
         docDirty = true;
 
-        // pitch the old marker and any associated rect
-        markers.remove(i);
-        rects.remove(i);
+        DocumentMarker firstMarker = markers[first];
+        DocumentMarker lastMarker = markers[last - 1];
+        markers.remove(first, last - first);
+        list.rects.remove(first, last - first);
 
         // add either of the resulting slices that are left after removing target
-        if (startOffset > marker.startOffset) {
-            DocumentMarker newLeft = marker;
+        if (startOffset > firstMarker.startOffset) {
+            DocumentMarker newLeft = firstMarker;
             newLeft.endOffset = startOffset;
-            markers.insert(i, newLeft);
-            rects.insert(i, placeholderRectForMarker());
-            // i now points to the newly-inserted node, but we want to skip that one
-            i++;
+            markers.insert(first, newLeft);
+            list.rects.insert(first, placeholderRectForMarker());
+            ++first;
         }
-        if (marker.endOffset > endOffset) {
-            DocumentMarker newRight = marker;
+        if (lastMarker.endOffset > endOffset) {
+            DocumentMarker newRight = lastMarker;
             newRight.startOffset = endOffset;
-            markers.insert(i, newRight);
-            rects.insert(i, placeholderRectForMarker());
-            // i now points to the newly-inserted node, but we want to skip that one
-            i++;
+            markers.insert(first, newRight);
+            list.rects.insert(first, placeholderRectForMarker());
         }
     }
 
-    if (markers.isEmpty()) {
-        ASSERT(rects.isEmpty());
+    // repaint the affected node, before m_markers can drop what may be the last reference to it
+    if (docDirty && node->renderer())
+        node->renderer()->repaint();
+
+    if (nodeMarkers->isEmpty()) {
         m_markers.remove(node);
-        delete vectorPair;
+        delete nodeMarkers;
     }
+}
 
-    // repaint the affected node
-    if (docDirty && node->renderer())
-        node->renderer()->repaint();
+DocumentMarkerController::MarkerList* DocumentMarkerController::renderedMarkerList(const RenderedMarker& renderedMarker, size_t& index)
+{
+    NodeMarkers* nodeMarkers = m_markers.get(renderedMarker.node);
+    if (!nodeMarkers)
+        return 0;
+
+    MarkerList& list = nodeMarkers->lists[renderedMarker.type];
+    index = firstMarkerStartingAtOrAfter(list.markers, renderedMarker.startOffset);
+    if (index == list.markers.size() || list.markers[index].startOffset != renderedMarker.startOffset)
+        return 0;
+    if (list.rects[index] == placeholderRectForMarker())
+        return 0;
+    return &list;
 }
 
 DocumentMarker* DocumentMarkerController::markerContainingPoint(const IntPoint& point, DocumentMarker::MarkerType markerType)
 {
-    // outer loop: process each node that contains any markers
-    MarkerMap::iterator end = m_markers.end();
-    for (MarkerMap::iterator nodeIterator = m_markers.begin(); nodeIterator != end; ++nodeIterator) {
-        // inner loop; process each marker in this node
-        MarkerMapVectorPair* vectorPair = nodeIterator->second;
-        Vector<DocumentMarker>& markers = vectorPair->first;
-        Vector<IntRect>& rects = vectorPair->second;
-        ASSERT(markers.size() == rects.size());
-        unsigned markerCount = markers.size();
-        for (unsigned markerIndex = 0; markerIndex < markerCount; ++markerIndex) {
-            DocumentMarker& marker = markers[markerIndex];
-
-            // skip marker that is wrong type
-            if (marker.type != markerType && markerType != DocumentMarker::AllMarkers)
-                continue;
-
-            IntRect& r = rects[markerIndex];
-
-            // skip placeholder rects
-            if (r == placeholderRectForMarker())
-                continue;
+    RectGrid::iterator cell = m_rectGrid.find(rectGridKey(rectGridCell(point.x()), rectGridCell(point.y())));
+    if (cell == m_rectGrid.end())
+        return 0;
+
+    Vector<RenderedMarker>& renderedMarkers = *cell->second;
+    size_t renderedMarkerCount = renderedMarkers.size();
+    for (size_t i = 0; i < renderedMarkerCount; ++i) {
+        if (!markerTypeMatches(renderedMarkers[i].type, markerType))
+            continue;
 
-            if (r.contains(point))
-                return &marker;
-        }
+        size_t index;
+        MarkerList* list = renderedMarkerList(renderedMarkers[i], index);
+        if (list && list->rects[index].contains(point))
+            return &list->markers[index];
     }
 
     return 0;
@@ -283,10 +366,36 @@ DocumentMarker* DocumentMarkerController::markerContainingPoint(const IntPoint&
 
 Vector<DocumentMarker> DocumentMarkerController::markersForNode(Node* node)
 {
-    MarkerMapVectorPair* vectorPair = m_markers.get(node);
-    if (vectorPair)
-        return vectorPair->first;
-    return Vector<DocumentMarker>();
+    NodeMarkers* nodeMarkers = m_markers.get(node);
+    if (!nodeMarkers)
+        return Vector<DocumentMarker>();
+
+    // Merge the lists of each type back into a single list sorted by start offset.
+    size_t positions[markerTypeCount];
+    size_t markerCount = 0;
+    for (unsigned type = 0; type < markerTypeCount; ++type) {
+        positions[type] = 0;
+        markerCount += nodeMarkers->lists[type].markers.size();
+    }
+
+    Vector<DocumentMarker> result;
+    result.reserveInitialCapacity(markerCount);
+    while (result.size() < markerCount) {
+        const DocumentMarker* next = 0;
+        unsigned nextType = 0;
+        for (unsigned type = 0; type < markerTypeCount; ++type) {
+            const Vector<DocumentMarker>& markers = nodeMarkers->lists[type].markers;
+            if (positions[type] == markers.size())
+                continue;
+            if (!next || markers[positions[type]].startOffset < next->startOffset) {
+                next = &markers[positions[type]];
+                nextType = type;
+            }
+        }
+        result.append(*next);
+        ++positions[nextType];
+    }
+    return result;
 }
 
 Vector<IntRect> DocumentMarkerController::renderedRectsForMarkers(DocumentMarker::MarkerType markerType)
@@ -296,25 +405,19 @@ Vector<IntRect> DocumentMarkerController::renderedRectsForMarkers(DocumentMarker
     // outer loop: process each node
     MarkerMap::iterator end = m_markers.end();
     for (MarkerMap::iterator nodeIterator = m_markers.begin(); nodeIterator != end; ++nodeIterator) {
-        // inner loop; process each marker in this node
-        MarkerMapVectorPair* vectorPair = nodeIterator->second;
-        Vector<DocumentMarker>& markers = vectorPair->first;
-        Vector<IntRect>& rects = vectorPair->second;
-        ASSERT(markers.size() == rects.size());
-        unsigned markerCount = markers.size();
-        for (unsigned markerIndex = 0; markerIndex < markerCount; ++markerIndex) {
-            DocumentMarker marker = markers[markerIndex];
-
-            // skip marker that is wrong type
-            if (marker.type != markerType && markerType != DocumentMarker::AllMarkers)
+        // inner loop; process each marker of the wanted types in this node
+        NodeMarkers* nodeMarkers = nodeIterator->second;
+        for (unsigned type = 0; type < markerTypeCount; ++type) {
+            if (!markerTypeMatches(type, markerType))
                 continue;
 
-            IntRect r = rects[markerIndex];
-            // skip placeholder rects
-            if (r == placeholderRectForMarker())
-                continue;
-
-            result.append(r);
+            const Vector<IntRect>& rects = nodeMarkers->lists[type].rects;
+            unsigned rectCount = rects.size();
+            for (unsigned rectIndex = 0; rectIndex < rectCount; ++rectIndex) {
+                // skip placeholder rects
+                if (rects[rectIndex] != placeholderRectForMarker())
+                    result.append(rects[rectIndex]);
+            }
         }
     }
 
@@ -341,25 +444,15 @@ void DocumentMarkerController::removeMarkers(DocumentMarker::MarkerType markerTy
         Node* node = i->first.get();
         bool nodeNeedsRepaint = false;
 
-        // inner loop: process each marker in the current node
-        MarkerMapVectorPair* vectorPair = i->second;
-        Vector<DocumentMarker>& markers = vectorPair->first;
-        Vector<IntRect>& rects = vectorPair->second;
-        ASSERT(markers.size() == rects.size());
-        for (size_t i = 0; i != markers.size();) {
-            DocumentMarker marker = markers[i];
-
-            // skip nodes that are not of the specified type
-            if (marker.type != markerType && markerType != DocumentMarker::AllMarkers) {
-                ++i;
+        // inner loop: drop the lists of the specified type in the current node
+        NodeMarkers* nodeMarkers = i->second;
+        for (unsigned type = 0; type < markerTypeCount; ++type) {
+            MarkerList& list = nodeMarkers->lists[type];
+            if (!markerTypeMatches(type, markerType) || list.markers.isEmpty())
                 continue;
-            }
-
-            // pitch the old marker
-            markers.remove(i);
-            rects.remove(i);
+            list.markers.clear();
+            list.rects.clear();
             nodeNeedsRepaint = true;
-            // markerIterator now points to the next node
         }
 
         // Redraw the node if it changed. Do this before the node is removed from m_markers, since 
@@ -370,13 +463,15 @@ void DocumentMarkerController::removeMarkers(DocumentMarker::MarkerType markerTy
                 renderer->repaint();
         }
 
-        // delete the node's list if it is now empty
-        if (markers.isEmpty()) {
-            ASSERT(rects.isEmpty());
+        // delete the node's lists if they are now empty
+        if (nodeMarkers->isEmpty()) {
             m_markers.remove(node);
-            delete vectorPair;
+            delete nodeMarkers;
         }
     }
+
+    if (m_markers.isEmpty())
+        clearRectGrid();
 }
 
 void DocumentMarkerController::repaintMarkers(DocumentMarker::MarkerType markerType)
@@ -386,15 +481,11 @@ void DocumentMarkerController::repaintMarkers(DocumentMarker::MarkerType markerT
     for (MarkerMap::iterator i = m_markers.begin(); i != end; ++i) {
         Node* node = i->first.get();
 
-        // inner loop: process each marker in the current node
-        MarkerMapVectorPair* vectorPair = i->second;
-        Vector<DocumentMarker>& markers = vectorPair->first;
+        // inner loop: look for markers of the specified type in the current node
+        NodeMarkers* nodeMarkers = i->second;
         bool nodeNeedsRepaint = false;
-        for (size_t i = 0; i != markers.size(); ++i) {
-            DocumentMarker marker = markers[i];
-
-            // skip nodes that are not of the specified type
-            if (marker.type == markerType || markerType == DocumentMarker::AllMarkers) {
+        for (unsigned type = 0; type < markerTypeCount; ++type) {
+            if (markerTypeMatches(type, markerType) && !nodeMarkers->lists[type].markers.isEmpty()) {
                 nodeNeedsRepaint = true;
                 break;
             }
@@ -411,64 +502,166 @@ void DocumentMarkerController::repaintMarkers(DocumentMarker::MarkerType markerT
 
 void DocumentMarkerController::setRenderedRectForMarker(Node* node, const DocumentMarker& marker, const IntRect& r)
 {
-    MarkerMapVectorPair* vectorPair = m_markers.get(node);
-    if (!vectorPair) {
+    NodeMarkers* nodeMarkers = m_markers.get(node);
+    if (!nodeMarkers) {
         ASSERT_NOT_REACHED(); // shouldn't be trying to set the rect for a marker we don't already know about
         return;
     }
 
-    Vector<DocumentMarker>& markers = vectorPair->first;
-    ASSERT(markers.size() == vectorPair->second.size());
-    unsigned markerCount = markers.size();
-    for (unsigned markerIndex = 0; markerIndex < markerCount; ++markerIndex) {
-        DocumentMarker m = markers[markerIndex];
-        if (m == marker) {
-            vectorPair->second[markerIndex] = r;
-            return;
-        }
+    MarkerList& list = nodeMarkers->lists[marker.type];
+    ASSERT(list.markers.size() == list.rects.size());
+    size_t markerIndex = firstMarkerStartingAtOrAfter(list.markers, marker.startOffset);
+    if (markerIndex == list.markers.size() || list.markers[markerIndex] != marker) {
+        ASSERT_NOT_REACHED(); // shouldn't be trying to set the rect for a marker we don't already know about
+        return;
     }
 
-    ASSERT_NOT_REACHED(); // shouldn't be trying to set the rect for a marker we don't already know about
+    // Markers are painted at the same place over and over; only a new rect needs indexing.
+    if (list.rects[markerIndex] == r)
+        return;
+    list.rects[markerIndex] = r;
+
+    RenderedMarker renderedMarker = {node, marker.type, marker.startOffset};
+    if (m_rectGridEntryCount >= m_rectGridRebuildThreshold)
+        rebuildRectGrid();
+    else
+        addToRectGrid(renderedMarker, r);
 }
 
-void DocumentMarkerController::invalidateRenderedRectsForMarkersInRect(const IntRect& r)
+void DocumentMarkerController::addToRectGrid(const RenderedMarker& renderedMarker, const IntRect& r)
 {
-    // outer loop: process each markered node in the document
+    if (r.isEmpty())
+        return;
+
+    int lastColumn = rectGridCell(r.right() - 1);
+    int lastRow = rectGridCell(r.bottom() - 1);
+    for (int column = rectGridCell(r.x()); column <= lastColumn; ++column) {
+        for (int row = rectGridCell(r.y()); row <= lastRow; ++row) {
+            pair<RectGrid::iterator, bool> result = m_rectGrid.add(rectGridKey(column, row), 0);
+            if (result.second)
+                result.first->second = new Vector<RenderedMarker>;
+            result.first->second->append(renderedMarker);
+            ++m_rectGridEntryCount;
+        }
+    }
+}
+
+void DocumentMarkerController::rebuildRectGrid()
+{
+    clearRectGrid();
+
     MarkerMap::iterator end = m_markers.end();
     for (MarkerMap::iterator i = m_markers.begin(); i != end; ++i) {
+        for (unsigned type = 0; type < markerTypeCount; ++type) {
+            const MarkerList& list = i->second->lists[type];
+            size_t markerCount = list.markers.size();
+            for (size_t markerIndex = 0; markerIndex < markerCount; ++markerIndex) {
+                if (list.rects[markerIndex] == placeholderRectForMarker())
+                    continue;
+                RenderedMarker renderedMarker = {i->first.get(), list.markers[markerIndex].type, list.markers[markerIndex].startOffset};
+                addToRectGrid(renderedMarker, list.rects[markerIndex]);
+            }
+        }
+    }
 
-        // inner loop: process each rect in the current node
-        MarkerMapVectorPair* vectorPair = i->second;
-        Vector<IntRect>& rects = vectorPair->second;
+    m_rectGridRebuildThreshold = max(minimumRectGridRebuildThreshold, 2 * m_rectGridEntryCount);
+}
 
-        unsigned rectCount = rects.size();
-        for (unsigned rectIndex = 0; rectIndex < rectCount; ++rectIndex)
-            if (rects[rectIndex].intersects(r))
-                rects[rectIndex] = placeholderRectForMarker();
+void DocumentMarkerController::clearRectGrid()
+{
+    deleteAllValues(m_rectGrid);
+    m_rectGrid.clear();
+    m_rectGridEntryCount = 0;
+}
+
+void DocumentMarkerController::invalidateRenderedRectsInCell(Vector<RenderedMarker>& renderedMarkers, const IntRect& cell, const IntRect& r)
+{
+    for (size_t i = 0; i < renderedMarkers.size();) {
+        size_t index;
+        MarkerList* list = renderedMarkerList(renderedMarkers[i], index);
+        if (list && list->rects[index].intersects(r))
+            list->rects[index] = placeholderRectForMarker();
+        else if (list && list->rects[index].intersects(cell)) {
+            ++i;
+            continue;
+        }
+
+        // The entry is stale or its marker no longer has a rect; drop it.
+        renderedMarkers[i] = renderedMarkers.last();
+        renderedMarkers.removeLast();
+        --m_rectGridEntryCount;
     }
 }
 
-void DocumentMarkerController::shiftMarkers(Node* node, unsigned startOffset, int delta, DocumentMarker::MarkerType markerType)
+void DocumentMarkerController::invalidateRenderedRectsForMarkersInRect(const IntRect& r)
 {
-    MarkerMapVectorPair* vectorPair = m_markers.get(node);
-    if (!vectorPair)
+    if (m_rectGrid.isEmpty() || r.isEmpty())
         return;
 
-    Vector<DocumentMarker>& markers = vectorPair->first;
-    Vector<IntRect>& rects = vectorPair->second;
-    ASSERT(markers.size() == rects.size());
+    int firstColumn = rectGridCell(r.x());
+    int lastColumn = rectGridCell(r.right() - 1);
+    int firstRow = rectGridCell(r.y());
+    int lastRow = rectGridCell(r.bottom() - 1);
+
+    Vector<unsigned long long> emptyCells;
+    unsigned long long cellCount = static_cast<unsigned long long>(lastColumn - firstColumn + 1) * (lastRow - firstRow + 1);
+    if (cellCount > m_rectGrid.size()) {
+        // The rect covers more cells than are in use; visit the ones in use instead.
+        RectGrid::iterator end = m_rectGrid.end();
+        for (RectGrid::iterator cell = m_rectGrid.begin(); cell != end; ++cell) {
+            int column = static_cast<int>(static_cast<unsigned>(cell->first >> 32) - 0x40000000u);
+            int row = static_cast<int>(static_cast<unsigned>(cell->first) - 0x40000000u);
+            if (column < firstColumn || column > lastColumn || row < firstRow || row > lastRow)
+                continue;
+            invalidateRenderedRectsInCell(*cell->second, rectGridCellRect(column, row), r);
+            if (cell->second->isEmpty())
+                emptyCells.append(cell->first);
+        }
+    } else {
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            for (int row = firstRow; row <= lastRow; ++row) {
+                RectGrid::iterator cell = m_rectGrid.find(rectGridKey(column, row));
+                if (cell == m_rectGrid.end())
+                    continue;
+                invalidateRenderedRectsInCell(*cell->second, rectGridCellRect(column, row), r);
+                if (cell->second->isEmpty())
+                    emptyCells.append(cell->first);
+            }
+        }
+    }
+
+    size_t emptyCellCount = emptyCells.size();
+    for (size_t i = 0; i < emptyCellCount; ++i)
+        delete m_rectGrid.take(emptyCells[i]);
+}
+
+void DocumentMarkerController::shiftMarkers(Node* node, unsigned startOffset, int delta, DocumentMarker::MarkerType markerType)
+{
+    NodeMarkers* nodeMarkers = m_markers.get(node);
+    if (!nodeMarkers)
+        return;
 
     bool docDirty = false;
-    for (size_t i = 0; i != markers.size(); ++i) {
-        DocumentMarker& marker = markers[i];
-        if (marker.startOffset >= startOffset && (markerType == DocumentMarker::AllMarkers || marker.type == markerType)) {
+    for (unsigned type = 0; type < markerTypeCount; ++type) {
+        if (!markerTypeMatches(type, markerType))
+            continue;
+
+        MarkerList& list = nodeMarkers->lists[type];
+        Vector<DocumentMarker>& markers = list.markers;
+        ASSERT(markers.size() == list.rects.size());
+
+        size_t first = firstMarkerStartingAtOrAfter(markers, startOffset);
+        // Shifting must keep the list sorted; callers remove the markers a negative shift would run into.
+        ASSERT(!first || first == markers.size() || static_cast<int>(markers[first].startOffset) + delta >= static_cast<int>(markers[first - 1].endOffset));
+        for (size_t i = first; i < markers.size(); ++i) {
+            DocumentMarker& marker = markers[i];
             ASSERT((int)marker.startOffset + delta >= 0);
             marker.startOffset += delta;
             marker.endOffset += delta;
             docDirty = true;
 
             // Marker moved, so previously-computed rendered rectangle is now invalid
-            rects[i] = placeholderRectForMarker();
+            list.rects[i] = placeholderRectForMarker();
         }
     }
 
@@ -496,25 +689,20 @@ void DocumentMarkerController::setMarkersActive(Range* range, bool active)
 
 void DocumentMarkerController::setMarkersActive(Node* node, unsigned startOffset, unsigned endOffset, bool active)
 {
-    MarkerMapVectorPair* vectorPair = m_markers.get(node);
-    if (!vectorPair)
+    NodeMarkers* nodeMarkers = m_markers.get(node);
+    if (!nodeMarkers)
         return;
 
-    Vector<DocumentMarker>& markers = vectorPair->first;
-    ASSERT(markers.size() == vectorPair->second.size());
+    Vector<DocumentMarker>& markers = nodeMarkers->lists[DocumentMarker::TextMatch].markers;
 
     bool docDirty = false;
-    for (size_t i = 0; i != markers.size(); ++i) {
+    for (size_t i = firstMarkerEndingAtOrAfter(markers, startOffset); i < markers.size(); ++i) {
         DocumentMarker& marker = markers[i];
 
         // Markers are returned in order, so stop if we are now past the specified range.
         if (marker.startOffset >= endOffset)
             break;
 
-        // Skip marker that is wrong type or before target.
-        if (marker.endOffset < startOffset || marker.type != DocumentMarker::TextMatch)
-            continue;
-
         marker.activeMatch = active;
         docDirty = true;
     }
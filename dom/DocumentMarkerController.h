@@ -28,23 +28,25 @@
 #define DocumentMarkerController_h
 
 #include "DocumentMarker.h"
+#include "IntRect.h"
 #include <wtf/HashMap.h>
 #include <wtf/Vector.h>
 
 namespace WebCore {
 
 class IntPoint;
-class IntRect;
 class Node;
 class Range;
 
 class DocumentMarkerController : public Noncopyable {
 public:
+    DocumentMarkerController();
     ~DocumentMarkerController() { detach(); }
 
     void detach();
     void addMarker(Range*, DocumentMarker::MarkerType, String description = String());
     void addMarker(Node*, DocumentMarker);
+    void addMarkers(const Vector<RefPtr<Range> >&, DocumentMarker::MarkerType);
     void copyMarkers(Node* srcNode, unsigned startOffset, int length, Node* dstNode, int delta, DocumentMarker::MarkerType = DocumentMarker::AllMarkers);
     void removeMarkers(Range*, DocumentMarker::MarkerType = DocumentMarker::AllMarkers);
     void removeMarkers(Node*, unsigned startOffset, int length, DocumentMarker::MarkerType = DocumentMarker::AllMarkers);
@@ -62,9 +64,45 @@ public:
     Vector<IntRect> renderedRectsForMarkers(DocumentMarker::MarkerType = DocumentMarker::AllMarkers);
 
 private:
-    typedef std::pair<Vector<DocumentMarker>, Vector<IntRect> > MarkerMapVectorPair;
-    typedef HashMap<RefPtr<Node>, MarkerMapVectorPair*> MarkerMap;
+    static const unsigned markerTypeCount = DocumentMarker::Replacement + 1;
+
+    // The markers of one type on a node, sorted by start offset, with the rects they were last
+    // painted at. Markers of the same type never overlap, so the list is sorted by end offset
+    // too, and the markers touching any range of offsets can be found by binary search.
+    struct MarkerList {
+        Vector<DocumentMarker> markers;
+        Vector<IntRect> rects;
+    };
+
+    struct NodeMarkers : Noncopyable {
+        MarkerList lists[markerTypeCount];
+
+        bool isEmpty() const;
+    };
+    typedef HashMap<RefPtr<Node>, NodeMarkers*> MarkerMap;
+
+    // Rendered rects are also indexed by the grid cells they touch, so that repaints and hit
+    // tests only look at the markers near them. Grid entries are hints: they are checked
+    // against the marker's current rect when used, and dropped when they turn out stale.
+    struct RenderedMarker {
+        Node* node;
+        DocumentMarker::MarkerType type;
+        unsigned startOffset;
+    };
+    typedef HashMap<unsigned long long, Vector<RenderedMarker>*> RectGrid;
+
+    void insertMarker(Node*, DocumentMarker);
+
+    MarkerList* renderedMarkerList(const RenderedMarker&, size_t& index);
+    void addToRectGrid(const RenderedMarker&, const IntRect&);
+    void invalidateRenderedRectsInCell(Vector<RenderedMarker>&, const IntRect& cell, const IntRect&);
+    void rebuildRectGrid();
+    void clearRectGrid();
+
     MarkerMap m_markers;
+    RectGrid m_rectGrid;
+    unsigned m_rectGridEntryCount;
+    unsigned m_rectGridRebuildThreshold;
 };
 
 } // namespace WebCore
@@ -34,7 +34,7 @@ class DocumentType : public Node {
 public:
     static PassRefPtr<DocumentType> create(Document* document, const String& name, const String& publicId, const String& systemId)
     {
-        return adoptRef(new DocumentType(document, name, publicId, systemId));
+        return adoptRef(new (document) DocumentType(document, name, publicId, systemId));
     }
 
     NamedNodeMap* entities() const { return m_entities.get(); }
@@ -25,13 +25,17 @@
 
 #include "Document.h"
 #include "Element.h"
+#include "HTMLNames.h"
 
 namespace WebCore {
 
-DynamicNodeList::DynamicNodeList(PassRefPtr<Node> rootNode)
+using namespace HTMLNames;
+
+DynamicNodeList::DynamicNodeList(PassRefPtr<Node> rootNode, NodeListInvalidationType invalidationType)
     : m_rootNode(rootNode)
     , m_caches(Caches::create())
     , m_ownsCaches(true)
+    , m_invalidationType(invalidationType)
 {
     m_rootNode->registerDynamicNodeList(this);
 }    
@@ -40,6 +44,7 @@ DynamicNodeList::DynamicNodeList(PassRefPtr<Node> rootNode, DynamicNodeList::Cac
     : m_rootNode(rootNode)
     , m_caches(caches)
     , m_ownsCaches(false)
+    , m_invalidationType(DoNotInvalidateOnAttributeChange)
 {
     m_rootNode->registerDynamicNodeList(this);
 }    
@@ -49,6 +54,28 @@ DynamicNodeList::~DynamicNodeList()
     m_rootNode->unregisterDynamicNodeList(this);
 }
 
+bool DynamicNodeList::invalidationTypeDependsOnAttribute(NodeListInvalidationType type, const QualifiedName& attrName, Document* document)
+{
+    switch (type) {
+    case DoNotInvalidateOnAttributeChange:
+        return false;
+    case InvalidateOnClassAttrChange:
+        return attrName == classAttr;
+    case InvalidateOnNameAttrChange:
+        return attrName == nameAttr;
+    case InvalidateOnForAttrChange:
+        // A label finds its control through the for attribute and getElementById().
+        return attrName == forAttr || (document && attrName == document->idAttributeName());
+    }
+    ASSERT_NOT_REACHED();
+    return true;
+}
+
+const Vector<Element*>* DynamicNodeList::indexedCandidates(bool&) const
+{
+    return 0;
+}
+
 unsigned DynamicNodeList::length() const
 {
     if (m_caches->isLengthCacheValid)
@@ -56,8 +83,18 @@ unsigned DynamicNodeList::length() const
 
     unsigned length = 0;
 
-    for (Node* n = m_rootNode->firstChild(); n; n = n->traverseNextNode(m_rootNode.get()))
-        length += n->isElementNode() && nodeMatches(static_cast<Element*>(n));
+    bool allMatch = false;
+    const Vector<Element*>* candidates = m_rootNode->isDocumentNode() ? indexedCandidates(allMatch) : 0;
+    if (candidates && allMatch)
+        length = candidates->size();
+    else if (candidates) {
+        size_t size = candidates->size();
+        for (size_t i = 0; i < size; ++i)
+            length += nodeMatches(candidates->at(i));
+    } else {
+        for (Node* n = m_rootNode->firstChild(); n; n = n->traverseNextNode(m_rootNode.get()))
+            length += n->isElementNode() && nodeMatches(static_cast<Element*>(n));
+    }
 
     m_caches->cachedLength = length;
     m_caches->isLengthCacheValid = true;
@@ -74,6 +111,7 @@ Node* DynamicNodeList::itemForwardsFromCurrent(Node* start, unsigned offset, int
                 m_caches->lastItem = n;
                 m_caches->lastItemOffset = offset;
                 m_caches->isItemCacheValid = true;
+                m_caches->isCandidateIndexValid = false;
                 return n;
             }
             --remainingOffset;
@@ -92,6 +130,7 @@ Node* DynamicNodeList::itemBackwardsFromCurrent(Node* start, unsigned offset, in
                 m_caches->lastItem = n;
                 m_caches->lastItemOffset = offset;
                 m_caches->isItemCacheValid = true;
+                m_caches->isCandidateIndexValid = false;
                 return n;
             }
             ++remainingOffset;
@@ -101,8 +140,60 @@ Node* DynamicNodeList::itemBackwardsFromCurrent(Node* start, unsigned offset, in
     return 0; // no matching node in this subtree
 }
 
+Node* DynamicNodeList::indexedItem(const Vector<Element*>& candidates, bool allMatch, unsigned offset) const
+{
+    if (allMatch)
+        return offset < candidates.size() ? candidates[offset] : 0;
+
+    // Like the tree walk in item(), carry on from the last item found, so that reading the list
+    // in order stays linear. The candidates only change with the DOM, which resets the caches.
+    size_t size = candidates.size();
+    size_t start = 0;
+    unsigned remainingOffset = offset;
+    if (m_caches->isItemCacheValid && m_caches->isCandidateIndexValid) {
+        unsigned lastOffset = m_caches->lastItemOffset;
+        size_t lastIndex = m_caches->lastCandidateIndex;
+        ASSERT(lastIndex < size && candidates[lastIndex] == m_caches->lastItem);
+        if (offset == lastOffset)
+            return m_caches->lastItem;
+        if (offset > lastOffset) {
+            start = lastIndex + 1;
+            remainingOffset = offset - lastOffset - 1;
+        } else if (lastOffset - offset < offset) {
+            remainingOffset = lastOffset - offset - 1;
+            for (size_t i = lastIndex; i-- > 0; ) {
+                if (nodeMatches(candidates[i]) && !remainingOffset--)
+                    return cacheIndexedItem(candidates[i], offset, i);
+            }
+            return 0;
+        }
+    }
+
+    for (size_t i = start; i < size; ++i) {
+        if (nodeMatches(candidates[i]) && !remainingOffset--)
+            return cacheIndexedItem(candidates[i], offset, i);
+    }
+    return 0;
+}
+
+Node* DynamicNodeList::cacheIndexedItem(Element* item, unsigned offset, size_t candidateIndex) const
+{
+    m_caches->lastItem = item;
+    m_caches->lastItemOffset = offset;
+    m_caches->lastCandidateIndex = candidateIndex;
+    m_caches->isItemCacheValid = true;
+    m_caches->isCandidateIndexValid = true;
+    return item;
+}
+
 Node* DynamicNodeList::item(unsigned offset) const
 {
+    if (m_rootNode->isDocumentNode()) {
+        bool allMatch = false;
+        if (const Vector<Element*>* candidates = indexedCandidates(allMatch))
+            return indexedItem(*candidates, allMatch, offset);
+    }
+
     int remainingOffset = offset;
     Node* start = m_rootNode->firstChild();
     if (m_caches->isItemCacheValid) {
@@ -156,6 +247,7 @@ DynamicNodeList::Caches::Caches()
     : lastItem(0)
     , isLengthCacheValid(false)
     , isItemCacheValid(false)
+    , isCandidateIndexValid(false)
 {
 }
 
@@ -169,6 +261,7 @@ void DynamicNodeList::Caches::reset()
     lastItem = 0;
     isLengthCacheValid = false;
     isItemCacheValid = false;     
+    isCandidateIndexValid = false;
 }
 
 } // namespace WebCore
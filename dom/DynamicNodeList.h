@@ -28,11 +28,24 @@
 #include <wtf/RefCounted.h>
 #include <wtf/Forward.h>
 #include <wtf/RefPtr.h>
+#include <wtf/Vector.h>
 
 namespace WebCore {
 
+    class Document;
     class Element;
     class Node;
+    class QualifiedName;
+
+    // Which attribute changes can alter the contents of a list. Documents keep a count of live
+    // lists per type so attribute changes that no list depends on skip the ancestor walk.
+    enum NodeListInvalidationType {
+        DoNotInvalidateOnAttributeChange = 0,
+        InvalidateOnClassAttrChange,
+        InvalidateOnNameAttrChange,
+        InvalidateOnForAttrChange,
+    };
+    const int numNodeListInvalidationTypes = InvalidateOnForAttrChange + 1;
 
     class DynamicNodeList : public NodeList {
     public:
@@ -43,8 +56,11 @@ namespace WebCore {
             unsigned cachedLength;
             Node* lastItem;
             unsigned lastItemOffset;
+            // Where lastItem is in the document index's candidates, when it was found there.
+            size_t lastCandidateIndex;
             bool isLengthCacheValid : 1;
             bool isItemCacheValid : 1;
+            bool isCandidateIndexValid : 1;
         protected:
             Caches();
         };
@@ -52,6 +68,9 @@ namespace WebCore {
         virtual ~DynamicNodeList();
 
         bool hasOwnCaches() const { return m_ownsCaches; }
+        NodeListInvalidationType invalidationType() const { return static_cast<NodeListInvalidationType>(m_invalidationType); }
+
+        static bool invalidationTypeDependsOnAttribute(NodeListInvalidationType, const QualifiedName&, Document*);
 
         // DOM methods & attributes for NodeList
         virtual unsigned length() const;
@@ -62,18 +81,26 @@ namespace WebCore {
         void invalidateCache();
 
     protected:
-        DynamicNodeList(PassRefPtr<Node> rootNode);
+        DynamicNodeList(PassRefPtr<Node> rootNode, NodeListInvalidationType);
         DynamicNodeList(PassRefPtr<Node> rootNode, Caches*);
 
         virtual bool nodeMatches(Element*) const = 0;
 
+        // Lists rooted at a document can answer from the document's element index instead of
+        // walking the tree. Returns the candidates in document order, or 0 if the index can't
+        // help; allMatch is set when every candidate passes nodeMatches().
+        virtual const Vector<Element*>* indexedCandidates(bool& allMatch) const;
+
         RefPtr<Node> m_rootNode;
         mutable RefPtr<Caches> m_caches;
-        bool m_ownsCaches;
+        bool m_ownsCaches : 1;
+        unsigned m_invalidationType : 2;
 
     private:
         Node* itemForwardsFromCurrent(Node* start, unsigned offset, int remainingOffset) const;
         Node* itemBackwardsFromCurrent(Node* start, unsigned offset, int remainingOffset) const;
+        Node* indexedItem(const Vector<Element*>&, bool allMatch, unsigned offset) const;
+        Node* cacheIndexedItem(Element*, unsigned offset, size_t candidateIndex) const;
     };
 
 } // namespace WebCore
@@ -34,7 +34,7 @@ inline EditingText::EditingText(Document* document, const String& data)
 
 PassRefPtr<EditingText> EditingText::create(Document* document, const String& data)
 {
-    return adoptRef(new EditingText(document, data));
+    return adoptRef(new (document) EditingText(document, data));
 }
 
 bool EditingText::rendererIsNeeded(RenderStyle*)
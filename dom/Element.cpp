@@ -35,6 +35,7 @@
 #include "ClientRectList.h"
 #include "DatasetDOMStringMap.h"
 #include "Document.h"
+#include "DocumentElementIndex.h"
 #include "DocumentFragment.h"
 #include "ElementRareData.h"
 #include "ExceptionCode.h"
@@ -68,7 +69,7 @@ using namespace XMLNames;
     
 PassRefPtr<Element> Element::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new Element(tagName, document, CreateElement));
+    return adoptRef(new (document) Element(tagName, document, CreateElement));
 }
 
 Element::~Element()
@@ -90,7 +91,7 @@ inline ElementRareData* Element::ensureRareData()
     
 NodeRareData* Element::createRareData()
 {
-    return new ElementRareData;
+    return new (document()->domArena()) ElementRareData;
 }
 
 PassRefPtr<DocumentFragment> Element::deprecatedCreateContextualFragment(const String& markup, FragmentScriptingPermission scriptingPermission)
@@ -548,7 +549,8 @@ void Element::setAttribute(const AtomicString& name, const AtomicString& value,
     const AtomicString& localName = shouldIgnoreAttributeCase(this) ? name.lower() : name;
 
     // Allocate attribute map if necessary.
-    Attribute* old = attributes(false)->getAttributeItem(localName, false);
+    attributes(false)->detachSharedAttributes();
+    Attribute* old = m_attributeMap->getAttributeItem(localName, false);
 
     document()->incDOMTreeVersion();
 
@@ -600,7 +602,8 @@ void Element::setAttribute(const QualifiedName& name, const AtomicString& value,
     document()->incDOMTreeVersion();
 
     // Allocate attribute map if necessary.
-    Attribute* old = attributes(false)->getAttributeItem(name);
+    attributes(false)->detachSharedAttributes();
+    Attribute* old = m_attributeMap->getAttributeItem(name);
 
     if (isIdAttributeName(name))
         updateId(old ? old->value() : nullAtom, value);
@@ -626,7 +629,7 @@ void Element::setAttribute(const QualifiedName& name, const AtomicString& value,
 
 PassRefPtr<Attribute> Element::createAttribute(const QualifiedName& name, const AtomicString& value)
 {
-    return Attribute::create(name, value);
+    return Attribute::create(name, value, document()->domArena());
 }
 
 void Element::attributeChanged(Attribute* attr, bool)
@@ -637,6 +640,8 @@ void Element::attributeChanged(Attribute* attr, bool)
 
 void Element::updateAfterAttributeChanged(Attribute* attr)
 {
+    notifyNodeListsAttributeChanged(attr->name());
+
     if (!AXObjectCache::accessibilityEnabled())
         return;
 
@@ -693,6 +698,11 @@ void Element::setAttributeMap(PassRefPtr<NamedNodeMap> list, FragmentScriptingPe
     if (oldId || newId)
         updateId(oldId ? oldId->value() : nullAtom, newId ? newId->value() : nullAtom);
 
+    // The index files the element under the classes of its current map; take it out while the map is replaced.
+    DocumentElementIndex* index = inDocument() ? document()->existingElementIndex() : 0;
+    if (index)
+        index->removeElement(this);
+
     if (m_attributeMap)
         m_attributeMap->m_element = 0;
 
@@ -733,6 +743,9 @@ void Element::setAttributeMap(PassRefPtr<NamedNodeMap> list, FragmentScriptingPe
 		}
         // FIXME: What about attributes that were in the old map that are not in the new map?
     }
+
+    if (index)
+        index->addElement(this);
 }
 
 bool Element::hasAttributes() const
@@ -816,6 +829,10 @@ RenderObject* Element::createRenderer(RenderArena* arena, RenderStyle* style)
 
 void Element::insertedIntoDocument()
 {
+    // Index this element before its descendants so the index sees them in document order.
+    if (DocumentElementIndex* index = document()->existingElementIndex())
+        index->addElement(this);
+
     // need to do superclass processing first so inDocument() is true
     // by the time we reach updateId
     ContainerNode::insertedIntoDocument();
@@ -831,6 +848,9 @@ void Element::insertedIntoDocument()
 
 void Element::removedFromDocument()
 {
+    if (DocumentElementIndex* index = document()->existingElementIndex())
+        index->removeElement(this);
+
     if (hasID()) {
         if (m_attributeMap) {
             Attribute* idItem = m_attributeMap->getAttributeItem(document()->idAttributeName());
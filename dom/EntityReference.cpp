@@ -33,7 +33,7 @@ inline EntityReference::EntityReference(Document* document, const String& entity
 
 PassRefPtr<EntityReference> EntityReference::create(Document* document, const String& entityName)
 {
-    return adoptRef(new EntityReference(document, entityName));
+    return adoptRef(new (document) EntityReference(document, entityName));
 }
 
 String EntityReference::nodeName() const
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2026 The WebKit Authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef MutationEventBatch_h
+#define MutationEventBatch_h
+
+#include "Document.h"
+#include <wtf/Noncopyable.h>
+#include <wtf/RefPtr.h>
+
+namespace WebCore {
+
+// Holds back the DOMSubtreeModified events for the mutations made while it is in scope, and
+// dispatches one per changed tree, at the lowest common parent of the changes, when the
+// outermost batch for the document ends. DOM Level 2 Events allows the event to be fired
+// after multiple changes this way. Other mutation events are still dispatched right away,
+// since they describe a single change.
+class MutationEventBatch : public Noncopyable {
+public:
+    explicit MutationEventBatch(Document* document)
+        : m_document(document)
+    {
+        m_document->beginMutationEventBatch();
+    }
+
+    ~MutationEventBatch()
+    {
+        m_document->endMutationEventBatch();
+    }
+
+private:
+    RefPtr<Document> m_document;
+};
+
+} // namespace WebCore
+
+#endif // MutationEventBatch_h
@@ -32,7 +32,7 @@ namespace WebCore {
 using namespace HTMLNames;
 
 NameNodeList::NameNodeList(PassRefPtr<Node> rootNode, const String& name)
-    : DynamicNodeList(rootNode)
+    : DynamicNodeList(rootNode, InvalidateOnNameAttrChange)
     , m_nodeName(name)
 {
 }
@@ -58,6 +58,7 @@ NamedNodeMap::~NamedNodeMap()
 
 PassRefPtr<Node> NamedNodeMap::getNamedItem(const String& name) const
 {
+    const_cast<NamedNodeMap*>(this)->detachSharedAttributes();
     Attribute* a = getAttributeItem(name, shouldIgnoreAttributeCase(m_element));
     if (!a)
         return 0;
@@ -72,6 +73,7 @@ PassRefPtr<Node> NamedNodeMap::getNamedItemNS(const String& namespaceURI, const
 
 PassRefPtr<Node> NamedNodeMap::removeNamedItem(const String& name, ExceptionCode& ec)
 {
+    detachSharedAttributes();
     Attribute* a = getAttributeItem(name, shouldIgnoreAttributeCase(m_element));
     if (!a) {
         ec = NOT_FOUND_ERR;
@@ -88,6 +90,7 @@ PassRefPtr<Node> NamedNodeMap::removeNamedItemNS(const String& namespaceURI, con
 
 PassRefPtr<Node> NamedNodeMap::getNamedItem(const QualifiedName& name) const
 {
+    const_cast<NamedNodeMap*>(this)->detachSharedAttributes();
     Attribute* a = getAttributeItem(name);
     if (!a)
         return 0;
@@ -113,6 +116,7 @@ PassRefPtr<Node> NamedNodeMap::setNamedItem(Node* arg, ExceptionCode& ec)
         ec = HIERARCHY_REQUEST_ERR;
         return 0;
     }
+    detachSharedAttributes();
 	V8IsolatedContext* isolatedContext = V8IsolatedContext::getEntered();
 	int worldID = 0;
 	if (isolatedContext!=0) worldID = isolatedContext->getWorldID();
@@ -154,6 +158,7 @@ PassRefPtr<Node> NamedNodeMap::setNamedItemNS(Node* node, ExceptionCode& ec)
 // because of removeNamedItem, removeNamedItemNS, and removeAttributeNode.
 PassRefPtr<Node> NamedNodeMap::removeNamedItem(const QualifiedName& name, ExceptionCode& ec)
 {
+    detachSharedAttributes();
     Attribute* a = getAttributeItem(name);
     if (!a) {
         ec = NOT_FOUND_ERR;
@@ -174,6 +179,7 @@ PassRefPtr<Node> NamedNodeMap::item(unsigned index) const
     if (index >= length())
         return 0;
 
+    const_cast<NamedNodeMap*>(this)->detachSharedAttributes();
     return m_attributes[index]->createAttrIfNeeded(m_element);
 }
 
@@ -210,6 +216,24 @@ void NamedNodeMap::clearAttributes()
 
     detachAttributesFromElement();
     m_attributes.clear();
+    m_attributesAreShared = false;
+}
+
+void NamedNodeMap::copySharedAttributes()
+{
+    ASSERT(m_attributesAreShared);
+    m_attributesAreShared = false;
+
+    // Unlike Attribute::clone(), the copy has to carry everything over; the element keeps using it as is.
+    size_t size = m_attributes.size();
+    for (size_t i = 0; i < size; i++) {
+        Attribute* shared = m_attributes[i].get();
+        ASSERT(!shared->attr());
+        RefPtr<Attribute> copy = shared->clone();
+        copy->m_readOnly = shared->m_readOnly;
+        copy->m_worldID = shared->m_worldID;
+        m_attributes[i] = copy.release();
+    }
 }
 
 void NamedNodeMap::detachFromElement()
@@ -253,6 +277,7 @@ void NamedNodeMap::setAttributes(const NamedNodeMap& other)
 void NamedNodeMap::addAttribute(PassRefPtr<Attribute> prpAttribute)
 {
     RefPtr<Attribute> attribute = prpAttribute;
+    detachSharedAttributes();
     
     // Add the attribute to the list
     m_attributes.append(attribute);
@@ -274,6 +299,7 @@ void NamedNodeMap::addAttribute(PassRefPtr<Attribute> prpAttribute)
 
 void NamedNodeMap::removeAttribute(const QualifiedName& name)
 {
+    detachSharedAttributes();
     unsigned len = length();
     unsigned index = len;
     for (unsigned i = 0; i < len; ++i) {
@@ -36,6 +36,7 @@ typedef int ExceptionCode;
 
 class NamedNodeMap : public RefCounted<NamedNodeMap> {
     friend class Element;
+    friend class SharedAttributeCache;
 public:
     static PassRefPtr<NamedNodeMap> create(Element* element = 0)
     {
@@ -102,10 +103,20 @@ public:
     void declRemoved() { m_mappedAttributeCount--; }
     void declAdded() { m_mappedAttributeCount++; }
 
+    // Attributes of parser-created elements may be shared with other elements (see
+    // SharedAttributeCache). They must be copied before they are changed or an Attr is made for them.
+    bool attributesAreShared() const { return m_attributesAreShared; }
+    void detachSharedAttributes()
+    {
+        if (m_attributesAreShared)
+            copySharedAttributes();
+    }
+
 private:
     NamedNodeMap(Element* element) 
         : m_mappedAttributeCount(0)
         , m_element(element)
+        , m_attributesAreShared(false)
     {
     }
 
@@ -114,11 +125,13 @@ private:
     Attribute* getAttributeItem(const String& name, bool shouldIgnoreAttributeCase) const;
     Attribute* getAttributeItemSlowCase(const String& name, bool shouldIgnoreAttributeCase) const;
     void clearAttributes();
+    void copySharedAttributes();
     int declCount() const;
 
     int m_mappedAttributeCount;
     SpaceSplitString m_classNames;
     Element* m_element;
+    bool m_attributesAreShared;
     Vector<RefPtr<Attribute> > m_attributes;
     AtomicString m_idForStyleResolution;
 };
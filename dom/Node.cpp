@@ -266,6 +266,8 @@ void Node::dumpStatistics()
     printf("  Number of Attributes with a StyleDeclaration: %zu\n", mappedAttributesWithStyleDecl);
     printf("  Number of Attributes with an Attr: %zu\n", attributesWithAttr);
     printf("  Number of NamedNodeMaps: %zu [%zu]\n", attrMaps, sizeof(NamedNodeMap));
+
+    printf("DOM arenas:\n%s", DOMArena::statistics().utf8().data());
 #endif
 }
 
@@ -340,6 +342,12 @@ Node::StyleChange Node::diff(const RenderStyle* s1, const RenderStyle* s2)
     return ch;
 }
 
+void* Node::operator new(size_t size, Document* document)
+{
+    ASSERT(document);
+    return DOMArena::allocate(document->domArena(), DOMArena::NodeObject, size);
+}
+
 void Node::trackForDebugging()
 {
 #ifndef NDEBUG
@@ -437,9 +445,13 @@ void Node::setDocument(Document* document)
 #endif
 
     if (hasRareData() && rareData()->nodeLists()) {
-        if (m_document)
+        NodeListsNodeData* nodeLists = rareData()->nodeLists();
+        if (m_document) {
             m_document->removeNodeListCache();
+            nodeLists->unregisterListsWithDocument(m_document);
+        }
         document->addNodeListCache();
+        nodeLists->registerListsWithDocument(document);
     }
 
     if (m_document)
@@ -472,7 +484,7 @@ NodeRareData* Node::ensureRareData()
     
 NodeRareData* Node::createRareData()
 {
-    return new NodeRareData;
+    return new (document()->domArena()) NodeRareData;
 }
     
 short Node::tabIndex() const
@@ -843,8 +855,11 @@ void Node::registerDynamicNodeList(DynamicNodeList* list)
         data->nodeLists()->invalidateCaches();
     }
 
-    if (list->hasOwnCaches())
+    if (list->hasOwnCaches()) {
         data->nodeLists()->m_listsWithCaches.add(list);
+        if (m_document)
+            m_document->registerDynamicNodeList(list);
+    }
 }
 
 void Node::unregisterDynamicNodeList(DynamicNodeList* list)
@@ -854,6 +869,8 @@ void Node::unregisterDynamicNodeList(DynamicNodeList* list)
     if (list->hasOwnCaches()) {
         NodeRareData* data = rareData();
         data->nodeLists()->m_listsWithCaches.remove(list);
+        if (m_document)
+            m_document->unregisterDynamicNodeList(list);
         if (data->nodeLists()->isEmpty()) {
             data->clearNodeLists();
             if (document())
@@ -862,7 +879,7 @@ void Node::unregisterDynamicNodeList(DynamicNodeList* list)
     }
 }
 
-void Node::notifyLocalNodeListsAttributeChanged()
+void Node::notifyLocalNodeListsAttributeChanged(const QualifiedName& attrName)
 {
     if (!hasRareData())
         return;
@@ -870,10 +887,7 @@ void Node::notifyLocalNodeListsAttributeChanged()
     if (!data->nodeLists())
         return;
 
-    if (!isAttributeNode())
-        data->nodeLists()->invalidateCachesThatDependOnAttributes();
-    else
-        data->nodeLists()->invalidateCaches();
+    data->nodeLists()->invalidateCachesThatDependOnAttribute(attrName, document());
 
     if (data->nodeLists()->isEmpty()) {
         data->clearNodeLists();
@@ -881,10 +895,14 @@ void Node::notifyLocalNodeListsAttributeChanged()
     }
 }
 
-void Node::notifyNodeListsAttributeChanged()
+void Node::notifyNodeListsAttributeChanged(const QualifiedName& attrName)
 {
-    for (Node *n = this; n; n = n->parentNode())
-        n->notifyLocalNodeListsAttributeChanged();
+    // Most attribute changes cannot affect any live list in the document; don't walk the ancestors for those.
+    if (!document()->shouldInvalidateDynamicNodeListCaches(attrName))
+        return;
+
+    for (Node* n = this; n; n = n->parentNode())
+        n->notifyLocalNodeListsAttributeChanged(attrName);
 }
 
 void Node::notifyLocalNodeListsChildrenChanged()
@@ -897,10 +915,6 @@ void Node::notifyLocalNodeListsChildrenChanged()
 
     data->nodeLists()->invalidateCaches();
 
-    NodeListsNodeData::NodeListSet::iterator end = data->nodeLists()->m_listsWithCaches.end();
-    for (NodeListsNodeData::NodeListSet::iterator i = data->nodeLists()->m_listsWithCaches.begin(); i != end; ++i)
-        (*i)->invalidateCache();
-
     if (data->nodeLists()->isEmpty()) {
         data->clearNodeLists();
         document()->removeNodeListCache();
@@ -923,6 +937,13 @@ void Node::notifyLocalNodeListsLabelChanged()
 
     if (data->nodeLists()->m_labelsNodeListCache)
         data->nodeLists()->m_labelsNodeListCache->invalidateCache();
+
+    // LabelsNodeLists are rooted at the document rather than the labelled control.
+    NodeListsNodeData::NodeListSet::iterator end = data->nodeLists()->m_listsWithCaches.end();
+    for (NodeListsNodeData::NodeListSet::iterator i = data->nodeLists()->m_listsWithCaches.begin(); i != end; ++i) {
+        if ((*i)->invalidationType() == InvalidateOnForAttrChange)
+            (*i)->invalidateCache();
+    }
 }
 
 void Node::removeCachedClassNodeList(ClassNodeList* list, const String& className)
@@ -2271,25 +2292,38 @@ void NodeListsNodeData::invalidateCaches()
 
     if (m_labelsNodeListCache)
         m_labelsNodeListCache->invalidateCache();
-    TagNodeListCache::const_iterator tagCacheEnd = m_tagNodeListCache.end();
-    for (TagNodeListCache::const_iterator it = m_tagNodeListCache.begin(); it != tagCacheEnd; ++it)
-        it->second->invalidateCache();
-    invalidateCachesThatDependOnAttributes();
+
+    // Every list with its own caches, including the tag, class and name lists, is in m_listsWithCaches.
+    NodeListSet::iterator end = m_listsWithCaches.end();
+    for (NodeListSet::iterator it = m_listsWithCaches.begin(); it != end; ++it)
+        (*it)->invalidateCache();
 }
 
-void NodeListsNodeData::invalidateCachesThatDependOnAttributes()
+void NodeListsNodeData::invalidateCachesThatDependOnAttribute(const QualifiedName& attrName, Document* document)
 {
-    ClassNodeListCache::iterator classCacheEnd = m_classNodeListCache.end();
-    for (ClassNodeListCache::iterator it = m_classNodeListCache.begin(); it != classCacheEnd; ++it)
-        it->second->invalidateCache();
-
-    NameNodeListCache::iterator nameCacheEnd = m_nameNodeListCache.end();
-    for (NameNodeListCache::iterator it = m_nameNodeListCache.begin(); it != nameCacheEnd; ++it)
-        it->second->invalidateCache();
-    if (m_labelsNodeListCache)
+    NodeListSet::iterator end = m_listsWithCaches.end();
+    for (NodeListSet::iterator it = m_listsWithCaches.begin(); it != end; ++it) {
+        if (DynamicNodeList::invalidationTypeDependsOnAttribute((*it)->invalidationType(), attrName, document))
+            (*it)->invalidateCache();
+    }
+    if (m_labelsNodeListCache && DynamicNodeList::invalidationTypeDependsOnAttribute(InvalidateOnForAttrChange, attrName, document))
         m_labelsNodeListCache->invalidateCache();
 }
 
+void NodeListsNodeData::registerListsWithDocument(Document* document)
+{
+    NodeListSet::iterator end = m_listsWithCaches.end();
+    for (NodeListSet::iterator it = m_listsWithCaches.begin(); it != end; ++it)
+        document->registerDynamicNodeList(*it);
+}
+
+void NodeListsNodeData::unregisterListsWithDocument(Document* document)
+{
+    NodeListSet::iterator end = m_listsWithCaches.end();
+    for (NodeListSet::iterator it = m_listsWithCaches.begin(); it != end; ++it)
+        document->unregisterDynamicNodeList(*it);
+}
+
 bool NodeListsNodeData::isEmpty() const
 {
     if (!m_listsWithCaches.isEmpty())
@@ -2806,11 +2840,14 @@ void Node::dispatchSubtreeModifiedEvent()
     
     document()->incDOMTreeVersion();
 
-    notifyNodeListsAttributeChanged(); // FIXME: Can do better some day. Really only care about the name attribute changing.
-    
     if (!document()->hasListenerType(Document::DOMSUBTREEMODIFIED_LISTENER))
         return;
 
+    if (document()->inMutationEventBatch()) {
+        document()->deferSubtreeModifiedEvent(this);
+        return;
+    }
+
     dispatchEvent(MutationEvent::create(eventNames().DOMSubtreeModifiedEvent, true));
 }
 
@@ -25,6 +25,7 @@
 #ifndef Node_h
 #define Node_h
 
+#include "DOMArena.h"
 #include "EventTarget.h"
 #include "KURLHash.h"
 #include "RenderStyleConstants.h"
@@ -126,6 +127,12 @@ public:
 
     virtual ~Node();
 
+    // Nodes are allocated from their document's DOM arena with new (document). The virtual
+    // destructor makes delete pass the size of the most derived class.
+    void* operator new(size_t size) { return DOMArena::allocate(0, DOMArena::NodeObject, size); }
+    void* operator new(size_t, Document*);
+    void operator delete(void* p, size_t size) { DOMArena::free(DOMArena::NodeObject, size, p); }
+
     // DOM methods & attributes for Node
 
     bool hasTagName(const QualifiedName&) const;
@@ -523,8 +530,8 @@ public:
     void unregisterDynamicNodeList(DynamicNodeList*);
     void notifyNodeListsChildrenChanged();
     void notifyLocalNodeListsChildrenChanged();
-    void notifyNodeListsAttributeChanged();
-    void notifyLocalNodeListsAttributeChanged();
+    void notifyNodeListsAttributeChanged(const QualifiedName&);
+    void notifyLocalNodeListsAttributeChanged(const QualifiedName&);
     void notifyLocalNodeListsLabelChanged();
     void removeCachedClassNodeList(ClassNodeList*, const String&);
     void removeCachedNameNodeList(NameNodeList*, const String&);
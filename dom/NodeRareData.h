@@ -23,6 +23,7 @@
 #define NodeRareData_h
 
 #include "ClassNodeList.h"
+#include "DOMArena.h"
 #include "DynamicNodeList.h"
 #include "NameNodeList.h"
 #include "QualifiedName.h"
@@ -57,7 +58,9 @@ struct NodeListsNodeData : Noncopyable {
     }
     
     void invalidateCaches();
-    void invalidateCachesThatDependOnAttributes();
+    void invalidateCachesThatDependOnAttribute(const QualifiedName&, Document*);
+    void registerListsWithDocument(Document*);
+    void unregisterListsWithDocument(Document*);
     bool isEmpty() const;
 
 private:
@@ -81,6 +84,9 @@ public:
     {
     }
 
+    void* operator new(size_t size, DOMArena* arena) { return DOMArena::allocate(arena, DOMArena::NodeRareDataObject, size); }
+    void operator delete(void* p, size_t size) { DOMArena::free(DOMArena::NodeRareDataObject, size, p); }
+
     typedef HashMap<const Node*, NodeRareData*> NodeRareDataMap;
     
     static NodeRareDataMap& rareDataMap()
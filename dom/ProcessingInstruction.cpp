@@ -52,7 +52,7 @@ inline ProcessingInstruction::ProcessingInstruction(Document* document, const St
 
 PassRefPtr<ProcessingInstruction> ProcessingInstruction::create(Document* document, const String& target, const String& data)
 {
-    return adoptRef(new ProcessingInstruction(document, target, data));
+    return adoptRef(new (document) ProcessingInstruction(document, target, data));
 }
 
 ProcessingInstruction::~ProcessingInstruction()
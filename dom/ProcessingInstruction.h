@@ -33,6 +33,10 @@ class CSSStyleSheet;
 
 class ProcessingInstruction : public ContainerNode, private CachedResourceClient {
 public:
+    // CachedResourceClient brings in the fastMalloc allocation functions too; nodes use the DOM arena.
+    using Node::operator new;
+    using Node::operator delete;
+
     static PassRefPtr<ProcessingInstruction> create(Document*, const String& target, const String& data);
     virtual ~ProcessingInstruction();
 
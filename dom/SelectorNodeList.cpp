@@ -33,6 +33,7 @@
 #include "CSSSelectorList.h"
 #include "CSSStyleSelector.h"
 #include "Document.h"
+#include "DocumentElementIndex.h"
 #include "Element.h"
 #include "HTMLNames.h"
 #include "StaticNodeList.h"
@@ -41,6 +42,22 @@ namespace WebCore {
 
 using namespace HTMLNames;
 
+// A lone compound selector keyed by a class or a tag name can start from the elements the
+// document index has for that key; the selector checker still decides every match.
+static const Vector<Element*>* indexedCandidates(Node* rootNode, CSSSelector* onlySelector)
+{
+    if (!rootNode->isDocumentNode() || !onlySelector || onlySelector->tagHistory())
+        return 0;
+    if (onlySelector->m_match != CSSSelector::Class && (onlySelector->m_match != CSSSelector::None || onlySelector->m_tag.localName() == starAtom))
+        return 0;
+    DocumentElementIndex* index = static_cast<Document*>(rootNode)->elementIndex();
+    if (!index)
+        return 0;
+    if (onlySelector->m_match == CSSSelector::Class)
+        return &index->elementsWithClassName(onlySelector->m_value);
+    return &index->elementsWithTagName(onlySelector->m_tag.localName());
+}
+
 PassRefPtr<StaticNodeList> createSelectorNodeList(Node* rootNode, const CSSSelectorList& querySelectorList)
 {
     Vector<RefPtr<Node> > nodes;
@@ -54,6 +71,12 @@ PassRefPtr<StaticNodeList> createSelectorNodeList(Node* rootNode, const CSSSelec
         Element* element = document->getElementById(onlySelector->m_value);
         if (element && (rootNode->isDocumentNode() || element->isDescendantOf(rootNode)) && selectorChecker.checkSelector(onlySelector, element))
             nodes.append(element);
+    } else if (const Vector<Element*>* candidates = indexedCandidates(rootNode, onlySelector)) {
+        size_t size = candidates->size();
+        for (size_t i = 0; i < size; ++i) {
+            if (selectorChecker.checkSelector(onlySelector, candidates->at(i)))
+                nodes.append(candidates->at(i));
+        }
     } else {
         for (Node* n = rootNode->firstChild(); n; n = n->traverseNextNode(rootNode)) {
             if (n->isElementNode()) {
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2026 The WebKit Authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.h"
+#include "SharedAttributeCache.h"
+
+#include "Attribute.h"
+#include "Document.h"
+#include "Element.h"
+#include "NamedNodeMap.h"
+#include "PlatformString.h"
+#include "StringBuilder.h"
+#include <wtf/HashFunctions.h>
+
+namespace WebCore {
+
+struct SharedAttributeCache::AttributeSet : public Noncopyable {
+    AttributeSet(const QualifiedName& tagName)
+        : tagName(tagName)
+    {
+    }
+
+    QualifiedName tagName;
+    Vector<RefPtr<Attribute> > attributes;
+};
+
+static const unsigned minimumSweepThreshold = 256;
+
+static inline void addToHash(unsigned& hash, void* pointer)
+{
+    hash = WTF::intHash(static_cast<uint64_t>(hash) << 32 | PtrHash<void*>::hash(pointer));
+}
+
+// Attribute names and values are atomic, so comparing and hashing their impls is enough.
+static unsigned hashAttributes(const QualifiedName& tagName, const NamedNodeMap* map)
+{
+    unsigned hash = 0;
+    addToHash(hash, tagName.impl());
+    unsigned length = map->length();
+    for (unsigned i = 0; i < length; ++i) {
+        Attribute* attribute = map->attributeItem(i);
+        addToHash(hash, attribute->name().impl());
+        addToHash(hash, attribute->value().impl());
+    }
+    return hash;
+}
+
+SharedAttributeCache::SharedAttributeCache()
+    : m_internCount(0)
+    , m_sharedCount(0)
+    , m_sweepThreshold(minimumSweepThreshold)
+{
+}
+
+SharedAttributeCache::~SharedAttributeCache()
+{
+    deleteAllValues(m_sets);
+}
+
+void SharedAttributeCache::shareAttributes(Element* element)
+{
+    NamedNodeMap* map = element->attributeMap();
+    if (!map || map->isEmpty() || map->m_attributesAreShared)
+        return;
+
+    // Ids are unique, no point keeping their sets around.
+    if (map->getAttributeItem(element->document()->idAttributeName()))
+        return;
+
+    unsigned length = map->length();
+    for (unsigned i = 0; i < length; ++i) {
+        if (map->m_attributes[i]->attr())
+            return;
+    }
+
+    ++m_internCount;
+    unsigned hash = hashAttributes(element->tagQName(), map);
+    std::pair<AttributeSetMap::iterator, bool> result = m_sets.add(hash, 0);
+    if (result.second) {
+        AttributeSet* set = new AttributeSet(element->tagQName());
+        set->attributes = map->m_attributes;
+        result.first->second = set;
+        map->m_attributesAreShared = true;
+        if (m_sets.size() >= m_sweepThreshold)
+            sweep();
+        return;
+    }
+
+    // Different sets that hash alike simply don't get shared. Everything the attributes carry
+    // has to match, including the mapped style declaration their element picked for them.
+    AttributeSet* set = result.first->second;
+    if (set->tagName != element->tagQName() || set->attributes.size() != length)
+        return;
+    for (unsigned i = 0; i < length; ++i) {
+        Attribute* ours = map->m_attributes[i].get();
+        Attribute* theirs = set->attributes[i].get();
+        if (ours->name() != theirs->name() || ours->value() != theirs->value()
+            || ours->m_isMappedAttribute != theirs->m_isMappedAttribute || ours->decl() != theirs->decl()
+            || ours->m_readOnly != theirs->m_readOnly || ours->m_worldID != theirs->m_worldID)
+            return;
+    }
+
+    map->m_attributes = set->attributes;
+    map->m_attributesAreShared = true;
+    ++m_sharedCount;
+}
+
+void SharedAttributeCache::sweep()
+{
+    // A set only the cache refers to belongs to elements that are gone or have copied it.
+    Vector<uint64_t> unused;
+    AttributeSetMap::iterator end = m_sets.end();
+    for (AttributeSetMap::iterator it = m_sets.begin(); it != end; ++it) {
+        if (it->second->attributes.first()->hasOneRef())
+            unused.append(it->first);
+    }
+    for (size_t i = 0; i < unused.size(); ++i)
+        delete m_sets.take(unused[i]);
+    m_sweepThreshold = std::max<unsigned>(minimumSweepThreshold, m_sets.size() * 2);
+}
+
+String SharedAttributeCache::memoryReport() const
+{
+    unsigned attributes = 0;
+    unsigned references = 0;
+    unsigned savedBytes = 0;
+    AttributeSetMap::const_iterator end = m_sets.end();
+    for (AttributeSetMap::const_iterator it = m_sets.begin(); it != end; ++it) {
+        const Vector<RefPtr<Attribute> >& set = it->second->attributes;
+        // One reference is the cache's own, every other one an element using the set.
+        unsigned users = set.first()->refCount() - 1;
+        attributes += set.size();
+        references += users * set.size();
+        if (users > 1)
+            savedBytes += (users - 1) * set.size() * sizeof(Attribute);
+    }
+
+    StringBuilder builder;
+    builder.append(String::format("Attribute sets: %u unique (%u attributes), %u attribute references, %u bytes saved (%u interned, %u shared)\n",
+        m_sets.size(), attributes, references, savedBytes, m_internCount, m_sharedCount));
+    return builder.toString();
+}
+
+} // namespace WebCore
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2026 The WebKit Authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef SharedAttributeCache_h
+#define SharedAttributeCache_h
+
+#include "QualifiedName.h"
+#include <wtf/HashMap.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/RefPtr.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+class Attribute;
+class Element;
+class String;
+
+// Per-document table of the attribute sets of parser-created elements. Markup tends to repeat
+// the same attributes over and over (class="row", type="text"); once an element has been
+// created and its attributes parsed, they are replaced with the equal Attribute objects of an
+// earlier element with the same tag name. The element's NamedNodeMap is marked as sharing them
+// and copies them before anything about them changes or an Attr node is handed out.
+class SharedAttributeCache : public Noncopyable {
+public:
+    SharedAttributeCache();
+    ~SharedAttributeCache();
+
+    void shareAttributes(Element*);
+
+    // The distinct attribute sets kept, the elements using them, and the memory saved by sharing.
+    String memoryReport() const;
+
+private:
+    struct AttributeSet;
+
+    // Any unsigned value can be a hash, including the ones HashMap<unsigned> reserves for empty and
+    // deleted buckets, so the key is widened and those markers live just above the unsigned range.
+    struct AttributeHashTraits : WTF::GenericHashTraits<uint64_t> {
+        static const bool emptyValueIsZero = false;
+        static uint64_t emptyValue() { return static_cast<uint64_t>(1) << 32; }
+        static void constructDeletedValue(uint64_t& slot) { slot = (static_cast<uint64_t>(1) << 32) + 1; }
+        static bool isDeletedValue(uint64_t value) { return value == (static_cast<uint64_t>(1) << 32) + 1; }
+    };
+    typedef HashMap<uint64_t, AttributeSet*, IntHash<uint64_t>, AttributeHashTraits> AttributeSetMap;
+
+    void sweep();
+
+    AttributeSetMap m_sets;
+    unsigned m_internCount;
+    unsigned m_sharedCount;
+    unsigned m_sweepThreshold;
+};
+
+} // namespace WebCore
+
+#endif // SharedAttributeCache_h
@@ -29,6 +29,7 @@
 #include "CSSStyleSheet.h"
 #include "CSSValueKeywords.h"
 #include "Document.h"
+#include "DocumentElementIndex.h"
 #include "HTMLNames.h"
 #include <wtf/HashFunctions.h>
 
@@ -118,7 +119,7 @@ StyledElement::~StyledElement()
 
 PassRefPtr<Attribute> StyledElement::createAttribute(const QualifiedName& name, const AtomicString& value)
 {
-    return Attribute::createMapped(name, value);
+    return Attribute::createMapped(name, value, document()->domArena());
 }
 
 void StyledElement::createInlineStyleDecl()
@@ -216,6 +217,15 @@ void StyledElement::classAttributeChanged(const AtomicString& newClassString)
             break;
     }
     bool hasClass = i < length;
+
+    DocumentElementIndex* index = inDocument() ? document()->existingElementIndex() : 0;
+    Vector<AtomicString, 8> oldClassNames;
+    if (index && this->hasClass() && attributeMap()) {
+        const SpaceSplitString& classNames = this->classNames();
+        for (size_t j = 0; j < classNames.size(); ++j)
+            oldClassNames.append(classNames[j]);
+    }
+
     setHasClass(hasClass);
     if (hasClass)
         attributes()->setClass(newClassString);
@@ -223,7 +233,12 @@ void StyledElement::classAttributeChanged(const AtomicString& newClassString)
         if (attributeMap())    
             attributeMap()->clearClass();
     }
+    if (index)
+        index->classNamesChanged(this, oldClassNames);
     setNeedsStyleRecalc();
+    // Element::updateAfterAttributeChanged() invalidates the lists too, but only after this event
+    // has run, and its listeners must not see class lists that predate the change.
+    notifyNodeListsAttributeChanged(classAttr);
     dispatchSubtreeModifiedEvent();
 }
 
@@ -24,13 +24,15 @@
 #include "config.h"
 #include "TagNodeList.h"
 
+#include "Document.h"
+#include "DocumentElementIndex.h"
 #include "Element.h"
 #include <wtf/Assertions.h>
 
 namespace WebCore {
 
 TagNodeList::TagNodeList(PassRefPtr<Node> rootNode, const AtomicString& namespaceURI, const AtomicString& localName)
-    : DynamicNodeList(rootNode)
+    : DynamicNodeList(rootNode, DoNotInvalidateOnAttributeChange)
     , m_namespaceURI(namespaceURI)
     , m_localName(localName)
 {
@@ -50,4 +52,16 @@ bool TagNodeList::nodeMatches(Element* testNode) const
     return m_localName == starAtom || m_localName == testNode->localName();
 }
 
+const Vector<Element*>* TagNodeList::indexedCandidates(bool& allMatch) const
+{
+    if (m_localName == starAtom)
+        return 0;
+    DocumentElementIndex* index = m_rootNode->document()->elementIndex();
+    if (!index)
+        return 0;
+
+    allMatch = m_namespaceURI == starAtom;
+    return &index->elementsWithTagName(m_localName);
+}
+
 } // namespace WebCore
@@ -43,6 +43,7 @@ namespace WebCore {
         TagNodeList(PassRefPtr<Node> rootNode, const AtomicString& namespaceURI, const AtomicString& localName);
 
         virtual bool nodeMatches(Element*) const;
+        virtual const Vector<Element*>* indexedCandidates(bool& allMatch) const;
 
         AtomicString m_namespaceURI;
         AtomicString m_localName;
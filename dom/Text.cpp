@@ -44,7 +44,7 @@ namespace WebCore {
 
 PassRefPtr<Text> Text::create(Document* document, const String& data)
 {
-    return adoptRef(new Text(document, data));
+    return adoptRef(new (document) Text(document, data));
 }
 
 PassRefPtr<Text> Text::splitText(unsigned offset, ExceptionCode& ec)
@@ -321,7 +321,7 @@ END
     my $createSuffix = "::create";
 
     if ($enabledTags{$tagName}{createWithNew}) {
-        $newPrefix = "new ";
+        $newPrefix = "new (document) ";
         $createSuffix = "";
     }
 
@@ -35,15 +35,53 @@
 #include "Element.h"
 #include "EventNames.h"
 #include "Frame.h"
+#include "FrameView.h"
+#include "Logging.h"
+#include "MutationEventBatch.h"
 #include "SelectionController.h"
 #include "VisiblePosition.h"
 #include "htmlediting.h"
 
 namespace WebCore {
 
+// Counts the layouts a top-level command causes, and holds back the layout side effects that
+// only matter once the command is done. Layout itself is not cached across the command's steps:
+// a step that needs positions gets a real layout, which only touches the dirty relayout roots.
+class EditCommand::LayoutScope : public Noncopyable {
+public:
+    LayoutScope(EditCommand* command)
+        : m_command(command->isTopLevelCommand() ? command : 0)
+        , m_view(command->document()->view())
+        , m_startLayoutCount(m_view ? m_view->layoutCount() : 0)
+    {
+        if (!m_command)
+            return;
+        m_command->m_layoutRequestCount = 0;
+        m_command->m_layoutCount = 0;
+        if (m_view)
+            m_view->beginEditingLayoutBatch();
+    }
+
+    ~LayoutScope()
+    {
+        if (!m_command || !m_view)
+            return;
+        m_command->m_layoutCount = m_view->layoutCount() - m_startLayoutCount;
+        m_view->endEditingLayoutBatch();
+        LOG(Editing, "Edit command for action %d: %u layout requests, %d layouts", m_command->editingAction(), m_command->m_layoutRequestCount, m_command->m_layoutCount);
+    }
+
+private:
+    EditCommand* m_command;
+    RefPtr<FrameView> m_view;
+    int m_startLayoutCount;
+};
+
 EditCommand::EditCommand(Document* document) 
     : m_document(document)
     , m_parent(0)
+    , m_layoutRequestCount(0)
+    , m_layoutCount(0)
 {
     ASSERT(m_document);
     ASSERT(m_document->frame());
@@ -88,7 +126,12 @@ void EditCommand::apply()
 
     DeleteButtonController* deleteButtonController = frame->editor()->deleteButtonController();
     deleteButtonController->disable();
-    doApply();
+    {
+        // Commands make many small changes; listeners hear about the subtree once, at the end.
+        LayoutScope layoutScope(this);
+        MutationEventBatch mutationEventBatch(m_document.get());
+        doApply();
+    }
     deleteButtonController->enable();
 
     if (isTopLevelCommand()) {
@@ -115,7 +158,11 @@ void EditCommand::unapply()
     
     DeleteButtonController* deleteButtonController = frame->editor()->deleteButtonController();
     deleteButtonController->disable();
-    doUnapply();
+    {
+        LayoutScope layoutScope(this);
+        MutationEventBatch mutationEventBatch(m_document.get());
+        doUnapply();
+    }
     deleteButtonController->enable();
 
     if (isTopLevelCommand())
@@ -138,7 +185,11 @@ void EditCommand::reapply()
 
     DeleteButtonController* deleteButtonController = frame->editor()->deleteButtonController();
     deleteButtonController->disable();
-    doReapply();
+    {
+        LayoutScope layoutScope(this);
+        MutationEventBatch mutationEventBatch(m_document.get());
+        doReapply();
+    }
     deleteButtonController->enable();
 
     if (isTopLevelCommand())
@@ -193,9 +244,18 @@ bool EditCommand::isTypingCommand() const
 
 void EditCommand::updateLayout() const
 {
+    countLayoutRequests(1);
     document()->updateLayoutIgnorePendingStylesheets();
 }
 
+void EditCommand::countLayoutRequests(unsigned count) const
+{
+    const EditCommand* topLevelCommand = this;
+    while (topLevelCommand->m_parent)
+        topLevelCommand = topLevelCommand->m_parent;
+    topLevelCommand->m_layoutRequestCount += count;
+}
+
 void EditCommand::setParent(CompositeEditCommand* parent)
 {
     ASSERT(parent);
@@ -60,6 +60,12 @@ public:
     
     bool isTopLevelCommand() const { return !m_parent; }
 
+    // The layout work done the last time this command was applied, unapplied or reapplied as a
+    // top-level command: how often its steps asked for an up-to-date layout, and how many
+    // layouts actually ran.
+    unsigned layoutRequestCount() const { return m_layoutRequestCount; }
+    int layoutCount() const { return m_layoutCount; }
+
 protected:
     EditCommand(Document*);
 
@@ -69,18 +75,24 @@ protected:
     void setEndingSelection(const VisibleSelection&);
 
     void updateLayout() const;
+    // For layouts forced on the command's behalf by helpers that are not commands.
+    void countLayoutRequests(unsigned) const;
 
 private:
     virtual void doApply() = 0;
     virtual void doUnapply() = 0;
     virtual void doReapply(); // calls doApply()
 
+    class LayoutScope;
+
     RefPtr<Document> m_document;
     VisibleSelection m_startingSelection;
     VisibleSelection m_endingSelection;
     RefPtr<Element> m_startingRootEditableElement;
     RefPtr<Element> m_endingRootEditableElement;
     CompositeEditCommand* m_parent;
+    mutable unsigned m_layoutRequestCount;
+    int m_layoutCount;
 
     friend void applyCommand(PassRefPtr<EditCommand>);
 };
@@ -64,6 +64,7 @@
 #include <SplitTextNodeCommand.cpp>
 #include <SplitTextNodeContainingElementCommand.cpp>
 #include <TextIterator.cpp>
+#include <TextSearchIndex.cpp>
 #include <TypingCommand.cpp>
 #include <UnlinkCommand.cpp>
 #include <VisiblePosition.cpp>
@@ -71,6 +71,9 @@ public:
     
     bool hasInterchangeNewlineAtStart() const { return m_hasInterchangeNewlineAtStart; }
     bool hasInterchangeNewlineAtEnd() const { return m_hasInterchangeNewlineAtEnd; }
+
+    // How many times test rendering forced a layout.
+    unsigned layoutRequestCount() const { return m_layoutRequestCount; }
     
     void removeNode(PassRefPtr<Node>);
     void removeNodePreservingChildren(Node*);
@@ -88,6 +91,7 @@ private:
     bool m_matchStyle;
     bool m_hasInterchangeNewlineAtStart;
     bool m_hasInterchangeNewlineAtEnd;
+    unsigned m_layoutRequestCount;
 };
 
 static bool isInterchangeNewlineNode(const Node *node)
@@ -125,7 +129,8 @@ ReplacementFragment::ReplacementFragment(Document* document, DocumentFragment* f
       m_fragment(fragment),
       m_matchStyle(matchStyle), 
       m_hasInterchangeNewlineAtStart(false), 
-      m_hasInterchangeNewlineAtEnd(false)
+      m_hasInterchangeNewlineAtEnd(false),
+      m_layoutRequestCount(0)
 {
     if (!m_document)
         return;
@@ -261,6 +266,7 @@ PassRefPtr<Node> ReplacementFragment::insertFragmentForTestRendering(Node* conte
     body->appendChild(holder.get(), ec);
     ASSERT(ec == 0);
     
+    ++m_layoutRequestCount;
     m_document->updateLayoutIgnorePendingStylesheets();
     
     return holder.release();
@@ -503,7 +509,7 @@ void ReplaceSelectionCommand::negateStyleRulesThatAffectAppearance()
 
 void ReplaceSelectionCommand::removeUnrenderedTextNodesAtEnds()
 {
-    document()->updateLayoutIgnorePendingStylesheets();
+    updateLayout();
     if (!m_lastLeafInserted->renderer() && 
         m_lastLeafInserted->isTextNode() && 
         !enclosingNodeWithTag(Position(m_lastLeafInserted.get(), 0), selectTag) && 
@@ -789,6 +795,7 @@ void ReplaceSelectionCommand::doApply()
     
     Element* currentRoot = selection.rootEditableElement();
     ReplacementFragment fragment(document(), m_documentFragment.get(), m_matchStyle, selection);
+    countLayoutRequests(fragment.layoutRequestCount());
     
     if (performTrivialReplace(fragment))
         return;
@@ -29,6 +29,7 @@
 
 #include "CharacterNames.h"
 #include "Document.h"
+#include "FrameView.h"
 #include "HTMLElement.h"
 #include "HTMLNames.h"
 #include "htmlediting.h"
@@ -265,6 +266,13 @@ TextIterator::TextIterator()
 {
 }
 
+// Blocks whose layout was deferred have no line boxes, so their text would be skipped.
+static void layoutDeferredContent(Node* node)
+{
+    if (FrameView* view = node->document()->view())
+        view->layoutDeferredContent();
+}
+
 TextIterator::TextIterator(const Range* r, TextIteratorBehavior behavior)
     : m_startContainer(0)
     , m_startOffset(0)
@@ -290,6 +298,7 @@ TextIterator::TextIterator(const Range* r, TextIteratorBehavior behavior)
     Node* startContainer = r->startContainer();
     if (!startContainer)
         return;
+    layoutDeferredContent(startContainer);
     int startOffset = r->startOffset();
     Node* endContainer = r->endContainer();
     int endOffset = r->endOffset();
@@ -1046,6 +1055,7 @@ SimplifiedBackwardsTextIterator::SimplifiedBackwardsTextIterator(const Range* r,
     Node* startNode = r->startContainer();
     if (!startNode)
         return;
+    layoutDeferredContent(startNode);
     Node* endNode = r->endContainer();
     int startOffset = r->startOffset();
     int endOffset = r->endOffset();
@@ -2360,4 +2370,188 @@ PassRefPtr<Range> findPlainText(const Range* range, const String& target, bool f
     return characterSubrange(computeRangeIterator, matchStart, matchLength);
 }
 
+// --------
+
+// Walks a FlattenedText the way a CharacterIterator walks the DOM, reporting breaks where
+// the TextIterator returned zero-length runs, so searching gives the same results.
+class FlattenedTextIterator {
+public:
+    FlattenedTextIterator(const FlattenedText& text, unsigned startOffset, unsigned endOffset)
+        : m_text(text)
+        , m_offset(startOffset)
+        , m_endOffset(endOffset)
+        , m_run(text.runContaining(startOffset))
+        , m_atBreak(true)
+    {
+    }
+
+    void advance(int);
+
+    bool atBreak() const { return m_atBreak; }
+    bool atEnd() const { return m_offset >= m_endOffset; }
+
+    int length() const
+    {
+        const FlattenedText::Run& run = m_text.m_runs[m_run];
+        return min(run.offset + run.length, m_endOffset) - m_offset;
+    }
+    const UChar* characters() const { return m_text.m_characters.data() + m_offset; }
+
+    int characterOffset() const { return m_offset; }
+
+private:
+    const FlattenedText& m_text;
+    unsigned m_offset;
+    unsigned m_endOffset;
+    size_t m_run;
+    bool m_atBreak;
+};
+
+void FlattenedTextIterator::advance(int count)
+{
+    ASSERT(count >= 0);
+    m_atBreak = false;
+    m_offset += count;
+
+    const Vector<FlattenedText::Run>& runs = m_text.m_runs;
+    while (m_run < runs.size() && m_offset >= runs[m_run].offset + runs[m_run].length) {
+        if (++m_run < runs.size() && runs[m_run].followsBreak)
+            m_atBreak = true;
+    }
+
+    if (atEnd())
+        m_atBreak = true;
+}
+
+// Like findPlainText searching backward, but remembers every match along the way.
+static void findAllPlainText(FlattenedTextIterator& it, const String& target, bool caseSensitive, Vector<FlattenedText::Match>& matches)
+{
+    SearchBuffer buffer(target, caseSensitive);
+
+    while (!it.atEnd()) {
+        it.advance(buffer.append(it.characters(), it.length()));
+tryAgain:
+        size_t matchStartOffset;
+        if (size_t matchLength = buffer.search(matchStartOffset)) {
+            ASSERT(static_cast<size_t>(it.characterOffset()) >= matchStartOffset);
+            FlattenedText::Match match;
+            match.offset = it.characterOffset() - matchStartOffset;
+            match.length = matchLength;
+            matches.append(match);
+            goto tryAgain;
+        }
+        if (it.atBreak() && !buffer.atBreak()) {
+            buffer.reachedBreak();
+            goto tryAgain;
+        }
+    }
+}
+
+PassOwnPtr<FlattenedText> FlattenedText::create(const Range* range)
+{
+    OwnPtr<FlattenedText> text(new FlattenedText);
+
+    bool followsBreak = false;
+    for (TextIterator it(range, TextIteratorEntersTextControls); !it.atEnd(); it.advance()) {
+        int length = it.length();
+        if (!length) {
+            followsBreak = true;
+            continue;
+        }
+
+        RefPtr<Range> runRange = it.range();
+        Run run;
+        run.offset = text->m_characters.size();
+        run.length = length;
+        run.followsBreak = followsBreak;
+        run.startContainer = runRange->startContainer();
+        run.startOffset = runRange->startOffset();
+        run.endContainer = runRange->endContainer();
+        run.endOffset = runRange->endOffset();
+        text->m_runs.append(run);
+        text->m_characters.append(it.characters(), length);
+        followsBreak = false;
+    }
+
+    return text.release();
+}
+
+void FlattenedText::findAll(const String& target, bool caseSensitive, Vector<Match>& matches) const
+{
+    if (m_characters.isEmpty())
+        return;
+    FlattenedTextIterator it(*this, 0, m_characters.size());
+    findAllPlainText(it, target, caseSensitive, matches);
+}
+
+void FlattenedText::findAt(const String& target, bool caseSensitive, const Vector<Match>& candidates, Vector<Match>& matches) const
+{
+    // Only the text right after each candidate is searched. A match of the longer target that
+    // starts where the old one did can't run much further than the target's own length past
+    // the old match, barring long stretches of characters the collator ignores.
+    Vector<Match> windowMatches;
+    size_t candidateCount = candidates.size();
+    for (size_t i = 0; i < candidateCount; ++i) {
+        const Match& candidate = candidates[i];
+        unsigned windowEnd = min<unsigned>(m_characters.size(), candidate.offset + candidate.length + 2 * target.length());
+        FlattenedTextIterator it(*this, candidate.offset, windowEnd);
+        windowMatches.shrink(0);
+        findAllPlainText(it, target, caseSensitive, windowMatches);
+        if (!windowMatches.isEmpty() && windowMatches[0].offset == candidate.offset)
+            matches.append(windowMatches[0]);
+    }
+}
+
+size_t FlattenedText::runContaining(unsigned offset) const
+{
+    ASSERT(!m_runs.isEmpty());
+    size_t low = 0;
+    size_t high = m_runs.size();
+    while (high - low > 1) {
+        size_t middle = low + (high - low) / 2;
+        if (m_runs[middle].offset <= offset)
+            low = middle;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+// Mirrors CharacterIterator::range(): single characters of a longer run map one to one onto
+// the offsets of the run's text node.
+void FlattenedText::characterPosition(unsigned offset, Node*& startContainer, int& startOffset, Node*& endContainer, int& endOffset) const
+{
+    const Run& run = m_runs[runContaining(offset)];
+    if (run.length <= 1) {
+        startContainer = run.startContainer;
+        startOffset = run.startOffset;
+        endContainer = run.endContainer;
+        endOffset = run.endOffset;
+        return;
+    }
+
+    ASSERT(run.startContainer == run.endContainer);
+    startContainer = run.startContainer;
+    endContainer = run.startContainer;
+    startOffset = run.startOffset + (offset - run.offset);
+    endOffset = startOffset + 1;
+}
+
+PassRefPtr<Range> FlattenedText::rangeForMatch(const Match& match) const
+{
+    ASSERT(match.length);
+    ASSERT(match.offset + match.length <= m_characters.size());
+
+    Node* startContainer;
+    int startOffset;
+    Node* endContainer;
+    int endOffset;
+    Node* unusedContainer;
+    int unusedOffset;
+    characterPosition(match.offset, startContainer, startOffset, unusedContainer, unusedOffset);
+    characterPosition(match.offset + match.length - 1, unusedContainer, unusedOffset, endContainer, endOffset);
+
+    return Range::create(startContainer->document(), startContainer, startOffset, endContainer, endOffset);
+}
+
 }
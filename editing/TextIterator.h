@@ -28,6 +28,7 @@
 
 #include "InlineTextBox.h"
 #include "Range.h"
+#include <wtf/PassOwnPtr.h>
 #include <wtf/Vector.h>
 
 namespace WebCore {
@@ -314,6 +315,53 @@ private:
     TextIterator m_textIterator;
 };
 
+// The text a CharacterIterator that enters text controls walks over in a range, copied into
+// one buffer along with the DOM position each run of it came from. Searching it gives the
+// same matches as findPlainText without walking the render tree again, so it is only valid
+// as long as neither the DOM nor the layout has changed; callers are responsible for that.
+class FlattenedText : public Noncopyable {
+public:
+    struct Match {
+        unsigned offset;
+        unsigned length;
+    };
+
+    static PassOwnPtr<FlattenedText> create(const Range*);
+
+    unsigned length() const { return m_characters.size(); }
+
+    // Appends every match of the target, in text order, including ones that overlap earlier matches.
+    void findAll(const String& target, bool caseSensitive, Vector<Match>&) const;
+
+    // Appends each of the candidates at whose start the target matches as well. If the target
+    // extends the query that produced the candidates, these are all of its matches.
+    void findAt(const String& target, bool caseSensitive, const Vector<Match>& candidates, Vector<Match>&) const;
+
+    PassRefPtr<Range> rangeForMatch(const Match&) const;
+
+private:
+    friend class FlattenedTextIterator;
+
+    FlattenedText() { }
+
+    // Nodes are not retained; see the class comment.
+    struct Run {
+        unsigned offset;
+        unsigned length;
+        bool followsBreak;
+        Node* startContainer;
+        int startOffset;
+        Node* endContainer;
+        int endOffset;
+    };
+
+    size_t runContaining(unsigned offset) const;
+    void characterPosition(unsigned offset, Node*& startContainer, int& startOffset, Node*& endContainer, int& endOffset) const;
+
+    Vector<UChar> m_characters;
+    Vector<Run> m_runs;
+};
+
 }
 
 #endif
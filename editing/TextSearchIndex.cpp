@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026 The WebKit Authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.h"
+#include "TextSearchIndex.h"
+
+#include "Document.h"
+#include "FrameView.h"
+#include "Range.h"
+
+namespace WebCore {
+
+PassOwnPtr<TextSearchIndex> TextSearchIndex::create(Document* document)
+{
+    return new TextSearchIndex(document);
+}
+
+TextSearchIndex::TextSearchIndex(Document* document)
+    : m_document(document)
+    , m_domTreeVersion(0)
+    , m_layoutCount(0)
+    , m_caseSensitive(false)
+{
+}
+
+TextSearchIndex::~TextSearchIndex()
+{
+}
+
+int TextSearchIndex::layoutCount() const
+{
+    FrameView* view = m_document->view();
+    return view ? view->layoutCount() : 0;
+}
+
+bool TextSearchIndex::isCurrent() const
+{
+    return m_text && m_domTreeVersion == m_document->domTreeVersion() && m_layoutCount == layoutCount();
+}
+
+void TextSearchIndex::invalidate()
+{
+    m_text.clear();
+    m_target = String();
+    m_allMatches.clear();
+    m_matches.clear();
+}
+
+const Vector<FlattenedText::Match>& TextSearchIndex::findMatches(const String& target, bool caseSensitive)
+{
+    if (!isCurrent()) {
+        invalidate();
+        m_text = FlattenedText::create(rangeOfContents(m_document).get());
+        m_domTreeVersion = m_document->domTreeVersion();
+        m_layoutCount = layoutCount();
+    }
+
+    bool sameMode = !m_target.isNull() && caseSensitive == m_caseSensitive;
+    if (sameMode && target == m_target)
+        return m_matches;
+
+    Vector<FlattenedText::Match> allMatches;
+    if (sameMode && target.length() > m_target.length() && target.startsWith(m_target, caseSensitive))
+        m_text->findAt(target, caseSensitive, m_allMatches, allMatches);
+    else
+        m_text->findAll(target, caseSensitive, allMatches);
+
+    m_target = target;
+    m_caseSensitive = caseSensitive;
+    m_allMatches.swap(allMatches);
+
+    // Each search after a match starts where that match ended, so overlapping matches are dropped.
+    m_matches.clear();
+    unsigned previousEnd = 0;
+    size_t matchCount = m_allMatches.size();
+    for (size_t i = 0; i < matchCount; ++i) {
+        const FlattenedText::Match& match = m_allMatches[i];
+        if (!m_matches.isEmpty() && match.offset < previousEnd)
+            continue;
+        m_matches.append(match);
+        previousEnd = match.offset + match.length;
+    }
+
+    return m_matches;
+}
+
+PassRefPtr<Range> TextSearchIndex::rangeForMatch(const FlattenedText::Match& match) const
+{
+    ASSERT(isCurrent());
+    return m_text->rangeForMatch(match);
+}
+
+} // namespace WebCore
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2026 The WebKit Authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef TextSearchIndex_h
+#define TextSearchIndex_h
+
+#include "TextIterator.h"
+#include <wtf/Noncopyable.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/PassOwnPtr.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+class Document;
+class Range;
+
+// Keeps the flattened text of a document between find-in-page searches. The text is taken
+// again after any DOM mutation, style recalculation or layout; until then each search only
+// runs the search buffer over the cached characters, and a query that extends the previous
+// one only looks at the places the previous one matched.
+class TextSearchIndex : public Noncopyable {
+public:
+    static PassOwnPtr<TextSearchIndex> create(Document*);
+    ~TextSearchIndex();
+
+    // The matches findPlainText would return if called repeatedly from the end of the previous
+    // match, in document order. The vector stays valid until the next call.
+    const Vector<FlattenedText::Match>& findMatches(const String& target, bool caseSensitive);
+
+    PassRefPtr<Range> rangeForMatch(const FlattenedText::Match&) const;
+
+    void invalidate();
+
+private:
+    TextSearchIndex(Document*);
+
+    bool isCurrent() const;
+    int layoutCount() const;
+
+    Document* m_document;
+    OwnPtr<FlattenedText> m_text;
+    unsigned m_domTreeVersion;
+    int m_layoutCount;
+
+    String m_target;
+    bool m_caseSensitive;
+    // Every match of m_target, overlapping ones included, for narrowing down the next query.
+    Vector<FlattenedText::Match> m_allMatches;
+    Vector<FlattenedText::Match> m_matches;
+};
+
+} // namespace WebCore
+
+#endif // TextSearchIndex_h
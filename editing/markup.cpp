@@ -143,32 +143,119 @@ private:
     const EAnnotateForInterchange m_shouldAnnotate;
     const Range* const m_range;
     Vector<String> m_reversedPrecedingMarkup;
-    Vector<String> m_succeedingMarkup;
+    // Markup that follows the wrapping ancestors is written straight into one buffer.
+    Vector<UChar> m_succeedingMarkup;
 };
 
+template<size_t length> static inline void appendLiteral(Vector<UChar>& result, const char (&literal)[length])
+{
+    size_t oldSize = result.size();
+    result.grow(oldSize + length - 1);
+    UChar* destination = result.data() + oldSize;
+    for (size_t i = 0; i < length - 1; ++i)
+        destination[i] = literal[i];
+}
+
+static inline void appendQualifiedName(Vector<UChar>& result, const QualifiedName& name)
+{
+    if (name.hasPrefix()) {
+        append(result, name.prefix());
+        result.append(':');
+    }
+    append(result, name.localName());
+}
+
+// Every character that may need escaping is at most '>' or a no-break space. Looks at four
+// characters at once; a block with neither can be copied as is.
+static inline bool blockMayNeedEscaping(const UChar* characters)
+{
+    const uint64_t ones = 0x0001000100010001ULL;
+    const uint64_t highBits = 0x8000800080008000ULL;
+
+    uint64_t block;
+    memcpy(&block, characters, sizeof(block));
+    uint64_t belowGreaterThan = (block - ones * ('>' + 1)) & ~block & highBits;
+    uint64_t noBreakSpaces = block ^ (ones * noBreakSpace);
+    uint64_t isNoBreakSpace = (noBreakSpaces - ones) & ~noBreakSpaces & highBits;
+    return belowGreaterThan | isNoBreakSpace;
+}
+
+static void appendEscapedCharacters(Vector<UChar>& result, const UChar* characters, size_t length, bool escapeQuotes, bool escapeNBSP)
+{
+    static const char ampEntity[] = "&amp;";
+    static const char gtEntity[] = "&gt;";
+    static const char ltEntity[] = "&lt;";
+    static const char quotEntity[] = "&quot;";
+    static const char nbspEntity[] = "&nbsp;";
+
+    size_t lastCopiedFrom = 0;
+    size_t i = 0;
+    while (i < length) {
+        if (i + 4 <= length && !blockMayNeedEscaping(characters + i)) {
+            i += 4;
+            continue;
+        }
+
+        switch (characters[i]) {
+        case '&':
+            result.append(characters + lastCopiedFrom, i - lastCopiedFrom);
+            appendLiteral(result, ampEntity);
+            lastCopiedFrom = i + 1;
+            break;
+        case '<':
+            result.append(characters + lastCopiedFrom, i - lastCopiedFrom);
+            appendLiteral(result, ltEntity);
+            lastCopiedFrom = i + 1;
+            break;
+        case '>':
+            result.append(characters + lastCopiedFrom, i - lastCopiedFrom);
+            appendLiteral(result, gtEntity);
+            lastCopiedFrom = i + 1;
+            break;
+        case '"':
+            if (!escapeQuotes)
+                break;
+            result.append(characters + lastCopiedFrom, i - lastCopiedFrom);
+            appendLiteral(result, quotEntity);
+            lastCopiedFrom = i + 1;
+            break;
+        case noBreakSpace:
+            if (!escapeNBSP)
+                break;
+            result.append(characters + lastCopiedFrom, i - lastCopiedFrom);
+            appendLiteral(result, nbspEntity);
+            lastCopiedFrom = i + 1;
+            break;
+        }
+        ++i;
+    }
+
+    result.append(characters + lastCopiedFrom, length - lastCopiedFrom);
+}
+
 void MarkupAccumulator::appendString(const String& string)
 {
-    m_succeedingMarkup.append(string);
+    append(m_succeedingMarkup, string);
 }
 
 void MarkupAccumulator::appendStartTag(Node* node, Namespaces* namespaces)
 {
-    Vector<UChar> markup;
-    appendStartMarkup(markup, node, false, namespaces, DoesFullySelectNode);
-	if ((node->nodeType()==3)&&(!R_check(node->parentNode()))) return;
-	if ((node->nodeType()!=3)&&(!R_check(node))) return;
-    m_succeedingMarkup.append(String::adopt(markup));
+    size_t oldSize = m_succeedingMarkup.size();
+    appendStartMarkup(m_succeedingMarkup, node, false, namespaces, DoesFullySelectNode);
+	if (((node->nodeType()==3)&&(!R_check(node->parentNode()))) || ((node->nodeType()!=3)&&(!R_check(node)))) {
+        m_succeedingMarkup.shrink(oldSize);
+        return;
+    }
     if (m_nodes)
         m_nodes->append(node);
 }
 
 void MarkupAccumulator::appendEndTag(Node* node)
 {
-    Vector<UChar> markup;
-    appendEndMarkup(markup, node);
-	if ((node->nodeType()==3)&&(!R_check(node->parentNode()))) return;
-	if ((node->nodeType()!=3)&&(!R_check(node))) return;
-    m_succeedingMarkup.append(String::adopt(markup));
+    size_t oldSize = m_succeedingMarkup.size();
+    appendEndMarkup(m_succeedingMarkup, node);
+	if (((node->nodeType()==3)&&(!R_check(node->parentNode()))) || ((node->nodeType()!=3)&&(!R_check(node))))
+        m_succeedingMarkup.shrink(oldSize);
 }
 
 void MarkupAccumulator::wrapWithNode(Node* node, bool convertBlocksToInlines, RangeFullySelectsNode rangeFullySelectsNode)
@@ -196,124 +283,40 @@ void MarkupAccumulator::wrapWithStyleNode(CSSStyleDeclaration* style, Document*
     openTag.append('\"');
     openTag.append('>');
     m_reversedPrecedingMarkup.append(String::adopt(openTag));
-    m_succeedingMarkup.append(isBlock ? divClose : styleSpanClose);
+    append(m_succeedingMarkup, isBlock ? divClose : styleSpanClose);
 }
 
-// FIXME: This is a very inefficient way of accumulating the markup.
-// We're converting results of appendStartMarkup and appendEndMarkup from Vector<UChar> to String
-// and then back to Vector<UChar> and again to String here.
 String MarkupAccumulator::takeResults()
 {
-    size_t length = 0;
+    // Serializing a node or its children never wraps anything around the markup; hand the buffer over as is.
+    if (m_reversedPrecedingMarkup.isEmpty())
+        return String::adopt(m_succeedingMarkup);
 
+    size_t length = m_succeedingMarkup.size();
     size_t preCount = m_reversedPrecedingMarkup.size();
     for (size_t i = 0; i < preCount; ++i)
         length += m_reversedPrecedingMarkup[i].length();
 
-    size_t postCount = m_succeedingMarkup.size();
-    for (size_t i = 0; i < postCount; ++i)
-        length += m_succeedingMarkup[i].length();
-
     Vector<UChar> result;
     result.reserveInitialCapacity(length);
 
     for (size_t i = preCount; i > 0; --i)
         append(result, m_reversedPrecedingMarkup[i - 1]);
 
-    for (size_t i = 0; i < postCount; ++i)
-        append(result, m_succeedingMarkup[i]);
+    result.append(m_succeedingMarkup.data(), m_succeedingMarkup.size());
 
     return String::adopt(result);
 }
 
 void MarkupAccumulator::appendAttributeValue(Vector<UChar>& result, const String& attribute, bool escapeNBSP)
 {
-    const UChar* uchars = attribute.characters();
-    unsigned len = attribute.length();
-    unsigned lastCopiedFrom = 0;
-
-    DEFINE_STATIC_LOCAL(const String, ampEntity, ("&amp;"));
-    DEFINE_STATIC_LOCAL(const String, gtEntity, ("&gt;"));
-    DEFINE_STATIC_LOCAL(const String, ltEntity, ("&lt;"));
-    DEFINE_STATIC_LOCAL(const String, quotEntity, ("&quot;"));
-    DEFINE_STATIC_LOCAL(const String, nbspEntity, ("&nbsp;"));
-    
-    for (unsigned i = 0; i < len; ++i) {
-        UChar c = uchars[i];
-        switch (c) {
-        case '&':
-            result.append(uchars + lastCopiedFrom, i - lastCopiedFrom);
-            append(result, ampEntity);
-            lastCopiedFrom = i + 1;
-            break;
-        case '<':
-            result.append(uchars + lastCopiedFrom, i - lastCopiedFrom);
-            append(result, ltEntity);
-            lastCopiedFrom = i + 1;
-            break;
-        case '>':
-            result.append(uchars + lastCopiedFrom, i - lastCopiedFrom);
-            append(result, gtEntity);
-            lastCopiedFrom = i + 1;
-            break;
-        case '"':
-            result.append(uchars + lastCopiedFrom, i - lastCopiedFrom);
-            append(result, quotEntity);
-            lastCopiedFrom = i + 1;
-            break;
-        case noBreakSpace:
-            if (!escapeNBSP)
-                break;
-            result.append(uchars + lastCopiedFrom, i - lastCopiedFrom);
-            append(result, nbspEntity);
-            lastCopiedFrom = i + 1;
-        }
-    }
-    
-    result.append(uchars + lastCopiedFrom, len - lastCopiedFrom);
+    appendEscapedCharacters(result, attribute.characters(), attribute.length(), true, escapeNBSP);
 }
 
 static void appendEscapedContent(Vector<UChar>& result, pair<const UChar*, size_t> range, bool escapeNBSP)
 {
-    const UChar* uchars = range.first;
-    unsigned len = range.second;
-    unsigned lastCopiedFrom = 0;
-    
-    DEFINE_STATIC_LOCAL(const String, ampEntity, ("&amp;"));
-    DEFINE_STATIC_LOCAL(const String, gtEntity, ("&gt;"));
-    DEFINE_STATIC_LOCAL(const String, ltEntity, ("&lt;"));
-    DEFINE_STATIC_LOCAL(const String, nbspEntity, ("&nbsp;"));
-
-    for (unsigned i = 0; i < len; ++i) {
-        UChar c = uchars[i];
-        switch (c) {
-        case '&':
-            result.append(uchars + lastCopiedFrom, i - lastCopiedFrom);
-            append(result, ampEntity);
-            lastCopiedFrom = i + 1;
-            break;
-        case '<':
-            result.append(uchars + lastCopiedFrom, i - lastCopiedFrom);
-            append(result, ltEntity);
-            lastCopiedFrom = i + 1;
-            break;
-        case '>':
-            result.append(uchars + lastCopiedFrom, i - lastCopiedFrom);
-            append(result, gtEntity);
-            lastCopiedFrom = i + 1;
-            break;
-        case noBreakSpace:
-            if (!escapeNBSP)
-                break;
-            result.append(uchars + lastCopiedFrom, i - lastCopiedFrom);
-            append(result, nbspEntity);
-            lastCopiedFrom = i + 1;
-            break;
-        }
-    }
-    
-    result.append(uchars + lastCopiedFrom, len - lastCopiedFrom);
-}    
+    appendEscapedCharacters(result, range.first, range.second, false, escapeNBSP);
+}
 
 String MarkupAccumulator::escapeContentText(const String& in, bool escapeNBSP)
 {
@@ -515,9 +518,9 @@ void MarkupAccumulator::appendText(Vector<UChar>& out, Text* text)
 void MarkupAccumulator::appendComment(Vector<UChar>& out, const String& comment)
 {
     // FIXME: Comment content is not escaped, but XMLSerializer (and possibly other callers) should raise an exception if it includes "-->".
-    append(out, "<!--");
+    appendLiteral(out, "<!--");
     append(out, comment);
-    append(out, "-->");
+    appendLiteral(out, "-->");
 }
 
 void MarkupAccumulator::appendDocumentType(Vector<UChar>& result, const DocumentType* n)
@@ -525,38 +528,38 @@ void MarkupAccumulator::appendDocumentType(Vector<UChar>& result, const Document
     if (n->name().isEmpty())
         return;
 
-    append(result, "<!DOCTYPE ");
+    appendLiteral(result, "<!DOCTYPE ");
     append(result, n->name());
     if (!n->publicId().isEmpty()) {
-        append(result, " PUBLIC \"");
+        appendLiteral(result, " PUBLIC \"");
         append(result, n->publicId());
-        append(result, "\"");
+        result.append('"');
         if (!n->systemId().isEmpty()) {
-            append(result, " \"");
+            appendLiteral(result, " \"");
             append(result, n->systemId());
-            append(result, "\"");
+            result.append('"');
         }
     } else if (!n->systemId().isEmpty()) {
-        append(result, " SYSTEM \"");
+        appendLiteral(result, " SYSTEM \"");
         append(result, n->systemId());
-        append(result, "\"");
+        result.append('"');
     }
     if (!n->internalSubset().isEmpty()) {
-        append(result, " [");
+        appendLiteral(result, " [");
         append(result, n->internalSubset());
-        append(result, "]");
+        result.append(']');
     }
-    append(result, ">");
+    result.append('>');
 }
 
 void MarkupAccumulator::appendProcessingInstruction(Vector<UChar>& out, const String& target, const String& data)
 {
     // FIXME: PI data is not escaped, but XMLSerializer (and possibly other callers) this should raise an exception if it includes "?>".
-    append(out, "<?");
+    appendLiteral(out, "<?");
     append(out, target);
-    append(out, " ");
+    out.append(' ');
     append(out, data);
-    append(out, "?>");
+    appendLiteral(out, "?>");
 }
 
 void MarkupAccumulator::removeExteriorStyles(CSSMutableStyleDeclaration* style)
@@ -568,7 +571,7 @@ void MarkupAccumulator::appendElement(Vector<UChar>& out, Element* element, bool
 {
     bool documentIsHTML = element->document()->isHTMLDocument();
     out.append('<');
-    append(out, element->nodeNamePreservingCase());
+    appendQualifiedName(out, element->tagQName());
     if (!documentIsHTML && namespaces && shouldAddNamespaceElement(element))
         appendNamespace(out, element->prefix(), element->namespaceURI(), *namespaces);
 
@@ -584,7 +587,7 @@ void MarkupAccumulator::appendElement(Vector<UChar>& out, Element* element, bool
         if (documentIsHTML)
             append(out, attribute->name().localName());
         else
-            append(out, attribute->name().toString());
+            appendQualifiedName(out, attribute->name());
 
         out.append('=');
 
@@ -640,8 +643,7 @@ void MarkupAccumulator::appendElement(Vector<UChar>& out, Element* element, bool
         if (rangeFullySelectsNode == DoesNotFullySelectNode)
             removeExteriorStyles(style.get());
         if (style->length() > 0) {
-            DEFINE_STATIC_LOCAL(const String, stylePrefix, (" style=\""));
-            append(out, stylePrefix);
+            appendLiteral(out, " style=\"");
             appendAttributeValue(out, style->cssText(), documentIsHTML);
             out.append('\"');
         }
@@ -658,9 +660,9 @@ void MarkupAccumulator::appendElement(Vector<UChar>& out, Element* element, bool
 void MarkupAccumulator::appendCDATASection(Vector<UChar>& out, const String& section)
 {
     // FIXME: CDATA content is not escaped, but XMLSerializer (and possibly other callers) should raise an exception if it includes "]]>".
-    append(out, "<![CDATA[");
+    appendLiteral(out, "<![CDATA[");
     append(out, section);
-    append(out, "]]>");
+    appendLiteral(out, "]]>");
 }
 
 void MarkupAccumulator::appendStartMarkup(Vector<UChar>& result, const Node* node, bool convertBlocksToInlines, Namespaces* namespaces, RangeFullySelectsNode rangeFullySelectsNode)
@@ -735,7 +737,7 @@ void MarkupAccumulator::appendEndMarkup(Vector<UChar>& result, const Node* node)
 
     result.append('<');
     result.append('/');
-    append(result, static_cast<const Element*>(node)->nodeNamePreservingCase());
+    appendQualifiedName(result, static_cast<const Element*>(node)->tagQName());
     result.append('>');
 }
 
@@ -50,12 +50,12 @@ HTMLAnchorElement::HTMLAnchorElement(const QualifiedName& tagName, Document* doc
 
 PassRefPtr<HTMLAnchorElement> HTMLAnchorElement::create(Document* document)
 {
-    return adoptRef(new HTMLAnchorElement(aTag, document));
+    return adoptRef(new (document) HTMLAnchorElement(aTag, document));
 }
 
 PassRefPtr<HTMLAnchorElement> HTMLAnchorElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new HTMLAnchorElement(tagName, document));
+    return adoptRef(new (document) HTMLAnchorElement(tagName, document));
 }
 
 // This function does not allow leading spaces before the port number.
@@ -43,7 +43,7 @@ inline HTMLAppletElement::HTMLAppletElement(const QualifiedName& tagName, Docume
 
 PassRefPtr<HTMLAppletElement> HTMLAppletElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new HTMLAppletElement(tagName, document));
+    return adoptRef(new (document) HTMLAppletElement(tagName, document));
 }
 
 void HTMLAppletElement::parseMappedAttribute(Attribute* attr)
@@ -47,7 +47,7 @@ inline HTMLAreaElement::HTMLAreaElement(const QualifiedName& tagName, Document*
 
 PassRefPtr<HTMLAreaElement> HTMLAreaElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new HTMLAreaElement(tagName, document));
+    return adoptRef(new (document) HTMLAreaElement(tagName, document));
 }
 
 void HTMLAreaElement::parseMappedAttribute(Attribute* attr)
@@ -44,12 +44,12 @@ HTMLAudioElement::HTMLAudioElement(const QualifiedName& tagName, Document* docum
 
 PassRefPtr<HTMLAudioElement> HTMLAudioElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new HTMLAudioElement(tagName, document));
+    return adoptRef(new (document) HTMLAudioElement(tagName, document));
 }
 
 PassRefPtr<HTMLAudioElement> HTMLAudioElement::createForJSConstructor(Document* document, const String& src)
 {
-    RefPtr<HTMLAudioElement> audio = adoptRef(new HTMLAudioElement(audioTag, document));
+    RefPtr<HTMLAudioElement> audio = adoptRef(new (document) HTMLAudioElement(audioTag, document));
 	int worldID = 0;
 	V8IsolatedContext* isolatedContext = V8IsolatedContext::getEntered();
 	if (isolatedContext!=0) worldID = isolatedContext->getWorldID();
@@ -37,7 +37,7 @@ inline HTMLBaseFontElement::HTMLBaseFontElement(const QualifiedName& tagName, Do
 
 PassRefPtr<HTMLBaseFontElement> HTMLBaseFontElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new HTMLBaseFontElement(tagName, document));
+    return adoptRef(new (document) HTMLBaseFontElement(tagName, document));
 }
 
 }
@@ -50,7 +50,7 @@ inline HTMLButtonElement::HTMLButtonElement(const QualifiedName& tagName, Docume
 
 PassRefPtr<HTMLButtonElement> HTMLButtonElement::create(const QualifiedName& tagName, Document* document, HTMLFormElement* form)
 {
-    return adoptRef(new HTMLButtonElement(tagName, document, form));
+    return adoptRef(new (document) HTMLButtonElement(tagName, document, form));
 }
 
 RenderObject* HTMLButtonElement::createRenderer(RenderArena* arena, RenderStyle*)
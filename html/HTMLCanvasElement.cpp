@@ -83,12 +83,12 @@ HTMLCanvasElement::HTMLCanvasElement(const QualifiedName& tagName, Document* doc
 
 PassRefPtr<HTMLCanvasElement> HTMLCanvasElement::create(Document* document)
 {
-    return adoptRef(new HTMLCanvasElement(canvasTag, document));
+    return adoptRef(new (document) HTMLCanvasElement(canvasTag, document));
 }
 
 PassRefPtr<HTMLCanvasElement> HTMLCanvasElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new HTMLCanvasElement(tagName, document));
+    return adoptRef(new (document) HTMLCanvasElement(tagName, document));
 }
 
 HTMLCanvasElement::~HTMLCanvasElement()
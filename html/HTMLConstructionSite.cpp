@@ -53,6 +53,7 @@
 #endif
 #include "ScriptController.h"
 #include "Settings.h"
+#include "SharedAttributeCache.h"
 #include "Text.h"
 #include <wtf/UnusedParam.h>
 
@@ -375,6 +376,9 @@ PassRefPtr<Element> HTMLConstructionSite::createHTMLElement(AtomicHTMLToken& tok
 			element->setAttribute(ROACLname.c_str(),aclid.c_str(),ec,worldID,false);
 		}
 	}
+    // Share only once the attributes are final; setting one copies a shared set.
+    if (SharedAttributeCache* cache = m_document->sharedAttributeCache())
+        cache->shareAttributes(element.get());
     return element.release();
 }
 
@@ -394,7 +398,7 @@ PassRefPtr<NamedNodeMap> cloneAttributes(Element* element)
     RefPtr<NamedNodeMap> newAttributes = NamedNodeMap::create();
     for (size_t i = 0; i < attributes->length(); ++i) {
         Attribute* attribute = attributes->attributeItem(i);
-        RefPtr<Attribute> clone = Attribute::createMapped(attribute->name(), attribute->value());
+        RefPtr<Attribute> clone = Attribute::createMapped(attribute->name(), attribute->value(), element->document()->domArena());
         newAttributes->addAttribute(clone);
     }
     return newAttributes.release();
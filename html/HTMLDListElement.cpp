@@ -37,7 +37,7 @@ inline HTMLDListElement::HTMLDListElement(const QualifiedName& tagName, Document
 
 PassRefPtr<HTMLDListElement> HTMLDListElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new HTMLDListElement(tagName, document));
+    return adoptRef(new (document) HTMLDListElement(tagName, document));
 }
 
 }
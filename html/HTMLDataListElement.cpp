@@ -44,7 +44,7 @@ inline HTMLDataListElement::HTMLDataListElement(const QualifiedName& tagName, Do
 
 PassRefPtr<HTMLDataListElement> HTMLDataListElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new HTMLDataListElement(tagName, document));
+    return adoptRef(new (document) HTMLDataListElement(tagName, document));
 }
 
 PassRefPtr<HTMLCollection> HTMLDataListElement::options()
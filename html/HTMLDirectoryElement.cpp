@@ -37,7 +37,7 @@ inline HTMLDirectoryElement::HTMLDirectoryElement(const QualifiedName& tagName,
 
 PassRefPtr<HTMLDirectoryElement> HTMLDirectoryElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new HTMLDirectoryElement(tagName, document));
+    return adoptRef(new (document) HTMLDirectoryElement(tagName, document));
 }
 
 }
@@ -35,6 +35,10 @@ class HTMLElement;
 
 class HTMLDocument : public Document, public CachedResourceClient {
 public:
+    // CachedResourceClient brings in the fastMalloc allocation functions too; nodes use the DOM arena.
+    using Node::operator new;
+    using Node::operator delete;
+
     static PassRefPtr<HTMLDocument> create(Frame* frame, const KURL& url)
     {
         return adoptRef(new HTMLDocument(frame, url));
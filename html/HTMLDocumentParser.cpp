@@ -30,12 +30,14 @@
 #include "Element.h"
 #include "Frame.h"
 #include "HTMLNames.h"
+#include "HTMLFastFragmentParser.h"
 #include "HTMLParserScheduler.h"
 #include "HTMLTokenizer.h"
 #include "HTMLPreloadScanner.h"
 #include "HTMLScriptRunner.h"
 #include "HTMLTreeBuilder.h"
 #include "HTMLDocument.h"
+#include "PhaseTracer.h"
 #include "XSSAuditor.h"
 #include "V8IsolatedContext.h"
 #include <sstream>
@@ -202,6 +204,8 @@ void HTMLDocumentParser::pumpTokenizer(SynchronousMode mode)
     // ASSERT that this object is both attached to the Document and protected.
     ASSERT(refCount() >= 2);
 
+    PhaseTraceScope traceScope(PhaseTracer::ParsingPhase);
+
     // We tell the InspectorTimelineAgent about every pump, even if we
     // end up pumping nothing.  It can filter out empty pumps itself.
     willPumpLexer();
@@ -498,6 +502,9 @@ ScriptController* HTMLDocumentParser::script() const
 
 void HTMLDocumentParser::parseDocumentFragment(const String& source, DocumentFragment* fragment, Element* contextElement, FragmentScriptingPermission scriptingPermission)
 {
+    if (HTMLFastFragmentParser::parse(source, fragment, contextElement, scriptingPermission))
+        return;
+
     RefPtr<HTMLDocumentParser> parser = HTMLDocumentParser::create(fragment, contextElement, scriptingPermission);
     parser->insert(source); // Use insert() so that the parser will not yield.
     parser->finish();
@@ -57,7 +57,7 @@ using std::max;
 
 PassRefPtr<HTMLElement> HTMLElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new HTMLElement(tagName, document));
+    return adoptRef(new (document) HTMLElement(tagName, document));
 }
 
 String HTMLElement::nodeName() const
@@ -0,0 +1,278 @@
+/*
+ * Copyright (C) 2026 The WebKit Authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.h"
+#include "HTMLFastFragmentParser.h"
+
+#include "Comment.h"
+#include "DocumentFragment.h"
+#include "Element.h"
+#include "HTMLElementFactory.h"
+#include "HTMLFormElement.h"
+#include "HTMLInputStream.h"
+#include "HTMLNames.h"
+#include "HTMLToken.h"
+#include "HTMLTokenizer.h"
+#include "NamedNodeMap.h"
+#include "SharedAttributeCache.h"
+#include "Text.h"
+#include "V8IsolatedContext.h"
+#include <wtf/HashMap.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/StdLibExtras.h>
+
+namespace WebCore {
+
+using namespace HTMLNames;
+
+enum FastPathTagFlags {
+    // Elements the fast path creates.
+    AllowedTag = 1 << 0,
+    // Elements whose start tag closes an open <p>.
+    ClosesParagraphTag = 1 << 1,
+    VoidTag = 1 << 2,
+    HeadingTag = 1 << 3,
+    // Context elements whose children are parsed in the "in body" insertion mode and the data state.
+    AllowedContextTag = 1 << 4
+};
+
+typedef HashMap<AtomicStringImpl*, unsigned> TagFlagMap;
+
+static void addTag(TagFlagMap& map, const QualifiedName& tag, unsigned flags)
+{
+    map.set(tag.localName().impl(), flags);
+}
+
+static unsigned tagFlags(const AtomicString& localName)
+{
+    DEFINE_STATIC_LOCAL(TagFlagMap, map, ());
+    if (map.isEmpty()) {
+        const unsigned phrasing = AllowedTag | AllowedContextTag;
+        const unsigned block = AllowedTag | ClosesParagraphTag | AllowedContextTag;
+        const unsigned heading = block | HeadingTag;
+
+        addTag(map, aTag, phrasing);
+        addTag(map, abbrTag, phrasing);
+        addTag(map, bTag, phrasing);
+        addTag(map, citeTag, phrasing);
+        addTag(map, codeTag, phrasing);
+        addTag(map, emTag, phrasing);
+        addTag(map, iTag, phrasing);
+        addTag(map, sTag, phrasing);
+        addTag(map, smallTag, phrasing);
+        addTag(map, spanTag, phrasing);
+        addTag(map, strongTag, phrasing);
+        addTag(map, subTag, phrasing);
+        addTag(map, supTag, phrasing);
+        addTag(map, uTag, phrasing);
+
+        addTag(map, articleTag, block);
+        addTag(map, asideTag, block);
+        addTag(map, blockquoteTag, block);
+        addTag(map, divTag, block);
+        addTag(map, footerTag, block);
+        addTag(map, headerTag, block);
+        addTag(map, liTag, block);
+        addTag(map, navTag, block);
+        addTag(map, olTag, block);
+        addTag(map, pTag, block);
+        addTag(map, sectionTag, block);
+        addTag(map, ulTag, block);
+        addTag(map, h1Tag, heading);
+        addTag(map, h2Tag, heading);
+        addTag(map, h3Tag, heading);
+        addTag(map, h4Tag, heading);
+        addTag(map, h5Tag, heading);
+        addTag(map, h6Tag, heading);
+
+        addTag(map, brTag, AllowedTag | VoidTag);
+        addTag(map, imgTag, AllowedTag | VoidTag);
+        addTag(map, hrTag, AllowedTag | VoidTag | ClosesParagraphTag);
+
+        addTag(map, bodyTag, AllowedContextTag);
+        addTag(map, tdTag, AllowedContextTag);
+        addTag(map, thTag, AllowedContextTag);
+    }
+    return map.get(localName.impl());
+}
+
+static HTMLFormElement* closestFormAncestor(Element* element)
+{
+    for (Node* node = element; node && node->isElementNode(); node = node->parentNode()) {
+        if (node->hasTagName(formTag))
+            return static_cast<HTMLFormElement*>(node);
+    }
+    return 0;
+}
+
+bool HTMLFastFragmentParser::parse(const String& source, DocumentFragment* fragment, Element* contextElement, FragmentScriptingPermission scriptingPermission)
+{
+    if (!contextElement || !contextElement->isHTMLElement() || !(tagFlags(contextElement->localName()) & AllowedContextTag))
+        return false;
+    if (!fragment->document()->isHTMLDocument())
+        return false;
+    // Elements parsed in an isolated world get their access control attributes from the tree builder.
+    if (V8IsolatedContext::getEntered())
+        return false;
+
+    HTMLFastFragmentParser parser(fragment, closestFormAncestor(contextElement), scriptingPermission);
+    if (parser.parse(source))
+        return true;
+    fragment->removeChildren();
+    return false;
+}
+
+HTMLFastFragmentParser::HTMLFastFragmentParser(DocumentFragment* fragment, HTMLFormElement* form, FragmentScriptingPermission scriptingPermission)
+    : m_document(fragment->document())
+    , m_fragment(fragment)
+    , m_form(form)
+    , m_scriptingPermission(scriptingPermission)
+{
+}
+
+bool HTMLFastFragmentParser::parse(const String& source)
+{
+    HTMLInputStream input;
+    input.appendToEnd(SegmentedString(source));
+    input.markEndOfFile();
+
+    OwnPtr<HTMLTokenizer> tokenizer = HTMLTokenizer::create();
+    HTMLToken token;
+    while (tokenizer->nextToken(input.current(), token)) {
+        AtomicHTMLToken atomicToken(token);
+        bool processed = true;
+        switch (atomicToken.type()) {
+        case HTMLToken::StartTag:
+            processed = processStartTag(atomicToken);
+            break;
+        case HTMLToken::EndTag:
+            processed = processEndTag(atomicToken);
+            break;
+        case HTMLToken::Character:
+            processCharacters(atomicToken);
+            break;
+        case HTMLToken::Comment:
+            processComment(atomicToken);
+            break;
+        case HTMLToken::EndOfFile:
+            // Like the tree builder, leave elements that were never closed where they are.
+            while (!m_openElements.isEmpty()) {
+                m_openElements.last()->finishParsingChildren();
+                m_openElements.removeLast();
+            }
+            return true;
+        case HTMLToken::DOCTYPE:
+        case HTMLToken::Uninitialized:
+            return false;
+        }
+        if (!processed)
+            return false;
+        // The character token refers to the characters of |token|; only let go of them now.
+        token.clear();
+    }
+    ASSERT_NOT_REACHED();
+    return false;
+}
+
+ContainerNode* HTMLFastFragmentParser::currentNode() const
+{
+    if (m_openElements.isEmpty())
+        return m_fragment;
+    return m_openElements.last().get();
+}
+
+bool HTMLFastFragmentParser::hasOpenElement(const AtomicString& localName) const
+{
+    for (size_t i = 0; i < m_openElements.size(); ++i) {
+        if (m_openElements[i]->hasLocalName(localName))
+            return true;
+    }
+    return false;
+}
+
+bool HTMLFastFragmentParser::processStartTag(AtomicHTMLToken& token)
+{
+    const AtomicString& name = token.name();
+    unsigned flags = tagFlags(name);
+    if (!(flags & AllowedTag))
+        return false;
+
+    // Anything that would make the tree builder close an open element goes the slow way.
+    if ((flags & ClosesParagraphTag) && hasOpenElement(pTag.localName()))
+        return false;
+    if (name == aTag && hasOpenElement(aTag.localName()))
+        return false;
+    Element* current = m_openElements.isEmpty() ? 0 : m_openElements.last().get();
+    if (current && (flags & HeadingTag) && (tagFlags(current->localName()) & HeadingTag))
+        return false;
+    if (current && name == liTag && !current->hasLocalName(ulTag) && !current->hasLocalName(olTag))
+        return false;
+
+    RefPtr<Element> element = HTMLElementFactory::createHTMLElement(QualifiedName(nullAtom, name, xhtmlNamespaceURI), m_document, m_form, true);
+    element->setAttributeMap(token.takeAtributes(), m_scriptingPermission);
+    if (SharedAttributeCache* cache = m_document->sharedAttributeCache())
+        cache->shareAttributes(element.get());
+    currentNode()->parserAddChild(element);
+
+    if (flags & VoidTag) {
+        element->finishParsingChildren();
+        return true;
+    }
+    element->beginParsingChildren();
+    m_openElements.append(element.release());
+    return true;
+}
+
+bool HTMLFastFragmentParser::processEndTag(AtomicHTMLToken& token)
+{
+    // Only the end tag of the current element is simple; anything else means implied end tags,
+    // misnested formatting elements or a stray end tag.
+    if (m_openElements.isEmpty() || !m_openElements.last()->hasLocalName(token.name()))
+        return false;
+    m_openElements.last()->finishParsingChildren();
+    m_openElements.removeLast();
+    return true;
+}
+
+void HTMLFastFragmentParser::processCharacters(AtomicHTMLToken& token)
+{
+    const HTMLToken::DataVector& characters = token.characters();
+    String text(characters.data(), characters.size());
+
+    ContainerNode* parent = currentNode();
+    Node* lastChild = parent->lastChild();
+    if (lastChild && lastChild->isTextNode()) {
+        static_cast<CharacterData*>(lastChild)->parserAppendData(text);
+        return;
+    }
+    parent->parserAddChild(Text::create(m_document, text));
+}
+
+void HTMLFastFragmentParser::processComment(AtomicHTMLToken& token)
+{
+    currentNode()->parserAddChild(Comment::create(m_document, token.comment()));
+}
+
+} // namespace WebCore
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2026 The WebKit Authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef HTMLFastFragmentParser_h
+#define HTMLFastFragmentParser_h
+
+#include "FragmentScriptingPermission.h"
+#include <wtf/Noncopyable.h>
+#include <wtf/RefPtr.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+class AtomicHTMLToken;
+class AtomicString;
+class ContainerNode;
+class Document;
+class DocumentFragment;
+class Element;
+class HTMLFormElement;
+class String;
+
+// Builds the nodes of an HTML fragment straight from the tokenizer, without the dummy document
+// and tree builder that HTMLDocumentParser sets up for every fragment. Only markup whose tree
+// the tree builder would build exactly as written is handled: a fixed set of phrasing and
+// block elements, properly nested, with no tag that implies closing another one. Everything
+// else (scripts, styles, tables, forms, misnesting) makes parse() give up.
+class HTMLFastFragmentParser : public Noncopyable {
+public:
+    // Returns false, with the fragment left empty, when the full parser has to be used.
+    static bool parse(const String& source, DocumentFragment*, Element* contextElement, FragmentScriptingPermission);
+
+private:
+    HTMLFastFragmentParser(DocumentFragment*, HTMLFormElement*, FragmentScriptingPermission);
+
+    bool parse(const String& source);
+    bool processStartTag(AtomicHTMLToken&);
+    bool processEndTag(AtomicHTMLToken&);
+    void processCharacters(AtomicHTMLToken&);
+    void processComment(AtomicHTMLToken&);
+
+    ContainerNode* currentNode() const;
+    bool hasOpenElement(const AtomicString& localName) const;
+
+    Document* m_document;
+    DocumentFragment* m_fragment;
+    HTMLFormElement* m_form;
+    FragmentScriptingPermission m_scriptingPermission;
+    Vector<RefPtr<Element> > m_openElements;
+};
+
+} // namespace WebCore
+
+#endif // HTMLFastFragmentParser_h
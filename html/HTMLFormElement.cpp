@@ -78,12 +78,12 @@ HTMLFormElement::HTMLFormElement(const QualifiedName& tagName, Document* documen
 
 PassRefPtr<HTMLFormElement> HTMLFormElement::create(Document* document)
 {
-    return adoptRef(new HTMLFormElement(formTag, document));
+    return adoptRef(new (document) HTMLFormElement(formTag, document));
 }
 
 PassRefPtr<HTMLFormElement> HTMLFormElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new HTMLFormElement(tagName, document));
+    return adoptRef(new (document) HTMLFormElement(tagName, document));
 }
 
 HTMLFormElement::~HTMLFormElement()
@@ -45,7 +45,7 @@ inline HTMLFrameElement::HTMLFrameElement(const QualifiedName& tagName, Document
 
 PassRefPtr<HTMLFrameElement> HTMLFrameElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new HTMLFrameElement(tagName, document));
+    return adoptRef(new (document) HTMLFrameElement(tagName, document));
 }
 
 bool HTMLFrameElement::rendererIsNeeded(RenderStyle*)
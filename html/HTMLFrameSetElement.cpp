@@ -56,7 +56,7 @@ HTMLFrameSetElement::HTMLFrameSetElement(const QualifiedName& tagName, Document*
 
 PassRefPtr<HTMLFrameSetElement> HTMLFrameSetElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new HTMLFrameSetElement(tagName, document));
+    return adoptRef(new (document) HTMLFrameSetElement(tagName, document));
 }
 
 bool HTMLFrameSetElement::mapToEntry(const QualifiedName& attrName, MappedAttributeEntry& result) const
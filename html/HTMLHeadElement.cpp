@@ -39,12 +39,12 @@ HTMLHeadElement::HTMLHeadElement(const QualifiedName& tagName, Document* documen
 
 PassRefPtr<HTMLHeadElement> HTMLHeadElement::create(Document* document)
 {
-    return adoptRef(new HTMLHeadElement(headTag, document));
+    return adoptRef(new (document) HTMLHeadElement(headTag, document));
 }
 
 PassRefPtr<HTMLHeadElement> HTMLHeadElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new HTMLHeadElement(tagName, document));
+    return adoptRef(new (document) HTMLHeadElement(tagName, document));
 }
 
 }
@@ -32,7 +32,7 @@ inline HTMLHeadingElement::HTMLHeadingElement(const QualifiedName& tagName, Docu
 
 PassRefPtr<HTMLHeadingElement> HTMLHeadingElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new HTMLHeadingElement(tagName, document));
+    return adoptRef(new (document) HTMLHeadingElement(tagName, document));
 }
 
 }
@@ -42,12 +42,12 @@ HTMLHtmlElement::HTMLHtmlElement(const QualifiedName& tagName, Document* documen
 
 PassRefPtr<HTMLHtmlElement> HTMLHtmlElement::create(Document* document)
 {
-    return adoptRef(new HTMLHtmlElement(htmlTag, document));
+    return adoptRef(new (document) HTMLHtmlElement(htmlTag, document));
 }
 
 PassRefPtr<HTMLHtmlElement> HTMLHtmlElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new HTMLHtmlElement(tagName, document));
+    return adoptRef(new (document) HTMLHtmlElement(tagName, document));
 }
 
 #if ENABLE(OFFLINE_WEB_APPLICATIONS)
@@ -44,7 +44,7 @@ inline HTMLIFrameElement::HTMLIFrameElement(const QualifiedName& tagName, Docume
 
 PassRefPtr<HTMLIFrameElement> HTMLIFrameElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new HTMLIFrameElement(tagName, document));
+    return adoptRef(new (document) HTMLIFrameElement(tagName, document));
 }
 
 bool HTMLIFrameElement::mapToEntry(const QualifiedName& attrName, MappedAttributeEntry& result) const
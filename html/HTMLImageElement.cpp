@@ -57,12 +57,12 @@ HTMLImageElement::HTMLImageElement(const QualifiedName& tagName, Document* docum
 
 PassRefPtr<HTMLImageElement> HTMLImageElement::create(Document* document)
 {
-    return adoptRef(new HTMLImageElement(imgTag, document));
+    return adoptRef(new (document) HTMLImageElement(imgTag, document));
 }
 
 PassRefPtr<HTMLImageElement> HTMLImageElement::create(const QualifiedName& tagName, Document* document, HTMLFormElement* form)
 {
-    return adoptRef(new HTMLImageElement(tagName, document, form));
+    return adoptRef(new (document) HTMLImageElement(tagName, document, form));
 }
 
 HTMLImageElement::~HTMLImageElement()
@@ -73,7 +73,7 @@ HTMLImageElement::~HTMLImageElement()
 
 PassRefPtr<HTMLImageElement> HTMLImageElement::createForJSConstructor(Document* document, const int* optionalWidth, const int* optionalHeight)
 {
-    RefPtr<HTMLImageElement> image = adoptRef(new HTMLImageElement(imgTag, document));
+    RefPtr<HTMLImageElement> image = adoptRef(new (document) HTMLImageElement(imgTag, document));
 	//image element should have the ACL/ROACL property
 	int worldID = 0;
 	V8IsolatedContext* isolatedContext = V8IsolatedContext::getEntered();
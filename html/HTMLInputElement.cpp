@@ -136,7 +136,7 @@ HTMLInputElement::HTMLInputElement(const QualifiedName& tagName, Document* docum
 
 PassRefPtr<HTMLInputElement> HTMLInputElement::create(const QualifiedName& tagName, Document* document, HTMLFormElement* form)
 {
-    return adoptRef(new HTMLInputElement(tagName, document, form));
+    return adoptRef(new (document) HTMLInputElement(tagName, document, form));
 }
 
 HTMLInputElement::~HTMLInputElement()
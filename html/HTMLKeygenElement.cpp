@@ -58,7 +58,7 @@ inline HTMLKeygenElement::HTMLKeygenElement(const QualifiedName& tagName, Docume
 
 PassRefPtr<HTMLKeygenElement> HTMLKeygenElement::create(const QualifiedName& tagName, Document* document, HTMLFormElement* form)
 {
-    return adoptRef(new HTMLKeygenElement(tagName, document, form));
+    return adoptRef(new (document) HTMLKeygenElement(tagName, document, form));
 }
 
 const AtomicString& HTMLKeygenElement::formControlType() const
@@ -40,7 +40,7 @@ inline HTMLLegendElement::HTMLLegendElement(const QualifiedName& tagName, Docume
 
 PassRefPtr<HTMLLegendElement> HTMLLegendElement::create(const QualifiedName& tagName, Document* document, HTMLFormElement* form)
 {
-    return adoptRef(new HTMLLegendElement(tagName, document, form));
+    return adoptRef(new (document) HTMLLegendElement(tagName, document, form));
 }
 
 bool HTMLLegendElement::supportsFocus() const
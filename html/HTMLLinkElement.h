@@ -35,6 +35,10 @@ class KURL;
 
 class HTMLLinkElement : public HTMLElement, public CachedResourceClient {
 public:
+    // CachedResourceClient brings in the fastMalloc allocation functions too; nodes use the DOM arena.
+    using Node::operator new;
+    using Node::operator delete;
+
     struct RelAttribute {
         bool m_isStyleSheet;
         bool m_isIcon;
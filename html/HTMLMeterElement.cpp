@@ -46,7 +46,7 @@ HTMLMeterElement::HTMLMeterElement(const QualifiedName& tagName, Document* docum
 
 PassRefPtr<HTMLMeterElement> HTMLMeterElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new HTMLMeterElement(tagName, document));
+    return adoptRef(new (document) HTMLMeterElement(tagName, document));
 }
 
 RenderObject* HTMLMeterElement::createRenderer(RenderArena* arena, RenderStyle*)
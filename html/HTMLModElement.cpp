@@ -36,7 +36,7 @@ inline HTMLModElement::HTMLModElement(const QualifiedName& tagName, Document* do
 
 PassRefPtr<HTMLModElement> HTMLModElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new HTMLModElement(tagName, document));
+    return adoptRef(new (document) HTMLModElement(tagName, document));
 }
 
 }
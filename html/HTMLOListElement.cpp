@@ -42,12 +42,12 @@ HTMLOListElement::HTMLOListElement(const QualifiedName& tagName, Document* docum
 
 PassRefPtr<HTMLOListElement> HTMLOListElement::create(Document* document)
 {
-    return adoptRef(new HTMLOListElement(olTag, document));
+    return adoptRef(new (document) HTMLOListElement(olTag, document));
 }
 
 PassRefPtr<HTMLOListElement> HTMLOListElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new HTMLOListElement(tagName, document));
+    return adoptRef(new (document) HTMLOListElement(tagName, document));
 }
 
 bool HTMLOListElement::mapToEntry(const QualifiedName& attrName, MappedAttributeEntry& result) const
@@ -53,18 +53,18 @@ HTMLOptionElement::HTMLOptionElement(const QualifiedName& tagName, Document* doc
 
 PassRefPtr<HTMLOptionElement> HTMLOptionElement::create(Document* document, HTMLFormElement* form)
 {
-    return adoptRef(new HTMLOptionElement(optionTag, document, form));
+    return adoptRef(new (document) HTMLOptionElement(optionTag, document, form));
 }
 
 PassRefPtr<HTMLOptionElement> HTMLOptionElement::create(const QualifiedName& tagName, Document* document, HTMLFormElement* form)
 {
-    return adoptRef(new HTMLOptionElement(tagName, document, form));
+    return adoptRef(new (document) HTMLOptionElement(tagName, document, form));
 }
 
 PassRefPtr<HTMLOptionElement> HTMLOptionElement::createForJSConstructor(Document* document, const String& data, const String& value,
         bool defaultSelected, bool selected, ExceptionCode& ec)
 {
-    RefPtr<HTMLOptionElement> element = adoptRef(new HTMLOptionElement(optionTag, document));
+    RefPtr<HTMLOptionElement> element = adoptRef(new (document) HTMLOptionElement(optionTag, document));
 	int worldID = 0;
 	V8IsolatedContext* isolatedContext = V8IsolatedContext::getEntered();
 	if (isolatedContext!=0) worldID = isolatedContext->getWorldID();
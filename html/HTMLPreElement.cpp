@@ -39,7 +39,7 @@ inline HTMLPreElement::HTMLPreElement(const QualifiedName& tagName, Document* do
 
 PassRefPtr<HTMLPreElement> HTMLPreElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new HTMLPreElement(tagName, document));
+    return adoptRef(new (document) HTMLPreElement(tagName, document));
 }
 
 bool HTMLPreElement::mapToEntry(const QualifiedName& attrName, MappedAttributeEntry& result) const
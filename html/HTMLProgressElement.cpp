@@ -44,7 +44,7 @@ HTMLProgressElement::HTMLProgressElement(const QualifiedName& tagName, Document*
 
 PassRefPtr<HTMLProgressElement> HTMLProgressElement::create(const QualifiedName& tagName, Document* document, HTMLFormElement* form)
 {
-    return adoptRef(new HTMLProgressElement(tagName, document, form));
+    return adoptRef(new (document) HTMLProgressElement(tagName, document, form));
 }
 
 RenderObject* HTMLProgressElement::createRenderer(RenderArena* arena, RenderStyle*)
@@ -46,7 +46,7 @@ inline HTMLScriptElement::HTMLScriptElement(const QualifiedName& tagName, Docume
 
 PassRefPtr<HTMLScriptElement> HTMLScriptElement::create(const QualifiedName& tagName, Document* document, bool createdByParser)
 {
-    return adoptRef(new HTMLScriptElement(tagName, document, createdByParser));
+    return adoptRef(new (document) HTMLScriptElement(tagName, document, createdByParser));
 }
 
 bool HTMLScriptElement::isURLAttribute(Attribute* attr) const
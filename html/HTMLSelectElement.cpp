@@ -56,7 +56,7 @@ HTMLSelectElement::HTMLSelectElement(const QualifiedName& tagName, Document* doc
 PassRefPtr<HTMLSelectElement> HTMLSelectElement::create(const QualifiedName& tagName, Document* document, HTMLFormElement* form)
 {
     ASSERT(tagName.matches(selectTag));
-    return adoptRef(new HTMLSelectElement(tagName, document, form));
+    return adoptRef(new (document) HTMLSelectElement(tagName, document, form));
 }
 
 void HTMLSelectElement::recalcStyle(StyleChange change)
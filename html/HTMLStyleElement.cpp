@@ -43,7 +43,7 @@ inline HTMLStyleElement::HTMLStyleElement(const QualifiedName& tagName, Document
 
 PassRefPtr<HTMLStyleElement> HTMLStyleElement::create(const QualifiedName& tagName, Document* document, bool createdByParser)
 {
-    return adoptRef(new HTMLStyleElement(tagName, document, createdByParser));
+    return adoptRef(new (document) HTMLStyleElement(tagName, document, createdByParser));
 }
 
 void HTMLStyleElement::parseMappedAttribute(Attribute* attr)
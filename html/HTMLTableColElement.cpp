@@ -44,7 +44,7 @@ inline HTMLTableColElement::HTMLTableColElement(const QualifiedName& tagName, Do
 
 PassRefPtr<HTMLTableColElement> HTMLTableColElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new HTMLTableColElement(tagName, document));
+    return adoptRef(new (document) HTMLTableColElement(tagName, document));
 }
 
 bool HTMLTableColElement::mapToEntry(const QualifiedName& attrName, MappedAttributeEntry& result) const
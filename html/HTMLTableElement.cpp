@@ -56,12 +56,12 @@ HTMLTableElement::HTMLTableElement(const QualifiedName& tagName, Document* docum
 
 PassRefPtr<HTMLTableElement> HTMLTableElement::create(Document* document)
 {
-    return adoptRef(new HTMLTableElement(tableTag, document));
+    return adoptRef(new (document) HTMLTableElement(tableTag, document));
 }
 
 PassRefPtr<HTMLTableElement> HTMLTableElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new HTMLTableElement(tagName, document));
+    return adoptRef(new (document) HTMLTableElement(tagName, document));
 }
 
 HTMLTableCaptionElement* HTMLTableElement::caption() const
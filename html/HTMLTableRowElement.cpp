@@ -47,12 +47,12 @@ HTMLTableRowElement::HTMLTableRowElement(const QualifiedName& tagName, Document*
 
 PassRefPtr<HTMLTableRowElement> HTMLTableRowElement::create(Document* document)
 {
-    return adoptRef(new HTMLTableRowElement(trTag, document));
+    return adoptRef(new (document) HTMLTableRowElement(trTag, document));
 }
 
 PassRefPtr<HTMLTableRowElement> HTMLTableRowElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new HTMLTableRowElement(tagName, document));
+    return adoptRef(new (document) HTMLTableRowElement(tagName, document));
 }
 
 int HTMLTableRowElement::rowIndex() const
@@ -45,7 +45,7 @@ inline HTMLTableSectionElement::HTMLTableSectionElement(const QualifiedName& tag
 
 PassRefPtr<HTMLTableSectionElement> HTMLTableSectionElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new HTMLTableSectionElement(tagName, document));
+    return adoptRef(new (document) HTMLTableSectionElement(tagName, document));
 }
 
 // used by table row groups to share style decls created by the enclosing table.
@@ -41,7 +41,7 @@ inline HTMLTitleElement::HTMLTitleElement(const QualifiedName& tagName, Document
 
 PassRefPtr<HTMLTitleElement> HTMLTitleElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new HTMLTitleElement(tagName, document));
+    return adoptRef(new (document) HTMLTitleElement(tagName, document));
 }
 
 void HTMLTitleElement::insertedIntoDocument()
@@ -354,7 +354,7 @@ private:
 // exiting HTMLToken to be internal to the HTMLTokenizer.
 class AtomicHTMLToken : public Noncopyable {
 public:
-    AtomicHTMLToken(HTMLToken& token)
+    AtomicHTMLToken(HTMLToken& token, DOMArena* attributeArena)
         : m_type(token.type())
     {
         switch (m_type) {
@@ -381,7 +381,7 @@ public:
                     ASSERT(iter->m_nameRange.m_end);
                     ASSERT(iter->m_valueRange.m_start);
                     ASSERT(iter->m_valueRange.m_end);
-                    RefPtr<Attribute> mappedAttribute = Attribute::createMapped(name, value);
+                    RefPtr<Attribute> mappedAttribute = Attribute::createMapped(name, value, attributeArena);
                     if (!m_attributes) {
                         m_attributes = NamedNodeMap::create();
                         // Reserving capacity here improves the parser
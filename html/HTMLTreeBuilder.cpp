@@ -425,8 +425,42 @@ HTMLTreeBuilder::FragmentParsingContext::FragmentParsingContext()
 {
 }
 
+// Creating a document is a good part of the cost of parsing a small fragment. With a context
+// element, the tree builder resets the parse mode of the dummy document and only ever leaves
+// an <html> element in it, so those documents are emptied and kept for the next fragment.
+static const size_t maximumPooledDummyDocuments = 4;
+
+static Vector<RefPtr<Document> >& dummyDocumentPool()
+{
+    DEFINE_STATIC_LOCAL(Vector<RefPtr<Document> >, pool, ());
+    return pool;
+}
+
+static PassRefPtr<Document> createDummyDocumentForFragmentParsing(Element* contextElement)
+{
+    Vector<RefPtr<Document> >& pool = dummyDocumentPool();
+    if (!contextElement || pool.isEmpty())
+        return HTMLDocument::create(0, KURL());
+    RefPtr<Document> document = pool.last().release();
+    pool.removeLast();
+    return document.release();
+}
+
+static void recycleDummyDocumentForFragmentParsing(PassRefPtr<Document> prpDocument)
+{
+    RefPtr<Document> document = prpDocument;
+    Vector<RefPtr<Document> >& pool = dummyDocumentPool();
+    if (pool.size() >= maximumPooledDummyDocuments)
+        return;
+    // If anything else still refers to the document it must not see it emptied or reused.
+    if (!document->hasOneRef())
+        return;
+    document->removeChildren();
+    pool.append(document.release());
+}
+
 HTMLTreeBuilder::FragmentParsingContext::FragmentParsingContext(DocumentFragment* fragment, Element* contextElement, FragmentScriptingPermission scriptingPermission)
-    : m_dummyDocumentForFragmentParsing(HTMLDocument::create(0, KURL()))
+    : m_dummyDocumentForFragmentParsing(createDummyDocumentForFragmentParsing(contextElement))
     , m_fragment(fragment)
     , m_contextElement(contextElement)
     , m_scriptingPermission(scriptingPermission)
@@ -458,6 +492,9 @@ void HTMLTreeBuilder::FragmentParsingContext::finished()
 
 HTMLTreeBuilder::FragmentParsingContext::~FragmentParsingContext()
 {
+    // The tree builder's stack of open elements is gone by now, so the dummy document can be emptied.
+    if (m_contextElement)
+        recycleDummyDocumentForFragmentParsing(m_dummyDocumentForFragmentParsing.release());
 }
 
 PassRefPtr<Element> HTMLTreeBuilder::takeScriptToProcess(int& scriptStartLine)
@@ -493,7 +530,7 @@ HTMLTokenizer::State HTMLTreeBuilder::adjustedLexerState(HTMLTokenizer::State st
 
 void HTMLTreeBuilder::constructTreeFromToken(HTMLToken& rawToken)
 {
-    AtomicHTMLToken token(rawToken);
+    AtomicHTMLToken token(rawToken, m_document->domArena());
     processToken(token);
 
     // Swallowing U+0000 characters isn't in the HTML5 spec, but turning all
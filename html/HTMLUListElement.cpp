@@ -39,12 +39,12 @@ HTMLUListElement::HTMLUListElement(const QualifiedName& tagName, Document* docum
 
 PassRefPtr<HTMLUListElement> HTMLUListElement::create(Document* document)
 {
-    return adoptRef(new HTMLUListElement(ulTag, document));
+    return adoptRef(new (document) HTMLUListElement(ulTag, document));
 }
 
 PassRefPtr<HTMLUListElement> HTMLUListElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new HTMLUListElement(tagName, document));
+    return adoptRef(new (document) HTMLUListElement(tagName, document));
 }
 
 bool HTMLUListElement::mapToEntry(const QualifiedName& attrName, MappedAttributeEntry& result) const
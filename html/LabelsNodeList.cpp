@@ -33,7 +33,7 @@ namespace WebCore {
 using namespace HTMLNames;
 
 LabelsNodeList::LabelsNodeList(PassRefPtr<Node> forNode )
-    : DynamicNodeList(forNode->document()) , m_forNode(forNode)
+    : DynamicNodeList(forNode->document(), InvalidateOnForAttrChange) , m_forNode(forNode)
 {
 }
 
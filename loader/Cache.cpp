@@ -30,12 +30,14 @@
 #include "CachedXSLStyleSheet.h"
 #include "DocLoader.h"
 #include "Document.h"
+#include "Frame.h"
 #include "FrameLoader.h"
 #include "FrameLoaderTypes.h"
 #include "FrameView.h"
 #include "Image.h"
 #include "ResourceHandle.h"
 #include "SecurityOrigin.h"
+#include "Settings.h"
 #include <stdio.h>
 #include <wtf/CurrentTime.h>
 
@@ -47,6 +49,7 @@ static const int cDefaultCacheCapacity = 8192 * 1024;
 static const double cMinDelayBeforeLiveDecodedPrune = 1; // Seconds.
 static const float cTargetPrunePercentage = .95f; // Percentage of capacity toward which we prune, to avoid immediately pruning again.
 static const double cDefaultDecodedDataDeletionInterval = 0;
+static const unsigned long long cDefaultDiskCacheCapacity = 64 * 1024 * 1024;
 
 Cache* cache()
 {
@@ -64,6 +67,8 @@ Cache::Cache()
     , m_deadDecodedDataDeletionInterval(cDefaultDecodedDataDeletionInterval)
     , m_liveSize(0)
     , m_deadSize(0)
+    , m_diskCache(0)
+    , m_diskCacheCapacity(cDefaultDiskCacheCapacity)
 {
 }
 
@@ -114,6 +119,10 @@ CachedResource* Cache::requestResource(DocLoader* docLoader, CachedResource::Typ
     }
     
     if (!resource) {
+        // A copy from the disk cache goes into the memory cache as if it had been there all along.
+        if (CachedResource* storedResource = requestResourceFromDiskCache(docLoader, type, url, charset))
+            return storedResource;
+
         // The resource does not exist. Create it.
         resource = createResource(type, url, charset);
         ASSERT(resource);
@@ -152,6 +161,71 @@ CachedResource* Cache::requestResource(DocLoader* docLoader, CachedResource::Typ
 
     return resource;
 }
+
+static bool privateBrowsingEnabled(DocLoader* docLoader)
+{
+    Frame* frame = docLoader->frame();
+    Settings* settings = frame ? frame->settings() : 0;
+    return settings && settings->privateBrowsingEnabled();
+}
+
+CachedResource* Cache::requestResourceFromDiskCache(DocLoader* docLoader, CachedResource::Type type, const KURL& url, const String& charset)
+{
+    if (!m_diskCache || disabled() || privateBrowsingEnabled(docLoader))
+        return 0;
+
+    // A reload goes to the network. Otherwise the stored copy is checked the way DocLoader::checkForReload()
+    // checks resources that are still in memory.
+    CachePolicy cachePolicy = docLoader->cachePolicy();
+    if (cachePolicy == CachePolicyReload)
+        return 0;
+
+    OwnPtr<ResourceDiskCache::StoredResource> storedResource = m_diskCache->retrieve(url.string());
+    if (!storedResource) {
+        m_diskCache->recordLookup(ResourceDiskCache::Miss);
+        return 0;
+    }
+
+    CachedResource* resource = createResource(type, url, charset);
+    ASSERT(resource);
+    resource->setInCache(true);
+    m_resources.set(url.string(), resource);
+    resourceAccessed(resource);
+    resource->restoreFromDiskCache(storedResource->response, storedResource->responseTimestamp, storedResource->data.release(), storedResource->cachedMetadata.release());
+
+    bool needsRevalidation = false;
+    switch (cachePolicy) {
+    case CachePolicyVerify:
+    case CachePolicyCache:
+        needsRevalidation = resource->mustRevalidate(cachePolicy);
+        break;
+    case CachePolicyRevalidate:
+        needsRevalidation = true;
+        break;
+    case CachePolicyReload:
+    case CachePolicyAllowStale:
+        break;
+    }
+
+    // A copy that can't be decoded is of no use, and neither is a stale one that can't be revalidated. The
+    // resource is loaded from the network instead, and the copy on disk is replaced once that load finishes.
+    if (resource->errorOccurred() || (needsRevalidation && !resource->canUseCacheValidator())) {
+        if (resource->errorOccurred())
+            m_diskCache->remove(url.string());
+        m_diskCache->recordLookup(ResourceDiskCache::Miss);
+        evict(resource);
+        return 0;
+    }
+
+    if (needsRevalidation) {
+        m_diskCache->recordLookup(ResourceDiskCache::Revalidated);
+        revalidateResource(resource, docLoader);
+        return m_resources.get(url.string());
+    }
+
+    m_diskCache->recordLookup(ResourceDiskCache::Hit);
+    return resource;
+}
     
 CachedCSSStyleSheet* Cache::requestUserCSSStyleSheet(DocLoader* docLoader, const String& url, const String& charset)
 {
@@ -218,6 +292,7 @@ void Cache::revalidationSucceeded(CachedResource* revalidatingResource, const Re
     m_resources.set(resource->url(), resource);
     resource->setInCache(true);
     resource->updateResponseAfterRevalidation(response);
+    updateDiskCacheEntry(resource);
     insertInLRUList(resource);
     int delta = resource->size();
     if (resource->decodedSize() && resource->hasClients())
@@ -236,6 +311,45 @@ void Cache::revalidationFailed(CachedResource* revalidatingResource)
     revalidatingResource->clearResourceToRevalidate();
 }
 
+void Cache::setDiskCacheDirectory(const String& directory)
+{
+    ASSERT(!m_diskCache);
+    ASSERT(!directory.isEmpty());
+    m_diskCache = new ResourceDiskCache(directory, m_diskCacheCapacity);
+}
+
+void Cache::setDiskCacheCapacity(unsigned long long capacity)
+{
+    m_diskCacheCapacity = capacity;
+    if (m_diskCache)
+        m_diskCache->setCapacity(capacity);
+}
+
+void Cache::storeInDiskCache(CachedResource* resource, DocLoader* docLoader)
+{
+    // Resources that aren't in the memory cache, because it is disabled or because they have been replaced
+    // in the meantime, don't go to the disk either.
+    if (!m_diskCache || !resource->inCache() || resource->errorOccurred() || privateBrowsingEnabled(docLoader))
+        return;
+    writeToDiskCache(resource);
+}
+
+void Cache::updateDiskCacheEntry(CachedResource* resource)
+{
+    // Whether to store a resource at all was decided when it finished loading.
+    if (!m_diskCache || !resource->inCache() || !m_diskCache->contains(resource->url()))
+        return;
+    writeToDiskCache(resource);
+}
+
+void Cache::writeToDiskCache(CachedResource* resource)
+{
+    // Purgeable data can't be read without making it unpurgeable, and the disk cache got the data before it became purgeable.
+    if (resource->m_purgeableData)
+        return;
+    m_diskCache->store(resource->url(), resource->response(), resource->m_responseTimestamp, resource->data(), resource->m_cachedMetadata.get());
+}
+
 CachedResource* Cache::resourceForURL(const String& url)
 {
     CachedResource* resource = m_resources.get(url);
@@ -691,6 +805,8 @@ Cache::Statistics Cache::getStatistics()
             break;
         }
     }
+    if (m_diskCache)
+        stats.diskCache = m_diskCache->statistics();
     return stats;
 }
 
@@ -722,6 +838,9 @@ void Cache::dumpStats()
     printf("%-11s %11d %11d %11d %11d %11d %11d\n", "JavaScript", s.scripts.count, s.scripts.size, s.scripts.liveSize, s.scripts.decodedSize, s.scripts.purgeableSize, s.scripts.purgedSize);
     printf("%-11s %11d %11d %11d %11d %11d %11d\n", "Fonts", s.fonts.count, s.fonts.size, s.fonts.liveSize, s.fonts.decodedSize, s.fonts.purgeableSize, s.fonts.purgedSize);
     printf("%-11s %-11s %-11s %-11s %-11s %-11s %-11s\n\n", "-----------", "-----------", "-----------", "-----------", "-----------", "-----------", "-----------");
+    if (m_diskCache)
+        printf("Disk cache: %u entries, %llu of %llu bytes, %u hits, %u revalidations, %u misses, hit ratio %.2f\n\n", s.diskCache.entryCount, s.diskCache.size, s.diskCache.capacity,
+            s.diskCache.hits, s.diskCache.revalidations, s.diskCache.misses, s.diskCache.hitRatio());
 }
 
 void Cache::dumpLRULists(bool includeLive) const
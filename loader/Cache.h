@@ -28,6 +28,7 @@
 #include "CachePolicy.h"
 #include "CachedResource.h"
 #include "PlatformString.h"
+#include "ResourceDiskCache.h"
 #include "loader.h"
 #include <wtf/HashMap.h>
 #include <wtf/HashSet.h>
@@ -86,6 +87,7 @@ public:
         TypeStatistic xslStyleSheets;
 #endif
         TypeStatistic fonts;
+        ResourceDiskCache::Statistics diskCache;
     };
 
     // The loader that fetches resources.
@@ -100,6 +102,16 @@ public:
     void revalidateResource(CachedResource*, DocLoader*);
     void revalidationSucceeded(CachedResource* revalidatingResource, const ResourceResponse&);
     void revalidationFailed(CachedResource* revalidatingResource);
+
+    // Keeps resources in a directory on disk as well, so that they outlive their eviction from memory and the process.
+    // The directory can only be set once.
+    void setDiskCacheDirectory(const String&);
+    void setDiskCacheCapacity(unsigned long long);
+
+    // Called when a resource has finished loading from the network.
+    void storeInDiskCache(CachedResource*, DocLoader*);
+    // Called when the response or the cached metadata of a resource changes, to update its copy on disk if it has one.
+    void updateDiskCacheEntry(CachedResource*);
     
     // Sets the cache's memory capacities, in bytes. These will hold only approximately, 
     // since the decoded cost of resources like scripts and stylesheets is not known.
@@ -170,6 +182,9 @@ private:
 
     void evict(CachedResource*);
 
+    CachedResource* requestResourceFromDiskCache(DocLoader*, CachedResource::Type, const KURL&, const String& charset);
+    void writeToDiskCache(CachedResource*);
+
     // Member variables.
     HashSet<DocLoader*> m_docLoaders;
     Loader m_loader;
@@ -197,6 +212,9 @@ private:
     // A URL-based map of all resources that are in the cache (including the freshest version of objects that are currently being 
     // referenced by a Web page).
     HashMap<String, CachedResource*> m_resources;
+
+    ResourceDiskCache* m_diskCache; // Never deleted, like the cache itself.
+    unsigned long long m_diskCacheCapacity;
 };
 
 // Function to obtain the global cache.
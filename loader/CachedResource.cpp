@@ -192,6 +192,7 @@ void CachedResource::setCachedMetadata(unsigned dataTypeID, const char* data, si
 
     m_cachedMetadata = CachedMetadata::create(dataTypeID, data, size);
     ResourceHandle::cacheMetadata(m_response, m_cachedMetadata->serialize());
+    cache()->updateDiskCacheEntry(this);
 }
 
 CachedMetadata* CachedResource::cachedMetadata(unsigned dataTypeID) const
@@ -428,6 +429,24 @@ void CachedResource::updateResponseAfterRevalidation(const ResourceResponse& val
     }
 }
 
+void CachedResource::restoreFromDiskCache(const ResourceResponse& response, double responseTimestamp, PassRefPtr<SharedBuffer> storedData, PassRefPtr<CachedMetadata> cachedMetadata)
+{
+    ASSERT(inCache());
+    ASSERT(!m_loading);
+
+    m_response = response;
+    m_responseTimestamp = responseTimestamp;
+    m_cachedMetadata = cachedMetadata;
+
+    String encoding = response.textEncodingName();
+    if (!encoding.isNull())
+        setEncoding(encoding);
+
+    // What the loader does once all the data has arrived.
+    data(storedData, true);
+    finish();
+}
+
 bool CachedResource::canUseCacheValidator() const
 {
     if (m_loading || m_errorOccurred)
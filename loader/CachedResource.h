@@ -231,6 +231,8 @@ private:
     void switchClientsToRevalidatedResource();
     void clearResourceToRevalidate();
     void updateResponseAfterRevalidation(const ResourceResponse& validatingResponse);
+    // Fills in a resource from the disk cache instead of loading it.
+    void restoreFromDiskCache(const ResourceResponse&, double responseTimestamp, PassRefPtr<SharedBuffer>, PassRefPtr<CachedMetadata>);
 
     double currentAge() const;
     double freshnessLifetime() const;
@@ -325,7 +325,7 @@ void MainResourceLoader::didReceiveResponse(const ResourceResponse& r)
         return;
 #endif
 
-    HTTPHeaderMap::const_iterator it = r.httpHeaderFields().find(AtomicString("x-frame-options"));
+    HTTPHeaderMap::const_iterator it = r.httpHeaderFields().find("x-frame-options");
     if (it != r.httpHeaderFields().end()) {
         String content = it->second;
         if (m_frame->loader()->shouldInterruptLoadForXFrameOptions(content, r.url())) {
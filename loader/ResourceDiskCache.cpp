@@ -0,0 +1,673 @@
+/*
+ * Copyright (C) 2026 The WebKit Authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "ResourceDiskCache.h"
+
+#include "AutodrainedPool.h"
+#include "CachedMetadata.h"
+#include "FileSystem.h"
+#include "KURL.h"
+#include "Logging.h"
+#include "SharedBuffer.h"
+#include <wtf/CurrentTime.h>
+#include <wtf/MD5.h>
+#include <wtf/MainThread.h>
+#include <wtf/MathExtras.h>
+#include <wtf/StdLibExtras.h>
+#include <wtf/text/CString.h>
+
+using namespace std;
+
+namespace WebCore {
+
+// The files are only read back on the machine that wrote them, so numbers are stored in native byte order.
+static const uint32_t entrySignature = 0x57524443;
+static const uint32_t indexSignature = 0x57524449;
+static const uint32_t formatVersion = 1;
+
+static const char indexFileName[] = "Index";
+
+// The index is written a while after it changes, so that the changes made by a page load are written together.
+static const double indexWriteDelay = 5;
+
+// A resource that takes up more than this share of the capacity isn't stored, so that it can't push out everything else.
+static const unsigned maximumEntryShareOfCapacity = 8;
+
+class DiskCacheWriter : public Noncopyable {
+public:
+    DiskCacheWriter(Vector<char>& buffer) : m_buffer(buffer) { }
+
+    void appendUInt32(uint32_t value) { m_buffer.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+    void appendInt64(int64_t value) { m_buffer.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+    void appendDouble(double value) { m_buffer.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+
+    void appendBytes(const char* bytes, size_t length)
+    {
+        appendUInt32(length);
+        m_buffer.append(bytes, length);
+    }
+
+    void appendString(const String& string)
+    {
+        CString utf8 = string.utf8();
+        appendBytes(utf8.data(), utf8.length());
+    }
+
+private:
+    Vector<char>& m_buffer;
+};
+
+class DiskCacheReader : public Noncopyable {
+public:
+    DiskCacheReader(const Vector<char>& buffer) : m_buffer(buffer), m_offset(0) { }
+
+    bool atEnd() const { return m_offset == m_buffer.size(); }
+
+    bool readUInt32(uint32_t& value) { return readValue(value); }
+    bool readInt64(int64_t& value) { return readValue(value); }
+    bool readDouble(double& value) { return readValue(value); }
+
+    // Points into the buffer rather than copying.
+    bool readBytes(const char*& bytes, uint32_t& length)
+    {
+        if (!readUInt32(length) || length > m_buffer.size() - m_offset)
+            return false;
+        bytes = m_buffer.data() + m_offset;
+        m_offset += length;
+        return true;
+    }
+
+    bool readString(String& string)
+    {
+        const char* bytes;
+        uint32_t length;
+        if (!readBytes(bytes, length))
+            return false;
+        string = String::fromUTF8(bytes, length);
+        return true;
+    }
+
+private:
+    template<typename T> bool readValue(T& value)
+    {
+        if (sizeof(value) > m_buffer.size() - m_offset)
+            return false;
+        memcpy(&value, m_buffer.data() + m_offset, sizeof(value));
+        m_offset += sizeof(value);
+        return true;
+    }
+
+    const Vector<char>& m_buffer;
+    size_t m_offset;
+};
+
+static bool readFile(const String& path, Vector<char>& contents)
+{
+    long long fileSize;
+    if (!getFileSize(path, fileSize) || fileSize < 0 || static_cast<unsigned long long>(fileSize) > numeric_limits<size_t>::max())
+        return false;
+
+    PlatformFileHandle handle = openFile(path, OpenForRead);
+    if (!isHandleValid(handle))
+        return false;
+
+    contents.resize(static_cast<size_t>(fileSize));
+    size_t totalBytesRead = 0;
+    while (totalBytesRead < contents.size()) {
+        int bytesRead = readFromFile(handle, contents.data() + totalBytesRead, static_cast<int>(min<size_t>(contents.size() - totalBytesRead, 1 << 20)));
+        if (bytesRead <= 0)
+            break;
+        totalBytesRead += bytesRead;
+    }
+    closeFile(handle);
+    return totalBytesRead == contents.size();
+}
+
+static bool writeFile(const String& path, const Vector<char>& contents)
+{
+    PlatformFileHandle handle = openFile(path, OpenForWrite);
+    if (!isHandleValid(handle))
+        return false;
+
+    size_t totalBytesWritten = 0;
+    while (totalBytesWritten < contents.size()) {
+        int bytesWritten = writeToFile(handle, contents.data() + totalBytesWritten, static_cast<int>(min<size_t>(contents.size() - totalBytesWritten, 1 << 20)));
+        if (bytesWritten <= 0)
+            break;
+        totalBytesWritten += bytesWritten;
+    }
+    closeFile(handle);
+    return totalBytesWritten == contents.size();
+}
+
+// Different URLs that end up with the same file name replace each other, which is harmless in a cache.
+static String fileNameForURL(const String& url)
+{
+    static const char digits[] = "0123456789abcdef";
+
+    CString utf8 = url.utf8();
+    MD5 md5;
+    md5.addBytes(reinterpret_cast<const uint8_t*>(utf8.data()), utf8.length());
+    Vector<uint8_t, 16> digest;
+    md5.checksum(digest);
+
+    Vector<char, 32> result;
+    for (int i = 0; i < 16; ++i) {
+        result.append(digits[(digest[i] >> 4) & 0xf]);
+        result.append(digits[digest[i] & 0xf]);
+    }
+    return String(result.data(), result.size());
+}
+
+static bool isStorable(const ResourceResponse& response)
+{
+    if (!response.url().protocolInHTTPFamily() || response.httpStatusCode() != 200 || response.isMultipart())
+        return false;
+
+    // RFC2616 14.9.2: no-store responses must not be written to non-volatile storage.
+    if (response.cacheControlContainsNoStore())
+        return false;
+
+    // The memory Cache ignores Vary, which is tolerable within a session but not across them.
+    String vary = response.httpHeaderField("Vary");
+    if (!vary.isEmpty() && !equalIgnoringCase(vary, "Accept-Encoding"))
+        return false;
+
+    // A copy that is never fresh and can't be revalidated either would never be used.
+    return !response.httpHeaderField("ETag").isEmpty() || !response.httpHeaderField("Last-Modified").isEmpty()
+        || isfinite(response.cacheControlMaxAge()) || isfinite(response.expires());
+}
+
+static void encodeEntry(Vector<char>& contents, const String& url, const ResourceResponse& response, double responseTimestamp, SharedBuffer* data, CachedMetadata* cachedMetadata)
+{
+    DiskCacheWriter writer(contents);
+    writer.appendUInt32(entrySignature);
+    writer.appendUInt32(formatVersion);
+    writer.appendString(url);
+    writer.appendDouble(responseTimestamp);
+
+    writer.appendString(response.url().string());
+    writer.appendString(response.mimeType());
+    writer.appendInt64(response.expectedContentLength());
+    writer.appendString(response.textEncodingName());
+    writer.appendString(response.suggestedFilename());
+    writer.appendUInt32(response.httpStatusCode());
+    writer.appendString(response.httpStatusText());
+
+    const HTTPHeaderMap& headers = response.httpHeaderFields();
+    writer.appendUInt32(headers.size());
+    HTTPHeaderMap::const_iterator end = headers.end();
+    for (HTTPHeaderMap::const_iterator it = headers.begin(); it != end; ++it) {
+        writer.appendString(it->first);
+        writer.appendString(it->second);
+    }
+
+    if (cachedMetadata) {
+        const Vector<char>& serializedMetadata = cachedMetadata->serialize();
+        writer.appendBytes(serializedMetadata.data(), serializedMetadata.size());
+    } else
+        writer.appendBytes(0, 0);
+
+    writer.appendBytes(data->data(), data->size());
+}
+
+static bool decodeEntry(const Vector<char>& contents, const String& url, ResourceDiskCache::StoredResource& resource)
+{
+    DiskCacheReader reader(contents);
+    uint32_t signature, version;
+    String storedURL;
+    if (!reader.readUInt32(signature) || signature != entrySignature || !reader.readUInt32(version) || version != formatVersion
+        || !reader.readString(storedURL) || storedURL != url || !reader.readDouble(resource.responseTimestamp))
+        return false;
+
+    String responseURL, mimeType, textEncodingName, suggestedFilename, statusText;
+    int64_t expectedContentLength;
+    uint32_t statusCode;
+    if (!reader.readString(responseURL) || !reader.readString(mimeType) || !reader.readInt64(expectedContentLength) || !reader.readString(textEncodingName)
+        || !reader.readString(suggestedFilename) || !reader.readUInt32(statusCode) || !reader.readString(statusText))
+        return false;
+
+    ResourceResponse response(KURL(ParsedURLString, responseURL), mimeType, expectedContentLength, textEncodingName, suggestedFilename);
+    response.setHTTPStatusCode(statusCode);
+    response.setHTTPStatusText(statusText);
+
+    uint32_t headerCount;
+    if (!reader.readUInt32(headerCount))
+        return false;
+    for (uint32_t i = 0; i < headerCount; ++i) {
+        String name, value;
+        if (!reader.readString(name) || !reader.readString(value))
+            return false;
+        response.setHTTPHeaderField(name, value);
+    }
+    resource.response = response;
+
+    const char* metadata;
+    uint32_t metadataSize;
+    if (!reader.readBytes(metadata, metadataSize))
+        return false;
+    if (metadataSize) {
+        // Serialized metadata always starts with its data type ID.
+        if (metadataSize <= sizeof(unsigned))
+            return false;
+        resource.cachedMetadata = CachedMetadata::deserialize(metadata, metadataSize);
+    }
+
+    const char* data;
+    uint32_t dataSize;
+    if (!reader.readBytes(data, dataSize) || !reader.atEnd())
+        return false;
+    resource.data = SharedBuffer::create(data, dataSize);
+    return true;
+}
+
+// Everything the thread touches is copied for it with crossThreadString().
+class ResourceDiskCache::Operation : public Noncopyable {
+public:
+    // The contents are taken over rather than copied.
+    static PassOwnPtr<Operation> createWrite(const String& path, const String& fileName, Vector<char>& contents)
+    {
+        OwnPtr<Operation> operation = adoptPtr(new Operation(WriteFile, path, fileName));
+        operation->m_contents.swap(contents);
+        return operation.release();
+    }
+
+    static PassOwnPtr<Operation> createDelete(const String& path)
+    {
+        return adoptPtr(new Operation(DeleteFile, path, String()));
+    }
+
+    void perform(ResourceDiskCache*);
+
+private:
+    enum Type {
+        WriteFile,
+        DeleteFile
+    };
+
+    Operation(Type type, const String& path, const String& fileName)
+        : m_type(type)
+        , m_path(path.crossThreadString())
+        , m_fileName(fileName.crossThreadString())
+    {
+    }
+
+    Type m_type;
+    String m_path;
+    String m_fileName; // Null for the index, which nobody waits for.
+    Vector<char> m_contents;
+};
+
+struct ResourceDiskCache::WriteCompletion {
+    ResourceDiskCache* diskCache;
+    String fileName;
+};
+
+void ResourceDiskCache::Operation::perform(ResourceDiskCache* diskCache)
+{
+    ASSERT(!isMainThread());
+
+    if (m_type == DeleteFile) {
+        deleteFile(m_path);
+        return;
+    }
+
+    // A partly written entry is recognized as damaged when it is read, but there is no point in keeping it.
+    if (!writeFile(m_path, m_contents)) {
+        LOG_ERROR("Unable to write %s to the resource disk cache", m_path.utf8().data());
+        deleteFile(m_path);
+    }
+
+    if (m_fileName.isNull())
+        return;
+
+    WriteCompletion* completion = new WriteCompletion;
+    completion->diskCache = diskCache;
+    completion->fileName = m_fileName.crossThreadString();
+    callOnMainThread(didWriteFileOnMainThread, completion);
+}
+
+struct ResourceDiskCache::IndexRecord {
+    String url;
+    unsigned long long size;
+    double lastAccessTime;
+};
+
+struct ResourceDiskCache::IndexHandoff {
+    ResourceDiskCache* diskCache;
+    Vector<IndexRecord> records;
+};
+
+ResourceDiskCache::ResourceDiskCache(const String& directory, unsigned long long capacity)
+    : m_directory(directory)
+    , m_threadDirectory(directory.crossThreadString())
+    , m_capacity(capacity)
+    , m_size(0)
+    , m_indexLoaded(false)
+    , m_head(0)
+    , m_tail(0)
+    , m_indexWriteTimer(this, &ResourceDiskCache::indexWriteTimerFired)
+    , m_thread(0)
+{
+    ASSERT(isMainThread());
+    m_thread = createThread(ResourceDiskCache::diskCacheThreadStart, this, "WebCore: ResourceDiskCache");
+}
+
+void* ResourceDiskCache::diskCacheThreadStart(void* diskCache)
+{
+    return static_cast<ResourceDiskCache*>(diskCache)->diskCacheThread();
+}
+
+void* ResourceDiskCache::diskCacheThread()
+{
+    readIndexOnThread();
+
+    AutodrainedPool pool;
+    while (OwnPtr<Operation> operation = m_queue.waitForMessage()) {
+        operation->perform(this);
+        pool.cycle();
+    }
+    return 0;
+}
+
+void ResourceDiskCache::readIndexOnThread()
+{
+    ASSERT(!isMainThread());
+
+#ifndef NDEBUG
+    double timeStamp = currentTime();
+#endif
+
+    IndexHandoff* handoff = new IndexHandoff;
+    handoff->diskCache = this;
+
+    Vector<char> contents;
+    if (makeAllDirectories(m_threadDirectory) && readFile(pathByAppendingComponent(m_threadDirectory, indexFileName), contents)) {
+        DiskCacheReader reader(contents);
+        uint32_t signature, version, recordCount;
+        if (reader.readUInt32(signature) && signature == indexSignature && reader.readUInt32(version) && version == formatVersion && reader.readUInt32(recordCount)) {
+            // A damaged record ends the index, and the files of the records after it are only replaced by later stores.
+            for (uint32_t i = 0; i < recordCount; ++i) {
+                IndexRecord record;
+                int64_t size;
+                if (!reader.readString(record.url) || !reader.readInt64(size) || size < 0 || !reader.readDouble(record.lastAccessTime))
+                    break;
+                record.size = size;
+                handoff->records.append(record);
+            }
+        }
+    }
+
+    LOG(Network, "Read %u records of the resource disk cache index in %.4f seconds", static_cast<unsigned>(handoff->records.size()), currentTime() - timeStamp);
+    callOnMainThread(installIndexOnMainThread, handoff);
+}
+
+void ResourceDiskCache::installIndexOnMainThread(void* context)
+{
+    OwnPtr<IndexHandoff> handoff = adoptPtr(static_cast<IndexHandoff*>(context));
+    handoff->diskCache->installIndex(handoff->records);
+}
+
+void ResourceDiskCache::installIndex(Vector<IndexRecord>& records)
+{
+    ASSERT(isMainThread());
+    ASSERT(!m_indexLoaded);
+
+    // The index lists the most recently used resources first. Resources stored before it was read
+    // are more recent still, so the records go after them.
+    for (size_t i = 0; i < records.size(); ++i) {
+        String fileName = fileNameForURL(records[i].url);
+        if (m_index.contains(fileName))
+            continue;
+
+        IndexEntry* entry = new IndexEntry(records[i].url, records[i].size, records[i].lastAccessTime);
+        m_index.set(fileName, entry);
+        m_size += entry->size;
+
+        entry->previous = m_tail;
+        if (m_tail)
+            m_tail->next = entry;
+        else
+            m_head = entry;
+        m_tail = entry;
+    }
+
+    m_indexLoaded = true;
+    pruneToCapacity();
+    scheduleIndexWrite();
+}
+
+void ResourceDiskCache::didWriteFileOnMainThread(void* context)
+{
+    OwnPtr<WriteCompletion> completion = adoptPtr(static_cast<WriteCompletion*>(context));
+    completion->diskCache->m_pendingWrites.remove(completion->fileName);
+}
+
+void ResourceDiskCache::postOperation(PassOwnPtr<Operation> operation)
+{
+    m_queue.append(operation);
+}
+
+void ResourceDiskCache::scheduleIndexWrite()
+{
+    if (!m_indexWriteTimer.isActive())
+        m_indexWriteTimer.startOneShot(indexWriteDelay);
+}
+
+void ResourceDiskCache::indexWriteTimerFired(Timer<ResourceDiskCache>*)
+{
+    // Writing the index before the old one has been read would lose the resources it lists.
+    // installIndex() schedules the write again.
+    if (!m_indexLoaded)
+        return;
+
+    Vector<char> contents;
+    DiskCacheWriter writer(contents);
+    writer.appendUInt32(indexSignature);
+    writer.appendUInt32(formatVersion);
+    writer.appendUInt32(m_index.size());
+    for (IndexEntry* entry = m_head; entry; entry = entry->next) {
+        writer.appendString(entry->url);
+        writer.appendInt64(entry->size);
+        writer.appendDouble(entry->lastAccessTime);
+    }
+    postOperation(Operation::createWrite(pathByAppendingComponent(m_directory, indexFileName), String(), contents));
+
+    LOG(Network, "Resource disk cache has %u entries, %llu bytes - %u hits, %u revalidations, %u misses (hit ratio %.2f), %u stores, %u evictions",
+        m_index.size(), m_size, m_statistics.hits, m_statistics.revalidations, m_statistics.misses, m_statistics.hitRatio(), m_statistics.stores, m_statistics.evictions);
+}
+
+void ResourceDiskCache::setCapacity(unsigned long long capacity)
+{
+    m_capacity = capacity;
+    pruneToCapacity();
+}
+
+PassOwnPtr<ResourceDiskCache::StoredResource> ResourceDiskCache::retrieve(const String& url)
+{
+    ASSERT(isMainThread());
+
+    if (!m_indexLoaded)
+        return 0;
+
+    String fileName = fileNameForURL(url);
+    IndexEntry* entry = m_index.get(fileName);
+    if (!entry || entry->url != url || m_pendingWrites.contains(fileName))
+        return 0;
+
+    Vector<char> contents;
+    OwnPtr<StoredResource> resource = adoptPtr(new StoredResource);
+    if (!readFile(pathByAppendingComponent(m_directory, fileName), contents) || !decodeEntry(contents, url, *resource)) {
+        LOG(Network, "Removing the damaged entry for %s from the resource disk cache", url.utf8().data());
+        removeEntry(fileName);
+        return 0;
+    }
+
+    removeFromLRUList(entry);
+    entry->lastAccessTime = currentTime();
+    insertInLRUList(entry);
+    scheduleIndexWrite();
+
+    return resource.release();
+}
+
+void ResourceDiskCache::recordLookup(LookupResult result)
+{
+    switch (result) {
+    case Miss:
+        ++m_statistics.misses;
+        break;
+    case Hit:
+        ++m_statistics.hits;
+        break;
+    case Revalidated:
+        ++m_statistics.revalidations;
+        break;
+    }
+}
+
+bool ResourceDiskCache::contains(const String& url) const
+{
+    IndexEntry* entry = m_index.get(fileNameForURL(url));
+    return entry && entry->url == url;
+}
+
+void ResourceDiskCache::store(const String& url, const ResourceResponse& response, double responseTimestamp, SharedBuffer* data, CachedMetadata* cachedMetadata)
+{
+    ASSERT(isMainThread());
+
+    if (!data || !isStorable(response)) {
+        remove(url);
+        return;
+    }
+
+    Vector<char> contents;
+    encodeEntry(contents, url, response, responseTimestamp, data, cachedMetadata);
+    if (contents.size() > m_capacity / maximumEntryShareOfCapacity) {
+        remove(url);
+        return;
+    }
+
+    String fileName = fileNameForURL(url);
+    IndexEntry* entry = m_index.get(fileName);
+    if (entry) {
+        removeFromLRUList(entry);
+        m_size -= entry->size;
+        entry->url = url;
+        entry->size = contents.size();
+        entry->lastAccessTime = currentTime();
+    } else {
+        entry = new IndexEntry(url, contents.size(), currentTime());
+        m_index.set(fileName, entry);
+    }
+    insertInLRUList(entry);
+    m_size += entry->size;
+    ++m_statistics.stores;
+
+    m_pendingWrites.add(fileName);
+    postOperation(Operation::createWrite(pathByAppendingComponent(m_directory, fileName), fileName, contents));
+
+    // The new entry is the most recently used, and small enough not to be pruned itself.
+    pruneToCapacity();
+    scheduleIndexWrite();
+}
+
+void ResourceDiskCache::remove(const String& url)
+{
+    if (contains(url))
+        removeEntry(fileNameForURL(url));
+}
+
+void ResourceDiskCache::removeEntry(const String& fileName)
+{
+    IndexEntry* entry = m_index.take(fileName);
+    if (!entry)
+        return;
+
+    removeFromLRUList(entry);
+    m_size -= entry->size;
+    delete entry;
+
+    postOperation(Operation::createDelete(pathByAppendingComponent(m_directory, fileName)));
+    scheduleIndexWrite();
+}
+
+void ResourceDiskCache::pruneToCapacity()
+{
+    while (m_size > m_capacity && m_tail) {
+        ++m_statistics.evictions;
+        removeEntry(fileNameForURL(m_tail->url));
+    }
+}
+
+void ResourceDiskCache::insertInLRUList(IndexEntry* entry)
+{
+    ASSERT(!entry->previous && !entry->next);
+
+    entry->next = m_head;
+    if (m_head)
+        m_head->previous = entry;
+    m_head = entry;
+
+    if (!m_tail)
+        m_tail = entry;
+}
+
+void ResourceDiskCache::removeFromLRUList(IndexEntry* entry)
+{
+    if (entry->previous)
+        entry->previous->next = entry->next;
+    else {
+        ASSERT(m_head == entry);
+        m_head = entry->next;
+    }
+
+    if (entry->next)
+        entry->next->previous = entry->previous;
+    else {
+        ASSERT(m_tail == entry);
+        m_tail = entry->previous;
+    }
+
+    entry->previous = 0;
+    entry->next = 0;
+}
+
+ResourceDiskCache::Statistics ResourceDiskCache::statistics() const
+{
+    Statistics statistics = m_statistics;
+    statistics.entryCount = m_index.size();
+    statistics.size = m_size;
+    statistics.capacity = m_capacity;
+    return statistics;
+}
+
+double ResourceDiskCache::Statistics::hitRatio() const
+{
+    unsigned lookups = hits + revalidations + misses;
+    return lookups ? static_cast<double>(hits) / lookups : 0;
+}
+
+} // namespace WebCore
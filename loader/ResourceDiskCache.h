@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2026 The WebKit Authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ResourceDiskCache_h
+#define ResourceDiskCache_h
+
+#include "PlatformString.h"
+#include "ResourceResponse.h"
+#include "Timer.h"
+#include <wtf/HashCountedSet.h>
+#include <wtf/HashMap.h>
+#include <wtf/MessageQueue.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/PassOwnPtr.h>
+#include <wtf/RefPtr.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
+#include <wtf/text/StringHash.h>
+
+namespace WebCore {
+
+class CachedMetadata;
+class SharedBuffer;
+
+// The disk tier behind the memory Cache. It keeps the encoded data, the response and the cached metadata
+// of resources in a directory, one file per resource, so that they outlive both their eviction from the
+// memory Cache and the process. The index of stored resources is kept in memory in least recently used
+// order. It is read on a background thread at startup, and that thread then writes and deletes the files,
+// including the index itself. Only reading a stored resource back, on a hit, happens on the main thread.
+class ResourceDiskCache : public Noncopyable {
+public:
+    ResourceDiskCache(const String& directory, unsigned long long capacity);
+    ~ResourceDiskCache(); // Not implemented to make sure nobody accidentally calls delete -- the thread relies on the disk cache staying around.
+
+    struct StoredResource : public Noncopyable {
+        ResourceResponse response;
+        double responseTimestamp;
+        RefPtr<SharedBuffer> data;
+        RefPtr<CachedMetadata> cachedMetadata;
+    };
+
+    enum LookupResult {
+        Miss,
+        Hit,
+        Revalidated
+    };
+
+    struct Statistics {
+        Statistics() : entryCount(0), size(0), capacity(0), hits(0), revalidations(0), misses(0), stores(0), evictions(0) { }
+
+        // The share of lookups that were served without going to the network.
+        double hitRatio() const;
+
+        unsigned entryCount;
+        unsigned long long size;
+        unsigned long long capacity;
+        unsigned hits;
+        unsigned revalidations; // Stored copies that were stale, and were checked with a conditional request.
+        unsigned misses;
+        unsigned stores;
+        unsigned evictions;
+    };
+
+    // The size is only bounded approximately, by the size of the files. Lowering the capacity evicts
+    // the least recently used resources right away.
+    void setCapacity(unsigned long long);
+    unsigned long long capacity() const { return m_capacity; }
+
+    // Returns the stored copy of url, or 0 if there is none or the index hasn't been read yet.
+    // Whether the copy is fresh enough to use is up to the caller, who records the outcome.
+    PassOwnPtr<StoredResource> retrieve(const String& url);
+    void recordLookup(LookupResult);
+
+    bool contains(const String& url) const;
+    void store(const String& url, const ResourceResponse&, double responseTimestamp, SharedBuffer* data, CachedMetadata*);
+    void remove(const String& url);
+
+    Statistics statistics() const;
+
+private:
+    class Operation;
+    struct IndexRecord;
+    struct IndexHandoff;
+    struct WriteCompletion;
+
+    struct IndexEntry : public Noncopyable {
+        IndexEntry(const String& url, unsigned long long size, double lastAccessTime)
+            : url(url), size(size), lastAccessTime(lastAccessTime), previous(0), next(0) { }
+
+        String url;
+        unsigned long long size;
+        double lastAccessTime;
+        IndexEntry* previous;
+        IndexEntry* next;
+    };
+    // Keyed by the name of the file, which is derived from the URL.
+    typedef HashMap<String, IndexEntry*> IndexMap;
+
+    static void* diskCacheThreadStart(void*);
+    void* diskCacheThread();
+    void readIndexOnThread();
+
+    static void installIndexOnMainThread(void*);
+    void installIndex(Vector<IndexRecord>&);
+    static void didWriteFileOnMainThread(void*);
+
+    void postOperation(PassOwnPtr<Operation>);
+    void scheduleIndexWrite();
+    void indexWriteTimerFired(Timer<ResourceDiskCache>*);
+
+    void removeEntry(const String& fileName);
+    void pruneToCapacity();
+    void insertInLRUList(IndexEntry*);
+    void removeFromLRUList(IndexEntry*);
+
+    String m_directory;
+    String m_threadDirectory; // A copy of m_directory for the thread.
+    unsigned long long m_capacity;
+    unsigned long long m_size;
+
+    bool m_indexLoaded;
+    IndexMap m_index;
+    IndexEntry* m_head;
+    IndexEntry* m_tail;
+    Timer<ResourceDiskCache> m_indexWriteTimer;
+
+    // Files that the thread hasn't finished writing yet can't be read back.
+    HashCountedSet<String> m_pendingWrites;
+
+    Statistics m_statistics;
+
+    ThreadIdentifier m_thread;
+    MessageQueue<Operation> m_queue;
+};
+
+} // namespace WebCore
+
+#endif // ResourceDiskCache_h
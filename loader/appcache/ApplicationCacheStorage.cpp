@@ -34,10 +34,12 @@
 #include "ApplicationCacheResource.h"
 #include "FileSystem.h"
 #include "KURL.h"
+#include "Logging.h"
 #include "SQLiteStatement.h"
 #include "SQLiteTransaction.h"
 #include "SecurityOrigin.h"
 #include <wtf/text/CString.h>
+#include <wtf/MD5.h>
 #include <wtf/StdLibExtras.h>
 #include <wtf/StringExtras.h>
 
@@ -84,6 +86,119 @@ private:
     Vector<Record> m_records;
 };
 
+// Resource data files are written before the transaction that refers to them is committed.
+// Unless the journal is committed, the files are deleted again. Their names are also recorded
+// in a file on disk before they are written, where a rollback can't undo it, so that
+// openDatabase() can reclaim them if we never got to delete them.
+class ResourceDataFileJournal : public Noncopyable {
+public:
+    ResourceDataFileJournal(const String& directory, const String& pendingFileNamesPath)
+        : m_directory(directory)
+        , m_pendingFileNamesPath(pendingFileNamesPath)
+        , m_pendingFileNamesHandle(invalidPlatformFileHandle)
+    {
+    }
+
+    ~ResourceDataFileJournal()
+    {
+        size_t size = m_fileNames.size();
+        for (size_t i = 0; i < size; ++i)
+            deleteFile(pathByAppendingComponent(m_directory, m_fileNames[i]));
+        closePendingFileNames();
+    }
+
+    // Must succeed before the file is written.
+    bool add(const String& fileName)
+    {
+        if (!isHandleValid(m_pendingFileNamesHandle)) {
+            m_pendingFileNamesHandle = openFile(m_pendingFileNamesPath, OpenForWrite);
+            if (!isHandleValid(m_pendingFileNamesHandle))
+                return false;
+        }
+
+        m_fileNames.append(fileName);
+        CString line = (fileName + "\n").utf8();
+        return writeToFile(m_pendingFileNamesHandle, line.data(), line.length()) == static_cast<int>(line.length());
+    }
+
+    // Call only once the transaction that refers to the files has been committed.
+    void commit()
+    {
+        m_fileNames.clear();
+        closePendingFileNames();
+    }
+
+private:
+    void closePendingFileNames()
+    {
+        if (!isHandleValid(m_pendingFileNamesHandle))
+            return;
+        closeFile(m_pendingFileNamesHandle);
+        deleteFile(m_pendingFileNamesPath);
+    }
+
+    String m_directory;
+    String m_pendingFileNamesPath;
+    PlatformFileHandle m_pendingFileNamesHandle;
+    Vector<String> m_fileNames;
+};
+
+static String resourceDataDigest(const char* data, size_t size)
+{
+    static const char digits[] = "0123456789abcdef";
+
+    MD5 md5;
+    md5.addBytes(reinterpret_cast<const uint8_t*>(data), size);
+    Vector<uint8_t, 16> digest;
+    md5.checksum(digest);
+
+    Vector<char, 32> result;
+    for (int i = 0; i < 16; ++i) {
+        result.append(digits[(digest[i] >> 4) & 0xf]);
+        result.append(digits[digest[i] & 0xf]);
+    }
+    return String(result.data(), result.size());
+}
+
+// readFromFile() and writeToFile() take int lengths, so large resources are transferred in pieces.
+static const int resourceDataFileChunkSize = 1 << 20;
+
+static bool writeResourceDataFile(const String& path, const char* data, size_t size)
+{
+    PlatformFileHandle handle = openFile(path, OpenForWrite);
+    if (!isHandleValid(handle))
+        return false;
+
+    size_t totalBytesWritten = 0;
+    while (totalBytesWritten < size) {
+        int bytesWritten = writeToFile(handle, data + totalBytesWritten, static_cast<int>(min<size_t>(size - totalBytesWritten, resourceDataFileChunkSize)));
+        if (bytesWritten <= 0)
+            break;
+        totalBytesWritten += bytesWritten;
+    }
+    closeFile(handle);
+
+    return totalBytesWritten == size;
+}
+
+static bool readResourceDataFile(const String& path, Vector<char>& data)
+{
+    PlatformFileHandle handle = openFile(path, OpenForRead);
+    if (!isHandleValid(handle))
+        return false;
+
+    size_t totalBytesRead = 0;
+    while (totalBytesRead < data.size()) {
+        int bytesRead = readFromFile(handle, data.data() + totalBytesRead, static_cast<int>(min<size_t>(data.size() - totalBytesRead, resourceDataFileChunkSize)));
+        if (bytesRead <= 0)
+            break;
+        totalBytesRead += bytesRead;
+    }
+    closeFile(handle);
+
+    return totalBytesRead == data.size();
+}
+
 static unsigned urlHostHash(const KURL& url)
 {
     unsigned hostStart = url.hostStart();
@@ -384,7 +499,8 @@ int64_t ApplicationCacheStorage::spaceNeeded(int64_t cacheToSave)
     if (!getFileSize(m_cacheFile, fileSize))
         return 0;
 
-    int64_t currentSize = fileSize;
+    // Resource data lives in files next to the database, and counts against the maximum size as well.
+    int64_t currentSize = fileSize + resourceDataFileSize();
 
     // Determine the amount of free space we have available.
     int64_t totalAvailableSize = 0;
@@ -550,7 +666,7 @@ bool ApplicationCacheStorage::executeSQLCommand(const String& sql)
 // Update the schemaVersion when the schema of any the Application Cache
 // SQLite tables changes. This allows the database to be rebuilt when
 // a new, incompatible change has been introduced to the database schema.
-static const int schemaVersion = 6;
+static const int schemaVersion = 7;
     
 void ApplicationCacheStorage::verifySchemaVersion()
 {
@@ -558,8 +674,18 @@ void ApplicationCacheStorage::verifySchemaVersion()
     if (version == schemaVersion)
         return;
 
+    // The resource data files belong to the tables that are about to be dropped. Any that are
+    // still pending are reclaimed by openDatabase() once the new tables are empty.
+    Vector<String> fileNames;
+    SQLiteStatement(m_database, "SELECT path FROM CacheResourceData WHERE path IS NOT NULL").returnTextResults(0, fileNames);
+
     m_database.clearAllTables();
 
+    size_t fileCount = fileNames.size();
+    for (size_t i = 0; i < fileCount; ++i)
+        deleteFile(pathByAppendingComponent(resourceDataDirectory(), fileNames[i]));
+    deleteEmptyDirectory(resourceDataDirectory());
+
     // Update user version.
     SQLiteTransaction setDatabaseVersion(m_database);
     setDatabaseVersion.begin();
@@ -608,7 +734,9 @@ void ApplicationCacheStorage::openDatabase(bool createIfDoesNotExist)
     executeSQLCommand("CREATE TABLE IF NOT EXISTS CacheEntries (cache INTEGER NOT NULL ON CONFLICT FAIL, type INTEGER, resource INTEGER NOT NULL)");
     executeSQLCommand("CREATE TABLE IF NOT EXISTS CacheResources (id INTEGER PRIMARY KEY AUTOINCREMENT, url TEXT NOT NULL ON CONFLICT FAIL, "
                       "statusCode INTEGER NOT NULL, responseURL TEXT NOT NULL, mimeType TEXT, textEncodingName TEXT, headers TEXT, data INTEGER NOT NULL ON CONFLICT FAIL)");
-    executeSQLCommand("CREATE TABLE IF NOT EXISTS CacheResourceData (id INTEGER PRIMARY KEY AUTOINCREMENT, data BLOB)");
+    executeSQLCommand("CREATE TABLE IF NOT EXISTS CacheResourceData (id INTEGER PRIMARY KEY AUTOINCREMENT, digest TEXT NOT NULL, size INTEGER NOT NULL, "
+                      "path TEXT, refCount INTEGER NOT NULL)");
+    executeSQLCommand("CREATE INDEX IF NOT EXISTS CacheResourceDataDigestIndex ON CacheResourceData (digest)");
     executeSQLCommand("CREATE TABLE IF NOT EXISTS Origins (origin TEXT UNIQUE ON CONFLICT IGNORE, quota INTEGER NOT NULL ON CONFLICT FAIL)");
 
     // When a cache is deleted, all its entries and its whitelist should be deleted.
@@ -626,11 +754,16 @@ void ApplicationCacheStorage::openDatabase(bool createIfDoesNotExist)
                       "  DELETE FROM CacheResources WHERE id = OLD.resource;"
                       " END");
 
-    // When a cache resource is deleted, its data blob should also be deleted.
+    // When a cache resource is deleted, it no longer refers to its data. Data nothing refers to anymore
+    // is deleted along with its file by deleteUnreferencedResourceData().
     executeSQLCommand("CREATE TRIGGER IF NOT EXISTS CacheResourceDeleted AFTER DELETE ON CacheResources"
                       " FOR EACH ROW BEGIN"
-                      "  DELETE FROM CacheResourceData WHERE id = OLD.data;"
+                      "  UPDATE CacheResourceData SET refCount = refCount - 1 WHERE id = OLD.data;"
                       " END");
+
+    // Clean up after a previous session that quit before it got to it.
+    reclaimPendingResourceDataFiles();
+    deleteUnreferencedResourceData();
 }
 
 bool ApplicationCacheStorage::executeStatement(SQLiteStatement& statement)
@@ -667,11 +800,12 @@ bool ApplicationCacheStorage::store(ApplicationCacheGroup* group, GroupStorageID
     return true;
 }    
 
-bool ApplicationCacheStorage::store(ApplicationCache* cache, ResourceStorageIDJournal* storageIDJournal)
+bool ApplicationCacheStorage::store(ApplicationCache* cache, ResourceStorageIDJournal* storageIDJournal, ResourceDataFileJournal* fileJournal)
 {
     ASSERT(cache->storageID() == 0);
     ASSERT(cache->group()->storageID() != 0);
     ASSERT(storageIDJournal);
+    ASSERT(fileJournal);
     
     SQLiteStatement statement(m_database, "INSERT INTO Caches (cacheGroup, size) VALUES (?, ?)");
     if (statement.prepare() != SQLResultOk)
@@ -690,7 +824,7 @@ bool ApplicationCacheStorage::store(ApplicationCache* cache, ResourceStorageIDJo
         ApplicationCache::ResourceMap::const_iterator end = cache->end();
         for (ApplicationCache::ResourceMap::const_iterator it = cache->begin(); it != end; ++it) {
             unsigned oldStorageID = it->second->storageID();
-            if (!store(it->second.get(), cacheStorageID))
+            if (!store(it->second.get(), cacheStorageID, fileJournal))
                 return false;
 
             // Storing the resource succeeded. Log its old storageID in case
@@ -748,7 +882,7 @@ bool ApplicationCacheStorage::store(ApplicationCache* cache, ResourceStorageIDJo
     return true;
 }
 
-bool ApplicationCacheStorage::store(ApplicationCacheResource* resource, unsigned cacheStorageID)
+bool ApplicationCacheStorage::store(ApplicationCacheResource* resource, unsigned cacheStorageID, ResourceDataFileJournal* fileJournal)
 {
     ASSERT(cacheStorageID);
     ASSERT(!resource->storageID());
@@ -759,18 +893,10 @@ bool ApplicationCacheStorage::store(ApplicationCacheResource* resource, unsigned
     if (!m_database.isOpen())
         return false;
 
-    // First, insert the data
-    SQLiteStatement dataStatement(m_database, "INSERT INTO CacheResourceData (data) VALUES (?)");
-    if (dataStatement.prepare() != SQLResultOk)
+    // First, store the data - or refer to an identical copy of it that is already stored
+    unsigned dataId;
+    if (!storeResourceData(resource->data(), fileJournal, dataId))
         return false;
-    
-    if (resource->data()->size())
-        dataStatement.bindBlob(1, resource->data()->data(), resource->data()->size());
-    
-    if (!dataStatement.executeCommand())
-        return false;
-
-    unsigned dataId = static_cast<unsigned>(m_database.lastInsertRowID());
 
     // Then, insert the resource
     
@@ -823,6 +949,101 @@ bool ApplicationCacheStorage::store(ApplicationCacheResource* resource, unsigned
     return true;
 }
 
+bool ApplicationCacheStorage::storeResourceData(SharedBuffer* data, ResourceDataFileJournal* fileJournal, unsigned& dataStorageID)
+{
+    ASSERT(fileJournal);
+
+    const char* bytes = data->data();
+    size_t size = data->size();
+    String digest = resourceDataDigest(bytes, size);
+
+    // Only use a stored copy with the same digest if its contents are really the same, so that
+    // a digest collision can never hand one resource the data of another.
+    SQLiteStatement findStatement(m_database, "SELECT id, size, path FROM CacheResourceData WHERE digest=?");
+    if (findStatement.prepare() != SQLResultOk)
+        return false;
+
+    findStatement.bindText(1, digest);
+
+    bool digestIsTaken = false;
+    int result;
+    while ((result = findStatement.step()) == SQLResultRow) {
+        digestIsTaken = true;
+        if (findStatement.getColumnInt64(1) != static_cast<int64_t>(size))
+            continue;
+
+        if (size) {
+            Vector<char> storedData(size);
+            if (!readResourceDataFile(pathByAppendingComponent(resourceDataDirectory(), findStatement.getColumnText(2)), storedData)
+                || memcmp(storedData.data(), bytes, size))
+                continue;
+        }
+
+        dataStorageID = static_cast<unsigned>(findStatement.getColumnInt64(0));
+        findStatement.finalize();
+
+        SQLiteStatement referenceStatement(m_database, "UPDATE CacheResourceData SET refCount=refCount+1 WHERE id=?");
+        if (referenceStatement.prepare() != SQLResultOk)
+            return false;
+
+        referenceStatement.bindInt64(1, dataStorageID);
+        return executeStatement(referenceStatement);
+    }
+
+    if (result != SQLResultDone) {
+        LOG_ERROR("Could not look up resource data, error \"%s\"", m_database.lastErrorMsg());
+        return false;
+    }
+    findStatement.finalize();
+
+    // The database no longer holds the data, so the maximum size has to be enforced here.
+    if (size && m_maximumSize != noQuota()) {
+        long long databaseSize = 0;
+        getFileSize(m_cacheFile, databaseSize);
+        if (databaseSize + resourceDataFileSize() + static_cast<int64_t>(size) > m_maximumSize) {
+            m_isMaximumSizeReached = true;
+            return false;
+        }
+    }
+
+    SQLiteStatement insertStatement(m_database, "INSERT INTO CacheResourceData (digest, size, refCount) VALUES (?, ?, 1)");
+    if (insertStatement.prepare() != SQLResultOk)
+        return false;
+
+    insertStatement.bindText(1, digest);
+    insertStatement.bindInt64(2, size);
+    if (!executeStatement(insertStatement))
+        return false;
+
+    dataStorageID = static_cast<unsigned>(m_database.lastInsertRowID());
+
+    // Empty data doesn't need a file.
+    if (!size)
+        return true;
+
+    // Files are named after the digest of their contents. In the unlikely case of different data with the same digest, the row ID tells the files apart.
+    String fileName = digestIsTaken ? digest + "-" + String::number(dataStorageID) : digest;
+    String path = pathByAppendingComponent(resourceDataDirectory(), fileName);
+
+    makeAllDirectories(resourceDataDirectory());
+    if (!fileJournal->add(fileName)) {
+        LOG_ERROR("Could not record pending resource data file %s", fileName.utf8().data());
+        return false;
+    }
+    if (!writeResourceDataFile(path, bytes, size)) {
+        LOG_ERROR("Could not write resource data to %s", path.utf8().data());
+        return false;
+    }
+
+    SQLiteStatement pathStatement(m_database, "UPDATE CacheResourceData SET path=? WHERE id=?");
+    if (pathStatement.prepare() != SQLResultOk)
+        return false;
+
+    pathStatement.bindText(1, fileName);
+    pathStatement.bindInt64(2, dataStorageID);
+    return executeStatement(pathStatement);
+}
+
 bool ApplicationCacheStorage::storeUpdatedType(ApplicationCacheResource* resource, ApplicationCache* cache)
 {
     ASSERT_UNUSED(cache, cache->storageID());
@@ -853,8 +1074,10 @@ bool ApplicationCacheStorage::store(ApplicationCacheResource* resource, Applicat
 
     SQLiteTransaction storeResourceTransaction(m_database);
     storeResourceTransaction.begin();
+
+    ResourceDataFileJournal fileJournal(resourceDataDirectory(), pendingResourceDataFileNamesPath());
     
-    if (!store(resource, cache->storageID())) {
+    if (!store(resource, cache->storageID(), &fileJournal)) {
         checkForMaxSizeReached();
         return false;
     }
@@ -871,6 +1094,10 @@ bool ApplicationCacheStorage::store(ApplicationCacheResource* resource, Applicat
         return false;
     
     storeResourceTransaction.commit();
+    if (storeResourceTransaction.inProgress())
+        return false;
+
+    fileJournal.commit();
     return true;
 }
 
@@ -930,8 +1157,11 @@ bool ApplicationCacheStorage::storeNewestCache(ApplicationCacheGroup* group, App
     // fails and this method returns early.
     ResourceStorageIDJournal resourceStorageIDJournal;
 
+    // Likewise, resource data files written for the cache are deleted again if storing it fails.
+    ResourceDataFileJournal fileJournal(resourceDataDirectory(), pendingResourceDataFileNamesPath());
+
     // Store the newest cache
-    if (!store(group->newestCache(), &resourceStorageIDJournal)) {
+    if (!store(group->newestCache(), &resourceStorageIDJournal, &fileJournal)) {
         checkForMaxSizeReached();
         failureReason = isMaximumSizeReached() ? TotalQuotaReached : DiskOrOperationFailure;
         return false;
@@ -953,9 +1183,24 @@ bool ApplicationCacheStorage::storeNewestCache(ApplicationCacheGroup* group, App
         return false;
     }
     
+    storeCacheTransaction.commit();
+    if (storeCacheTransaction.inProgress()) {
+        failureReason = DiskOrOperationFailure;
+        return false;
+    }
+
     groupStorageIDJournal.commit();
     resourceStorageIDJournal.commit();
-    storeCacheTransaction.commit();
+    fileJournal.commit();
+
+#if !LOG_DISABLED
+    int64_t referencedSize;
+    int64_t storedSize;
+    if (resourceDataSize(referencedSize, storedSize))
+        LOG(StorageAPI, "Application cache resource data: %lld bytes referenced by the stored caches, %lld bytes on disk",
+            static_cast<long long>(referencedSize), static_cast<long long>(storedSize));
+#endif
+
     return true;
 }
 
@@ -996,7 +1241,8 @@ static inline void parseHeaders(const String& headers, ResourceResponse& respons
 PassRefPtr<ApplicationCache> ApplicationCacheStorage::loadCache(unsigned storageID)
 {
     SQLiteStatement cacheStatement(m_database, 
-                                   "SELECT url, type, mimeType, textEncodingName, headers, CacheResourceData.data FROM CacheEntries INNER JOIN CacheResources ON CacheEntries.resource=CacheResources.id "
+                                   "SELECT url, type, mimeType, textEncodingName, headers, CacheResourceData.id, CacheResourceData.size, CacheResourceData.path FROM CacheEntries "
+                                   "INNER JOIN CacheResources ON CacheEntries.resource=CacheResources.id "
                                    "INNER JOIN CacheResourceData ON CacheResourceData.id=CacheResources.data WHERE CacheEntries.cache=?");
     if (cacheStatement.prepare() != SQLResultOk) {
         LOG_ERROR("Could not prepare cache statement, error \"%s\"", m_database.lastErrorMsg());
@@ -1006,6 +1252,9 @@ PassRefPtr<ApplicationCache> ApplicationCacheStorage::loadCache(unsigned storage
     cacheStatement.bindInt64(1, storageID);
 
     RefPtr<ApplicationCache> cache = ApplicationCache::create();
+
+    // Resources with identical data share one buffer.
+    HashMap<unsigned, RefPtr<SharedBuffer> > dataForStorageID;
     
     int result;
     while ((result = cacheStatement.step()) == SQLResultRow) {
@@ -1013,10 +1262,17 @@ PassRefPtr<ApplicationCache> ApplicationCacheStorage::loadCache(unsigned storage
         
         unsigned type = static_cast<unsigned>(cacheStatement.getColumnInt64(1));
 
-        Vector<char> blob;
-        cacheStatement.getColumnBlobAsVector(5, blob);
-        
-        RefPtr<SharedBuffer> data = SharedBuffer::adoptVector(blob);
+        unsigned dataStorageID = static_cast<unsigned>(cacheStatement.getColumnInt64(5));
+        RefPtr<SharedBuffer> data = dataForStorageID.get(dataStorageID);
+        if (!data) {
+            Vector<char> blob(static_cast<size_t>(cacheStatement.getColumnInt64(6)));
+            if (blob.size() && !readResourceDataFile(pathByAppendingComponent(resourceDataDirectory(), cacheStatement.getColumnText(7)), blob)) {
+                LOG_ERROR("Could not read the data of cache resource %s", url.string().utf8().data());
+                return 0;
+            }
+            data = SharedBuffer::adoptVector(blob);
+            dataForStorageID.set(dataStorageID, data);
+        }
         
         String mimeType = cacheStatement.getColumnText(2);
         String textEncodingName = cacheStatement.getColumnText(3);
@@ -1120,6 +1376,8 @@ void ApplicationCacheStorage::remove(ApplicationCache* cache)
 
         cache->group()->clearStorageID();
     }
+
+    deleteUnreferencedResourceData();
 }    
 
 void ApplicationCacheStorage::empty()
@@ -1133,6 +1391,7 @@ void ApplicationCacheStorage::empty()
     executeSQLCommand("DELETE FROM CacheGroups");
     executeSQLCommand("DELETE FROM Caches");
     executeSQLCommand("DELETE FROM Origins");
+    deleteUnreferencedResourceData();
     
     // Clear the storage IDs for the caches in memory.
     // The caches will still work, but cached resources will not be saved to disk 
@@ -1267,6 +1526,7 @@ bool ApplicationCacheStorage::deleteCacheGroup(const String& manifestURL)
     }
 
     deleteTransaction.commit();
+    deleteUnreferencedResourceData();
     return true;
 }
 
@@ -1279,6 +1539,115 @@ void ApplicationCacheStorage::vacuumDatabaseFile()
     m_database.runVacuumCommand();
 }
 
+bool ApplicationCacheStorage::resourceDataSize(int64_t& referencedSize, int64_t& storedSize)
+{
+    openDatabase(false);
+    if (!m_database.isOpen())
+        return false;
+
+    SQLiteStatement statement(m_database, "SELECT SUM(size * refCount), SUM(size) FROM CacheResourceData WHERE refCount > 0");
+    if (statement.prepare() != SQLResultOk)
+        return false;
+
+    if (statement.step() != SQLResultRow) {
+        LOG_ERROR("Could not get the size of the resource data, error \"%s\"", m_database.lastErrorMsg());
+        return false;
+    }
+
+    referencedSize = statement.getColumnInt64(0);
+    storedSize = statement.getColumnInt64(1);
+    return true;
+}
+
+String ApplicationCacheStorage::resourceDataDirectory() const
+{
+    return pathByAppendingComponent(m_cacheDirectory, "ApplicationCacheResources");
+}
+
+String ApplicationCacheStorage::pendingResourceDataFileNamesPath() const
+{
+    return pathByAppendingComponent(m_cacheDirectory, "ApplicationCacheResources-pending");
+}
+
+void ApplicationCacheStorage::reclaimPendingResourceDataFiles()
+{
+    String pendingFileNamesPath = pendingResourceDataFileNamesPath();
+    long long pendingFileNamesSize;
+    if (!getFileSize(pendingFileNamesPath, pendingFileNamesSize))
+        return;
+
+    // Whatever a committed row refers to was stored successfully; everything else was left
+    // behind by a store that never finished.
+    Vector<char> pendingFileNames(static_cast<size_t>(pendingFileNamesSize));
+    if (!readResourceDataFile(pendingFileNamesPath, pendingFileNames))
+        return;
+
+    Vector<String> fileNames;
+    String::fromUTF8(pendingFileNames.data(), pendingFileNames.size()).split('\n', fileNames);
+
+    SQLiteStatement statement(m_database, "SELECT id FROM CacheResourceData WHERE path=?");
+    if (statement.prepare() != SQLResultOk)
+        return;
+
+    size_t fileCount = fileNames.size();
+    for (size_t i = 0; i < fileCount; ++i) {
+        statement.bindText(1, fileNames[i]);
+        int result = statement.step();
+        statement.reset();
+        if (result == SQLResultDone)
+            deleteFile(pathByAppendingComponent(resourceDataDirectory(), fileNames[i]));
+        else if (result != SQLResultRow) {
+            LOG_ERROR("Could not look up pending resource data file, error \"%s\"", m_database.lastErrorMsg());
+            return;
+        }
+    }
+
+    deleteFile(pendingFileNamesPath);
+}
+
+int64_t ApplicationCacheStorage::resourceDataFileSize()
+{
+    if (!m_database.isOpen())
+        return 0;
+
+    // Unreferenced data counts as well, since its file is still on disk until it is deleted.
+    SQLiteStatement statement(m_database, "SELECT SUM(size) FROM CacheResourceData");
+    if (statement.prepare() != SQLResultOk || statement.step() != SQLResultRow)
+        return 0;
+
+    return statement.getColumnInt64(0);
+}
+
+void ApplicationCacheStorage::deleteUnreferencedResourceData()
+{
+    // Files can't be deleted while a transaction that might still be rolled back is in progress - if one is, this is left to the next time.
+    if (!m_database.isOpen() || m_database.transactionInProgress())
+        return;
+
+    SQLiteStatement selectStatement(m_database, "SELECT path FROM CacheResourceData WHERE refCount <= 0 AND path IS NOT NULL");
+    if (selectStatement.prepare() != SQLResultOk)
+        return;
+
+    Vector<String> paths;
+    int result;
+    while ((result = selectStatement.step()) == SQLResultRow)
+        paths.append(pathByAppendingComponent(resourceDataDirectory(), selectStatement.getColumnText(0)));
+
+    if (result != SQLResultDone) {
+        LOG_ERROR("Could not load unreferenced resource data, error \"%s\"", m_database.lastErrorMsg());
+        return;
+    }
+    selectStatement.finalize();
+
+    // Delete the rows first - should that fail, the files must stay around for them.
+    if (!executeSQLCommand("DELETE FROM CacheResourceData WHERE refCount <= 0"))
+        return;
+
+    size_t pathCount = paths.size();
+    for (size_t i = 0; i < pathCount; ++i)
+        deleteFile(paths[i]);
+}
+
 void ApplicationCacheStorage::checkForMaxSizeReached()
 {
     if (m_database.lastError() == SQLResultFull)
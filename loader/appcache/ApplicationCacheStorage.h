@@ -40,9 +40,11 @@ class ApplicationCacheGroup;
 class ApplicationCacheHost;
 class ApplicationCacheResource;
 class KURL;
+class ResourceDataFileJournal;
 template <class T>
 class StorageIDJournal;
 class SecurityOrigin;
+class SharedBuffer;
 
 class ApplicationCacheStorage : public Noncopyable {
 public:
@@ -91,6 +93,10 @@ public:
     bool deleteCacheGroup(const String& manifestURL);
     void vacuumDatabaseFile();
 
+    // Resource data that is identical across resources, caches and cache groups is only stored once.
+    // referencedSize is the size of the resource data of all stored caches, storedSize the size of the files holding it.
+    bool resourceDataSize(int64_t& referencedSize, int64_t& storedSize);
+
     static int64_t unknownQuota() { return -1; }
     static int64_t noQuota() { return std::numeric_limits<int64_t>::max(); }
 private:
@@ -102,8 +108,15 @@ private:
     typedef StorageIDJournal<ApplicationCacheGroup> GroupStorageIDJournal;
 
     bool store(ApplicationCacheGroup*, GroupStorageIDJournal*);
-    bool store(ApplicationCache*, ResourceStorageIDJournal*);
-    bool store(ApplicationCacheResource*, unsigned cacheStorageID);
+    bool store(ApplicationCache*, ResourceStorageIDJournal*, ResourceDataFileJournal*);
+    bool store(ApplicationCacheResource*, unsigned cacheStorageID, ResourceDataFileJournal*);
+    bool storeResourceData(SharedBuffer*, ResourceDataFileJournal*, unsigned& dataStorageID);
+
+    String resourceDataDirectory() const;
+    String pendingResourceDataFileNamesPath() const;
+    void reclaimPendingResourceDataFiles();
+    int64_t resourceDataFileSize();
+    void deleteUnreferencedResourceData();
 
     bool ensureOriginRecord(const SecurityOrigin*);
 
@@ -33,6 +33,7 @@
 #include "DocumentLoader.h"
 #include "FileSystem.h"
 #include "IconDatabaseClient.h"
+#include "IconMappingSnapshot.h"
 #include "IconRecord.h"
 #include "IntSize.h"
 #include "Logging.h"
@@ -133,6 +134,9 @@ bool IconDatabase::open(const String& databasePath)
     // Formulate the full path for the database file
     m_completeDatabasePath = pathByAppendingComponent(m_databaseDirectory, defaultDatabaseFilename());
 
+    m_openTime = currentTime();
+    m_ignoreMappingSnapshots = false;
+
     // Lock here as well as first thing in the thread so the thread doesn't actually commence until the createThread() call 
     // completes and m_syncThreadRunning is properly set
     m_syncLock.lock();
@@ -163,6 +167,12 @@ void IconDatabase::close()
     m_threadTerminationRequested = false;
     m_removeIconsRequested = false;
 
+    LOG(IconDatabase, "%u of %u page URL lookups were answered by a mapping snapshot", m_mappingSnapshotHitCount, m_mappingSnapshotLookupCount);
+    m_mappingSnapshot.clear();
+    m_mappingSnapshotIsComplete = false;
+    m_pageURLsChangedSinceMappingSnapshot.clear();
+    ++m_mappingSnapshotSession;
+
     m_syncDB.close();
     ASSERT(!isOpen());
 }
@@ -175,6 +185,12 @@ void IconDatabase::removeAllIcons()
         return;
 
     LOG(IconDatabase, "Requesting background thread to remove all icons");
+
+    // Until the sync thread has emptied the database, any snapshot it hands over is out of date.
+    m_mappingSnapshot.clear();
+    m_mappingSnapshotIsComplete = false;
+    m_pageURLsChangedSinceMappingSnapshot.clear();
+    m_ignoreMappingSnapshots = true;
     
     // Clear the in-memory record of every IconRecord, anything waiting to be read from disk, and anything waiting to be written to disk
     {
@@ -217,6 +233,11 @@ Image* IconDatabase::iconForPageURL(const String& pageURLOriginal, const IntSize
 
     // pageURLOriginal cannot be stored without being deep copied first.  
     // We should go our of our way to only copy it if we have to store it
+
+    // A page URL that the complete mapping snapshot has no icon URL for has no icon, and nothing has to be read for it
+    String snapshotIconURL;
+    if (iconURLFromMappingSnapshot(pageURLOriginal, snapshotIconURL) && snapshotIconURL.isNull())
+        return 0;
     
     if (!isOpen() || pageURLOriginal.isEmpty())
         return defaultIcon(size);
@@ -304,6 +325,10 @@ String IconDatabase::iconURLForPageURL(const String& pageURLOriginal)
         
     // Cannot do anything with pageURLOriginal that would end up storing it without deep copying first
     // Also, in the case we have a real answer for the caller, we must deep copy that as well
+
+    String iconURL;
+    if (iconURLFromMappingSnapshot(pageURLOriginal, iconURL))
+        return iconURL;
     
     if (!isOpen() || pageURLOriginal.isEmpty())
         return String();
@@ -464,6 +489,7 @@ void IconDatabase::releaseIconForPageURL(const String& pageURLOriginal)
     LOG(IconDatabase, "No more retainers for PageURL %s", urlForLogging(pageURLOriginal).ascii().data());
     m_pageURLToRecordMap.remove(pageURLOriginal);
     m_retainedPageURLs.remove(pageURLOriginal);       
+    m_pageURLsChangedSinceMappingSnapshot.add(pageURLOriginal);
     
     // Grab the iconRecord for later use (and do a sanity check on it for kicks)
     IconRecord* iconRecord = pageRecord->iconRecord();
@@ -626,6 +652,8 @@ void IconDatabase::setIconURLForPageURL(const String& iconURLOriginal, const Str
     // Since this mapping is new, send the notification out - but not if we're on the sync thread because that implies this mapping
     // comes from the initial import which we don't want notifications for
     if (!IS_ICON_SYNC_THREAD()) {
+        m_pageURLsChangedSinceMappingSnapshot.add(pageURL);
+
         // Start the timer to commit this change - or further delay the timer if it was already started
         scheduleOrDeferSyncTimer();
         
@@ -758,6 +786,12 @@ size_t IconDatabase::iconRecordCountWithData()
 IconDatabase::IconDatabase()
     : m_syncTimer(this, &IconDatabase::syncTimerFired)
     , m_syncThreadRunning(false)
+    , m_mappingSnapshotIsComplete(false)
+    , m_mappingSnapshotSession(0)
+    , m_ignoreMappingSnapshots(false)
+    , m_openTime(0)
+    , m_mappingSnapshotLookupCount(0)
+    , m_mappingSnapshotHitCount(0)
     , m_isEnabled(false)
     , m_privateBrowsingEnabled(false)
     , m_threadTerminationRequested(false)
@@ -768,6 +802,7 @@ IconDatabase::IconDatabase()
     , m_client(defaultClient())
     , m_imported(false)
     , m_isImportedSet(false)
+    , m_pageURLMappingsChangedSinceSnapshot(false)
 {
     ASSERT(isMainThread());
 }
@@ -800,6 +835,58 @@ void IconDatabase::notifyPendingLoadDecisions()
     m_loadersPendingDecision.clear();
 }
 
+struct IconDatabase::MappingSnapshotHandoff {
+    IconDatabase* database;
+    OwnPtr<IconMappingSnapshot> snapshot;
+    bool isComplete;
+    unsigned session;
+};
+
+void IconDatabase::installMappingSnapshotOnMainThread(void* context)
+{
+    OwnPtr<MappingSnapshotHandoff> handoff = adoptPtr(static_cast<MappingSnapshotHandoff*>(context));
+    handoff->database->installMappingSnapshot(*handoff);
+}
+
+void IconDatabase::installMappingSnapshot(MappingSnapshotHandoff& handoff)
+{
+    ASSERT_NOT_SYNC_THREAD();
+
+    if (handoff.session != m_mappingSnapshotSession)
+        return;
+
+    // The sync thread hands over no snapshot once it has removed all icons - snapshots after that one are current again
+    if (!handoff.snapshot) {
+        m_ignoreMappingSnapshots = false;
+        return;
+    }
+
+    if (m_ignoreMappingSnapshots)
+        return;
+
+    LOG(IconDatabase, "Installed %s snapshot of %u page URL mappings %.4f seconds after opening - %u of %u lookups so far were answered by a snapshot",
+        handoff.isComplete ? "a complete" : "the previous session's", handoff.snapshot->size(), currentTime() - m_openTime, m_mappingSnapshotHitCount, m_mappingSnapshotLookupCount);
+    m_mappingSnapshot = handoff.snapshot.release();
+    m_mappingSnapshotIsComplete = handoff.isComplete;
+}
+
+// Returns true if the mapping snapshot can answer for the page URL, with a null iconURL meaning the page has no icon
+bool IconDatabase::iconURLFromMappingSnapshot(const String& pageURL, String& iconURL)
+{
+    ASSERT_NOT_SYNC_THREAD();
+
+    if (!m_mappingSnapshot || pageURL.isEmpty() || m_pageURLsChangedSinceMappingSnapshot.contains(pageURL))
+        return false;
+
+    ++m_mappingSnapshotLookupCount;
+    iconURL = m_mappingSnapshot->iconURLForPageURL(pageURL);
+    if (iconURL.isNull() && !m_mappingSnapshotIsComplete)
+        return false;
+
+    ++m_mappingSnapshotHitCount;
+    return true;
+}
+
 void IconDatabase::wakeSyncThread()
 {
     MutexLocker locker(m_syncLock);
@@ -969,6 +1056,7 @@ void* IconDatabase::iconDatabaseSyncThread()
     // Existence of a journal file is evidence of a previous crash/force quit and automatically qualifies
     // us to do an integrity check
     String journalFilename = m_completeDatabasePath + "-journal";
+    m_mappingSnapshotPath = m_completeDatabasePath + "-mappings";
     if (!checkIntegrityOnOpen) {
         AutodrainedPool pool;
         checkIntegrityOnOpen = fileExists(journalFilename);
@@ -1000,6 +1088,9 @@ void* IconDatabase::iconDatabaseSyncThread()
     timeStamp = newStamp;
 #endif 
 
+    // Until the URL import below has finished, the mappings the last session left behind can already answer lookups
+    readMappingSnapshot();
+
     if (!imported()) {
         LOG(IconDatabase, "(THREAD) Performing Safari2 import procedure");
         SQLiteTransaction importTransaction(m_syncDB);
@@ -1126,6 +1217,7 @@ void IconDatabase::performOpenInitialization()
                 // Should've been consumed by SQLite, delete just to make sure we don't see it again in the future;
                 deleteFile(m_completeDatabasePath + "-journal");
                 deleteFile(m_completeDatabasePath);
+                deleteFile(m_mappingSnapshotPath);
             }
             
             // Reopen the write database, creating it from scratch
@@ -1149,6 +1241,7 @@ void IconDatabase::performOpenInitialization()
         LOG(IconDatabase, "%s is missing or in an invalid state - reconstructing", m_completeDatabasePath.ascii().data());
         m_syncDB.clearAllTables();
         createDatabaseTables(m_syncDB);
+        deleteFile(m_mappingSnapshotPath);
     }
 
     // Reduce sqlite RAM cache size from default 2000 pages (~1.5kB per page). 3MB of cache for icon database is overkill
@@ -1203,6 +1296,10 @@ void IconDatabase::performURLImport()
     // Informal testing shows that draining the autorelease pool every 25 iterations is about as low as we can go
     // before performance starts to drop off, but we don't want to increase this number because then accumulated memory usage will go up
     AutodrainedPool pool(25);
+
+    // The snapshot has to agree with iconURLForPageURL(), so it only gets the mappings the import keeps a PageURLRecord for.
+    // Those are also the ones pruneUnretainedIcons() leaves on disk.
+    Vector<std::pair<String, String> > importedMappings;
         
     int result = query.step();
     while (result == SQLResultRow) {
@@ -1235,6 +1332,8 @@ void IconDatabase::performURLImport()
                 // Regardless, the time stamp from disk still takes precedence.  Until we read this icon from disk, we didn't think we'd seen it before
                 // so we marked the timestamp as "now", but it's really much older
                 currentIcon->setTimestamp(query.getColumnInt(2));
+
+                importedMappings.append(std::make_pair(pageURL, iconURL));
             }            
         }
         
@@ -1276,6 +1375,7 @@ void IconDatabase::performURLImport()
     }
     
     Vector<String> urlsToNotify;
+    HashSet<String> removedPageURLs;
     
     // Loop through the urls pending import
     // Remove unretained ones if database cleanup is allowed
@@ -1308,6 +1408,7 @@ void IconDatabase::performURLImport()
                     }
                     
                     delete record;
+                    removedPageURLs.add(urls[i]);
                 }
             } else {
                 urlsToNotify.append(urls[i]);
@@ -1315,6 +1416,22 @@ void IconDatabase::performURLImport()
         }
     }
 
+    if (result == SQLResultDone) {
+#ifndef NDEBUG
+        double timeStamp = currentTime();
+#endif
+        IconMappingSnapshot::Builder snapshotBuilder;
+        for (size_t i = 0; i < importedMappings.size(); ++i) {
+            if (!removedPageURLs.contains(importedMappings[i].first))
+                snapshotBuilder.add(importedMappings[i].first, importedMappings[i].second);
+        }
+        OwnPtr<IconMappingSnapshot> snapshot = snapshotBuilder.build();
+        if (snapshot->write(m_mappingSnapshotPath))
+            m_pageURLMappingsChangedSinceSnapshot = false;
+        LOG(IconDatabase, "Building and writing a snapshot of %lu page URL mappings took %.4f seconds", static_cast<unsigned long>(snapshotBuilder.size()), currentTime() - timeStamp);
+        handOffMappingSnapshot(snapshot.release(), true);
+    }
+
     LOG(IconDatabase, "Notifying %lu interested page URLs that their icon URL is known due to the import", static_cast<unsigned long>(urlsToNotify.size()));
     // Now that we don't hold any locks, perform the actual notifications
     for (unsigned i = 0; i < urlsToNotify.size(); ++i) {
@@ -1574,6 +1691,10 @@ bool IconDatabase::writeToDatabase()
     
     if (iconSnapshots.size() || pageSnapshots.size())
         didAnyWork = true;
+
+    // Removing an icon removes the page URL mappings to it as well
+    if (didAnyWork)
+        invalidateMappingSnapshotFile();
         
     SQLiteTransaction syncTransaction(m_syncDB);
     syncTransaction.begin();
@@ -1637,6 +1758,8 @@ void IconDatabase::pruneUnretainedIcons()
     // Delete page URLs that were in the table, but not in our retain count set.
     size_t numToDelete = pageIDsToDelete.size();
     if (numToDelete) {
+        invalidateMappingSnapshotFile();
+
         SQLiteTransaction pruningTransaction(m_syncDB);
         pruningTransaction.begin();
         
@@ -1724,11 +1847,95 @@ void IconDatabase::removeAllIconsOnThread()
     m_syncDB.clearAllTables();
     m_syncDB.runVacuumCommand();
     createDatabaseTables(m_syncDB);
+
+    // There are no mappings left - let the main thread know that the snapshots it gets from here on can be trusted again
+    deleteFile(m_mappingSnapshotPath);
+    m_pageURLMappingsChangedSinceSnapshot = false;
+    handOffMappingSnapshot(0, false);
     
     LOG(IconDatabase, "Dispatching notification that we removed all icons");
     m_client->dispatchDidRemoveAllIcons();    
 }
 
+void IconDatabase::readMappingSnapshot()
+{
+    ASSERT_ICON_SYNC_THREAD();
+
+#ifndef NDEBUG
+    double timeStamp = currentTime();
+#endif
+
+    OwnPtr<IconMappingSnapshot> snapshot = IconMappingSnapshot::read(m_mappingSnapshotPath);
+    if (!snapshot) {
+        LOG(IconDatabase, "No usable page URL mapping snapshot at %s", m_mappingSnapshotPath.ascii().data());
+        return;
+    }
+
+    LOG(IconDatabase, "Reading a snapshot of %u page URL mappings took %.4f seconds", snapshot->size(), currentTime() - timeStamp);
+    handOffMappingSnapshot(snapshot.release(), false);
+}
+
+void IconDatabase::writeMappingSnapshot()
+{
+    ASSERT_ICON_SYNC_THREAD();
+
+    if (!m_syncDB.isOpen())
+        return;
+
+#ifndef NDEBUG
+    double timeStamp = currentTime();
+#endif
+
+    SQLiteStatement query(m_syncDB, "SELECT PageURL.url, IconInfo.url FROM PageURL INNER JOIN IconInfo ON PageURL.iconID=IconInfo.iconID;");
+    if (query.prepare() != SQLResultOk) {
+        LOG_ERROR("Unable to prepare page URL mapping snapshot query");
+        return;
+    }
+
+    IconMappingSnapshot::Builder snapshotBuilder;
+    int result;
+    while ((result = query.step()) == SQLResultRow)
+        snapshotBuilder.add(query.getColumnText(0), query.getColumnText(1));
+
+    if (result != SQLResultDone) {
+        LOG_ERROR("Error reading page->icon url mappings for the mapping snapshot");
+        return;
+    }
+
+    if (!snapshotBuilder.build()->write(m_mappingSnapshotPath)) {
+        LOG_ERROR("Unable to write page URL mapping snapshot to %s", m_mappingSnapshotPath.ascii().data());
+        return;
+    }
+
+    m_pageURLMappingsChangedSinceSnapshot = false;
+    LOG(IconDatabase, "Writing a snapshot of %lu page URL mappings took %.4f seconds", static_cast<unsigned long>(snapshotBuilder.size()), currentTime() - timeStamp);
+}
+
+// Called before the first change to the mappings on disk, so that a crash can't leave the next session a snapshot that disagrees with them
+void IconDatabase::invalidateMappingSnapshotFile()
+{
+    ASSERT_ICON_SYNC_THREAD();
+
+    if (m_pageURLMappingsChangedSinceSnapshot)
+        return;
+
+    deleteFile(m_mappingSnapshotPath);
+    m_pageURLMappingsChangedSinceSnapshot = true;
+}
+
+void IconDatabase::handOffMappingSnapshot(PassOwnPtr<IconMappingSnapshot> snapshot, bool isComplete)
+{
+    ASSERT_ICON_SYNC_THREAD();
+
+    // m_mappingSnapshotSession only changes in close(), after this thread has been joined
+    MappingSnapshotHandoff* handoff = new MappingSnapshotHandoff;
+    handoff->database = this;
+    handoff->snapshot = snapshot;
+    handoff->isComplete = isComplete;
+    handoff->session = m_mappingSnapshotSession;
+    callOnMainThread(installMappingSnapshotOnMainThread, handoff);
+}
+
 void IconDatabase::deleteAllPreparedStatements()
 {
     ASSERT_ICON_SYNC_THREAD();
@@ -1764,12 +1971,17 @@ void* IconDatabase::cleanupSyncThread()
     // Sync remaining icons out
     LOG(IconDatabase, "(THREAD) Doing final writeout and closure of sync thread");
     writeToDatabase();
+
+    // Leave the next session a snapshot of the mappings as they are now
+    if (m_pageURLMappingsChangedSinceSnapshot)
+        writeMappingSnapshot();
     
     // Close the database
     MutexLocker locker(m_syncLock);
     
     m_databaseDirectory = String();
     m_completeDatabasePath = String();
+    m_mappingSnapshotPath = String();
     deleteAllPreparedStatements();    
     m_syncDB.close();
     
@@ -45,6 +45,7 @@ class DocumentLoader;
 class Image;
 class IntSize;
 class IconDatabaseClient;
+class IconMappingSnapshot;
 class IconRecord;
 class IconSnapshot;
 class KURL;
@@ -112,6 +113,11 @@ private:
     static void notifyPendingLoadDecisionsOnMainThread(void*);
     void notifyPendingLoadDecisions();
 
+    struct MappingSnapshotHandoff;
+    static void installMappingSnapshotOnMainThread(void*);
+    void installMappingSnapshot(MappingSnapshotHandoff&);
+    bool iconURLFromMappingSnapshot(const String& pageURL, String& iconURL);
+
     void wakeSyncThread();
     void scheduleOrDeferSyncTimer();
     void syncTimerFired(Timer<IconDatabase>*);
@@ -123,6 +129,21 @@ private:
     HashSet<RefPtr<DocumentLoader> > m_loadersPendingDecision;
 
     RefPtr<IconRecord> m_defaultIconRecord;
+
+    // A read-only copy of the page URL to icon URL mappings on disk, handed over by the sync thread so that
+    // lookups don't have to wait for the URL import or take m_urlAndIconLock. Page URLs whose mapping changed
+    // after it was taken are answered from the records instead.
+    OwnPtr<IconMappingSnapshot> m_mappingSnapshot;
+    // The snapshot from the previous session may lack mappings that were added late in it. Once the URL
+    // import has finished the snapshot holds every mapping on disk, so a page URL it lacks has no icon.
+    bool m_mappingSnapshotIsComplete;
+    HashSet<String> m_pageURLsChangedSinceMappingSnapshot;
+    // Snapshots handed over by an earlier session, or from before removeAllIcons(), are dropped.
+    unsigned m_mappingSnapshotSession;
+    bool m_ignoreMappingSnapshots;
+    double m_openTime;
+    unsigned m_mappingSnapshotLookupCount;
+    unsigned m_mappingSnapshotHitCount;
 #endif // ENABLE(ICONDATABASE)
 
 // *** Any Thread ***
@@ -195,6 +216,11 @@ private:
     void deleteAllPreparedStatements();
     void* cleanupSyncThread();
 
+    void readMappingSnapshot();
+    void writeMappingSnapshot();
+    void invalidateMappingSnapshotFile();
+    void handOffMappingSnapshot(PassOwnPtr<IconMappingSnapshot>, bool isComplete);
+
     // Record (on disk) whether or not Safari 2-style icons were imported (once per dataabse)
     bool imported();
     void setImported(bool);
@@ -218,6 +244,9 @@ private:
     // Track whether the "Safari 2" import is complete and/or set in the database
     bool m_imported;
     bool m_isImportedSet;
+
+    String m_mappingSnapshotPath;
+    bool m_pageURLMappingsChangedSinceSnapshot;
     
     OwnPtr<SQLiteStatement> m_setIconIDForPageURLStatement;
     OwnPtr<SQLiteStatement> m_removePageURLStatement;
@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2026 The WebKit Authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "IconMappingSnapshot.h"
+
+#if ENABLE(ICONDATABASE)
+
+#include "FileSystem.h"
+#include <wtf/HashMap.h>
+#include <wtf/text/StringHash.h>
+
+namespace WebCore {
+
+// A snapshot is a SnapshotHeader, then bucketCount SnapshotBuckets forming an open addressed hash table
+// keyed by page URL, then the strings. Each string is a 32-bit length followed by its UTF-16 code units,
+// padded to a multiple of four bytes. Icon URLs are shared by many pages, so each is stored once.
+// Everything is in the byte order of the machine, which is the only one that reads the file back.
+static const uint32_t snapshotSignature = 0x49434d53;
+static const uint32_t snapshotVersion = 1;
+static const long long maximumSnapshotSize = 64 * 1024 * 1024;
+
+struct SnapshotHeader {
+    uint32_t signature;
+    uint32_t version;
+    uint32_t size;
+    uint32_t bucketCount;
+    uint32_t mappingCount;
+};
+
+// No string starts at offset 0, since the header is there, so a zero pageURLOffset marks an empty bucket.
+struct SnapshotBucket {
+    uint32_t hash;
+    uint32_t pageURLOffset;
+    uint32_t iconURLOffset;
+};
+
+static uint32_t appendString(Vector<char>& data, const String& string)
+{
+    uint32_t offset = data.size();
+    uint32_t length = string.length();
+    data.append(reinterpret_cast<const char*>(&length), sizeof(length));
+    data.append(reinterpret_cast<const char*>(string.characters()), length * sizeof(UChar));
+    while (data.size() % sizeof(uint32_t))
+        data.append(0);
+    return offset;
+}
+
+void IconMappingSnapshot::Builder::add(const String& pageURL, const String& iconURL)
+{
+    if (pageURL.isEmpty() || iconURL.isEmpty())
+        return;
+    m_mappings.append(std::make_pair(pageURL, iconURL));
+}
+
+PassOwnPtr<IconMappingSnapshot> IconMappingSnapshot::Builder::build() const
+{
+    // Keep the table at most half full, so that misses find an empty bucket quickly.
+    unsigned bucketCount = 8;
+    while (bucketCount < m_mappings.size() * 2)
+        bucketCount *= 2;
+    unsigned mask = bucketCount - 1;
+
+    // Each slot holds the index of its mapping plus one. A page URL added more than once keeps the last icon URL.
+    Vector<unsigned> slots;
+    slots.fill(0, bucketCount);
+    for (size_t i = 0; i < m_mappings.size(); ++i) {
+        const String& pageURL = m_mappings[i].first;
+        unsigned slot = pageURL.impl()->hash() & mask;
+        while (slots[slot] && m_mappings[slots[slot] - 1].first != pageURL)
+            slot = (slot + 1) & mask;
+        slots[slot] = i + 1;
+    }
+
+    Vector<char> data;
+    data.fill(0, sizeof(SnapshotHeader) + bucketCount * sizeof(SnapshotBucket));
+
+    Vector<SnapshotBucket> buckets(bucketCount);
+    HashMap<String, uint32_t> iconURLOffsets;
+    unsigned mappingCount = 0;
+    for (unsigned slot = 0; slot < bucketCount; ++slot) {
+        SnapshotBucket& bucket = buckets[slot];
+        if (!slots[slot]) {
+            bucket.hash = 0;
+            bucket.pageURLOffset = 0;
+            bucket.iconURLOffset = 0;
+            continue;
+        }
+
+        const std::pair<String, String>& mapping = m_mappings[slots[slot] - 1];
+        bucket.hash = mapping.first.impl()->hash();
+        bucket.pageURLOffset = appendString(data, mapping.first);
+        pair<HashMap<String, uint32_t>::iterator, bool> result = iconURLOffsets.add(mapping.second, 0);
+        if (result.second)
+            result.first->second = appendString(data, mapping.second);
+        bucket.iconURLOffset = result.first->second;
+        ++mappingCount;
+    }
+
+    SnapshotHeader* header = reinterpret_cast<SnapshotHeader*>(data.data());
+    header->signature = snapshotSignature;
+    header->version = snapshotVersion;
+    header->size = data.size();
+    header->bucketCount = bucketCount;
+    header->mappingCount = mappingCount;
+    memcpy(data.data() + sizeof(SnapshotHeader), buckets.data(), bucketCount * sizeof(SnapshotBucket));
+
+    return adoptPtr(new IconMappingSnapshot(data));
+}
+
+IconMappingSnapshot::IconMappingSnapshot(Vector<char>& data)
+{
+    m_data.swap(data);
+}
+
+PassOwnPtr<IconMappingSnapshot> IconMappingSnapshot::read(const String& path)
+{
+    long long fileSize;
+    if (!getFileSize(path, fileSize) || fileSize < static_cast<long long>(sizeof(SnapshotHeader)) || fileSize > maximumSnapshotSize)
+        return 0;
+
+    PlatformFileHandle handle = openFile(path, OpenForRead);
+    if (!isHandleValid(handle))
+        return 0;
+
+    Vector<char> data(static_cast<size_t>(fileSize));
+    size_t totalBytesRead = 0;
+    while (totalBytesRead < data.size()) {
+        int bytesRead = readFromFile(handle, data.data() + totalBytesRead, data.size() - totalBytesRead);
+        if (bytesRead <= 0)
+            break;
+        totalBytesRead += bytesRead;
+    }
+    closeFile(handle);
+    if (totalBytesRead != data.size())
+        return 0;
+
+    // The strings are checked as they are looked up. The header has to be right for the buckets to be usable at all,
+    // and its size catches a snapshot that was only partly written.
+    const SnapshotHeader* header = reinterpret_cast<const SnapshotHeader*>(data.data());
+    if (header->signature != snapshotSignature || header->version != snapshotVersion || header->size != data.size())
+        return 0;
+    if (!header->bucketCount || (header->bucketCount & (header->bucketCount - 1)))
+        return 0;
+    if ((data.size() - sizeof(SnapshotHeader)) / sizeof(SnapshotBucket) < header->bucketCount)
+        return 0;
+
+    return adoptPtr(new IconMappingSnapshot(data));
+}
+
+bool IconMappingSnapshot::write(const String& path) const
+{
+    PlatformFileHandle handle = openFile(path, OpenForWrite);
+    if (!isHandleValid(handle))
+        return false;
+
+    int bytesWritten = writeToFile(handle, m_data.data(), m_data.size());
+    closeFile(handle);
+    if (bytesWritten == static_cast<int>(m_data.size()))
+        return true;
+
+    // read() would reject the partial file anyway, but there is no point in keeping it around.
+    deleteFile(path);
+    return false;
+}
+
+bool IconMappingSnapshot::stringAt(unsigned offset, const UChar*& characters, unsigned& length) const
+{
+    if (offset < sizeof(SnapshotHeader) || offset % sizeof(uint32_t) || offset > m_data.size() - sizeof(uint32_t))
+        return false;
+
+    length = *reinterpret_cast<const uint32_t*>(m_data.data() + offset);
+    if ((m_data.size() - offset - sizeof(uint32_t)) / sizeof(UChar) < length)
+        return false;
+
+    characters = reinterpret_cast<const UChar*>(m_data.data() + offset + sizeof(uint32_t));
+    return true;
+}
+
+String IconMappingSnapshot::iconURLForPageURL(const String& pageURL) const
+{
+    if (pageURL.isEmpty())
+        return String();
+
+    const SnapshotHeader* header = reinterpret_cast<const SnapshotHeader*>(m_data.data());
+    const SnapshotBucket* buckets = reinterpret_cast<const SnapshotBucket*>(m_data.data() + sizeof(SnapshotHeader));
+    unsigned mask = header->bucketCount - 1;
+    unsigned hash = pageURL.impl()->hash();
+
+    for (unsigned probe = 0, slot = hash & mask; probe <= mask; ++probe, slot = (slot + 1) & mask) {
+        const SnapshotBucket& bucket = buckets[slot];
+        if (!bucket.pageURLOffset)
+            return String();
+        if (bucket.hash != hash)
+            continue;
+
+        const UChar* characters;
+        unsigned length;
+        if (!stringAt(bucket.pageURLOffset, characters, length))
+            return String();
+        if (length != pageURL.length() || memcmp(characters, pageURL.characters(), length * sizeof(UChar)))
+            continue;
+
+        if (!stringAt(bucket.iconURLOffset, characters, length))
+            return String();
+        return String(characters, length);
+    }
+
+    return String();
+}
+
+unsigned IconMappingSnapshot::size() const
+{
+    return reinterpret_cast<const SnapshotHeader*>(m_data.data())->mappingCount;
+}
+
+} // namespace WebCore
+
+#endif // ENABLE(ICONDATABASE)
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2026 The WebKit Authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef IconMappingSnapshot_h
+#define IconMappingSnapshot_h
+
+#include "PlatformString.h"
+#include <wtf/Noncopyable.h>
+#include <wtf/PassOwnPtr.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+// An immutable hash table of page URL to icon URL mappings, laid out as one block of bytes so that
+// it can be written to disk and read back in a single read. Once created it is never modified, so
+// it can be handed from the icon database sync thread to the main thread and read without locking.
+class IconMappingSnapshot : public Noncopyable {
+public:
+    class Builder : public Noncopyable {
+    public:
+        void add(const String& pageURL, const String& iconURL);
+        size_t size() const { return m_mappings.size(); }
+        PassOwnPtr<IconMappingSnapshot> build() const;
+
+    private:
+        Vector<std::pair<String, String> > m_mappings;
+    };
+
+    // Returns 0 if the file doesn't exist or isn't a complete snapshot.
+    static PassOwnPtr<IconMappingSnapshot> read(const String& path);
+    bool write(const String& path) const;
+
+    // Returns a null string if the snapshot has no mapping for the page URL.
+    String iconURLForPageURL(const String& pageURL) const;
+
+    unsigned size() const;
+
+private:
+    explicit IconMappingSnapshot(Vector<char>& data);
+
+    bool stringAt(unsigned offset, const UChar*& characters, unsigned& length) const;
+
+    Vector<char> m_data;
+};
+
+} // namespace WebCore
+
+#endif // IconMappingSnapshot_h
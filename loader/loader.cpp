@@ -408,6 +408,7 @@ void Loader::Host::didFinishLoading(SubresourceLoader* loader)
         docLoader->setLoadInProgress(true);
         resource->data(loader->resourceData(), true);
         resource->finish();
+        cache()->storeInDiskCache(resource, docLoader);
     }
 
     delete request;
@@ -45,7 +45,7 @@ MathMLElement::MathMLElement(const QualifiedName& tagName, Document* document)
     
 PassRefPtr<MathMLElement> MathMLElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new MathMLElement(tagName, document));
+    return adoptRef(new (document) MathMLElement(tagName, document));
 }
 
 bool MathMLElement::mapToEntry(const QualifiedName& attrName, MappedAttributeEntry& result) const
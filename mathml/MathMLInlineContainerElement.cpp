@@ -51,7 +51,7 @@ MathMLInlineContainerElement::MathMLInlineContainerElement(const QualifiedName&
 
 PassRefPtr<MathMLInlineContainerElement> MathMLInlineContainerElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new MathMLInlineContainerElement(tagName, document));
+    return adoptRef(new (document) MathMLInlineContainerElement(tagName, document));
 }
 
 RenderObject* MathMLInlineContainerElement::createRenderer(RenderArena* arena, RenderStyle*)
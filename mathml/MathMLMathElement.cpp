@@ -41,7 +41,7 @@ inline MathMLMathElement::MathMLMathElement(const QualifiedName& tagName, Docume
 
 PassRefPtr<MathMLMathElement> MathMLMathElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new MathMLMathElement(tagName, document));
+    return adoptRef(new (document) MathMLMathElement(tagName, document));
 }
 
 RenderObject* MathMLMathElement::createRenderer(RenderArena* arena, RenderStyle*)
@@ -44,7 +44,7 @@ inline MathMLTextElement::MathMLTextElement(const QualifiedName& tagName, Docume
 
 PassRefPtr<MathMLTextElement> MathMLTextElement::create(const QualifiedName& tagName, Document* document)
 {
-    return adoptRef(new MathMLTextElement(tagName, document));
+    return adoptRef(new (document) MathMLTextElement(tagName, document));
 }
 
 RenderObject* MathMLTextElement::createRenderer(RenderArena* arena, RenderStyle* style)
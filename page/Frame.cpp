@@ -75,6 +75,7 @@
 #include "Settings.h"
 #include "TextIterator.h"
 #include "TextResourceDecoder.h"
+#include "TextSearchIndex.h"
 #include "UserContentURLPattern.h"
 #include "UserTypingGestureIndicator.h"
 #include "XMLNSNames.h"
@@ -1180,6 +1181,10 @@ bool Frame::findString(const String& target, bool forward, bool caseFlag, bool w
     if (excludeFromTextSearch())
         return false;
 
+    // Text in blocks whose layout was deferred has no text boxes for the TextIterator to find.
+    if (m_view)
+        m_view->layoutDeferredContent();
+
     // Start from an edge of the selection, if there's a selection that's not in shadow content. Which edge
     // is used depends on whether we're searching forward or backward, and whether startInSelection is set.
     RefPtr<Range> searchRange(rangeOfContents(document()));
@@ -1263,6 +1268,45 @@ unsigned Frame::markAllMatchesForText(const String& target, bool caseFlag, unsig
     if (target.isEmpty())
         return 0;
 
+    if (m_view)
+        m_view->layoutDeferredContent();
+
+    unsigned matchCount = 0;
+    if (TextSearchIndex* index = document()->textSearchIndex()) {
+        const Vector<FlattenedText::Match>& matches = index->findMatches(target, caseFlag);
+        Vector<RefPtr<Range> > matchRanges;
+        size_t candidateCount = matches.size();
+        for (size_t i = 0; i < candidateCount; ++i) {
+            RefPtr<Range> resultRange = index->rangeForMatch(matches[i]);
+            if (!editor()->insideVisibleArea(resultRange.get()))
+                continue;
+            matchRanges.append(resultRange.release());
+            if (limit > 0 && matchRanges.size() >= limit)
+                break;
+        }
+        matchCount = matchRanges.size();
+        document()->markers()->addMarkers(matchRanges, DocumentMarker::TextMatch);
+    } else
+        matchCount = markAllMatchesForTextInDocument(target, caseFlag, limit);
+
+    // Do a "fake" paint in order to execute the code that computes the rendered rect for
+    // each text match.
+    Document* doc = document();
+    if (m_view && contentRenderer()) {
+        doc->updateLayout(); // Ensure layout is up to date.
+        IntRect visibleRect = m_view->visibleContentRect();
+        if (!visibleRect.isEmpty()) {
+            GraphicsContext context((PlatformGraphicsContext*)0);
+            context.setPaintingDisabled(true);
+            m_view->paintContents(&context, visibleRect);
+        }
+    }
+
+    return matchCount;
+}
+
+unsigned Frame::markAllMatchesForTextInDocument(const String& target, bool caseFlag, unsigned limit)
+{
     RefPtr<Range> searchRange(rangeOfContents(document()));
 
     ExceptionCode exception = 0;
@@ -1299,19 +1343,6 @@ unsigned Frame::markAllMatchesForText(const String& target, bool caseFlag, unsig
             searchRange->setEnd(shadowTreeRoot, shadowTreeRoot->childNodeCount(), exception);
     } while (true);
 
-    // Do a "fake" paint in order to execute the code that computes the rendered rect for
-    // each text match.
-    Document* doc = document();
-    if (m_view && contentRenderer()) {
-        doc->updateLayout(); // Ensure layout is up to date.
-        IntRect visibleRect = m_view->visibleContentRect();
-        if (!visibleRect.isEmpty()) {
-            GraphicsContext context((PlatformGraphicsContext*)0);
-            context.setPaintingDisabled(true);
-            m_view->paintContents(&context, visibleRect);
-        }
-    }
-
     return matchCount;
 }
 
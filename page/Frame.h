@@ -224,6 +224,9 @@ namespace WebCore {
         DragImageRef nodeImage(Node*);
         DragImageRef dragImageForSelection();
 
+    private:
+        unsigned markAllMatchesForTextInDocument(const String&, bool caseFlag, unsigned limit);
+
     // === to be moved into SelectionController
 
     public:
@@ -46,6 +46,7 @@
 #include "HTMLNames.h"
 #include "InspectorTimelineAgent.h"
 #include "OverflowEvent.h"
+#include "PhaseTracer.h"
 #include "RenderEmbeddedObject.h"
 #include "RenderLayer.h"
 #include "RenderPart.h"
@@ -56,6 +57,7 @@
 #include "Settings.h"
 #include "TextResourceDecoder.h"
 #include <wtf/CurrentTime.h>
+#include <wtf/MathExtras.h>
 
 #if USE(ACCELERATED_COMPOSITING)
 #include "RenderLayerCompositor.h"
@@ -127,8 +129,9 @@ FrameView::FrameView(Frame* frame)
     , m_slowRepaintObjectCount(0)
     , m_fixedObjectCount(0)
     , m_layoutTimer(this, &FrameView::layoutTimerFired)
-    , m_layoutRoot(0)
     , m_postLayoutTasksTimer(this, &FrameView::postLayoutTimerFired)
+    , m_editingLayoutBatchDepth(0)
+    , m_selectionAppearanceUpdateDeferred(false)
     , m_isTransparent(false)
     , m_baseBackgroundColor(Color::white)
     , m_mediaType("screen")
@@ -199,12 +202,19 @@ void FrameView::reset()
     m_borderX = 30;
     m_borderY = 30;
     m_layoutTimer.stop();
-    m_layoutRoot = 0;
+    m_layoutRoots.clear();
     m_delayedLayout = false;
     m_doFullRepaint = true;
     m_layoutSchedulingEnabled = true;
     m_inLayout = false;
     m_layoutCount = 0;
+    m_deferredContentLaidOutAbove = INT_MIN;
+    m_layingOutDeferredContent = false;
+    m_deferredContentLayoutCount = 0;
+    m_fullLayoutCount = 0;
+    m_subtreeLayoutCount = 0;
+    m_layoutRootsLaidOutCount = 0;
+    m_subtreeLayoutFallbackCount = 0;
     m_nestedLayoutCount = 0;
     m_postLayoutTasksTimer.stop();
     m_firstLayout = true;
@@ -492,6 +502,8 @@ void FrameView::updateCompositingLayers()
     if (!view)
         return;
 
+    PhaseTraceScope traceScope(PhaseTracer::CompositingUpdatePhase);
+
     // This call will make sure the cached hasAcceleratedCompositing is updated from the pref
     view->compositor()->cacheAcceleratedCompositingFlags();
     view->compositor()->updateCompositingLayers(CompositingUpdateAfterLayoutOrStyleChange);
@@ -593,9 +605,99 @@ void FrameView::willMoveOffscreen()
         view->willMoveOffscreen();
 }
 
-RenderObject* FrameView::layoutRoot(bool onlyDuringLayout) const
+bool FrameView::isLayoutRoot(const RenderObject* renderer, bool onlyDuringLayout) const
+{
+    if (onlyDuringLayout && layoutPending())
+        return false;
+    return m_layoutRoots.contains(const_cast<RenderObject*>(renderer));
+}
+
+void FrameView::removeLayoutRoot(RenderObject* renderer)
+{
+    m_layoutRoots.remove(renderer);
+}
+
+void FrameView::layoutDeferredContent()
+{
+    layoutDeferredContentAbove(INT_MAX);
+}
+
+void FrameView::layoutDeferredContentAbove(int bottom)
 {
-    return onlyDuringLayout && layoutPending() ? 0 : m_layoutRoot;
+    RenderView* root = m_frame->contentRenderer();
+    if (!root || m_inLayout || m_isPainting || m_layingOutDeferredContent || !root->hasDeferredLayoutBlocks())
+        return;
+
+    // Nothing has moved since everything above |bottom| was laid out, so there is nothing
+    // new to find. This keeps repeated hit tests from walking every deferred block.
+    if (bottom <= m_deferredContentLaidOutAbove && m_layoutCount == m_deferredContentLayoutCount)
+        return;
+
+    // Giving a block its real height moves everything below it, which can bring
+    // blocks that were below |bottom| above it. Document::updateLayoutIgnorePendingStylesheets()
+    // calls back into here, which the flag turns into a no-op.
+    m_layingOutDeferredContent = true;
+    bool laidOutEverything = true;
+    while (root->markDeferredLayoutBlocksAbove(bottom)) {
+        m_frame->document()->updateLayoutIgnorePendingStylesheets();
+        if (root->needsLayout()) {
+            laidOutEverything = false;
+            break;
+        }
+    }
+    m_layingOutDeferredContent = false;
+
+    if (laidOutEverything) {
+        m_deferredContentLaidOutAbove = bottom;
+        m_deferredContentLayoutCount = m_layoutCount;
+    }
+}
+
+bool FrameView::layoutRootsAreIndependent() const
+{
+    // Each root must still be a relayout boundary hanging off the RenderView, and no root
+    // may have become the descendant of another one (e.g. after its renderer was re-parented).
+    LayoutRootSet::const_iterator end = m_layoutRoots.end();
+    for (LayoutRootSet::const_iterator it = m_layoutRoots.begin(); it != end; ++it) {
+        RenderObject* root = *it;
+        if (!objectIsRelayoutBoundary(root))
+            return false;
+        RenderObject* last = root;
+        for (RenderObject* o = root->container(); o; o = o->container()) {
+            if (m_layoutRoots.contains(o))
+                return false;
+            last = o;
+        }
+        if (!last->isRenderView())
+            return false;
+    }
+    return true;
+}
+
+void FrameView::convertSubtreeLayoutToFullLayout()
+{
+    LayoutRootSet::iterator end = m_layoutRoots.end();
+    for (LayoutRootSet::iterator it = m_layoutRoots.begin(); it != end; ++it)
+        (*it)->markContainingBlocksForLayout(false);
+    m_layoutRoots.clear();
+}
+
+void FrameView::layoutSubtree(RenderObject* root)
+{
+    if (!root->needsLayout())
+        return;
+
+    RenderView* view = root->view();
+    bool disableLayoutState = view->shouldDisableLayoutStateForSubtree(root);
+    view->pushLayoutState(root);
+    if (disableLayoutState)
+        view->disableLayoutState();
+
+    root->layout();
+
+    view->popLayoutState();
+    if (disableLayoutState)
+        view->enableLayoutState();
 }
 
 void FrameView::layout(bool allowSubtree)
@@ -603,6 +705,8 @@ void FrameView::layout(bool allowSubtree)
     if (m_inLayout)
         return;
 
+    PhaseTraceScope traceScope(PhaseTracer::LayoutPhase);
+
     m_layoutTimer.stop();
     m_delayedLayout = false;
     m_setNeedsLayoutWasDeferred = false;
@@ -627,10 +731,8 @@ void FrameView::layout(bool allowSubtree)
         timelineAgent->willLayout();
 #endif
 
-    if (!allowSubtree && m_layoutRoot) {
-        m_layoutRoot->markContainingBlocksForLayout(false);
-        m_layoutRoot = 0;
-    }
+    if (!allowSubtree)
+        convertSubtreeLayoutToFullLayout();
 
     ASSERT(m_frame->view() == this);
 
@@ -638,7 +740,7 @@ void FrameView::layout(bool allowSubtree)
 
     m_layoutSchedulingEnabled = false;
 
-    if (!m_nestedLayoutCount && m_postLayoutTasksTimer.isActive()) {
+    if (!m_nestedLayoutCount && m_postLayoutTasksTimer.isActive() && !m_editingLayoutBatchDepth) {
         // This is a new top-level layout. If there are any remaining tasks from the previous
         // layout, finish them now.
         m_postLayoutTasksTimer.stop();
@@ -657,14 +759,27 @@ void FrameView::layout(bool allowSubtree)
     else
         document->updateStyleIfNeeded();
     
-    bool subtree = m_layoutRoot;
+    bool subtree = !m_layoutRoots.isEmpty();
+    if (subtree && !layoutRootsAreIndependent()) {
+        convertSubtreeLayoutToFullLayout();
+        m_subtreeLayoutFallbackCount++;
+        subtree = false;
+    }
 
     // If there is only one ref to this view left, then its going to be destroyed as soon as we exit, 
     // so there's no point to continuing to layout
     if (protector->hasOneRef())
         return;
 
-    RenderObject* root = subtree ? m_layoutRoot : document->renderer();
+    Vector<RenderObject*> roots;
+    if (subtree) {
+        LayoutRootSet::iterator end = m_layoutRoots.end();
+        for (LayoutRootSet::iterator it = m_layoutRoots.begin(); it != end; ++it)
+            roots.append(*it);
+    } else if (document->renderer())
+        roots.append(document->renderer());
+
+    RenderObject* root = roots.isEmpty() ? 0 : roots[0];
     if (!root) {
         // FIXME: Do we need to set m_size here?
         m_layoutSchedulingEnabled = true;
@@ -754,49 +869,55 @@ void FrameView::layout(bool allowSubtree)
             m_doFullRepaint = true;
     }
 
-    RenderLayer* layer = root->enclosingLayer();
+    Vector<RenderLayer*> layers;
+    for (size_t i = 0; i < roots.size(); ++i) {
+        RenderLayer* layer = roots[i]->enclosingLayer();
+        if (!layers.contains(layer))
+            layers.append(layer);
+    }
 
     pauseScheduledEvents();
 
-    bool disableLayoutState = false;
-    if (subtree) {
-        RenderView* view = root->view();
-        disableLayoutState = view->shouldDisableLayoutStateForSubtree(root);
-        view->pushLayoutState(root);
-        if (disableLayoutState)
-            view->disableLayoutState();
-    }
-        
     m_inLayout = true;
     beginDeferredRepaints();
-    root->layout();
+    if (subtree) {
+        for (size_t i = 0; i < roots.size(); ++i)
+            layoutSubtree(roots[i]);
+    } else
+        root->layout();
     endDeferredRepaints();
     m_inLayout = false;
 
-    if (subtree) {
-        RenderView* view = root->view();
-        view->popLayoutState();
-        if (disableLayoutState)
-            view->enableLayoutState();
-    }
-    m_layoutRoot = 0;
+    m_layoutRoots.clear();
 
     m_frame->selection()->setCaretRectNeedsUpdate();
-    m_frame->selection()->updateAppearance();
+    if (m_editingLayoutBatchDepth)
+        m_selectionAppearanceUpdateDeferred = true;
+    else
+        m_frame->selection()->updateAppearance();
    
     m_layoutSchedulingEnabled = true;
 
     if (!subtree && !toRenderView(root)->printing())
         adjustViewSize();
 
+    // Deferred blocks above the visible area that got their real height would otherwise
+    // move the content in view.
+    if (int scrollAdjustment = m_frame->contentRenderer()->takeDeferredLayoutScrollAdjustment()) {
+        if (!m_maintainScrollPositionAnchor)
+            scrollBy(IntSize(0, scrollAdjustment));
+    }
+
     // Now update the positions of all layers.
     beginDeferredRepaints();
     IntPoint cachedOffset;
-    layer->updateLayerPositions((m_doFullRepaint ? RenderLayer::DoFullRepaint : 0)
-                                | RenderLayer::CheckForRepaint
-                                | RenderLayer::IsCompositingUpdateRoot
-                                | RenderLayer::UpdateCompositingLayers,
-                                subtree ? 0 : &cachedOffset);
+    for (size_t i = 0; i < layers.size(); ++i) {
+        layers[i]->updateLayerPositions((m_doFullRepaint ? RenderLayer::DoFullRepaint : 0)
+                                        | RenderLayer::CheckForRepaint
+                                        | RenderLayer::IsCompositingUpdateRoot
+                                        | RenderLayer::UpdateCompositingLayers,
+                                        subtree ? 0 : &cachedOffset);
+    }
     endDeferredRepaints();
 
 #if USE(ACCELERATED_COMPOSITING)
@@ -804,16 +925,26 @@ void FrameView::layout(bool allowSubtree)
 #endif
     
     m_layoutCount++;
+    if (subtree) {
+        m_subtreeLayoutCount++;
+        m_layoutRootsLaidOutCount += roots.size();
+    } else
+        m_fullLayoutCount++;
 
 #if PLATFORM(MAC)
-    if (AXObjectCache::accessibilityEnabled())
-        root->document()->axObjectCache()->postNotification(root, AXObjectCache::AXLayoutComplete, true);
+    if (AXObjectCache::accessibilityEnabled()) {
+        for (size_t i = 0; i < roots.size(); ++i)
+            roots[i]->document()->axObjectCache()->postNotification(roots[i], AXObjectCache::AXLayoutComplete, true);
+    }
 #endif
 #if ENABLE(DASHBOARD_SUPPORT)
     updateDashboardRegions();
 #endif
 
-    ASSERT(!root->needsLayout());
+#ifndef NDEBUG
+    for (size_t i = 0; i < roots.size(); ++i)
+        ASSERT(!roots[i]->needsLayout());
+#endif
 
     setCanBlitOnScroll(!useSlowRepaints());
 
@@ -821,7 +952,10 @@ void FrameView::layout(bool allowSubtree)
         updateOverflowStatus(layoutWidth() < contentsWidth(),
                              layoutHeight() < contentsHeight());
 
-    if (!m_postLayoutTasksTimer.isActive()) {
+    if (!m_postLayoutTasksTimer.isActive() && m_editingLayoutBatchDepth) {
+        // Keep scheduled events paused; endEditingLayoutBatch() runs the tasks.
+        m_postLayoutTasksTimer.startOneShot(0);
+    } else if (!m_postLayoutTasksTimer.isActive()) {
         // Calls resumeScheduledEvents()
         performPostLayoutTasks();
 
@@ -1130,6 +1264,13 @@ void FrameView::scrollPositionChanged()
 {
     frame()->eventHandler()->sendScrollEvent();
 
+    // Blocks whose layout was deferred lay themselves out as they come near the visible area.
+    // Marking them schedules the layout.
+    if (!m_inLayout) {
+        if (RenderView* root = m_frame->contentRenderer())
+            root->markDeferredLayoutBlocksNearViewport();
+    }
+
 #if USE(ACCELERATED_COMPOSITING)
     if (RenderView* root = m_frame->contentRenderer()) {
         if (root->usesCompositing())
@@ -1339,10 +1480,7 @@ void FrameView::scheduleRelayout()
     // too many false assertions.  See <rdar://problem/7218118>.
     ASSERT(m_frame->view() == this);
 
-    if (m_layoutRoot) {
-        m_layoutRoot->markContainingBlocksForLayout(false);
-        m_layoutRoot = 0;
-    }
+    convertSubtreeLayoutToFullLayout();
     if (!m_layoutSchedulingEnabled)
         return;
     if (!needsLayout())
@@ -1393,25 +1531,48 @@ void FrameView::scheduleRelayoutOfSubtree(RenderObject* relayoutRoot)
     }
 
     if (layoutPending() || !m_layoutSchedulingEnabled) {
-        if (m_layoutRoot != relayoutRoot) {
-            if (isObjectAncestorContainerOf(m_layoutRoot, relayoutRoot)) {
-                // Keep the current root
-                relayoutRoot->markContainingBlocksForLayout(false, m_layoutRoot);
-            } else if (m_layoutRoot && isObjectAncestorContainerOf(relayoutRoot, m_layoutRoot)) {
-                // Re-root at relayoutRoot
-                m_layoutRoot->markContainingBlocksForLayout(false, relayoutRoot);
-                m_layoutRoot = relayoutRoot;
-            } else {
-                // Just do a full relayout
-                if (m_layoutRoot)
-                    m_layoutRoot->markContainingBlocksForLayout(false);
-                m_layoutRoot = 0;
-                relayoutRoot->markContainingBlocksForLayout(false);
+        if (m_layoutRoots.contains(relayoutRoot))
+            return;
+
+        // An empty root set with a pending layout means a full layout is already scheduled.
+        if (m_layoutRoots.isEmpty()) {
+            relayoutRoot->markContainingBlocksForLayout(false);
+            return;
+        }
+
+        LayoutRootSet::iterator end = m_layoutRoots.end();
+        for (LayoutRootSet::iterator it = m_layoutRoots.begin(); it != end; ++it) {
+            if (isObjectAncestorContainerOf(*it, relayoutRoot)) {
+                // Keep the enclosing root
+                relayoutRoot->markContainingBlocksForLayout(false, *it);
+                return;
             }
         }
+
+        // Roots can only be added before the layout itself starts; once we are inside
+        // FrameView::layout() the root set has already been captured.
+        if (m_inLayout) {
+            relayoutRoot->markContainingBlocksForLayout(false);
+            return;
+        }
+
+        // Re-root any existing roots contained in relayoutRoot at relayoutRoot.
+        Vector<RenderObject*> containedRoots;
+        for (LayoutRootSet::iterator it = m_layoutRoots.begin(); it != end; ++it) {
+            if (isObjectAncestorContainerOf(relayoutRoot, *it))
+                containedRoots.append(*it);
+        }
+        for (size_t i = 0; i < containedRoots.size(); ++i) {
+            containedRoots[i]->markContainingBlocksForLayout(false, relayoutRoot);
+            m_layoutRoots.remove(containedRoots[i]);
+        }
+
+        // Unrelated subtrees are laid out independently.
+        m_layoutRoots.add(relayoutRoot);
     } else if (m_layoutSchedulingEnabled) {
         int delay = m_frame->document()->minimumLayoutDelay();
-        m_layoutRoot = relayoutRoot;
+        m_layoutRoots.clear();
+        m_layoutRoots.add(relayoutRoot);
         m_delayedLayout = delay != 0;
         m_layoutTimer.startOneShot(delay * 0.001);
     }
@@ -1433,7 +1594,7 @@ bool FrameView::needsLayout() const
     Document* document = m_frame->document();
     return layoutPending()
         || (root && root->needsLayout())
-        || m_layoutRoot
+        || !m_layoutRoots.isEmpty()
         || (document && document->childNeedsStyleRecalc()) // can occur when using WebKit ObjC interface
         || m_frame->needsReapplyStyles()
         || (m_deferSetNeedsLayouts && m_setNeedsLayoutWasDeferred);
@@ -1593,6 +1754,26 @@ bool FrameView::updateWidgets()
     return m_widgetUpdateSet->isEmpty();
 }
     
+void FrameView::endEditingLayoutBatch()
+{
+    ASSERT(m_editingLayoutBatchDepth);
+    if (--m_editingLayoutBatchDepth)
+        return;
+
+    RefPtr<FrameView> protector(this);
+
+    if (m_selectionAppearanceUpdateDeferred) {
+        m_selectionAppearanceUpdateDeferred = false;
+        if (m_frame)
+            m_frame->selection()->updateAppearance();
+    }
+
+    if (m_postLayoutTasksTimer.isActive() && !m_inLayout) {
+        m_postLayoutTasksTimer.stop();
+        performPostLayoutTasks();
+    }
+}
+
 void FrameView::performPostLayoutTasks()
 {
     if (m_firstLayoutCallbackPending) {
@@ -1895,6 +2076,9 @@ void FrameView::paintContents(GraphicsContext* p, const IntRect& rect)
     if (!frame())
         return;
 
+    PhaseTraceScope traceScope(PhaseTracer::PaintPhase);
+    PhaseTracer::increment(PhaseTracer::PixelsPaintedCounter, static_cast<unsigned long long>(rect.width()) * rect.height());
+
 #if ENABLE(INSPECTOR)
     if (InspectorTimelineAgent* timelineAgent = inspectorTimelineAgent())
         timelineAgent->willPaint(rect);
@@ -31,6 +31,7 @@
 #include "RenderObject.h" // For PaintBehavior
 #include "ScrollView.h"
 #include <wtf/Forward.h>
+#include <wtf/ListHashSet.h>
 #include <wtf/OwnPtr.h>
 
 namespace WebCore {
@@ -90,12 +91,34 @@ public:
     bool layoutPending() const;
     bool isInLayout() const { return m_inLayout; }
 
-    RenderObject* layoutRoot(bool onlyDuringLayout = false) const;
+    bool isLayoutRoot(const RenderObject*, bool onlyDuringLayout = false) const;
+    void removeLayoutRoot(RenderObject*);
     int layoutCount() const { return m_layoutCount; }
 
+    // Layout scope counters. A subtree layout lays out one or more independent
+    // relayout roots; a fallback is a pending subtree layout that had to be
+    // turned into a full layout because its roots nested or escaped their containers.
+    int fullLayoutCount() const { return m_fullLayoutCount; }
+    int subtreeLayoutCount() const { return m_subtreeLayoutCount; }
+    int layoutRootsLaidOutCount() const { return m_layoutRootsLaidOutCount; }
+    int subtreeLayoutFallbackCount() const { return m_subtreeLayoutFallbackCount; }
+
+    // Editing commands force layout between steps to compute positions. While a batch is open,
+    // those layouts leave post-layout tasks and selection painting, which nothing inside the
+    // command looks at, until the outermost batch ends.
+    void beginEditingLayoutBatch() { ++m_editingLayoutBatchDepth; }
+    void endEditingLayoutBatch();
+
     bool needsLayout() const;
     void setNeedsLayout();
 
+    // Lazy layout leaves blocks far from the visible area with an estimated height and no
+    // line boxes. Anything that needs real geometry or text there (script geometry queries
+    // through Document::updateLayoutIgnorePendingStylesheets(), TextIterator, hit testing)
+    // calls one of these first.
+    void layoutDeferredContent();
+    void layoutDeferredContentAbove(int bottom);
+
     bool needsFullRepaint() const { return m_doFullRepaint; }
 
 #if USE(ACCELERATED_COMPOSITING)
@@ -257,6 +280,10 @@ private:
     void dispatchScheduledEvents();
     void performPostLayoutTasks();
 
+    bool layoutRootsAreIndependent() const;
+    void convertSubtreeLayoutToFullLayout();
+    void layoutSubtree(RenderObject*);
+
     virtual void repaintContentRectangle(const IntRect&, bool immediate);
     virtual void contentsResized() { setNeedsLayout(); }
     virtual void visibleContentsResized();
@@ -315,13 +342,24 @@ private:
 
     Timer<FrameView> m_layoutTimer;
     bool m_delayedLayout;
-    RenderObject* m_layoutRoot;
+    typedef ListHashSet<RenderObject*> LayoutRootSet;
+    LayoutRootSet m_layoutRoots;
     
     bool m_layoutSchedulingEnabled;
     bool m_inLayout;
     int m_layoutCount;
+    // How far down deferred content was last laid out on request, and at which layout.
+    int m_deferredContentLaidOutAbove;
+    int m_deferredContentLayoutCount;
+    bool m_layingOutDeferredContent;
+    int m_fullLayoutCount;
+    int m_subtreeLayoutCount;
+    int m_layoutRootsLaidOutCount;
+    int m_subtreeLayoutFallbackCount;
     unsigned m_nestedLayoutCount;
     Timer<FrameView> m_postLayoutTasksTimer;
+    unsigned m_editingLayoutBatchDepth;
+    bool m_selectionAppearanceUpdateDeferred;
     bool m_firstLayoutCallbackPending;
 
     bool m_firstLayout;
@@ -136,6 +136,10 @@ Settings::Settings(Page* page)
     , m_dnsPrefetchingEnabled(true)
     , m_memoryInfoEnabled(false)
     , m_interactiveFormValidation(false)
+    , m_lazyLayoutEnabled(false)
+    , m_documentElementIndexEnabled(false)
+    , m_sharedParserAttributesEnabled(false)
+    , m_textSearchIndexEnabled(false)
 {
     // A Frame may not have been created yet, so we initialize the AtomicString 
     // hash before trying to use it.
@@ -314,6 +314,27 @@ namespace WebCore {
         void setMemoryInfoEnabled(bool flag) { m_memoryInfoEnabled = flag; }
         bool memoryInfoEnabled() const { return m_memoryInfoEnabled; }
 
+        // When enabled, blocks of inline content far outside the visible area get an estimated
+        // height instead of being laid out, and are laid out as they get near it.
+        void setLazyLayoutEnabled(bool flag) { m_lazyLayoutEnabled = flag; }
+        bool lazyLayoutEnabled() const { return m_lazyLayoutEnabled; }
+
+        // When enabled, document-wide getElementsByTagName, getElementsByClassName and simple
+        // querySelectorAll calls answer from a per-document index that every DOM insertion and
+        // removal keeps up to date.
+        void setDocumentElementIndexEnabled(bool flag) { m_documentElementIndexEnabled = flag; }
+        bool documentElementIndexEnabled() const { return m_documentElementIndexEnabled; }
+
+        // When enabled, elements created by the HTML parser share Attribute objects with earlier
+        // elements that have the same tag name and attributes, copying them on first change.
+        void setSharedParserAttributesEnabled(bool flag) { m_sharedParserAttributesEnabled = flag; }
+        bool sharedParserAttributesEnabled() const { return m_sharedParserAttributesEnabled; }
+
+        // When enabled, find-in-page keeps a flattened copy of the document's text between
+        // searches, so highlighting all matches doesn't walk the render tree for every keystroke.
+        void setTextSearchIndexEnabled(bool flag) { m_textSearchIndexEnabled = flag; }
+        bool textSearchIndexEnabled() const { return m_textSearchIndexEnabled; }
+
         // This setting will be removed when an HTML5 compatibility issue is
         // resolved and WebKit implementation of interactive validation is
         // completed. See http://webkit.org/b/40520, http://webkit.org/b/40747,
@@ -404,6 +425,10 @@ namespace WebCore {
         bool m_dnsPrefetchingEnabled : 1;
         bool m_memoryInfoEnabled: 1;
         bool m_interactiveFormValidation: 1;
+        bool m_lazyLayoutEnabled : 1;
+        bool m_documentElementIndexEnabled : 1;
+        bool m_sharedParserAttributesEnabled : 1;
+        bool m_textSearchIndexEnabled : 1;
     
 #if USE(SAFARI_THEME)
         static bool gShouldPaintNativeControls;
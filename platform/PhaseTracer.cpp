@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2026 The WebKit Authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "PhaseTracer.h"
+
+#include "StringBuilder.h"
+#include "ThreadGlobalData.h"
+#include <wtf/CurrentTime.h>
+#include <wtf/HashSet.h>
+#include <wtf/StdLibExtras.h>
+
+namespace WebCore {
+
+static const size_t eventBufferSize = 1024;
+
+bool PhaseTracer::s_enabled = false;
+
+static Mutex& tracersMutex()
+{
+    AtomicallyInitializedStatic(Mutex&, mutex = *new Mutex);
+    return mutex;
+}
+
+static HashSet<PhaseTracer*>& tracers()
+{
+    DEFINE_STATIC_LOCAL(HashSet<PhaseTracer*>, tracers, ());
+    return tracers;
+}
+
+PhaseTracer::PhaseTracer()
+    : m_thread(currentThread())
+    , m_depth(0)
+    , m_nextEvent(0)
+{
+    for (unsigned i = 0; i < NumberOfCounters; ++i)
+        m_counters[i] = 0;
+    for (unsigned i = 0; i < NumberOfPhases; ++i) {
+        m_phaseCounts[i] = 0;
+        m_phaseTimes[i] = 0;
+    }
+
+    MutexLocker locker(tracersMutex());
+    tracers().add(this);
+}
+
+PhaseTracer::~PhaseTracer()
+{
+    MutexLocker locker(tracersMutex());
+    tracers().remove(this);
+}
+
+void PhaseTracer::setEnabled(bool enabled)
+{
+    s_enabled = enabled;
+}
+
+PhaseTracer& PhaseTracer::current()
+{
+    return threadGlobalData().phaseTracer();
+}
+
+double PhaseTracer::willEnterPhase()
+{
+    ++m_depth;
+    return currentTime();
+}
+
+void PhaseTracer::didLeavePhase(Phase phase, double startTime)
+{
+    double endTime = currentTime();
+    ASSERT(m_depth);
+    --m_depth;
+
+    m_phaseCounts[phase]++;
+    m_phaseTimes[phase] += endTime - startTime;
+
+    Event event;
+    event.phase = phase;
+    event.depth = m_depth;
+    event.startTime = startTime;
+    event.endTime = endTime;
+
+    MutexLocker locker(m_eventsMutex);
+    if (m_events.size() < eventBufferSize) {
+        if (!m_events.capacity())
+            m_events.reserveInitialCapacity(eventBufferSize);
+        m_events.append(event);
+        return;
+    }
+    m_events[m_nextEvent] = event;
+    m_nextEvent = (m_nextEvent + 1) % eventBufferSize;
+}
+
+void PhaseTracer::copyEvents(Vector<Event>& events) const
+{
+    MutexLocker locker(m_eventsMutex);
+    events.clear();
+    events.reserveCapacity(m_events.size());
+    for (size_t i = m_nextEvent; i < m_events.size(); ++i)
+        events.append(m_events[i]);
+    for (size_t i = 0; i < m_nextEvent; ++i)
+        events.append(m_events[i]);
+}
+
+void PhaseTracer::reset()
+{
+    for (unsigned i = 0; i < NumberOfCounters; ++i)
+        m_counters[i] = 0;
+    for (unsigned i = 0; i < NumberOfPhases; ++i) {
+        m_phaseCounts[i] = 0;
+        m_phaseTimes[i] = 0;
+    }
+
+    MutexLocker locker(m_eventsMutex);
+    m_events.clear();
+    m_nextEvent = 0;
+}
+
+const char* PhaseTracer::phaseName(Phase phase)
+{
+    switch (phase) {
+    case StyleRecalcPhase:
+        return "style-recalc";
+    case LayoutPhase:
+        return "layout";
+    case PaintPhase:
+        return "paint";
+    case CompositingUpdatePhase:
+        return "compositing-update";
+    case ParsingPhase:
+        return "parsing";
+    case NumberOfPhases:
+        break;
+    }
+    ASSERT_NOT_REACHED();
+    return "";
+}
+
+const char* PhaseTracer::counterName(Counter counter)
+{
+    switch (counter) {
+    case ElementsStyledCounter:
+        return "elements-styled";
+    case RenderersLaidOutCounter:
+        return "renderers-laid-out";
+    case LinesCreatedCounter:
+        return "lines-created";
+    case PixelsPaintedCounter:
+        return "pixels-painted";
+    case NumberOfCounters:
+        break;
+    }
+    ASSERT_NOT_REACHED();
+    return "";
+}
+
+String PhaseTracer::dump() const
+{
+    StringBuilder builder;
+    builder.append(String::format("thread %u\n", static_cast<unsigned>(m_thread)));
+
+    for (unsigned i = 0; i < NumberOfPhases; ++i) {
+        Phase phase = static_cast<Phase>(i);
+        builder.append(String::format("  %s: %llu, %.3fms\n", phaseName(phase), m_phaseCounts[i], m_phaseTimes[i] * 1000));
+    }
+    for (unsigned i = 0; i < NumberOfCounters; ++i)
+        builder.append(String::format("  %s: %llu\n", counterName(static_cast<Counter>(i)), m_counters[i]));
+
+    Vector<Event> events;
+    copyEvents(events);
+    for (size_t i = 0; i < events.size(); ++i) {
+        const Event& event = events[i];
+        builder.append(String::format("    %*s%s @%.3f %.3fms\n", event.depth * 2, "", phaseName(event.phase), event.startTime * 1000, (event.endTime - event.startTime) * 1000));
+    }
+    return builder.toString();
+}
+
+String PhaseTracer::dumpAllThreads()
+{
+    StringBuilder builder;
+    MutexLocker locker(tracersMutex());
+    HashSet<PhaseTracer*>::const_iterator end = tracers().end();
+    for (HashSet<PhaseTracer*>::const_iterator it = tracers().begin(); it != end; ++it)
+        builder.append((*it)->dump());
+    return builder.toString();
+}
+
+} // namespace WebCore
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2026 The WebKit Authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PhaseTracer_h
+#define PhaseTracer_h
+
+#include "PlatformString.h"
+#include <wtf/Noncopyable.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+// Always-available, low-overhead tracing of the main rendering phases. Unlike
+// InspectorTimelineAgent it does not require an attached inspector, so embedders
+// can use it for production telemetry. Tracing is off by default; while it is on,
+// every thread records completed phases into its own ring buffer and keeps
+// cumulative per-phase totals and work counters. Kept in ThreadGlobalData.
+class PhaseTracer : public Noncopyable {
+public:
+    enum Phase {
+        StyleRecalcPhase,
+        LayoutPhase,
+        PaintPhase,
+        CompositingUpdatePhase,
+        ParsingPhase,
+        NumberOfPhases
+    };
+
+    enum Counter {
+        ElementsStyledCounter,
+        RenderersLaidOutCounter,
+        LinesCreatedCounter,
+        PixelsPaintedCounter,
+        NumberOfCounters
+    };
+
+    struct Event {
+        Phase phase;
+        unsigned depth;
+        double startTime;
+        double endTime;
+    };
+
+    PhaseTracer();
+    ~PhaseTracer();
+
+    static bool isEnabled() { return s_enabled; }
+    static void setEnabled(bool);
+
+    // The tracer of the calling thread.
+    static PhaseTracer& current();
+
+    static void increment(Counter counter, unsigned long long amount = 1)
+    {
+        if (s_enabled)
+            current().m_counters[counter] += amount;
+    }
+
+    double willEnterPhase();
+    void didLeavePhase(Phase, double startTime);
+
+    unsigned long long counter(Counter counter) const { return m_counters[counter]; }
+    unsigned long long phaseCount(Phase phase) const { return m_phaseCounts[phase]; }
+    double phaseTime(Phase phase) const { return m_phaseTimes[phase]; }
+
+    // Copies the buffered events, oldest first.
+    void copyEvents(Vector<Event>&) const;
+    void reset();
+
+    String dump() const;
+    // Counters of threads other than the calling one are read without synchronization
+    // and may be slightly out of date.
+    static String dumpAllThreads();
+
+    static const char* phaseName(Phase);
+    static const char* counterName(Counter);
+
+private:
+    static bool s_enabled;
+
+    ThreadIdentifier m_thread;
+    unsigned m_depth;
+    unsigned long long m_counters[NumberOfCounters];
+    unsigned long long m_phaseCounts[NumberOfPhases];
+    double m_phaseTimes[NumberOfPhases];
+
+    mutable Mutex m_eventsMutex;
+    Vector<Event> m_events;
+    size_t m_nextEvent;
+};
+
+class PhaseTraceScope : public Noncopyable {
+public:
+    PhaseTraceScope(PhaseTracer::Phase phase)
+        : m_tracer(PhaseTracer::isEnabled() ? &PhaseTracer::current() : 0)
+        , m_phase(phase)
+        , m_startTime(m_tracer ? m_tracer->willEnterPhase() : 0)
+    {
+    }
+
+    ~PhaseTraceScope()
+    {
+        if (m_tracer)
+            m_tracer->didLeavePhase(m_phase, m_startTime);
+    }
+
+private:
+    PhaseTracer* m_tracer;
+    PhaseTracer::Phase m_phase;
+    double m_startTime;
+};
+
+} // namespace WebCore
+
+#endif // PhaseTracer_h
@@ -28,6 +28,8 @@
 #include "ThreadGlobalData.h"
 
 #include "EventNames.h"
+#include "HTTPHeaderNames.h"
+#include "PhaseTracer.h"
 #include "ThreadTimers.h"
 #include <wtf/UnusedParam.h>
 #include <wtf/WTFThreadData.h>
@@ -57,7 +59,9 @@ ThreadGlobalData* ThreadGlobalData::staticData;
 
 ThreadGlobalData::ThreadGlobalData()
     : m_eventNames(new EventNames)
+    , m_httpHeaderNames(new HTTPHeaderNames)
     , m_threadTimers(new ThreadTimers)
+    , m_phaseTracer(new PhaseTracer)
 #ifndef NDEBUG
     , m_isMainThread(isMainThread())
 #endif
@@ -95,8 +99,12 @@ void ThreadGlobalData::destroy()
 
     delete m_eventNames;
     m_eventNames = 0;
+    delete m_httpHeaderNames;
+    m_httpHeaderNames = 0;
     delete m_threadTimers;
     m_threadTimers = 0;
+    delete m_phaseTracer;
+    m_phaseTracer = 0;
 }
 
 } // namespace WebCore
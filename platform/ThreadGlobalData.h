@@ -41,7 +41,9 @@ using WTF::ThreadSpecific;
 namespace WebCore {
 
     class EventNames;
+    class HTTPHeaderNames;
     struct ICUConverterWrapper;
+    class PhaseTracer;
     struct TECConverterWrapper;
     class ThreadTimers;
 
@@ -52,7 +54,9 @@ namespace WebCore {
         void destroy(); // called on workers to clean up the ThreadGlobalData before the thread exits.
 
         EventNames& eventNames() { return *m_eventNames; }
+        HTTPHeaderNames& httpHeaderNames() { return *m_httpHeaderNames; }
         ThreadTimers& threadTimers() { return *m_threadTimers; }
+        PhaseTracer& phaseTracer() { return *m_phaseTracer; }
 
 #if USE(ICU_UNICODE)
         ICUConverterWrapper& cachedConverterICU() { return *m_cachedConverterICU; }
@@ -64,7 +68,9 @@ namespace WebCore {
 
     private:
         EventNames* m_eventNames;
+        HTTPHeaderNames* m_httpHeaderNames;
         ThreadTimers* m_threadTimers;
+        PhaseTracer* m_phaseTracer;
 
 #ifndef NDEBUG
         bool m_isMainThread;
@@ -31,68 +31,182 @@
 #include "config.h"
 #include "HTTPHeaderMap.h"
 
+#include "HTTPHeaderNames.h"
 #include <utility>
 
 using namespace std;
 
 namespace WebCore {
 
-PassOwnPtr<CrossThreadHTTPHeaderMapData> HTTPHeaderMap::copyData() const
+static inline AtomicString fieldName(const String& name)
 {
-    OwnPtr<CrossThreadHTTPHeaderMapData> data(new CrossThreadHTTPHeaderMapData());
-    data->reserveInitialCapacity(size());
+    const AtomicString& predeclaredName = httpHeaderNames().find(name);
+    return predeclaredName.isNull() ? AtomicString(name) : predeclaredName;
+}
 
-    HTTPHeaderMap::const_iterator end_it = end();
-    for (HTTPHeaderMap::const_iterator it = begin(); it != end_it; ++it) {
-        data->append(make_pair(it->first.string().crossThreadString(), it->second.crossThreadString()));
-    }
-    return data.release();
+static inline AtomicString fieldName(const char* name)
+{
+    const AtomicString& predeclaredName = httpHeaderNames().find(name);
+    return predeclaredName.isNull() ? AtomicString(name) : predeclaredName;
 }
 
-void HTTPHeaderMap::adopt(PassOwnPtr<CrossThreadHTTPHeaderMapData> data)
+template<typename NameType> size_t HTTPHeaderMap::indexOf(const NameType& name) const
 {
-    clear();
-    size_t dataSize = data->size();
-    for (size_t index = 0; index < dataSize; ++index) {
-        pair<String, String>& header = (*data)[index];
-        set(header.first, header.second);
+    size_t fieldCount = m_fields.size();
+    for (size_t i = 0; i < fieldCount; ++i) {
+        if (equalIgnoringCase(m_fields[i].first, name))
+            return i;
     }
+    return notFound;
 }
-    
-// Adapter that allows the HashMap to take C strings as keys.
-struct CaseFoldingCStringTranslator {
-    static unsigned hash(const char* cString)
-    {
-        return CaseFoldingHash::hash(cString, strlen(cString));
-    }
-    
-    static bool equal(const AtomicString& key, const char* cString)
-    {
-        return equalIgnoringCase(key, cString);
-    }
-    
-    static void translate(AtomicString& location, const char* cString, unsigned /*hash*/)
-    {
-        location = AtomicString(cString);
+
+template<typename NameType> pair<HTTPHeaderMap::iterator, bool> HTTPHeaderMap::setOrAdd(const NameType& name, const String& value, bool replaceExistingValue)
+{
+    size_t index = indexOf(name);
+    if (index != notFound) {
+        if (replaceExistingValue)
+            m_fields[index].second = value;
+        return make_pair(begin() + index, false);
     }
-};
+    m_fields.append(make_pair(fieldName(name), value));
+    return make_pair(end() - 1, true);
+}
+
+HTTPHeaderMap::iterator HTTPHeaderMap::find(const String& name)
+{
+    size_t index = indexOf(name);
+    return index == notFound ? end() : begin() + index;
+}
+
+HTTPHeaderMap::const_iterator HTTPHeaderMap::find(const String& name) const
+{
+    size_t index = indexOf(name);
+    return index == notFound ? end() : begin() + index;
+}
+
+String HTTPHeaderMap::get(const String& name) const
+{
+    size_t index = indexOf(name);
+    return index == notFound ? String() : m_fields[index].second;
+}
+
+pair<HTTPHeaderMap::iterator, bool> HTTPHeaderMap::set(const String& name, const String& value)
+{
+    return setOrAdd(name, value, true);
+}
+
+pair<HTTPHeaderMap::iterator, bool> HTTPHeaderMap::add(const String& name, const String& value)
+{
+    return setOrAdd(name, value, false);
+}
+
+void HTTPHeaderMap::remove(const String& name)
+{
+    size_t index = indexOf(name);
+    if (index != notFound)
+        m_fields.remove(index);
+}
+
+void HTTPHeaderMap::remove(iterator it)
+{
+    m_fields.remove(it - begin());
+}
+
+HTTPHeaderMap::iterator HTTPHeaderMap::find(const char* name)
+{
+    size_t index = indexOf(name);
+    return index == notFound ? end() : begin() + index;
+}
+
+HTTPHeaderMap::const_iterator HTTPHeaderMap::find(const char* name) const
+{
+    size_t index = indexOf(name);
+    return index == notFound ? end() : begin() + index;
+}
 
 String HTTPHeaderMap::get(const char* name) const
 {
-    const_iterator i = find<const char*, CaseFoldingCStringTranslator>(name);
-    if (i == end())
-        return String();
-    return i->second;
+    size_t index = indexOf(name);
+    return index == notFound ? String() : m_fields[index].second;
 }
-    
-bool HTTPHeaderMap::contains(const char* name) const
+
+pair<HTTPHeaderMap::iterator, bool> HTTPHeaderMap::set(const char* name, const String& value)
 {
-    return find<const char*, CaseFoldingCStringTranslator>(name) != end();
+    return setOrAdd(name, value, true);
 }
 
 pair<HTTPHeaderMap::iterator, bool> HTTPHeaderMap::add(const char* name, const String& value)
 {
-    return HashMap<AtomicString, String, CaseFoldingHash>::add<const char*, CaseFoldingCStringTranslator>(name, value);
+    return setOrAdd(name, value, false);
+}
+
+void HTTPHeaderMap::remove(const char* name)
+{
+    size_t index = indexOf(name);
+    if (index != notFound)
+        m_fields.remove(index);
+}
+
+PassOwnPtr<CrossThreadHTTPHeaderMapData> HTTPHeaderMap::copyData() const
+{
+    OwnPtr<CrossThreadHTTPHeaderMapData> data(new CrossThreadHTTPHeaderMapData());
+    HTTPHeaderNames& names = httpHeaderNames();
+    size_t fieldCount = m_fields.size();
+    data->m_fields.reserveInitialCapacity(fieldCount);
+
+    size_t characterCount = 0;
+    for (size_t i = 0; i < fieldCount; ++i) {
+        CrossThreadHTTPHeaderMapData::Field field;
+        field.nameIndex = names.indexOf(m_fields[i].first);
+        field.nameLength = field.nameIndex == notFound ? m_fields[i].first.length() : 0;
+        field.valueLength = m_fields[i].second.length();
+        characterCount += field.nameLength + field.valueLength;
+        data->m_fields.uncheckedAppend(field);
+    }
+
+    data->m_characters.reserveInitialCapacity(characterCount);
+    for (size_t i = 0; i < fieldCount; ++i) {
+        if (data->m_fields[i].nameLength)
+            data->m_characters.append(m_fields[i].first.characters(), data->m_fields[i].nameLength);
+        data->m_characters.append(m_fields[i].second.characters(), data->m_fields[i].valueLength);
+    }
+    return data.release();
+}
+
+void HTTPHeaderMap::adopt(PassOwnPtr<CrossThreadHTTPHeaderMapData> data)
+{
+    HTTPHeaderNames& names = httpHeaderNames();
+    size_t fieldCount = data->m_fields.size();
+    m_fields.clear();
+    m_fields.reserveCapacity(fieldCount);
+
+    const UChar* characters = data->m_characters.data();
+    for (size_t i = 0; i < fieldCount; ++i) {
+        const CrossThreadHTTPHeaderMapData::Field& field = data->m_fields[i];
+        AtomicString name;
+        if (field.nameIndex != notFound)
+            name = names.nameAt(field.nameIndex);
+        else {
+            name = AtomicString(characters, field.nameLength);
+            characters += field.nameLength;
+        }
+        m_fields.uncheckedAppend(make_pair(name, String(characters, field.valueLength)));
+        characters += field.valueLength;
+    }
+}
+
+bool operator==(const HTTPHeaderMap& a, const HTTPHeaderMap& b)
+{
+    if (a.size() != b.size())
+        return false;
+
+    HTTPHeaderMap::const_iterator end = a.end();
+    for (HTTPHeaderMap::const_iterator it = a.begin(); it != end; ++it) {
+        HTTPHeaderMap::const_iterator field = b.find(it->first);
+        if (field == b.end() || field->second != it->second)
+            return false;
+    }
+    return true;
 }
 
 } // namespace WebCore
@@ -29,6 +29,7 @@
 
 #include <utility>
 #include <wtf/HashMap.h>
+#include <wtf/Noncopyable.h>
 #include <wtf/PassOwnPtr.h>
 #include <wtf/Vector.h>
 #include <wtf/text/AtomicString.h>
@@ -37,32 +38,83 @@
 
 namespace WebCore {
 
-    typedef Vector<std::pair<String, String> > CrossThreadHTTPHeaderMapData;
+    // Header fields packed for passing to another thread. Predeclared names (see HTTPHeaderNames)
+    // travel as their index; other names and all values are copied into one character buffer, so
+    // copying a map takes two allocations however many fields it has.
+    struct CrossThreadHTTPHeaderMapData : Noncopyable {
+        struct Field {
+            size_t nameIndex; // notFound if the name is stored in m_characters.
+            unsigned nameLength;
+            unsigned valueLength;
+        };
 
-    class HTTPHeaderMap : public HashMap<AtomicString, String, CaseFoldingHash> {
+        Vector<Field> m_fields;
+        Vector<UChar> m_characters;
+    };
+
+    // Header fields in the order they were added. Requests and responses rarely carry more than a
+    // couple of dozen fields, so the map is a flat vector searched linearly: building or copying one
+    // is a single allocation rather than a hash table, and lookups compare a few short names instead
+    // of hashing. Names listed in HTTPHeaderNames share the thread's predeclared AtomicString instead
+    // of being atomized field by field. The interface follows HashMap, which this used to be.
+    class HTTPHeaderMap {
     public:
+        typedef std::pair<AtomicString, String> ValueType;
+        typedef ValueType* iterator;
+        typedef const ValueType* const_iterator;
+
+        iterator begin() { return m_fields.begin(); }
+        iterator end() { return m_fields.end(); }
+        const_iterator begin() const { return m_fields.begin(); }
+        const_iterator end() const { return m_fields.end(); }
+
+        int size() const { return m_fields.size(); }
+        bool isEmpty() const { return m_fields.isEmpty(); }
+        void clear() { m_fields.clear(); }
+
+        // Names are compared case-insensitively.
+        iterator find(const String& name);
+        const_iterator find(const String& name) const;
+        bool contains(const String& name) const { return find(name) != end(); }
+        String get(const String& name) const;
+
+        // set() replaces the value of an existing field; add() leaves it alone. Both return the
+        // field and whether it was newly added.
+        std::pair<iterator, bool> set(const String& name, const String& value);
+        std::pair<iterator, bool> add(const String& name, const String& value);
+
+        void remove(const String& name);
+        void remove(iterator);
+
+        // Alternate accessors that avoid converting the char* to a String first.
+        iterator find(const char* name);
+        const_iterator find(const char* name) const;
+        bool contains(const char* name) const { return find(name) != end(); }
+        String get(const char* name) const;
+        std::pair<iterator, bool> set(const char* name, const String& value);
+        std::pair<iterator, bool> add(const char* name, const String& value);
+        void remove(const char* name);
+
         // Gets a copy of the data suitable for passing to another thread.
         PassOwnPtr<CrossThreadHTTPHeaderMapData> copyData() const;
 
         void adopt(PassOwnPtr<CrossThreadHTTPHeaderMapData>);
-        
-        String get(const AtomicString& name) const
-        {
-            return HashMap<AtomicString, String, CaseFoldingHash>::get(name);
-        }
-
-        pair<iterator, bool> add(const AtomicString& name, const String& value)
-        {
-            return HashMap<AtomicString, String, CaseFoldingHash>::add(name, value);
-        }
-
-        // Alternate accessors that are faster than converting the char* to AtomicString first.
-        bool contains(const char*) const;
-        String get(const char*) const;
-        pair<iterator, bool> add(const char* name, const String& value);
-        
+
+    private:
+        template<typename NameType> size_t indexOf(const NameType&) const;
+        template<typename NameType> std::pair<iterator, bool> setOrAdd(const NameType&, const String& value, bool replaceExistingValue);
+
+        Vector<ValueType> m_fields;
     };
 
+    // Like HashMap equality, this ignores the order of the fields.
+    bool operator==(const HTTPHeaderMap&, const HTTPHeaderMap&);
+
+    inline bool operator!=(const HTTPHeaderMap& a, const HTTPHeaderMap& b)
+    {
+        return !(a == b);
+    }
+
 } // namespace WebCore
 
 #endif // HTTPHeaderMap_h
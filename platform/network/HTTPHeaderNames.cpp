@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 The WebKit Authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "HTTPHeaderNames.h"
+
+namespace WebCore {
+
+// The index is keyed case-insensitively so that both lookups below can hash without
+// building a String, but a name only matches if its case is the same too.
+struct PredeclaredHeaderNameTranslator {
+    static unsigned hash(const String& name)
+    {
+        return CaseFoldingHash::hash(name.characters(), name.length());
+    }
+
+    static bool equal(const AtomicString& key, const String& name)
+    {
+        return key == name;
+    }
+};
+
+struct PredeclaredHeaderNameCStringTranslator {
+    static unsigned hash(const char* name)
+    {
+        return CaseFoldingHash::hash(name, strlen(name));
+    }
+
+    static bool equal(const AtomicString& key, const char* name)
+    {
+        return key == name;
+    }
+};
+
+#define INITIALIZE_HTTP_HEADER_NAME(identifier, name) \
+    , identifier##Header(name)
+HTTPHeaderNames::HTTPHeaderNames()
+    : dummy(0)
+HTTP_HEADER_NAMES_FOR_EACH(INITIALIZE_HTTP_HEADER_NAME)
+{
+    #define APPEND_HTTP_HEADER_NAME(identifier, name) m_names.append(&identifier##Header);
+    HTTP_HEADER_NAMES_FOR_EACH(APPEND_HTTP_HEADER_NAME)
+    #undef APPEND_HTTP_HEADER_NAME
+
+    size_t count = m_names.size();
+    for (size_t i = 0; i < count; ++i)
+        m_indices.set(*m_names[i], i);
+}
+
+const AtomicString& HTTPHeaderNames::find(const String& name) const
+{
+    HashMap<AtomicString, size_t, CaseFoldingHash>::const_iterator it = m_indices.find<String, PredeclaredHeaderNameTranslator>(name);
+    if (it == m_indices.end())
+        return nullAtom;
+    return it->first;
+}
+
+const AtomicString& HTTPHeaderNames::find(const char* name) const
+{
+    HashMap<AtomicString, size_t, CaseFoldingHash>::const_iterator it = m_indices.find<const char*, PredeclaredHeaderNameCStringTranslator>(name);
+    if (it == m_indices.end())
+        return nullAtom;
+    return it->first;
+}
+
+size_t HTTPHeaderNames::indexOf(const AtomicString& name) const
+{
+    HashMap<AtomicString, size_t, CaseFoldingHash>::const_iterator it = m_indices.find(name);
+    // Atomized on this thread, so identical names share an impl.
+    if (it == m_indices.end() || it->first.impl() != name.impl())
+        return notFound;
+    return it->second;
+}
+
+} // namespace WebCore
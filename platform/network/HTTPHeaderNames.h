@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2026 The WebKit Authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HTTPHeaderNames_h
+#define HTTPHeaderNames_h
+
+#include "ThreadGlobalData.h"
+#include <wtf/HashMap.h>
+#include <wtf/Vector.h>
+#include <wtf/text/AtomicString.h>
+#include <wtf/text/AtomicStringHash.h>
+#include <wtf/text/StringHash.h>
+
+namespace WebCore {
+
+#define HTTP_HEADER_NAMES_FOR_EACH(macro) \
+    \
+    macro(accept, "Accept") \
+    macro(acceptCharset, "Accept-Charset") \
+    macro(acceptEncoding, "Accept-Encoding") \
+    macro(acceptLanguage, "Accept-Language") \
+    macro(acceptRanges, "Accept-Ranges") \
+    macro(accessControlAllowCredentials, "Access-Control-Allow-Credentials") \
+    macro(accessControlAllowHeaders, "Access-Control-Allow-Headers") \
+    macro(accessControlAllowMethods, "Access-Control-Allow-Methods") \
+    macro(accessControlAllowOrigin, "Access-Control-Allow-Origin") \
+    macro(accessControlMaxAge, "Access-Control-Max-Age") \
+    macro(age, "Age") \
+    macro(authorization, "Authorization") \
+    macro(cacheControl, "Cache-Control") \
+    macro(connection, "Connection") \
+    macro(contentDisposition, "Content-Disposition") \
+    macro(contentEncoding, "Content-Encoding") \
+    macro(contentLanguage, "Content-Language") \
+    macro(contentLength, "Content-Length") \
+    macro(contentLocation, "Content-Location") \
+    macro(contentRange, "Content-Range") \
+    macro(contentType, "Content-Type") \
+    macro(cookie, "Cookie") \
+    macro(date, "Date") \
+    macro(eTag, "ETag") \
+    macro(expires, "Expires") \
+    macro(host, "Host") \
+    macro(ifMatch, "If-Match") \
+    macro(ifModifiedSince, "If-Modified-Since") \
+    macro(ifNoneMatch, "If-None-Match") \
+    macro(ifRange, "If-Range") \
+    macro(ifUnmodifiedSince, "If-Unmodified-Since") \
+    macro(keepAlive, "Keep-Alive") \
+    macro(lastModified, "Last-Modified") \
+    macro(link, "Link") \
+    macro(location, "Location") \
+    macro(origin, "Origin") \
+    macro(p3p, "P3P") \
+    macro(pragma, "Pragma") \
+    macro(range, "Range") \
+    macro(referer, "Referer") \
+    macro(refresh, "Refresh") \
+    macro(server, "Server") \
+    macro(setCookie, "Set-Cookie") \
+    macro(setCookie2, "Set-Cookie2") \
+    macro(transferEncoding, "Transfer-Encoding") \
+    macro(userAgent, "User-Agent") \
+    macro(vary, "Vary") \
+    macro(via, "Via") \
+    macro(xContentTypeOptions, "X-Content-Type-Options") \
+    macro(xFrameOptions, "X-Frame-Options") \
+    macro(xPoweredBy, "X-Powered-By") \
+    macro(xXSSProtection, "X-XSS-Protection") \
+    \
+// end of HTTP_HEADER_NAMES_FOR_EACH
+
+    // The header names most responses and requests carry, atomized once per thread so that
+    // an HTTPHeaderMap can share them instead of atomizing every field it is given. A name
+    // is only shared when it matches the predeclared spelling exactly, so maps still hand
+    // back names in the case they were received in.
+    class HTTPHeaderNames : public Noncopyable {
+        int dummy; // Needed to make initialization macro work.
+        // Private to prevent accidental call to HTTPHeaderNames() instead of httpHeaderNames()
+        HTTPHeaderNames();
+        friend class ThreadGlobalData;
+
+    public:
+        #define HTTP_HEADER_NAMES_DECLARE(identifier, name) AtomicString identifier##Header;
+        HTTP_HEADER_NAMES_FOR_EACH(HTTP_HEADER_NAMES_DECLARE)
+        #undef HTTP_HEADER_NAMES_DECLARE
+
+        // Return the predeclared name spelled exactly like the argument, or nullAtom.
+        const AtomicString& find(const String&) const;
+        const AtomicString& find(const char*) const;
+
+        // Indices are the same on every thread, so a predeclared name can be passed between
+        // threads as its index. indexOf() returns notFound for names that aren't predeclared.
+        size_t indexOf(const AtomicString&) const;
+        const AtomicString& nameAt(size_t index) const { return *m_names[index]; }
+
+    private:
+        Vector<const AtomicString*> m_names;
+        HashMap<AtomicString, size_t, CaseFoldingHash> m_indices;
+    };
+
+    inline HTTPHeaderNames& httpHeaderNames()
+    {
+        return threadGlobalData().httpHeaderNames();
+    }
+
+}
+
+#endif
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2026 The WebKit Authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "ReplayResourceHandle.h"
+
+#include "FormData.h"
+#include "KURL.h"
+#include "Logging.h"
+#include "ResourceError.h"
+#include "ResourceHandleClient.h"
+#include "ResourceLoadTiming.h"
+#include "ResourceResponse.h"
+#include <wtf/CurrentTime.h>
+
+using namespace std;
+
+namespace WebCore {
+
+static const char replayErrorDomain[] = "WebKitReplayErrorDomain";
+static const unsigned maximumRedirectCount = 20;
+
+// ResourceHandle::setDefersLoading() doesn't let subclasses know, so a deferred replay checks back periodically.
+static const double deferredLoadingPollInterval = 0.05;
+
+static int scaledPhase(int phase, double timeScale)
+{
+    // -1 means the phase didn't happen.
+    return phase < 0 ? phase : static_cast<int>(phase * timeScale);
+}
+
+ReplayResourceHandle::ReplayResourceHandle(PassRefPtr<ResourceReplayArchive> archive, const ResourceRequest& request, ResourceHandleClient* client, bool defersLoading, bool shouldContentSniff)
+    : ResourceHandle(request, client, defersLoading, shouldContentSniff)
+    , m_archive(archive)
+    , m_currentRequest(request)
+    , m_entry(0)
+    , m_replayTimer(this, &ReplayResourceHandle::replayTimerFired)
+    , m_entryStartTime(0)
+    , m_nextChunk(0)
+    , m_dataOffset(0)
+    , m_responseDelivered(false)
+    , m_redirectCount(0)
+{
+}
+
+ReplayResourceHandle::~ReplayResourceHandle()
+{
+}
+
+void ReplayResourceHandle::start()
+{
+    beginEntry();
+}
+
+void ReplayResourceHandle::beginEntry()
+{
+    m_entry = m_archive->entryForRequest(m_currentRequest);
+    m_entryStartTime = currentTime();
+    m_nextChunk = 0;
+    m_dataOffset = 0;
+    m_responseDelivered = false;
+
+    LOG(Network, "Handle %p replaying %s from the archive", this, m_entry ? "a response" : "a failure for a request missing");
+    scheduleNextStep();
+}
+
+void ReplayResourceHandle::scheduleNextStep()
+{
+    if (!client())
+        return;
+
+    double delay = 0;
+    if (m_entry) {
+        if (!m_responseDelivered)
+            delay = m_entry->responseDelay;
+        else if (m_nextChunk < m_entry->chunks.size())
+            delay = m_entry->chunks[m_nextChunk].delay;
+        else
+            delay = m_entry->finishDelay;
+    }
+
+    double fireTime = m_entryStartTime + delay * m_archive->timeScale();
+    m_replayTimer.startOneShot(max(0.0, fireTime - currentTime()));
+}
+
+void ReplayResourceHandle::replayTimerFired(Timer<ReplayResourceHandle>*)
+{
+    // The client is cleared when the load is cancelled.
+    if (!client())
+        return;
+
+    if (defersLoading()) {
+        m_replayTimer.startOneShot(deferredLoadingPollInterval);
+        return;
+    }
+
+    RefPtr<ReplayResourceHandle> protect(this);
+
+    if (!m_entry) {
+        notifyFail("The resource is not in the replay archive");
+        return;
+    }
+
+    if (!m_responseDelivered) {
+        if (followRedirect())
+            return;
+        notifyResponse();
+    } else if (m_nextChunk < m_entry->chunks.size())
+        notifyReceiveData();
+    else {
+        notifyFinish();
+        return;
+    }
+
+    scheduleNextStep();
+}
+
+bool ReplayResourceHandle::followRedirect()
+{
+    const ResourceResponse& redirectResponse = m_entry->response;
+    int statusCode = redirectResponse.httpStatusCode();
+    String location = redirectResponse.httpHeaderField("Location");
+    if (statusCode < 300 || statusCode >= 400 || location.isEmpty())
+        return false;
+
+    if (++m_redirectCount > maximumRedirectCount) {
+        notifyFail("Too many redirects in the replay archive");
+        return true;
+    }
+
+    ResourceRequest request = m_currentRequest;
+    request.setURL(KURL(m_currentRequest.url(), location));
+    if (statusCode == 303 || ((statusCode == 301 || statusCode == 302) && equalIgnoringCase(request.httpMethod(), "POST"))) {
+        request.setHTTPMethod("GET");
+        request.setHTTPBody(0);
+    }
+
+    client()->willSendRequest(this, request, redirectResponse);
+    if (!client())
+        return true;
+
+    m_currentRequest = request;
+    beginEntry();
+    return true;
+}
+
+void ReplayResourceHandle::notifyResponse()
+{
+    ResourceResponse response = m_entry->response;
+    double timeScale = m_archive->timeScale();
+
+    // Report the recorded phases of the load, scaled like the replay itself.
+    RefPtr<ResourceLoadTiming> timing;
+    if (ResourceLoadTiming* recordedTiming = response.resourceLoadTiming()) {
+        timing = recordedTiming->deepCopy();
+        timing->proxyStart = scaledPhase(timing->proxyStart, timeScale);
+        timing->proxyEnd = scaledPhase(timing->proxyEnd, timeScale);
+        timing->dnsStart = scaledPhase(timing->dnsStart, timeScale);
+        timing->dnsEnd = scaledPhase(timing->dnsEnd, timeScale);
+        timing->connectStart = scaledPhase(timing->connectStart, timeScale);
+        timing->connectEnd = scaledPhase(timing->connectEnd, timeScale);
+        timing->sendStart = scaledPhase(timing->sendStart, timeScale);
+        timing->sendEnd = scaledPhase(timing->sendEnd, timeScale);
+        timing->receiveHeadersEnd = scaledPhase(timing->receiveHeadersEnd, timeScale);
+        timing->sslStart = scaledPhase(timing->sslStart, timeScale);
+        timing->sslEnd = scaledPhase(timing->sslEnd, timeScale);
+    } else {
+        timing = ResourceLoadTiming::create();
+        timing->receiveHeadersEnd = static_cast<int>(m_entry->responseDelay * timeScale * 1000);
+    }
+    timing->requestTime = m_entryStartTime;
+    response.setResourceLoadTiming(timing.release());
+
+    m_responseDelivered = true;
+    client()->didReceiveResponse(this, response);
+}
+
+void ReplayResourceHandle::notifyReceiveData()
+{
+    const ResourceReplayArchive::Chunk& chunk = m_entry->chunks[m_nextChunk++];
+    const char* data = m_entry->data.data() + m_dataOffset;
+    m_dataOffset += chunk.size;
+
+    client()->didReceiveData(this, data, chunk.size, chunk.size);
+}
+
+void ReplayResourceHandle::notifyFinish()
+{
+    client()->didFinishLoading(this);
+}
+
+void ReplayResourceHandle::notifyFail(const String& description)
+{
+    client()->didFail(this, ResourceError(replayErrorDomain, 0, m_currentRequest.url().string(), description));
+}
+
+} // namespace WebCore
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026 The WebKit Authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ReplayResourceHandle_h
+#define ReplayResourceHandle_h
+
+#include "ResourceHandle.h"
+#include "ResourceReplayArchive.h"
+#include "ResourceRequest.h"
+#include "Timer.h"
+#include <wtf/PassRefPtr.h>
+#include <wtf/RefPtr.h>
+
+namespace WebCore {
+
+class ResourceHandleClient;
+
+// Replays a load from a ResourceReplayArchive: redirects, the response and the data are delivered to the
+// client the way they were recorded, spaced out according to the archive's time scale.
+class ReplayResourceHandle : public ResourceHandle {
+public:
+    static PassRefPtr<ReplayResourceHandle> create(PassRefPtr<ResourceReplayArchive> archive, const ResourceRequest& request, ResourceHandleClient* client, bool defersLoading, bool shouldContentSniff)
+    {
+        return adoptRef(new ReplayResourceHandle(archive, request, client, defersLoading, shouldContentSniff));
+    }
+
+    virtual ~ReplayResourceHandle();
+
+    void start();
+
+private:
+    ReplayResourceHandle(PassRefPtr<ResourceReplayArchive>, const ResourceRequest&, ResourceHandleClient*, bool defersLoading, bool shouldContentSniff);
+
+    void beginEntry();
+    void scheduleNextStep();
+    void replayTimerFired(Timer<ReplayResourceHandle>*);
+
+    void notifyResponse();
+    void notifyReceiveData();
+    void notifyFinish();
+    void notifyFail(const String& description);
+    bool followRedirect();
+
+    RefPtr<ResourceReplayArchive> m_archive;
+    ResourceRequest m_currentRequest;
+    const ResourceReplayArchive::Entry* m_entry;
+    Timer<ReplayResourceHandle> m_replayTimer;
+    double m_entryStartTime;
+    size_t m_nextChunk;
+    size_t m_dataOffset;
+    bool m_responseDelivered;
+    unsigned m_redirectCount;
+};
+
+} // namespace WebCore
+
+#endif // ReplayResourceHandle_h
@@ -30,7 +30,9 @@
 #include "BlobRegistry.h"
 #include "DNS.h"
 #include "Logging.h"
+#include "ReplayResourceHandle.h"
 #include "ResourceHandleClient.h"
+#include "ResourceReplayArchive.h"
 #include "Timer.h"
 #include <algorithm>
 
@@ -63,7 +65,21 @@ PassRefPtr<ResourceHandle> ResourceHandle::create(const ResourceRequest& request
     }
 #endif
 
+    ResourceReplayArchive* replayArchive = ResourceReplayArchive::installed();
+    if (replayArchive && replayArchive->shouldReplay(request)) {
+        RefPtr<ReplayResourceHandle> handle = ReplayResourceHandle::create(replayArchive, request, client, defersLoading, shouldContentSniff);
+        handle->start();
+        return handle.release();
+    }
+
+    OwnPtr<ResourceHandleClient> recordingClient;
+    if (replayArchive && replayArchive->shouldRecord(request)) {
+        recordingClient = replayArchive->createRecordingClient(request, client);
+        client = recordingClient.get();
+    }
+
     RefPtr<ResourceHandle> newHandle(adoptRef(new ResourceHandle(request, client, defersLoading, shouldContentSniff)));
+    newHandle->d->m_recordingClient = recordingClient.release();
 
     if (newHandle->d->m_scheduledFailureType != NoFailure)
         return newHandle.release();
@@ -155,6 +171,11 @@ void ResourceHandle::forceContentSniffing()
     shouldForceContentSniffing = true;
 }
 
+bool ResourceHandle::defersLoading() const
+{
+    return d->m_defersLoading;
+}
+
 void ResourceHandle::setDefersLoading(bool defers)
 {
     LOG(Network, "Handle %p setDefersLoading(%s)", this, defers ? "true" : "false");
@@ -101,6 +101,8 @@ class ResourceHandle : public RefCounted<ResourceHandle>
 protected:
     ResourceHandle(const ResourceRequest&, ResourceHandleClient*, bool defersLoading, bool shouldContentSniff);
 
+    bool defersLoading() const;
+
 private:
     enum FailureType {
         NoFailure,
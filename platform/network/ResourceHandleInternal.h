@@ -27,6 +27,7 @@
 #define ResourceHandleInternal_h
 
 #include "ResourceHandle.h"
+#include "ResourceHandleClient.h"
 #include "ResourceRequest.h"
 #include "AuthenticationChallenge.h"
 #include "Timer.h"
@@ -145,6 +146,8 @@ namespace WebCore {
 
         ResourceHandleClient* client() { return m_client; }
         ResourceHandleClient* m_client;
+        // Stands in for the client while a ResourceReplayArchive records the load.
+        OwnPtr<ResourceHandleClient> m_recordingClient;
         
         ResourceRequest m_firstRequest;
         String m_lastHTTPMethod;
@@ -0,0 +1,462 @@
+/*
+ * Copyright (C) 2026 The WebKit Authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "ResourceReplayArchive.h"
+
+#include "FileSystem.h"
+#include "KURL.h"
+#include "Logging.h"
+#include "ResourceHandleClient.h"
+#include "ResourceLoadTiming.h"
+#include "ResourceRequest.h"
+#include <wtf/CurrentTime.h>
+#include <wtf/StdLibExtras.h>
+#include <wtf/text/CString.h>
+
+using namespace std;
+
+namespace WebCore {
+
+// The archive is only meant to be read back on the machine that wrote it, so numbers are stored in native byte order.
+static const uint32_t archiveSignature = 0x57524141;
+static const uint32_t archiveVersion = 1;
+
+class ArchiveWriter : public Noncopyable {
+public:
+    ArchiveWriter(Vector<char>& buffer) : m_buffer(buffer) { }
+
+    void appendUInt32(uint32_t value) { m_buffer.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+    void appendInt64(int64_t value) { m_buffer.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+    void appendDouble(double value) { m_buffer.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+    void appendBytes(const char* bytes, size_t length) { m_buffer.append(bytes, length); }
+
+    void appendString(const String& string)
+    {
+        CString utf8 = string.utf8();
+        appendUInt32(utf8.length());
+        m_buffer.append(utf8.data(), utf8.length());
+    }
+
+private:
+    Vector<char>& m_buffer;
+};
+
+class ArchiveReader : public Noncopyable {
+public:
+    ArchiveReader(const Vector<char>& buffer) : m_buffer(buffer), m_offset(0) { }
+
+    bool atEnd() const { return m_offset == m_buffer.size(); }
+
+    bool readUInt32(uint32_t& value) { return readBytes(reinterpret_cast<char*>(&value), sizeof(value)); }
+    bool readInt64(int64_t& value) { return readBytes(reinterpret_cast<char*>(&value), sizeof(value)); }
+    bool readDouble(double& value) { return readBytes(reinterpret_cast<char*>(&value), sizeof(value)); }
+
+    bool readBytes(char* bytes, size_t length)
+    {
+        if (length > m_buffer.size() - m_offset)
+            return false;
+        memcpy(bytes, m_buffer.data() + m_offset, length);
+        m_offset += length;
+        return true;
+    }
+
+    bool readString(String& string)
+    {
+        uint32_t length;
+        if (!readUInt32(length) || length > m_buffer.size() - m_offset)
+            return false;
+        string = String::fromUTF8(m_buffer.data() + m_offset, length);
+        m_offset += length;
+        return true;
+    }
+
+private:
+    const Vector<char>& m_buffer;
+    size_t m_offset;
+};
+
+static String keyForRequest(const ResourceRequest& request)
+{
+    KURL url = request.url();
+    url.removeFragmentIdentifier();
+    return request.httpMethod() + " " + url.string();
+}
+
+static void writeEntry(ArchiveWriter& writer, const String& key, const ResourceReplayArchive::Entry& entry)
+{
+    writer.appendString(key);
+
+    const ResourceResponse& response = entry.response;
+    writer.appendString(response.url().string());
+    writer.appendString(response.mimeType());
+    writer.appendInt64(response.expectedContentLength());
+    writer.appendString(response.textEncodingName());
+    writer.appendString(response.suggestedFilename());
+    writer.appendUInt32(response.httpStatusCode());
+    writer.appendString(response.httpStatusText());
+
+    const HTTPHeaderMap& headers = response.httpHeaderFields();
+    writer.appendUInt32(headers.size());
+    HTTPHeaderMap::const_iterator end = headers.end();
+    for (HTTPHeaderMap::const_iterator it = headers.begin(); it != end; ++it) {
+        writer.appendString(it->first);
+        writer.appendString(it->second);
+    }
+
+    ResourceLoadTiming* timing = response.resourceLoadTiming();
+    writer.appendUInt32(timing ? 1 : 0);
+    if (timing) {
+        int phases[] = { timing->proxyStart, timing->proxyEnd, timing->dnsStart, timing->dnsEnd, timing->connectStart, timing->connectEnd,
+            timing->sendStart, timing->sendEnd, timing->receiveHeadersEnd, timing->sslStart, timing->sslEnd };
+        for (size_t i = 0; i < sizeof(phases) / sizeof(phases[0]); ++i)
+            writer.appendUInt32(static_cast<uint32_t>(phases[i]));
+    }
+
+    writer.appendDouble(entry.responseDelay);
+    writer.appendUInt32(entry.chunks.size());
+    for (size_t i = 0; i < entry.chunks.size(); ++i) {
+        writer.appendUInt32(entry.chunks[i].size);
+        writer.appendDouble(entry.chunks[i].delay);
+    }
+    writer.appendDouble(entry.finishDelay);
+
+    writer.appendUInt32(entry.data.size());
+    writer.appendBytes(entry.data.data(), entry.data.size());
+}
+
+static bool readEntry(ArchiveReader& reader, String& key, ResourceReplayArchive::Entry& entry)
+{
+    String url, mimeType, textEncodingName, suggestedFilename, statusText;
+    int64_t expectedContentLength;
+    uint32_t statusCode;
+    if (!reader.readString(key) || !reader.readString(url) || !reader.readString(mimeType) || !reader.readInt64(expectedContentLength)
+        || !reader.readString(textEncodingName) || !reader.readString(suggestedFilename) || !reader.readUInt32(statusCode) || !reader.readString(statusText))
+        return false;
+
+    ResourceResponse response(KURL(ParsedURLString, url), mimeType, expectedContentLength, textEncodingName, suggestedFilename);
+    response.setHTTPStatusCode(statusCode);
+    response.setHTTPStatusText(statusText);
+
+    uint32_t headerCount;
+    if (!reader.readUInt32(headerCount))
+        return false;
+    for (uint32_t i = 0; i < headerCount; ++i) {
+        String name, value;
+        if (!reader.readString(name) || !reader.readString(value))
+            return false;
+        response.setHTTPHeaderField(name, value);
+    }
+
+    uint32_t hasTiming;
+    if (!reader.readUInt32(hasTiming))
+        return false;
+    if (hasTiming) {
+        RefPtr<ResourceLoadTiming> timing = ResourceLoadTiming::create();
+        int* phases[] = { &timing->proxyStart, &timing->proxyEnd, &timing->dnsStart, &timing->dnsEnd, &timing->connectStart, &timing->connectEnd,
+            &timing->sendStart, &timing->sendEnd, &timing->receiveHeadersEnd, &timing->sslStart, &timing->sslEnd };
+        for (size_t i = 0; i < sizeof(phases) / sizeof(phases[0]); ++i) {
+            uint32_t phase;
+            if (!reader.readUInt32(phase))
+                return false;
+            *phases[i] = static_cast<int>(phase);
+        }
+        response.setResourceLoadTiming(timing.release());
+    }
+    entry.response = response;
+
+    uint32_t chunkCount;
+    if (!reader.readDouble(entry.responseDelay) || !reader.readUInt32(chunkCount))
+        return false;
+
+    uint64_t chunkSizeTotal = 0;
+    for (uint32_t i = 0; i < chunkCount; ++i) {
+        ResourceReplayArchive::Chunk chunk;
+        if (!reader.readUInt32(chunk.size) || !reader.readDouble(chunk.delay))
+            return false;
+        chunkSizeTotal += chunk.size;
+        entry.chunks.append(chunk);
+    }
+
+    uint32_t dataSize;
+    if (!reader.readDouble(entry.finishDelay) || !reader.readUInt32(dataSize) || dataSize != chunkSizeTotal)
+        return false;
+
+    entry.data.resize(dataSize);
+    return reader.readBytes(entry.data.data(), dataSize);
+}
+
+// Forwards every callback to the client of the load, and records the response, the data and when they arrived.
+class RecordingResourceHandleClient : public ResourceHandleClient {
+public:
+    RecordingResourceHandleClient(PassRefPtr<ResourceReplayArchive> archive, const ResourceRequest& request, ResourceHandleClient* client)
+        : m_archive(archive)
+        , m_request(request)
+        , m_client(client)
+        , m_startTime(currentTime())
+        , m_entry(adoptPtr(new ResourceReplayArchive::Entry))
+    {
+    }
+
+    virtual void willSendRequest(ResourceHandle* handle, ResourceRequest& request, const ResourceResponse& redirectResponse)
+    {
+        // A redirect is recorded as an entry of its own, without any data, and the load continues with a new entry.
+        if (!redirectResponse.isNull()) {
+            double delay = currentTime() - m_startTime;
+            m_entry->response = redirectResponse;
+            m_entry->responseDelay = delay;
+            m_entry->finishDelay = delay;
+            m_archive->addEntry(m_request, m_entry.release());
+            m_entry = adoptPtr(new ResourceReplayArchive::Entry);
+        }
+
+        m_client->willSendRequest(handle, request, redirectResponse);
+
+        if (!redirectResponse.isNull()) {
+            m_request = request;
+            m_startTime = currentTime();
+        }
+    }
+
+    virtual void didSendData(ResourceHandle* handle, unsigned long long bytesSent, unsigned long long totalBytesToBeSent)
+    {
+        m_client->didSendData(handle, bytesSent, totalBytesToBeSent);
+    }
+
+    virtual void didReceiveResponse(ResourceHandle* handle, const ResourceResponse& response)
+    {
+        m_entry->response = response;
+        m_entry->responseDelay = currentTime() - m_startTime;
+        m_client->didReceiveResponse(handle, response);
+    }
+
+    virtual void didReceiveData(ResourceHandle* handle, const char* data, int length, int lengthReceived)
+    {
+        if (length > 0) {
+            m_entry->data.append(data, length);
+            m_entry->chunks.append(ResourceReplayArchive::Chunk(length, currentTime() - m_startTime));
+        }
+        m_client->didReceiveData(handle, data, length, lengthReceived);
+    }
+
+    virtual void didReceiveCachedMetadata(ResourceHandle* handle, const char* data, int length)
+    {
+        m_client->didReceiveCachedMetadata(handle, data, length);
+    }
+
+    virtual void didFinishLoading(ResourceHandle* handle)
+    {
+        m_entry->finishDelay = currentTime() - m_startTime;
+        m_archive->addEntry(m_request, m_entry.release());
+        m_client->didFinishLoading(handle);
+    }
+
+    virtual void didFail(ResourceHandle* handle, const ResourceError& error)
+    {
+        // Failed loads are not recorded, they fail during replay as well.
+        m_entry.clear();
+        m_client->didFail(handle, error);
+    }
+
+    virtual void wasBlocked(ResourceHandle* handle) { m_client->wasBlocked(handle); }
+    virtual void cannotShowURL(ResourceHandle* handle) { m_client->cannotShowURL(handle); }
+
+    virtual void willCacheResponse(ResourceHandle* handle, CacheStoragePolicy& policy) { m_client->willCacheResponse(handle, policy); }
+
+    virtual bool shouldUseCredentialStorage(ResourceHandle* handle) { return m_client->shouldUseCredentialStorage(handle); }
+    virtual void didReceiveAuthenticationChallenge(ResourceHandle* handle, const AuthenticationChallenge& challenge) { m_client->didReceiveAuthenticationChallenge(handle, challenge); }
+    virtual void didCancelAuthenticationChallenge(ResourceHandle* handle, const AuthenticationChallenge& challenge) { m_client->didCancelAuthenticationChallenge(handle, challenge); }
+#if USE(PROTECTION_SPACE_AUTH_CALLBACK)
+    virtual bool canAuthenticateAgainstProtectionSpace(ResourceHandle* handle, const ProtectionSpace& space) { return m_client->canAuthenticateAgainstProtectionSpace(handle, space); }
+#endif
+    virtual void receivedCancellation(ResourceHandle* handle, const AuthenticationChallenge& challenge) { m_client->receivedCancellation(handle, challenge); }
+
+#if PLATFORM(MAC)
+    virtual NSCachedURLResponse* willCacheResponse(ResourceHandle* handle, NSCachedURLResponse* response) { return m_client->willCacheResponse(handle, response); }
+    virtual void willStopBufferingData(ResourceHandle* handle, const char* data, int length) { m_client->willStopBufferingData(handle, data, length); }
+#endif
+#if USE(CFNETWORK)
+    virtual bool shouldCacheResponse(ResourceHandle* handle, CFCachedURLResponseRef response) { return m_client->shouldCacheResponse(handle, response); }
+#endif
+#if ENABLE(BLOB)
+    virtual AsyncFileStream* createAsyncFileStream(FileStreamClient* client) { return m_client->createAsyncFileStream(client); }
+#endif
+
+private:
+    RefPtr<ResourceReplayArchive> m_archive;
+    ResourceRequest m_request;
+    ResourceHandleClient* m_client;
+    double m_startTime;
+    OwnPtr<ResourceReplayArchive::Entry> m_entry;
+};
+
+static RefPtr<ResourceReplayArchive>& installedArchive()
+{
+    DEFINE_STATIC_LOCAL(RefPtr<ResourceReplayArchive>, archive, ());
+    return archive;
+}
+
+PassRefPtr<ResourceReplayArchive> ResourceReplayArchive::create(const String& path, Mode mode)
+{
+    RefPtr<ResourceReplayArchive> archive = adoptRef(new ResourceReplayArchive(path, mode));
+    if (mode == Replay && !archive->read())
+        return 0;
+    return archive.release();
+}
+
+ResourceReplayArchive::ResourceReplayArchive(const String& path, Mode mode)
+    : m_path(path)
+    , m_mode(mode)
+    , m_timeScale(1)
+{
+}
+
+ResourceReplayArchive::~ResourceReplayArchive()
+{
+    deleteAllValues(m_entries);
+}
+
+void ResourceReplayArchive::install(PassRefPtr<ResourceReplayArchive> archive)
+{
+    installedArchive() = archive;
+}
+
+ResourceReplayArchive* ResourceReplayArchive::installed()
+{
+    return installedArchive().get();
+}
+
+// Only HTTP loads are replayed and recorded - everything else is local already.
+static bool isReplayableRequest(const ResourceRequest& request)
+{
+    const KURL& url = request.url();
+    return url.isValid() && url.protocolInHTTPFamily() && portAllowed(url);
+}
+
+bool ResourceReplayArchive::shouldReplay(const ResourceRequest& request) const
+{
+    return m_mode == Replay && isReplayableRequest(request);
+}
+
+const ResourceReplayArchive::Entry* ResourceReplayArchive::entryForRequest(const ResourceRequest& request) const
+{
+    return m_entries.get(keyForRequest(request));
+}
+
+bool ResourceReplayArchive::shouldRecord(const ResourceRequest& request) const
+{
+    return m_mode == Record && isReplayableRequest(request);
+}
+
+PassOwnPtr<ResourceHandleClient> ResourceReplayArchive::createRecordingClient(const ResourceRequest& request, ResourceHandleClient* client)
+{
+    ASSERT(m_mode == Record);
+    return adoptPtr(new RecordingResourceHandleClient(this, request, client));
+}
+
+void ResourceReplayArchive::addEntry(const ResourceRequest& request, PassOwnPtr<Entry> entry)
+{
+    setEntry(keyForRequest(request), entry);
+}
+
+void ResourceReplayArchive::setEntry(const String& key, PassOwnPtr<Entry> entry)
+{
+    // The last response for a request wins, like it would in a cache.
+    pair<EntryMap::iterator, bool> result = m_entries.add(key, 0);
+    if (!result.second)
+        delete result.first->second;
+    result.first->second = entry.leakPtr();
+}
+
+bool ResourceReplayArchive::read()
+{
+    long long fileSize;
+    if (!getFileSize(m_path, fileSize) || fileSize < 0 || static_cast<unsigned long long>(fileSize) > numeric_limits<size_t>::max())
+        return false;
+
+    PlatformFileHandle handle = openFile(m_path, OpenForRead);
+    if (!isHandleValid(handle))
+        return false;
+
+    Vector<char> buffer(static_cast<size_t>(fileSize));
+    size_t totalBytesRead = 0;
+    while (totalBytesRead < buffer.size()) {
+        int bytesRead = readFromFile(handle, buffer.data() + totalBytesRead, static_cast<int>(min<size_t>(buffer.size() - totalBytesRead, 1 << 20)));
+        if (bytesRead <= 0)
+            break;
+        totalBytesRead += bytesRead;
+    }
+    closeFile(handle);
+    if (totalBytesRead != buffer.size())
+        return false;
+
+    ArchiveReader reader(buffer);
+    uint32_t signature, version, entryCount;
+    if (!reader.readUInt32(signature) || signature != archiveSignature || !reader.readUInt32(version) || version != archiveVersion || !reader.readUInt32(entryCount))
+        return false;
+
+    for (uint32_t i = 0; i < entryCount; ++i) {
+        String key;
+        OwnPtr<Entry> entry = adoptPtr(new Entry);
+        if (!readEntry(reader, key, *entry)) {
+            LOG_ERROR("Resource replay archive %s is damaged", m_path.utf8().data());
+            return false;
+        }
+        setEntry(key, entry.release());
+    }
+
+    LOG(Network, "Read %u entries from resource replay archive %s", entryCount, m_path.utf8().data());
+    return reader.atEnd();
+}
+
+bool ResourceReplayArchive::save() const
+{
+    Vector<char> buffer;
+    ArchiveWriter writer(buffer);
+    writer.appendUInt32(archiveSignature);
+    writer.appendUInt32(archiveVersion);
+    writer.appendUInt32(m_entries.size());
+
+    EntryMap::const_iterator end = m_entries.end();
+    for (EntryMap::const_iterator it = m_entries.begin(); it != end; ++it)
+        writeEntry(writer, it->first, *it->second);
+
+    PlatformFileHandle handle = openFile(m_path, OpenForWrite);
+    if (!isHandleValid(handle))
+        return false;
+
+    size_t totalBytesWritten = 0;
+    while (totalBytesWritten < buffer.size()) {
+        int bytesWritten = writeToFile(handle, buffer.data() + totalBytesWritten, static_cast<int>(min<size_t>(buffer.size() - totalBytesWritten, 1 << 20)));
+        if (bytesWritten <= 0)
+            break;
+        totalBytesWritten += bytesWritten;
+    }
+    closeFile(handle);
+
+    LOG(Network, "Wrote %u entries to resource replay archive %s", m_entries.size(), m_path.utf8().data());
+    return totalBytesWritten == buffer.size();
+}
+
+} // namespace WebCore
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2026 The WebKit Authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ResourceReplayArchive_h
+#define ResourceReplayArchive_h
+
+#include "PlatformString.h"
+#include "ResourceResponse.h"
+#include <wtf/HashMap.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/PassOwnPtr.h>
+#include <wtf/PassRefPtr.h>
+#include <wtf/RefCounted.h>
+#include <wtf/Vector.h>
+#include <wtf/text/StringHash.h>
+
+namespace WebCore {
+
+class ResourceHandleClient;
+class ResourceRequest;
+
+// An archive of recorded HTTP responses, so that pages can be loaded reproducibly without a network.
+// While an archive is installed, ResourceHandle::create() either hands HTTP loads to a ReplayResourceHandle
+// that replays them from the archive, or records the responses of the real loads into it.
+class ResourceReplayArchive : public RefCounted<ResourceReplayArchive> {
+public:
+    enum Mode {
+        Replay,
+        Record
+    };
+
+    struct Chunk {
+        Chunk() : size(0), delay(0) { }
+        Chunk(unsigned size, double delay) : size(size), delay(delay) { }
+
+        unsigned size;
+        double delay;
+    };
+
+    // The delays are in seconds, measured from the start of the load.
+    struct Entry : public Noncopyable {
+        Entry() : responseDelay(0), finishDelay(0) { }
+
+        ResourceResponse response;
+        double responseDelay;
+        Vector<Chunk> chunks;
+        Vector<char> data;
+        double finishDelay;
+    };
+
+    // In Replay mode the archive is read from path, and 0 is returned if it can't be.
+    static PassRefPtr<ResourceReplayArchive> create(const String& path, Mode);
+    ~ResourceReplayArchive();
+
+    static void install(PassRefPtr<ResourceReplayArchive>);
+    static ResourceReplayArchive* installed();
+
+    Mode mode() const { return m_mode; }
+
+    // Recorded delays are multiplied by the time scale while replaying - 0 delivers everything as soon as possible.
+    double timeScale() const { return m_timeScale; }
+    void setTimeScale(double timeScale) { m_timeScale = timeScale; }
+
+    bool shouldReplay(const ResourceRequest&) const;
+    const Entry* entryForRequest(const ResourceRequest&) const;
+
+    bool shouldRecord(const ResourceRequest&) const;
+    // The returned client forwards every callback to client, and adds an entry once the load has finished.
+    PassOwnPtr<ResourceHandleClient> createRecordingClient(const ResourceRequest&, ResourceHandleClient*);
+    void addEntry(const ResourceRequest&, PassOwnPtr<Entry>);
+
+    bool save() const;
+
+    unsigned entryCount() const { return m_entries.size(); }
+
+private:
+    ResourceReplayArchive(const String& path, Mode);
+
+    bool read();
+    void setEntry(const String& key, PassOwnPtr<Entry>);
+
+    String m_path;
+    Mode m_mode;
+    double m_timeScale;
+
+    typedef HashMap<String, Entry*> EntryMap;
+    EntryMap m_entries;
+};
+
+} // namespace WebCore
+
+#endif // ResourceReplayArchive_h
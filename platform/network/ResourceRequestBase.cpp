@@ -204,7 +204,7 @@ const HTTPHeaderMap& ResourceRequestBase::httpHeaderFields() const
     return m_httpHeaderFields; 
 }
 
-String ResourceRequestBase::httpHeaderField(const AtomicString& name) const
+String ResourceRequestBase::httpHeaderField(const String& name) const
 {
     updateResourceRequest(); 
     
@@ -218,7 +218,7 @@ String ResourceRequestBase::httpHeaderField(const char* name) const
     return m_httpHeaderFields.get(name);
 }
 
-void ResourceRequestBase::setHTTPHeaderField(const AtomicString& name, const String& value)
+void ResourceRequestBase::setHTTPHeaderField(const String& name, const String& value)
 {
     updateResourceRequest(); 
     
@@ -230,7 +230,12 @@ void ResourceRequestBase::setHTTPHeaderField(const AtomicString& name, const Str
 
 void ResourceRequestBase::setHTTPHeaderField(const char* name, const String& value)
 {
-    setHTTPHeaderField(AtomicString(name), value);
+    updateResourceRequest(); 
+    
+    m_httpHeaderFields.set(name, value); 
+    
+    if (url().protocolInHTTPFamily())
+        m_platformRequestUpdated = false;
 }
 
 void ResourceRequestBase::clearHTTPReferrer()
@@ -303,7 +308,7 @@ void ResourceRequestBase::setAllowCookies(bool allowCookies)
         m_platformRequestUpdated = false;
 }
 
-void ResourceRequestBase::addHTTPHeaderField(const AtomicString& name, const String& value) 
+void ResourceRequestBase::addHTTPHeaderField(const String& name, const String& value) 
 {
     updateResourceRequest();
     pair<HTTPHeaderMap::iterator, bool> result = m_httpHeaderFields.add(name, value); 
@@ -93,11 +93,11 @@ namespace WebCore {
         void setHTTPMethod(const String& httpMethod);
         
         const HTTPHeaderMap& httpHeaderFields() const;
-        String httpHeaderField(const AtomicString& name) const;
+        String httpHeaderField(const String& name) const;
         String httpHeaderField(const char* name) const;
-        void setHTTPHeaderField(const AtomicString& name, const String& value);
+        void setHTTPHeaderField(const String& name, const String& value);
         void setHTTPHeaderField(const char* name, const String& value);
-        void addHTTPHeaderField(const AtomicString& name, const String& value);
+        void addHTTPHeaderField(const String& name, const String& value);
         void addHTTPHeaderFields(const HTTPHeaderMap& headerFields);
         
         String httpContentType() const { return httpHeaderField("Content-Type");  }
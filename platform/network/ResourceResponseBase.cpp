@@ -27,6 +27,7 @@
 #include "config.h"
 #include "ResourceResponseBase.h"
 
+#include "HTTPHeaderNames.h"
 #include "HTTPParsers.h"
 #include "ResourceResponse.h"
 #include <wtf/CurrentTime.h>
@@ -241,7 +242,7 @@ void ResourceResponseBase::setHTTPStatusText(const String& statusText)
     m_httpStatusText = statusText; 
 }
 
-String ResourceResponseBase::httpHeaderField(const AtomicString& name) const
+String ResourceResponseBase::httpHeaderField(const String& name) const
 {
     lazyInit();
 
@@ -255,25 +256,20 @@ String ResourceResponseBase::httpHeaderField(const char* name) const
     return m_httpHeaderFields.get(name); 
 }
 
-void ResourceResponseBase::setHTTPHeaderField(const AtomicString& name, const String& value)
+void ResourceResponseBase::setHTTPHeaderField(const String& name, const String& value)
 {
     lazyInit();
     
-    DEFINE_STATIC_LOCAL(const AtomicString, ageHeader, ("age"));
-    DEFINE_STATIC_LOCAL(const AtomicString, cacheControlHeader, ("cache-control"));
-    DEFINE_STATIC_LOCAL(const AtomicString, dateHeader, ("date"));
-    DEFINE_STATIC_LOCAL(const AtomicString, expiresHeader, ("expires"));
-    DEFINE_STATIC_LOCAL(const AtomicString, lastModifiedHeader, ("last-modified"));
-    DEFINE_STATIC_LOCAL(const AtomicString, pragmaHeader, ("pragma"));
-    if (equalIgnoringCase(name, ageHeader))
+    HTTPHeaderNames& names = httpHeaderNames();
+    if (equalIgnoringCase(name, names.ageHeader))
         m_haveParsedAgeHeader = false;
-    else if (equalIgnoringCase(name, cacheControlHeader) || equalIgnoringCase(name, pragmaHeader))
+    else if (equalIgnoringCase(name, names.cacheControlHeader) || equalIgnoringCase(name, names.pragmaHeader))
         m_haveParsedCacheControlHeader = false;
-    else if (equalIgnoringCase(name, dateHeader))
+    else if (equalIgnoringCase(name, names.dateHeader))
         m_haveParsedDateHeader = false;
-    else if (equalIgnoringCase(name, expiresHeader))
+    else if (equalIgnoringCase(name, names.expiresHeader))
         m_haveParsedExpiresHeader = false;
-    else if (equalIgnoringCase(name, lastModifiedHeader))
+    else if (equalIgnoringCase(name, names.lastModifiedHeader))
         m_haveParsedLastModifiedHeader = false;
 
     m_httpHeaderFields.set(name, value);
@@ -298,13 +294,12 @@ void ResourceResponseBase::parseCacheControlDirectives() const
     m_cacheControlContainsNoCache = false;
     m_cacheControlMaxAge = numeric_limits<double>::quiet_NaN();
 
-    DEFINE_STATIC_LOCAL(const AtomicString, cacheControlString, ("cache-control"));
     DEFINE_STATIC_LOCAL(const AtomicString, noCacheDirective, ("no-cache"));
     DEFINE_STATIC_LOCAL(const AtomicString, noStoreDirective, ("no-store"));
     DEFINE_STATIC_LOCAL(const AtomicString, mustRevalidateDirective, ("must-revalidate"));
     DEFINE_STATIC_LOCAL(const AtomicString, maxAgeDirective, ("max-age"));
 
-    String cacheControlValue = m_httpHeaderFields.get(cacheControlString);
+    String cacheControlValue = m_httpHeaderFields.get(httpHeaderNames().cacheControlHeader);
     if (!cacheControlValue.isEmpty()) {
         Vector<pair<String, String> > directives;
         parseCacheHeader(cacheControlValue, directives);
@@ -332,8 +327,7 @@ void ResourceResponseBase::parseCacheControlDirectives() const
         // Handle Pragma: no-cache
         // This is deprecated and equivalent to Cache-control: no-cache
         // Don't bother tokenizing the value, it is not important
-        DEFINE_STATIC_LOCAL(const AtomicString, pragmaHeader, ("pragma"));
-        String pragmaValue = m_httpHeaderFields.get(pragmaHeader);
+        String pragmaValue = m_httpHeaderFields.get(httpHeaderNames().pragmaHeader);
         m_cacheControlContainsNoCache = pragmaValue.lower().contains(noCacheDirective);
     }
 }
@@ -366,7 +360,7 @@ double ResourceResponseBase::cacheControlMaxAge() const
     return m_cacheControlMaxAge;
 }
 
-static double parseDateValueInHeader(const HTTPHeaderMap& headers, const AtomicString& headerName)
+static double parseDateValueInHeader(const HTTPHeaderMap& headers, const String& headerName)
 {
     String headerValue = headers.get(headerName);
     if (headerValue.isEmpty())
@@ -386,8 +380,7 @@ double ResourceResponseBase::date() const
     lazyInit();
 
     if (!m_haveParsedDateHeader) {
-        DEFINE_STATIC_LOCAL(const AtomicString, headerName, ("date"));
-        m_date = parseDateValueInHeader(m_httpHeaderFields, headerName);
+        m_date = parseDateValueInHeader(m_httpHeaderFields, httpHeaderNames().dateHeader);
         m_haveParsedDateHeader = true;
     }
     return m_date;
@@ -398,8 +391,7 @@ double ResourceResponseBase::age() const
     lazyInit();
     
     if (!m_haveParsedAgeHeader) {
-        DEFINE_STATIC_LOCAL(const AtomicString, headerName, ("age"));
-        String headerValue = m_httpHeaderFields.get(headerName);
+        String headerValue = m_httpHeaderFields.get(httpHeaderNames().ageHeader);
         bool ok;
         m_age = headerValue.toDouble(&ok);
         if (!ok)
@@ -414,8 +406,7 @@ double ResourceResponseBase::expires() const
     lazyInit();
 
     if (!m_haveParsedExpiresHeader) {
-        DEFINE_STATIC_LOCAL(const AtomicString, headerName, ("expires"));
-        m_expires = parseDateValueInHeader(m_httpHeaderFields, headerName);
+        m_expires = parseDateValueInHeader(m_httpHeaderFields, httpHeaderNames().expiresHeader);
         m_haveParsedExpiresHeader = true;
     }
     return m_expires;
@@ -426,8 +417,7 @@ double ResourceResponseBase::lastModified() const
     lazyInit();
     
     if (!m_haveParsedLastModifiedHeader) {
-        DEFINE_STATIC_LOCAL(const AtomicString, headerName, ("last-modified"));
-        m_lastModified = parseDateValueInHeader(m_httpHeaderFields, headerName);
+        m_lastModified = parseDateValueInHeader(m_httpHeaderFields, httpHeaderNames().lastModifiedHeader);
         m_haveParsedLastModifiedHeader = true;
     }
     return m_lastModified;
@@ -437,8 +427,7 @@ bool ResourceResponseBase::isAttachment() const
 {
     lazyInit();
 
-    DEFINE_STATIC_LOCAL(const AtomicString, headerName, ("content-disposition"));
-    String value = m_httpHeaderFields.get(headerName);
+    String value = m_httpHeaderFields.get(httpHeaderNames().contentDispositionHeader);
     size_t loc = value.find(';');
     if (loc != notFound)
         value = value.left(loc);
@@ -72,9 +72,9 @@ public:
     const String& httpStatusText() const;
     void setHTTPStatusText(const String&);
     
-    String httpHeaderField(const AtomicString& name) const;
+    String httpHeaderField(const String& name) const;
     String httpHeaderField(const char* name) const;
-    void setHTTPHeaderField(const AtomicString& name, const String& value);
+    void setHTTPHeaderField(const String& name, const String& value);
     const HTTPHeaderMap& httpHeaderFields() const;
 
     bool isMultipart() const { return mimeType() == "multipart/x-mixed-replace"; }
@@ -31,6 +31,7 @@
 #include "Logging.h"
 #include "SQLiteFileSystem.h"
 #include "SQLiteStatement.h"
+#include "SQLiteTransaction.h"
 #include <sqlite3.h>
 #include <wtf/Threading.h>
 #include <wtf/text/CString.h>
@@ -45,13 +46,24 @@ const int SQLResultSchema = SQLITE_SCHEMA;
 const int SQLResultFull = SQLITE_FULL;
 const int SQLResultInterrupt = SQLITE_INTERRUPT;
 
+// Enough for the fixed set of queries any one of our databases runs; dynamically built queries age out.
+static const unsigned StatementCacheCapacity = 64;
+
+SQLiteStatementObserver* SQLiteDatabase::s_statementObserver = 0;
+
 SQLiteDatabase::SQLiteDatabase()
     : m_db(0)
     , m_pageSize(-1)
     , m_transactionInProgress(false)
     , m_sharable(false)
+    , m_usingWriteAheadLogging(false)
     , m_openingThread(0)
     , m_interrupted(false)
+    , m_statementCacheEnabled(true)
+    , m_statementCacheClock(0)
+    , m_statementCompileCount(0)
+    , m_statementCacheHitCount(0)
+    , m_currentBatch(0)
 {
 }
 
@@ -84,6 +96,9 @@ bool SQLiteDatabase::open(const String& filename, bool forWebSQLDatabase)
 
 void SQLiteDatabase::close()
 {
+    // Cached statements would keep the database from closing.
+    clearStatementCache();
+
     if (m_db) {
         // FIXME: This is being called on themain thread during JS GC. <rdar://problem/5739818>
         // ASSERT(currentThread() == m_openingThread);
@@ -95,6 +110,7 @@ void SQLiteDatabase::close()
         sqlite3_close(db);
     }
 
+    m_usingWriteAheadLogging = false;
     m_openingThread = 0;
 }
 
@@ -412,6 +428,12 @@ void SQLiteDatabase::setAuthorizer(PassRefPtr<DatabaseAuthorizer> auth)
         return;
     }
 
+    {
+        MutexLocker locker(m_statementCacheLock);
+        m_statementCacheEnabled = false;
+    }
+    clearStatementCache();
+
     MutexLocker locker(m_authorizerLock);
 
     m_authorizer = auth;
@@ -462,4 +484,86 @@ bool SQLiteDatabase::turnOnIncrementalAutoVacuum()
     }
 }
 
+bool SQLiteDatabase::turnOnWriteAheadLogging()
+{
+    // Versions of SQLite without write-ahead logging, and file systems without the shared memory
+    // it needs, leave the journal mode as it was. Either way the pragma returns the mode in effect.
+    SQLiteStatement statement(*this, "PRAGMA journal_mode = WAL");
+    m_usingWriteAheadLogging = equalIgnoringCase(statement.getColumnText(0), "wal");
+    return m_usingWriteAheadLogging;
+}
+
+void SQLiteDatabase::setStatementObserver(SQLiteStatementObserver* observer)
+{
+    s_statementObserver = observer;
+}
+
+void SQLiteDatabase::clearStatementCache()
+{
+    MutexLocker locker(m_statementCacheLock);
+
+    StatementCache::iterator end = m_statementCache.end();
+    for (StatementCache::iterator it = m_statementCache.begin(); it != end; ++it)
+        sqlite3_finalize(it->second.statement);
+    m_statementCache.clear();
+}
+
+sqlite3_stmt* SQLiteDatabase::takeCachedStatement(const String& query)
+{
+    MutexLocker locker(m_statementCacheLock);
+
+    StatementCache::iterator it = m_statementCache.find(query);
+    if (it == m_statementCache.end())
+        return 0;
+
+    sqlite3_stmt* statement = it->second.statement;
+    m_statementCache.remove(it);
+    ++m_statementCacheHitCount;
+    return statement;
+}
+
+bool SQLiteDatabase::cacheStatement(const String& query, sqlite3_stmt* statement)
+{
+    MutexLocker locker(m_statementCacheLock);
+
+    // The statement may belong to a handle that has since been closed, and only one
+    // statement is kept per query.
+    if (!m_statementCacheEnabled || !m_db || sqlite3_db_handle(statement) != m_db || m_statementCache.contains(query))
+        return false;
+
+    if (m_statementCache.size() >= StatementCacheCapacity) {
+        StatementCache::iterator end = m_statementCache.end();
+        StatementCache::iterator leastRecentlyUsed = m_statementCache.begin();
+        for (StatementCache::iterator it = leastRecentlyUsed; it != end; ++it) {
+            if (it->second.lastUse < leastRecentlyUsed->second.lastUse)
+                leastRecentlyUsed = it;
+        }
+        sqlite3_finalize(leastRecentlyUsed->second.statement);
+        m_statementCache.remove(leastRecentlyUsed);
+    }
+
+    CachedStatement cachedStatement;
+    cachedStatement.statement = statement;
+    cachedStatement.lastUse = ++m_statementCacheClock;
+    m_statementCache.set(query.crossThreadString(), cachedStatement);
+    return true;
+}
+
+void SQLiteDatabase::didCompileStatement(const String& query, double compileTime)
+{
+    {
+        MutexLocker locker(m_statementCacheLock);
+        ++m_statementCompileCount;
+    }
+
+    if (s_statementObserver)
+        s_statementObserver->statementCompiled(query, compileTime);
+}
+
+void SQLiteDatabase::statementCompleted()
+{
+    if (m_currentBatch)
+        m_currentBatch->statementCompleted();
+}
+
 } // namespace WebCore
@@ -28,19 +28,23 @@
 #define SQLiteDatabase_h
 
 #include "PlatformString.h"
+#include <wtf/HashMap.h>
 #include <wtf/Threading.h>
+#include <wtf/text/StringHash.h>
 
 #if COMPILER(MSVC)
 #pragma warning(disable: 4800)
 #endif
 
 struct sqlite3;
+struct sqlite3_stmt;
 
 namespace WebCore {
 
 class DatabaseAuthorizer;
 class SQLiteStatement;
 class SQLiteTransaction;
+class SQLiteTransactionBatch;
 
 extern const int SQLResultDone;
 extern const int SQLResultError;
@@ -50,8 +54,19 @@ extern const int SQLResultSchema;
 extern const int SQLResultFull;
 extern const int SQLResultInterrupt;
 
+// Debugging hook that is told about every statement compiled or stepped on any database.
+class SQLiteStatementObserver {
+public:
+    virtual ~SQLiteStatementObserver() { }
+
+    virtual void statementCompiled(const String& query, double compileTime) = 0;
+    virtual void statementStepped(const String& query, double stepTime) = 0;
+};
+
 class SQLiteDatabase : public Noncopyable {
+    friend class SQLiteStatement;
     friend class SQLiteTransaction;
+    friend class SQLiteTransactionBatch;
 public:
     SQLiteDatabase();
     ~SQLiteDatabase();
@@ -123,6 +138,12 @@ public:
     enum AutoVacuumPragma { AutoVacuumNone = 0, AutoVacuumFull = 1, AutoVacuumIncremental = 2 };
     bool turnOnIncrementalAutoVacuum();
 
+    // In write-ahead logging mode, connections that read no longer block a connection that writes,
+    // and the reads keep seeing the database as it was when their transaction began. The mode is
+    // stored in the file. Returns false if SQLite or the file system doesn't support it.
+    bool turnOnWriteAheadLogging();
+    bool isUsingWriteAheadLogging() const { return m_usingWriteAheadLogging; }
+
     // Set this flag to allow access from multiple threads.  Not all multi-threaded accesses are safe!
     // See http://www.sqlite.org/cvstrac/wiki?p=MultiThreading for more info.
 #ifndef NDEBUG
@@ -131,12 +152,30 @@ public:
     void disableThreadingChecks() {}
 #endif
 
+    // Statements are returned to a small LRU cache keyed by their SQL text when they are finalized,
+    // so preparing the same query again reuses the compiled statement. Databases with an authorizer
+    // bypass the cache, since the authorizer is only consulted when a statement is compiled.
+    void clearStatementCache();
+    unsigned statementCompileCount() const { return m_statementCompileCount; }
+    unsigned statementCacheHitCount() const { return m_statementCacheHitCount; }
+
+    // The observer is shared by every database on every thread, so it should be set before any are opened.
+    static void setStatementObserver(SQLiteStatementObserver*);
+    static SQLiteStatementObserver* statementObserver() { return s_statementObserver; }
+
 private:
     static int authorizerFunction(void*, int, const char*, const char*, const char*, const char*);
 
     void enableAuthorizer(bool enable);
     
     int pageSize();
+
+    sqlite3_stmt* takeCachedStatement(const String& query);
+    bool cacheStatement(const String& query, sqlite3_stmt*);
+    void didCompileStatement(const String& query, double compileTime);
+    void statementCompleted();
+
+    static SQLiteStatementObserver* s_statementObserver;
     
     sqlite3* m_db;
     int m_lastError;
@@ -144,6 +183,7 @@ private:
     
     bool m_transactionInProgress;
     bool m_sharable;
+    bool m_usingWriteAheadLogging;
     
     Mutex m_authorizerLock;
     RefPtr<DatabaseAuthorizer> m_authorizer;
@@ -153,6 +193,21 @@ private:
 
     Mutex m_databaseClosingMutex;
     bool m_interrupted;
+
+    struct CachedStatement {
+        sqlite3_stmt* statement;
+        unsigned lastUse;
+    };
+    typedef HashMap<String, CachedStatement> StatementCache;
+
+    Mutex m_statementCacheLock;
+    StatementCache m_statementCache;
+    bool m_statementCacheEnabled;
+    unsigned m_statementCacheClock;
+    unsigned m_statementCompileCount;
+    unsigned m_statementCacheHitCount;
+
+    SQLiteTransactionBatch* m_currentBatch;
 }; // class SQLiteDatabase
 
 } // namespace WebCore
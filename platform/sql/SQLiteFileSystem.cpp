@@ -109,15 +109,24 @@ bool SQLiteFileSystem::deleteEmptyDatabaseDirectory(const String& path)
     return deleteEmptyDirectory(path);
 }
 
+// A database in write-ahead logging mode keeps its recent changes in a "-wal" file next to it,
+// and an index of that file in a "-shm" file.
 bool SQLiteFileSystem::deleteDatabaseFile(const String& fileName)
 {
+    deleteFile(fileName + "-wal");
+    deleteFile(fileName + "-shm");
     return deleteFile(fileName);
 }
 
 long long SQLiteFileSystem::getDatabaseFileSize(const String& fileName)
 {        
     long long size;
-    return getFileSize(fileName, size) ? size : 0;
+    if (!getFileSize(fileName, size))
+        return 0;
+    long long walSize;
+    if (getFileSize(fileName + "-wal", walSize))
+        size += walSize;
+    return size;
 }
 
 } // namespace WebCore
@@ -97,12 +97,12 @@ public:
     // path - The directory.
     static bool deleteEmptyDatabaseDirectory(const String& path);
 
-    // Deletes a database file.
+    // Deletes a database file, along with its write-ahead log.
     //
     // fileName - The file name.
     static bool deleteDatabaseFile(const String& fileName);
 
-    // Returns the size of the database file.
+    // Returns the size of the database file, including changes still in its write-ahead log.
     //
     // fileName - The file name.
     static long long getDatabaseFileSize(const String& fileName);
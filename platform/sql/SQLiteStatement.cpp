@@ -30,6 +30,7 @@
 #include "SQLValue.h"
 #include <sqlite3.h>
 #include <wtf/Assertions.h>
+#include <wtf/CurrentTime.h>
 #include <wtf/text/CString.h>
 
 namespace WebCore {
@@ -67,6 +68,16 @@ int SQLiteStatement::prepare()
     if (m_database.isInterrupted())
         return SQLITE_INTERRUPT;
 
+    if (sqlite3_stmt* cachedStatement = m_database.takeCachedStatement(m_query)) {
+        LOG(SQLDatabase, "SQL - prepare (cached) - %s", m_query.ascii().data());
+        m_statement = cachedStatement;
+#ifndef NDEBUG
+        m_isPrepared = true;
+#endif
+        return SQLITE_OK;
+    }
+
+    double startTime = SQLiteDatabase::statementObserver() ? currentTime() : 0;
     const void* tail = 0;
     LOG(SQLDatabase, "SQL - prepare - %s", m_query.ascii().data());
     String strippedQuery = m_query.stripWhiteSpace();
@@ -85,6 +96,12 @@ int SQLiteStatement::prepare()
     const UChar* ch = static_cast<const UChar*>(tail);
     if (ch && *ch)
         error = SQLITE_ERROR;
+    // Never let a statement that failed to prepare find its way into the statement cache.
+    if (error != SQLITE_OK && m_statement) {
+        sqlite3_finalize(m_statement);
+        m_statement = 0;
+    }
+    m_database.didCompileStatement(m_query, startTime ? currentTime() - startTime : 0);
 #ifndef NDEBUG
     m_isPrepared = error == SQLITE_OK;
 #endif
@@ -95,19 +112,30 @@ int SQLiteStatement::step()
 {
     ASSERT(m_isPrepared);
 
-    MutexLocker databaseLock(m_database.databaseMutex());
-    if (m_database.isInterrupted())
-        return SQLITE_INTERRUPT;
-
-    if (!m_statement)
-        return SQLITE_OK;
-    LOG(SQLDatabase, "SQL - step - %s", m_query.ascii().data());
-    int error = sqlite3_step(m_statement);
-    if (error != SQLITE_DONE && error != SQLITE_ROW) {
-        LOG(SQLDatabase, "sqlite3_step failed (%i)\nQuery - %s\nError - %s", 
-            error, m_query.ascii().data(), sqlite3_errmsg(m_database.sqlite3Handle()));
+    int error;
+    {
+        MutexLocker databaseLock(m_database.databaseMutex());
+        if (m_database.isInterrupted())
+            return SQLITE_INTERRUPT;
+
+        if (!m_statement)
+            return SQLITE_OK;
+        LOG(SQLDatabase, "SQL - step - %s", m_query.ascii().data());
+        SQLiteStatementObserver* observer = SQLiteDatabase::statementObserver();
+        double startTime = observer ? currentTime() : 0;
+        error = sqlite3_step(m_statement);
+        if (observer)
+            observer->statementStepped(m_query, currentTime() - startTime);
+        if (error != SQLITE_DONE && error != SQLITE_ROW) {
+            LOG(SQLDatabase, "sqlite3_step failed (%i)\nQuery - %s\nError - %s", 
+                error, m_query.ascii().data(), sqlite3_errmsg(m_database.sqlite3Handle()));
+        }
     }
 
+    // This may commit the current transaction batch, which needs the database lock.
+    if (error == SQLITE_DONE)
+        m_database.statementCompleted();
+
     return error;
 }
     
@@ -119,7 +147,12 @@ int SQLiteStatement::finalize()
     if (!m_statement)
         return SQLITE_OK;
     LOG(SQLDatabase, "SQL - finalize - %s", m_query.ascii().data());
-    int result = sqlite3_finalize(m_statement);
+    // Resetting reports the error of the last step just like finalizing does, and leaves
+    // the statement ready to be handed out again by the database's statement cache.
+    int result = sqlite3_reset(m_statement);
+    sqlite3_clear_bindings(m_statement);
+    if (!m_database.cacheStatement(m_query, m_statement))
+        sqlite3_finalize(m_statement);
     m_statement = 0;
     return result;
 }
@@ -100,4 +100,66 @@ bool SQLiteTransaction::wasRolledBackBySqlite() const
     return m_inProgress && m_db.isAutoCommitOn();
 }
 
+SQLiteTransactionBatch::SQLiteTransactionBatch(SQLiteDatabase& db, unsigned maxStatementsPerTransaction)
+    : m_db(db)
+    , m_maxStatementsPerTransaction(maxStatementsPerTransaction)
+    , m_statementCount(0)
+    , m_committing(false)
+{
+    ASSERT(m_maxStatementsPerTransaction);
+    if (m_db.m_currentBatch || m_db.transactionInProgress() || !m_db.isOpen())
+        return;
+
+    m_transaction = adoptPtr(new SQLiteTransaction(m_db));
+    m_transaction->begin();
+    if (!m_transaction->inProgress()) {
+        m_transaction.clear();
+        return;
+    }
+    m_db.m_currentBatch = this;
+}
+
+SQLiteTransactionBatch::~SQLiteTransactionBatch()
+{
+    commit();
+}
+
+void SQLiteTransactionBatch::commit()
+{
+    if (!m_transaction)
+        return;
+
+    ASSERT(m_db.m_currentBatch == this);
+    m_db.m_currentBatch = 0;
+
+    // If the commit fails, destroying the transaction rolls it back.
+    m_committing = true;
+    m_transaction->commit();
+    m_transaction.clear();
+    m_committing = false;
+}
+
+void SQLiteTransactionBatch::statementCompleted()
+{
+    ASSERT(m_transaction);
+
+    // Ignore the COMMIT and BEGIN statements run below.
+    if (m_committing || ++m_statementCount < m_maxStatementsPerTransaction)
+        return;
+
+    m_committing = true;
+    m_transaction->commit();
+    // The commit fails while other statements are still in progress; just keep going in the current transaction.
+    if (!m_transaction->inProgress()) {
+        m_transaction->begin();
+        m_statementCount = 0;
+    }
+    m_committing = false;
+
+    if (!m_transaction->inProgress()) {
+        m_transaction.clear();
+        m_db.m_currentBatch = 0;
+    }
+}
+
 } // namespace WebCore
@@ -27,6 +27,7 @@
 #define SQLiteTransaction_h
 
 #include <wtf/Noncopyable.h>
+#include <wtf/OwnPtr.h>
 
 namespace WebCore {
 
@@ -51,6 +52,28 @@ private:
     bool m_readOnly;
 };
 
+// Groups every statement run on the database while it is alive into as few transactions as possible:
+// a transaction is begun up front and committed, then begun again, each time maxStatementsPerTransaction
+// statements have completed, so that long batches don't grow the journal without bound. If a transaction
+// or another batch is already in progress the batch simply joins it.
+class SQLiteTransactionBatch : public Noncopyable {
+public:
+    SQLiteTransactionBatch(SQLiteDatabase&, unsigned maxStatementsPerTransaction = 256);
+    ~SQLiteTransactionBatch();
+
+    void commit();
+
+private:
+    friend class SQLiteDatabase;
+    void statementCompleted();
+
+    SQLiteDatabase& m_db;
+    OwnPtr<SQLiteTransaction> m_transaction;
+    unsigned m_maxStatementsPerTransaction;
+    unsigned m_statementCount;
+    bool m_committing;
+};
+
 } // namespace WebCore
 
 #endif // SQLiteTransation_H
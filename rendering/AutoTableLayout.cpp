@@ -34,6 +34,7 @@ namespace WebCore {
 AutoTableLayout::AutoTableLayout(RenderTable* table)
     : TableLayout(table)
     , m_hasPercent(false)
+    , m_needsFullRecalc(true)
     , m_percentagesDirty(true)
     , m_effWidthDirty(true)
     , m_totalPercent(0)
@@ -44,6 +45,46 @@ AutoTableLayout::~AutoTableLayout()
 {
 }
 
+// Past this many dirty cells a full recalc is cheaper than tracking each of them.
+static const unsigned maxTrackedDirtyCells = 1024;
+
+static inline void addCellContribution(int& largest, unsigned& count, int width)
+{
+    if (width > largest) {
+        largest = width;
+        count = 1;
+    } else if (width == largest)
+        count++;
+}
+
+// Replaces one cell's contribution to a column maximum. Returns false when the new maximum
+// can't be known without looking at the other cells, i.e. when the only cell at the maximum shrank.
+static inline bool replaceCellContribution(int& largest, unsigned& count, int oldWidth, int newWidth)
+{
+    if (newWidth > largest) {
+        largest = newWidth;
+        count = 1;
+        return true;
+    }
+    if (newWidth == largest) {
+        if (oldWidth != largest)
+            count++;
+        return true;
+    }
+    if (oldWidth != largest)
+        return true;
+    if (count > 1) {
+        count--;
+        return true;
+    }
+    return false;
+}
+
+static inline bool cellHasContent(RenderTableCell* cell)
+{
+    return cell->firstChild() || cell->style()->hasBorder() || cell->style()->hasPadding();
+}
+
 /* recalculates the full structure needed to do layouting and minmax calculations.
    This is usually calculated on the fly, but needs to be done fully when table cells change
    dynamically
@@ -68,8 +109,8 @@ void AutoTableLayout::recalcColumn(int effCol)
                 RenderTableSection::CellStruct current = section->cellAt(i, effCol);
                 RenderTableCell* cell = current.primaryCell();
                 
-                bool cellHasContent = cell && !current.inColSpan && (cell->firstChild() || cell->style()->hasBorder() || cell->style()->hasPadding());
-                if (cellHasContent)
+                bool hasContent = cell && !current.inColSpan && cellHasContent(cell);
+                if (hasContent)
                     l.emptyCellsOnly = false;
                     
                 if (current.inColSpan)
@@ -77,7 +118,7 @@ void AutoTableLayout::recalcColumn(int effCol)
                 if (cell && cell->colSpan() == 1) {
                     // A cell originates in this column.  Ensure we have
                     // a min/max width of at least 1px for this column now.
-                    l.minWidth = max(l.minWidth, cellHasContent ? 1 : 0);
+                    l.minWidth = max(l.minWidth, hasContent ? 1 : 0);
                     l.maxWidth = max(l.maxWidth, 1);
                     if (cell->prefWidthsDirty())
                         cell->calcPrefWidths();
@@ -86,8 +127,12 @@ void AutoTableLayout::recalcColumn(int effCol)
                         l.maxWidth = cell->maxPrefWidth();
                         maxContributor = cell;
                     }
+                    addCellContribution(l.cellMinWidth, l.cellMinWidthCount, cell->minPrefWidth());
+                    addCellContribution(l.cellMaxWidth, l.cellMaxWidthCount, cell->maxPrefWidth());
 
                     Length w = cell->styleOrColWidth();
+                    if (!w.isAuto())
+                        l.hasSpecifiedWidth = true;
                     // FIXME: What is this arbitrary value?
                     if (w.rawValue() > 32760)
                         w.setRawValue(32760);
@@ -113,6 +158,7 @@ void AutoTableLayout::recalcColumn(int effCol)
                         break;
                     case Percent:
                         m_hasPercent = true;
+                        l.hasPercentCell = true;
                         if (w.isPositive() && (!l.width.isPercent() || w.rawValue() > l.width.rawValue()))
                             l.width = w;
                         break;
@@ -128,7 +174,7 @@ void AutoTableLayout::recalcColumn(int effCol)
                     if (cell && (!effCol || section->primaryCellAt(i, effCol-1) != cell)) {
                         // This spanning cell originates in this column.  Ensure we have
                         // a min/max width of at least 1px for this column now.
-                        l.minWidth = max(l.minWidth, cellHasContent ? 1 : 0);
+                        l.minWidth = max(l.minWidth, hasContent ? 1 : 0);
                         l.maxWidth = max(l.maxWidth, 1);
                         insertSpanCell(cell);
                     }
@@ -151,17 +197,9 @@ void AutoTableLayout::recalcColumn(int effCol)
     // ### we need to add col elements as well
 }
 
-void AutoTableLayout::fullRecalc()
+void AutoTableLayout::calcColElementWidths(Vector<Layout, 4>& columns)
 {
-    m_percentagesDirty = true;
-    m_hasPercent = false;
-    m_effWidthDirty = true;
-
-    int nEffCols = m_table->numEffCols();
-    m_layoutStruct.resize(nEffCols);
-    m_layoutStruct.fill(Layout());
-    m_spanCells.fill(0);
-
+    int nEffCols = columns.size();
     RenderObject *child = m_table->firstChild();
     Length grpWidth;
     int cCol = 0;
@@ -180,9 +218,10 @@ void AutoTableLayout::fullRecalc()
                 int cEffCol = m_table->colToEffCol(cCol);
                 if (!w.isAuto() && span == 1 && cEffCol < nEffCols) {
                     if (m_table->spanOfEffCol(cEffCol) == 1) {
-                        m_layoutStruct[cEffCol].width = w;
-                        if (w.isFixed() && m_layoutStruct[cEffCol].maxWidth < w.value())
-                            m_layoutStruct[cEffCol].maxWidth = w.value();
+                        columns[cEffCol].width = w;
+                        columns[cEffCol].hasSpecifiedWidth = true;
+                        if (w.isFixed() && columns[cEffCol].maxWidth < w.value())
+                            columns[cEffCol].maxWidth = w.value();
                     }
                 }
                 cCol += span;
@@ -200,12 +239,109 @@ void AutoTableLayout::fullRecalc()
         }
         child = next;
     }
+}
+
+void AutoTableLayout::fullRecalc()
+{
+    m_percentagesDirty = true;
+    m_hasPercent = false;
+    m_effWidthDirty = true;
+    m_needsFullRecalc = false;
+    m_dirtyCells.clear();
+
+    int nEffCols = m_table->numEffCols();
+    m_layoutStruct.resize(nEffCols);
+    m_layoutStruct.fill(Layout());
+    m_spanCells.fill(0);
 
+    calcColElementWidths(m_layoutStruct);
 
     for (int i = 0; i < nEffCols; i++)
         recalcColumn(i);
 }
 
+void AutoTableLayout::cellPrefWidthsDirtied(RenderTableCell* cell)
+{
+    if (m_needsFullRecalc)
+        return;
+
+    if (m_dirtyCells.size() >= maxTrackedDirtyCells) {
+        m_needsFullRecalc = true;
+        m_dirtyCells.clear();
+        return;
+    }
+
+    // The cell is still clean, so these are the widths its column was computed with. Only keep
+    // the first notification: the cell may be recomputed and dirtied again before we look at it.
+    m_dirtyCells.add(cell, make_pair(cell->minPrefWidth(), cell->maxPrefWidth()));
+}
+
+bool AutoTableLayout::updateColumnForCell(RenderTableCell* cell, int oldMinWidth, int oldMaxWidth, Vector<int>& columnsToRescan)
+{
+    if (cell->colSpan() != 1)
+        return false;
+    int effCol = m_table->colToEffCol(cell->col());
+    if (effCol >= static_cast<int>(m_layoutStruct.size()))
+        return false;
+    if (columnsToRescan.contains(effCol))
+        return true;
+
+    if (cell->prefWidthsDirty())
+        cell->calcPrefWidths();
+
+    // Only columns whose width comes from their cells' content can be updated from the counts
+    // alone. Specified widths bring in the Nav/IE tie-breaking rules of recalcColumn(), which
+    // depend on the order of the cells.
+    Layout& l = m_layoutStruct[effCol];
+    if (l.hasSpecifiedWidth || cell->rowSpan() != 1 || !cellHasContent(cell) || !cell->styleOrColWidth().isAuto()
+        || !replaceCellContribution(l.cellMinWidth, l.cellMinWidthCount, oldMinWidth, cell->minPrefWidth())
+        || !replaceCellContribution(l.cellMaxWidth, l.cellMaxWidthCount, oldMaxWidth, cell->maxPrefWidth())) {
+        columnsToRescan.append(effCol);
+        return true;
+    }
+
+    l.emptyCellsOnly = false;
+    l.minWidth = max(l.cellMinWidth, 1);
+    l.maxWidth = max(max(l.cellMaxWidth, 1), l.minWidth);
+    return true;
+}
+
+bool AutoTableLayout::recalcDirtyColumns()
+{
+    // Spanning cells are distributed over their columns by calcEffectiveWidth(), which also
+    // writes back into the per-column data, so tables with colspans always take the full path.
+    int nEffCols = m_table->numEffCols();
+    if (m_needsFullRecalc || static_cast<int>(m_layoutStruct.size()) != nEffCols || (!m_spanCells.isEmpty() && m_spanCells[0]))
+        return false;
+
+    Vector<int> columnsToRescan;
+    HashMap<RenderTableCell*, pair<int, int> >::iterator end = m_dirtyCells.end();
+    for (HashMap<RenderTableCell*, pair<int, int> >::iterator it = m_dirtyCells.begin(); it != end; ++it) {
+        if (!updateColumnForCell(it->first, it->second.first, it->second.second, columnsToRescan))
+            return false;
+    }
+    m_dirtyCells.clear();
+
+    if (!columnsToRescan.isEmpty()) {
+        Vector<Layout, 4> columns(nEffCols);
+        calcColElementWidths(columns);
+        for (size_t i = 0; i < columnsToRescan.size(); ++i) {
+            int effCol = columnsToRescan[i];
+            m_layoutStruct[effCol] = columns[effCol];
+            recalcColumn(effCol);
+        }
+    }
+
+    m_hasPercent = false;
+    for (int i = 0; i < nEffCols; i++) {
+        if (m_layoutStruct[i].hasPercentCell)
+            m_hasPercent = true;
+    }
+    m_percentagesDirty = true;
+    m_effWidthDirty = true;
+    return true;
+}
+
 static bool shouldScaleColumns(RenderTable* table)
 {
     // A special case.  If this table is not fixed width and contained inside
@@ -241,7 +377,8 @@ static bool shouldScaleColumns(RenderTable* table)
 
 void AutoTableLayout::calcPrefWidths(int& minWidth, int& maxWidth)
 {
-    fullRecalc();
+    if (!recalcDirtyColumns())
+        fullRecalc();
 
     int spanMaxWidth = calcEffectiveWidth();
     minWidth = 0;
@@ -760,10 +897,10 @@ void AutoTableLayout::layout()
 
     int pos = 0;
     for (int i = 0; i < nEffCols; i++) {
-        m_table->columnPositions()[i] = pos;
+        m_table->setColumnPosition(i, pos);
         pos += m_layoutStruct[i].calcWidth + m_table->hBorderSpacing();
     }
-    m_table->columnPositions()[m_table->columnPositions().size() - 1] = pos;
+    m_table->setColumnPosition(m_table->columnPositions().size() - 1, pos);
 }
 
 
@@ -23,6 +23,7 @@
 
 #include "Length.h"
 #include "TableLayout.h"
+#include <wtf/HashMap.h>
 #include <wtf/Vector.h>
 
 namespace WebCore {
@@ -38,8 +39,16 @@ public:
     virtual void calcPrefWidths(int& minWidth, int& maxWidth);
     virtual void layout();
 
+    virtual void cellPrefWidthsDirtied(RenderTableCell*);
+    virtual void tableStructureChanged()
+    {
+        m_needsFullRecalc = true;
+        m_dirtyCells.clear();
+    }
+
 protected:
     void fullRecalc();
+    bool recalcDirtyColumns();
     void recalcColumn(int effCol);
 
     void calcPercentages() const;
@@ -61,7 +70,13 @@ protected:
             , effMinWidth(0)
             , effMaxWidth(0)
             , calcWidth(0)
-            , emptyCellsOnly(true) {}
+            , cellMinWidth(0)
+            , cellMaxWidth(0)
+            , cellMinWidthCount(0)
+            , cellMaxWidthCount(0)
+            , emptyCellsOnly(true)
+            , hasSpecifiedWidth(false)
+            , hasPercentCell(false) {}
         Length width;
         Length effWidth;
         int minWidth;
@@ -69,12 +84,29 @@ protected:
         int effMinWidth;
         int effMaxWidth;
         int calcWidth;
+        // Largest min/max preferred width among the single-column cells originating in
+        // this column, and how many cells have it. Lets a changed cell update its column
+        // without rescanning every row.
+        int cellMinWidth;
+        int cellMaxWidth;
+        unsigned cellMinWidthCount;
+        unsigned cellMaxWidthCount;
         bool emptyCellsOnly;
+        // A cell or col element gave this column a non-auto width.
+        bool hasSpecifiedWidth;
+        bool hasPercentCell;
     };
 
+    void calcColElementWidths(Vector<Layout, 4>&);
+    bool updateColumnForCell(RenderTableCell*, int oldMinWidth, int oldMaxWidth, Vector<int>& columnsToRescan);
+
     Vector<Layout, 4> m_layoutStruct;
     Vector<RenderTableCell*, 4> m_spanCells;
+    // Cells whose preferred widths were dirtied since the last calcPrefWidths(), with
+    // the min/max widths they contributed to their column at that time.
+    HashMap<RenderTableCell*, std::pair<int, int> > m_dirtyCells;
     bool m_hasPercent : 1;
+    bool m_needsFullRecalc : 1;
     mutable bool m_percentagesDirty : 1;
     mutable bool m_effWidthDirty : 1;
     mutable unsigned short m_totalPercent;
@@ -46,7 +46,9 @@
 #include "RenderView.h"
 #include "SelectionController.h"
 #include "Settings.h"
+#include "SimpleFontData.h"
 #include "TransformState.h"
+#include <wtf/MathExtras.h>
 #include <wtf/StdLibExtras.h>
 
 using namespace std;
@@ -173,6 +175,9 @@ void RenderBlock::destroy()
     }
     
     if (!documentBeingDestroyed()) {
+        if (layoutDeferred())
+            view()->removeDeferredLayoutBlock(this);
+
         if (firstLineBox()) {
             // We can't wait for RenderBox::destroy to clear the selection,
             // because by then we will have nuked the line boxes.
@@ -815,6 +820,7 @@ RootInlineBox* RenderBlock::createAndAppendRootInlineBox()
 {
     RootInlineBox* rootBox = createRootInlineBox();
     m_lineBoxes.appendLineBox(rootBox);
+    PhaseTracer::increment(PhaseTracer::LinesCreatedCounter);
     return rootBox;
 }
 
@@ -1131,6 +1137,11 @@ void RenderBlock::layoutBlock(bool relayoutChildren)
     if (!relayoutChildren && layoutOnlyPositionedObjects())
         return;
 
+    if (layoutDeferred()) {
+        setLayoutDeferred(false);
+        view()->removeDeferredLayoutBlock(this);
+    }
+
     LayoutRepainter repainter(*this, m_everHadLayout && checkForRepaintDuringLayout());
     LayoutStateMaintainer statePusher(view(), this, IntSize(x(), y()), hasColumns() || hasTransform() || hasReflection());
 
@@ -1805,8 +1816,12 @@ void RenderBlock::layoutBlockChild(RenderBox* child, MarginInfo& marginInfo, int
 
     bool childHadLayout = child->m_everHadLayout;
     bool childNeededLayout = child->needsLayout();
-    if (childNeededLayout)
-        child->layout();
+    if (childNeededLayout) {
+        if (child->isRenderBlock() && (!childHadLayout || child->layoutDeferred()) && !markDescendantsWithFloats)
+            layoutOrDeferBlockChild(toRenderBlock(child), yPosEstimate);
+        else
+            child->layout();
+    }
 
     // Now determine the correct ypos based off examination of collapsing margin
     // values.
@@ -1871,6 +1886,107 @@ void RenderBlock::layoutBlockChild(RenderBox* child, MarginInfo& marginInfo, int
     ASSERT(oldLayoutDelta == view()->layoutDelta());
 }
 
+void RenderBlock::layoutOrDeferBlockChild(RenderBlock* child, int yPosEstimate)
+{
+    bool wasDeferred = child->layoutDeferred();
+    bool canDefer = child->canDeferLayout();
+    if (!wasDeferred && !canDefer) {
+        child->layout();
+        return;
+    }
+
+    RenderView* renderView = view();
+    int absoluteTop = lroundf(localToAbsolute(FloatPoint(0, yPosEstimate)).y());
+    if (canDefer) {
+        child->calcWidth();
+        int estimatedHeight = child->estimatedHeightForDeferredLayout();
+        if (renderView->shouldDeferLayoutOfBlock(absoluteTop, estimatedHeight)) {
+            child->deferLayout(estimatedHeight);
+            return;
+        }
+    }
+
+    int estimatedHeight = child->height();
+    child->layout();
+
+    // If the estimate was for a block entirely above the visible area, scroll by the
+    // difference so that what the user is looking at doesn't move.
+    if (wasDeferred && absoluteTop + estimatedHeight <= renderView->frameView()->scrollY())
+        renderView->addDeferredLayoutScrollAdjustment(child->height() - estimatedHeight);
+}
+
+bool RenderBlock::canDeferLayout() const
+{
+    if (!childrenInline() || !firstChild() || !isBlockFlow() || isListItem() || isFlexibleBox() || isFieldset())
+        return false;
+    if (hasLayer() || hasColumns() || isFloatingOrPositioned())
+        return false;
+
+    Document* doc = document();
+    if (doc->printing() || !doc->settings() || !doc->settings()->lazyLayoutEnabled())
+        return false;
+
+    // Only text and inlines without layers. Layers, floats and positioned objects are reached
+    // through the layer tree and the float and positioned object lists rather than through our
+    // line boxes, and replaced elements and inline blocks keep layout state of their own. Plain
+    // inline content is rebuilt from scratch by the full line layout a block without line boxes
+    // gets, so deferLayout() can clear its layout bits.
+    for (RenderObject* object = firstChild(); object; object = object->nextInPreOrder(this)) {
+        if (!(object->isText() || object->isRenderInline()) || object->hasLayer() || object->isFloatingOrPositioned())
+            return false;
+    }
+    return true;
+}
+
+int RenderBlock::estimatedHeightForDeferredLayout() const
+{
+    // Guess how many lines the inline content wraps to by laying its text end to end in
+    // characters of average width. Only text and forced breaks are looked at.
+    unsigned characterCount = 0;
+    int forcedLineBreaks = 0;
+    for (RenderObject* object = firstChild(); object; object = object->nextInPreOrder(this)) {
+        if (object->isBR())
+            forcedLineBreaks++;
+        else if (object->isText()) {
+            RenderText* text = toRenderText(object);
+            characterCount += text->textLength();
+            if (text->style()->preserveNewline()) {
+                const UChar* characters = text->characters();
+                for (unsigned i = 0; i < text->textLength(); ++i) {
+                    if (characters[i] == '\n')
+                        forcedLineBreaks++;
+                }
+            }
+        }
+    }
+
+    float averageCharacterWidth = max(style()->font().primaryFont()->avgCharWidth(), 1.0f);
+    int lineWidth = max(contentWidth(), 1);
+    int lineCount = static_cast<int>(ceilf(characterCount * averageCharacterWidth / lineWidth)) + forcedLineBreaks;
+    return borderTop() + paddingTop() + lineCount * lineHeight(false, true) + paddingBottom() + borderBottom();
+}
+
+void RenderBlock::deferLayout(int estimatedHeight)
+{
+    ASSERT(!firstLineBox());
+
+    // The width has already been computed by our parent.
+    setHeight(estimatedHeight);
+    calcHeight();
+
+    if (!layoutDeferred()) {
+        setLayoutDeferred();
+        view()->addDeferredLayoutBlock(this);
+    }
+
+    // Clear our descendants' layout bits as well, so that a later change inside us marks us
+    // for layout again and gets us a new estimate. Their layout happens when ours does, since
+    // without line boxes we do a full line layout (see canDeferLayout()).
+    for (RenderObject* object = firstChild(); object; object = object->nextInPreOrder(this))
+        object->setNeedsLayout(false);
+    setNeedsLayout(false);
+}
+
 bool RenderBlock::layoutOnlyPositionedObjects()
 {
     if (!posChildNeedsLayout() || normalChildNeedsLayout() || selfNeedsLayout())
@@ -523,6 +523,10 @@ private:
     };
 
     void layoutBlockChild(RenderBox* child, MarginInfo&, int& previousFloatBottom, int& maxFloatBottom);
+    void layoutOrDeferBlockChild(RenderBlock* child, int yPosEstimate);
+    bool canDeferLayout() const;
+    int estimatedHeightForDeferredLayout() const;
+    void deferLayout(int estimatedHeight);
     void adjustPositionedBlock(RenderBox* child, const MarginInfo&);
     void adjustFloatingBlock(const MarginInfo&);
     bool handleSpecialChild(RenderBox* child, const MarginInfo&);
@@ -2611,6 +2611,8 @@ static inline IntRect frameVisibleRect(RenderObject* renderer)
 bool RenderLayer::hitTest(const HitTestRequest& request, HitTestResult& result)
 {
     renderer()->document()->updateLayout();
+    if (renderer()->isRenderView() && toRenderView(renderer())->hasDeferredLayoutBlocks())
+        toRenderView(renderer())->frameView()->layoutDeferredContentAbove(result.point().y() + 1);
     
     IntRect boundsRect(m_x, m_y, width(), height());
     if (!request.ignoreClipping())
@@ -214,6 +214,7 @@ RenderObject::RenderObject(Node* node)
     , m_hasMarkupTruncation(false)
     , m_selectionState(SelectionNone)
     , m_hasColumns(false)
+    , m_layoutDeferred(false)
     , m_cellWidthChanged(false)
 {
 #ifndef NDEBUG
@@ -224,7 +225,7 @@ RenderObject::RenderObject(Node* node)
 
 RenderObject::~RenderObject()
 {
-    ASSERT(!node() || documentBeingDestroyed() || !frame()->view() || frame()->view()->layoutRoot() != this);
+    ASSERT(!node() || documentBeingDestroyed() || !frame()->view() || !frame()->view()->isLayoutRoot(this));
 #ifndef NDEBUG
     ASSERT(!m_hasAXObject);
     renderObjectCounter.decrement();
@@ -573,9 +574,27 @@ RenderBlock* RenderObject::firstLineBlock() const
     return 0;
 }
 
+// Lets an auto table layout update only the column of a cell whose preferred widths change,
+// instead of rescanning every cell. Must run while the old preferred widths are still cached.
+static void notifyTablePrefWidthsWillBeDirty(RenderObject* object)
+{
+    if (object->isTableCell()) {
+        RenderObject* row = object->parent();
+        RenderObject* section = row ? row->parent() : 0;
+        RenderObject* table = section ? section->parent() : 0;
+        if (table && table->isTable())
+            toRenderTable(table)->cellPrefWidthsDirtied(toRenderTableCell(object));
+    } else if (object->isTableCol()) {
+        if (RenderTable* table = toRenderTableCol(object)->table())
+            table->colPrefWidthsDirtied();
+    }
+}
+
 void RenderObject::setPrefWidthsDirty(bool b, bool markParents)
 {
     bool alreadyDirty = m_prefWidthsDirty;
+    if (b && !alreadyDirty)
+        notifyTablePrefWidthsWillBeDirty(this);
     m_prefWidthsDirty = b;
     if (b && !alreadyDirty && markParents && (isText() || (style()->position() != FixedPosition && style()->position() != AbsolutePosition)))
         invalidateContainerPrefWidths();
@@ -593,6 +612,7 @@ void RenderObject::invalidateContainerPrefWidths()
         if (!container && !o->isRenderView())
             break;
 
+        notifyTablePrefWidthsWillBeDirty(o);
         o->m_prefWidthsDirty = true;
         if (o->style()->position() == FixedPosition || o->style()->position() == AbsolutePosition)
             // A positioned object has no effect on the min/max width of its containing block ever.
@@ -2160,6 +2180,11 @@ void RenderObject::destroy()
     }
     animation()->cancelAnimations(this);
 
+    // A pending relayout root can be destroyed while another, unrelated subtree keeps the
+    // subtree layout alive, so make sure the FrameView forgets about it.
+    if (needsLayout() && frame() && frame()->view())
+        frame()->view()->removeLayoutRoot(this);
+
     // By default no ref-counting. RenderWidget::destroy() doesn't call
     // this function because it needs to do ref-counting. If anything
     // in this function changes, be sure to fix RenderWidget::destroy() as well.
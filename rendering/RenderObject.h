@@ -32,6 +32,7 @@
 #include "Element.h"
 #include "FloatQuad.h"
 #include "PaintInfo.h"
+#include "PhaseTracer.h"
 #include "RenderObjectChildList.h"
 #include "RenderStyle.h"
 #include "TextAffinity.h"
@@ -297,6 +298,9 @@ public:
     void setChildrenInline(bool b = true) { m_childrenInline = b; }
     bool hasColumns() const { return m_hasColumns; }
     void setHasColumns(bool b = true) { m_hasColumns = b; }
+    // True for a block with an estimated height whose inline content has not been laid out yet.
+    bool layoutDeferred() const { return m_layoutDeferred; }
+    void setLayoutDeferred(bool b = true) { m_layoutDeferred = b; }
     bool cellWidthChanged() const { return m_cellWidthChanged; }
     void setCellWidthChanged(bool b = true) { m_cellWidthChanged = b; }
 
@@ -851,6 +855,7 @@ private:
     bool m_hasMarkupTruncation : 1;
     unsigned m_selectionState : 3; // SelectionState
     bool m_hasColumns : 1;
+    bool m_layoutDeferred : 1;
     
     // from RenderTableCell
     bool m_cellWidthChanged : 1;
@@ -888,6 +893,8 @@ inline void RenderObject::setNeedsLayout(bool b, bool markParents)
                 setLayerNeedsFullRepaint();
         }
     } else {
+        if (alreadyNeededLayout || m_posChildNeedsLayout || m_normalChildNeedsLayout || m_needsPositionedMovementLayout)
+            PhaseTracer::increment(PhaseTracer::RenderersLaidOutCounter);
         m_everHadLayout = true;
         m_posChildNeedsLayout = false;
         m_normalChildNeedsLayout = false;
@@ -47,6 +47,7 @@ using namespace HTMLNames;
 
 RenderTable::RenderTable(Node* node)
     : RenderBlock(node)
+    , m_columnPositionsGeneration(0)
     , m_caption(0)
     , m_head(0)
     , m_foot(0)
@@ -82,6 +83,7 @@ void RenderTable::styleDidChange(StyleDifference diff, const RenderStyle* oldSty
         else
             m_tableLayout.set(new AutoTableLayout(this));
     }
+    m_tableLayout->tableStructureChanged();
 }
 
 static inline void resetSectionPointerIfNotBefore(RenderTableSection*& ptr, RenderObject* before)
@@ -528,6 +530,28 @@ void RenderTable::paintMask(PaintInfo& paintInfo, int tx, int ty)
     paintMaskImages(paintInfo, tx, ty, w, h);
 }
 
+void RenderTable::setNeedsSectionRecalc()
+{
+    if (documentBeingDestroyed())
+        return;
+    m_needsSectionRecalc = true;
+    if (m_tableLayout)
+        m_tableLayout->tableStructureChanged();
+    setNeedsLayout(true);
+}
+
+void RenderTable::cellPrefWidthsDirtied(RenderTableCell* cell)
+{
+    if (m_tableLayout)
+        m_tableLayout->cellPrefWidthsDirtied(cell);
+}
+
+void RenderTable::colPrefWidthsDirtied()
+{
+    if (m_tableLayout)
+        m_tableLayout->tableStructureChanged();
+}
+
 void RenderTable::calcPrefWidths()
 {
     ASSERT(prefWidthsDirty());
@@ -561,6 +585,8 @@ void RenderTable::splitColumn(int pos, int firstSpan)
     }
 
     m_columnPos.grow(numEffCols() + 1);
+    ++m_columnPositionsGeneration;
+    m_tableLayout->tableStructureChanged();
     setNeedsLayoutAndPrefWidthsRecalc();
 }
 
@@ -579,6 +605,8 @@ void RenderTable::appendColumn(int span)
     }
 
     m_columnPos.grow(numEffCols() + 1);
+    ++m_columnPositionsGeneration;
+    m_tableLayout->tableStructureChanged();
     setNeedsLayoutAndPrefWidthsRecalc();
 }
 
@@ -706,6 +734,8 @@ void RenderTable::recalcSections() const
     
     m_columns.resize(maxCols);
     m_columnPos.resize(maxCols + 1);
+    ++m_columnPositionsGeneration;
+    m_tableLayout->tableStructureChanged();
 
     ASSERT(selfNeedsLayout());
 
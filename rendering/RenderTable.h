@@ -81,6 +81,16 @@ public:
 
     Vector<ColumnStruct>& columns() { return m_columns; }
     Vector<int>& columnPositions() { return m_columnPos; }
+    void setColumnPosition(int index, int position)
+    {
+        if (m_columnPos[index] == position)
+            return;
+        m_columnPos[index] = position;
+        ++m_columnPositionsGeneration;
+    }
+    // Changes whenever a column moves or the number of columns changes, so sections can tell
+    // whether the cells they did not lay out again are still in place.
+    unsigned columnPositionsGeneration() const { return m_columnPositionsGeneration; }
     RenderTableSection* header() const { return m_head; }
     RenderTableSection* footer() const { return m_foot; }
     RenderTableSection* firstBody() const { return m_firstBody; }
@@ -117,13 +127,12 @@ public:
     RenderTableCol* nextColElement(RenderTableCol* current) const;
 
     bool needsSectionRecalc() const { return m_needsSectionRecalc; }
-    void setNeedsSectionRecalc()
-    {
-        if (documentBeingDestroyed())
-            return;
-        m_needsSectionRecalc = true;
-        setNeedsLayout(true);
-    }
+    void setNeedsSectionRecalc();
+
+    // Called by RenderObject just before a cell or column of this table gets its
+    // preferred widths marked dirty, so the table layout can update incrementally.
+    void cellPrefWidthsDirtied(RenderTableCell*);
+    void colPrefWidthsDirtied();
 
     RenderTableSection* sectionAbove(const RenderTableSection*, bool skipEmptySections = false) const;
     RenderTableSection* sectionBelow(const RenderTableSection*, bool skipEmptySections = false) const;
@@ -177,6 +186,7 @@ private:
     void recalcSections() const;
 
     mutable Vector<int> m_columnPos;
+    mutable unsigned m_columnPositionsGeneration;
     mutable Vector<ColumnStruct> m_columns;
 
     mutable RenderBlock* m_caption;
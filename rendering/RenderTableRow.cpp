@@ -123,7 +123,9 @@ void RenderTableRow::layout()
             if (child->needsLayout()) {
                 cell->calcVerticalMargins();
                 cell->layout();
-            }
+                section()->setRowsDirtyForCell(cell);
+            } else if (selfNeedsLayout())
+                section()->setRowsDirtyForCell(cell);
         }
     }
 
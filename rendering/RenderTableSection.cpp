@@ -53,6 +53,10 @@ static inline void setRowHeightToRowStyleHeightIfNotRelative(RenderTableSection:
 
 RenderTableSection::RenderTableSection(Node* node)
     : RenderBox(node)
+    , m_firstDirtyRow(0)
+    , m_lastDirtyRow(numeric_limits<int>::max())
+    , m_columnPositionsGeneration(0)
+    , m_rowPosIncludesExtraHeight(false)
     , m_gridRows(0)
     , m_cCol(0)
     , m_cRow(-1)
@@ -167,6 +171,8 @@ bool RenderTableSection::ensureRows(int numRows)
             m_grid[r].baseline = 0;
             m_grid[r].height = Length();
         }
+        m_firstDirtyRow = min(m_firstDirtyRow, nRows);
+        m_lastDirtyRow = max(m_lastDirtyRow, numRows - 1);
     }
 
     return true;
@@ -303,10 +309,23 @@ int RenderTableSection::calcRowHeight()
 
     LayoutStateMaintainer statePusher(view());
 
+    // Cells in every row move when the columns or the section width change, and rows spread
+    // with extra height last time have to be measured again from scratch.
+    if (m_rowPosIncludesExtraHeight || m_rowPos.size() != static_cast<size_t>(m_gridRows + 1)
+        || table()->selfNeedsLayout() || width() != table()->contentWidth()
+        || m_columnPositionsGeneration != table()->columnPositionsGeneration())
+        setAllRowsDirty();
+
     m_rowPos.resize(m_gridRows + 1);
     m_rowPos[0] = spacing;
 
-    for (int r = 0; r < m_gridRows; r++) {
+    // Only the dirty rows are measured again. The rows below them keep their heights, so they
+    // just move by however much the dirty rows grew or shrank.
+    int firstRow = min(m_firstDirtyRow, m_gridRows);
+    int endRow = max(firstRow, min(m_lastDirtyRow, m_gridRows - 1) + 1);
+    int oldEndRowPos = endRow < m_gridRows ? m_rowPos[endRow] : 0;
+
+    for (int r = firstRow; r < endRow; r++) {
         m_rowPos[r + 1] = 0;
         m_grid[r].baseline = 0;
         int baseline = 0;
@@ -378,6 +397,13 @@ int RenderTableSection::calcRowHeight()
         m_rowPos[r + 1] = max(m_rowPos[r + 1], m_rowPos[r]);
     }
 
+    if (endRow < m_gridRows && m_rowPos[endRow] != oldEndRowPos) {
+        int delta = m_rowPos[endRow] - oldEndRowPos;
+        for (int r = endRow + 1; r <= m_gridRows; r++)
+            m_rowPos[r] += delta;
+        m_lastDirtyRow = m_gridRows - 1;
+    }
+
 #ifndef NDEBUG
     setNeedsLayoutIsForbidden(false);
 #endif
@@ -389,10 +415,25 @@ int RenderTableSection::calcRowHeight()
     return m_rowPos[m_gridRows];
 }
 
+void RenderTableSection::setRowsDirtyForCell(RenderTableCell* cell)
+{
+    m_firstDirtyRow = min(m_firstDirtyRow, cell->row());
+    m_lastDirtyRow = max(m_lastDirtyRow, cell->row() + cell->rowSpan() - 1);
+}
+
+void RenderTableSection::setAllRowsDirty()
+{
+    m_firstDirtyRow = 0;
+    m_lastDirtyRow = numeric_limits<int>::max();
+}
+
 void RenderTableSection::layout()
 {
     ASSERT(needsLayout());
 
+    if (selfNeedsLayout())
+        setAllRowsDirty();
+
     LayoutStateMaintainer statePusher(view(), this, IntSize(x(), y()));
     for (RenderObject* child = children()->firstChild(); child; child = child->nextSibling()) {
         if (child->isTableRow()) {
@@ -419,9 +460,14 @@ int RenderTableSection::layoutRows(int toAdd)
     // Set the width of our section now.  The rows will also be this width.
     setWidth(table()->contentWidth());
     m_overflow.clear();
+    bool hadOverflowingCell = m_hasOverflowingCell;
     m_hasOverflowingCell = false;
+    m_rowPosIncludesExtraHeight = false;
 
     if (toAdd && totalRows && (m_rowPos[totalRows] || !nextSibling())) {
+        setAllRowsDirty();
+        m_rowPosIncludesExtraHeight = true;
+
         int totalHeight = m_rowPos[totalRows] + toAdd;
 
         int dh = toAdd;
@@ -483,10 +529,17 @@ int RenderTableSection::layoutRows(int toAdd)
     int hspacing = table()->hBorderSpacing();
     int vspacing = table()->vBorderSpacing();
     int nEffCols = table()->numEffCols();
+    Vector<int>& columnPos = table()->columnPositions();
+
+    // calcRowHeight() left every row outside the dirty range where it was, so the cells there
+    // are already where they belong. This keeps a one-cell change in a large table from
+    // touching every cell.
+    int firstRow = min(m_firstDirtyRow, totalRows);
+    int endRow = max(firstRow, min(m_lastDirtyRow, totalRows - 1) + 1);
 
     LayoutStateMaintainer statePusher(view(), this, IntSize(x(), y()));
 
-    for (int r = 0; r < totalRows; r++) {
+    for (int r = firstRow; r < endRow; r++) {
         // Set the row's x/y position and width/height.
         if (RenderTableRow* rowRenderer = m_grid[r].rowRenderer) {
             rowRenderer->setLocation(0, m_rowPos[r]);
@@ -613,9 +666,9 @@ int RenderTableSection::layoutRows(int toAdd)
             IntRect oldCellRect(cell->x(), cell->y() , cell->width(), cell->height());
         
             if (style()->direction() == RTL)
-                cell->setLocation(table()->columnPositions()[nEffCols] - table()->columnPositions()[table()->colToEffCol(cell->col() + cell->colSpan())] + hspacing, m_rowPos[rindx]);
+                cell->setLocation(columnPos[nEffCols] - columnPos[table()->colToEffCol(cell->col() + cell->colSpan())] + hspacing, m_rowPos[rindx]);
             else
-                cell->setLocation(table()->columnPositions()[c] + hspacing, m_rowPos[rindx]);
+                cell->setLocation(columnPos[c] + hspacing, m_rowPos[rindx]);
 
             // If the cell moved, we have to repaint it as well as any floating/positioned
             // descendants.  An exception is if we need a layout.  In this case, we know we're going to
@@ -631,10 +684,20 @@ int RenderTableSection::layoutRows(int toAdd)
 
     ASSERT(!needsLayout());
 
+    m_firstDirtyRow = numeric_limits<int>::max();
+    m_lastDirtyRow = -1;
+    m_columnPositionsGeneration = table()->columnPositionsGeneration();
+
     setHeight(m_rowPos[totalRows]);
 
-    // Now that our height has been determined, add in overflow from cells.
-    for (int r = 0; r < totalRows; r++) {
+    // Now that our height has been determined, add in overflow from cells. Cells without
+    // overflow of their own stay inside the section, so when none had any the rows that
+    // were not positioned again have nothing to add.
+    if (hadOverflowingCell) {
+        firstRow = 0;
+        endRow = totalRows;
+    }
+    for (int r = firstRow; r < endRow; r++) {
         for (int c = 0; c < nEffCols; c++) {
             CellStruct& cs = cellAt(r, c);
             RenderTableCell* cell = cs.primaryCell();
@@ -122,6 +122,10 @@ public:
 
     int getBaseline(int row) { return m_grid[row].baseline; }
 
+    // Marks the rows spanned by a cell that was laid out again, so the next calcRowHeight()
+    // and layoutRows() look at them.
+    void setRowsDirtyForCell(RenderTableCell*);
+
 private:
     virtual RenderObjectChildList* virtualChildren() { return children(); }
     virtual const RenderObjectChildList* virtualChildren() const { return children(); }
@@ -153,11 +157,24 @@ private:
     bool ensureRows(int);
     void clearGrid();
 
+    void setAllRowsDirty();
+
     RenderObjectChildList m_children;
 
     Vector<RowStruct> m_grid;
     Vector<int> m_rowPos;
 
+    // Rows m_firstDirtyRow through m_lastDirtyRow have a cell that was laid out again since the
+    // last layoutRows(). Rows above them keep their heights and positions, and so do the rows
+    // below them unless the dirty rows changed their total height.
+    int m_firstDirtyRow;
+    int m_lastDirtyRow;
+    // The table's column positions generation when the cells were last positioned.
+    unsigned m_columnPositionsGeneration;
+    // Whether layoutRows() spread extra height over m_rowPos, which then no longer holds the
+    // heights calcRowHeight() computed.
+    bool m_rowPosIncludesExtraHeight;
+
     int m_gridRows;
 
     // the current insertion position
@@ -34,6 +34,7 @@
 #include "RenderWidget.h"
 #include "RenderWidgetProtector.h"
 #include "TransformState.h"
+#include <wtf/MathExtras.h>
 
 #if USE(ACCELERATED_COMPOSITING)
 #include "RenderLayerCompositor.h"
@@ -56,6 +57,9 @@ RenderView::RenderView(Node* node, FrameView* view)
     , m_forcedPageBreak(false)
     , m_layoutState(0)
     , m_layoutStateDisableCount(0)
+    , m_deferredLayoutForcedBottom(INT_MIN)
+    , m_deferredLayoutScrollAdjustment(0)
+    , m_deferredLayoutCheckedLayoutCount(-1)
 {
     // Clear our anonymous bit, set because RenderObject assumes
     // any renderer with document as the node is anonymous.
@@ -727,6 +731,73 @@ void RenderView::updateHitTestResult(HitTestResult& result, const IntPoint& poin
     }
 }
 
+IntRect RenderView::lazyLayoutRect() const
+{
+    // Keep a viewport's worth of real layout above and below the visible area, so that
+    // ordinary scrolling rarely reaches content that only has an estimated height.
+    IntRect rect = m_frameView->visibleContentRect();
+    rect.inflateY(rect.height());
+    return rect;
+}
+
+bool RenderView::shouldDeferLayoutOfBlock(int absoluteTop, int estimatedHeight) const
+{
+    if (absoluteTop < m_deferredLayoutForcedBottom)
+        return false;
+
+    IntRect rect = lazyLayoutRect();
+    if (rect.isEmpty())
+        return false;
+    return absoluteTop >= rect.bottom() || absoluteTop + estimatedHeight <= rect.y();
+}
+
+bool RenderView::markDeferredLayoutBlocksIntersecting(int top, int bottom)
+{
+    bool markedBlocks = false;
+    RenderBlockSet::iterator end = m_deferredLayoutBlocks.end();
+    for (RenderBlockSet::iterator it = m_deferredLayoutBlocks.begin(); it != end; ++it) {
+        RenderBlock* block = *it;
+        if (block->needsLayout())
+            continue;
+        int blockTop = lroundf(block->localToAbsolute().y());
+        if (blockTop < bottom && blockTop + block->height() > top) {
+            block->setNeedsLayout(true);
+            markedBlocks = true;
+        }
+    }
+    return markedBlocks;
+}
+
+bool RenderView::markDeferredLayoutBlocksNearViewport()
+{
+    if (m_deferredLayoutBlocks.isEmpty())
+        return false;
+
+    // Blocks that were outside lazyLayoutRect() at the last check were at least a viewport
+    // height from the visible area, so there is no need to look again until we have
+    // scrolled a good part of that distance or a layout has moved things around.
+    IntRect visibleRect = m_frameView->visibleContentRect();
+    if (m_frameView->layoutCount() == m_deferredLayoutCheckedLayoutCount
+        && visibleRect.size() == m_deferredLayoutCheckedVisibleRect.size()
+        && abs(visibleRect.y() - m_deferredLayoutCheckedVisibleRect.y()) < visibleRect.height() / 4)
+        return false;
+    m_deferredLayoutCheckedVisibleRect = visibleRect;
+    m_deferredLayoutCheckedLayoutCount = m_frameView->layoutCount();
+
+    IntRect rect = lazyLayoutRect();
+    return markDeferredLayoutBlocksIntersecting(rect.y(), rect.bottom());
+}
+
+bool RenderView::markDeferredLayoutBlocksAbove(int bottom)
+{
+    if (m_deferredLayoutBlocks.isEmpty())
+        return false;
+
+    // Once content has been laid out for real on request, don't defer it again.
+    m_deferredLayoutForcedBottom = std::max(m_deferredLayoutForcedBottom, bottom);
+    return markDeferredLayoutBlocksIntersecting(INT_MIN, bottom);
+}
+
 #if USE(ACCELERATED_COMPOSITING)
 bool RenderView::usesCompositing() const
 {
@@ -156,6 +156,25 @@ public:
 
     virtual void updateHitTestResult(HitTestResult&, const IntPoint&);
 
+    // Lazy layout (see Settings::lazyLayoutEnabled()). Blocks far from the visible area are
+    // given an estimated height and are tracked here until they get laid out for real.
+    bool shouldDeferLayoutOfBlock(int absoluteTop, int estimatedHeight) const;
+    void addDeferredLayoutBlock(RenderBlock* block) { m_deferredLayoutBlocks.add(block); }
+    void removeDeferredLayoutBlock(RenderBlock* block) { m_deferredLayoutBlocks.remove(block); }
+    bool hasDeferredLayoutBlocks() const { return !m_deferredLayoutBlocks.isEmpty(); }
+    // These return whether any block was marked for layout.
+    bool markDeferredLayoutBlocksNearViewport();
+    bool markDeferredLayoutBlocksAbove(int bottom);
+
+    // Height changes of deferred blocks above the visible area, to be undone by scrolling.
+    void addDeferredLayoutScrollAdjustment(int delta) { m_deferredLayoutScrollAdjustment += delta; }
+    int takeDeferredLayoutScrollAdjustment()
+    {
+        int adjustment = m_deferredLayoutScrollAdjustment;
+        m_deferredLayoutScrollAdjustment = 0;
+        return adjustment;
+    }
+
     // Notifications that this view became visible in a window, or will be
     // removed from the window.
     void didMoveOnscreen();
@@ -172,6 +191,9 @@ protected:
 
 private:
     bool shouldRepaint(const IntRect& r) const;
+
+    IntRect lazyLayoutRect() const;
+    bool markDeferredLayoutBlocksIntersecting(int top, int bottom);
         
     int docHeight() const;
     int docWidth() const;
@@ -202,6 +224,14 @@ private:
     bool m_forcedPageBreak;
     LayoutState* m_layoutState;
     unsigned m_layoutStateDisableCount;
+
+    typedef HashSet<RenderBlock*> RenderBlockSet;
+    RenderBlockSet m_deferredLayoutBlocks;
+    int m_deferredLayoutForcedBottom;
+    int m_deferredLayoutScrollAdjustment;
+    // The visible area, and the layout, at which deferred blocks were last checked on scroll.
+    IntRect m_deferredLayoutCheckedVisibleRect;
+    int m_deferredLayoutCheckedLayoutCount;
 #if USE(ACCELERATED_COMPOSITING)
     OwnPtr<RenderLayerCompositor> m_compositor;
 #endif
@@ -25,6 +25,8 @@
 
 #include "AXObjectCache.h"
 #include "AnimationController.h"
+#include "Frame.h"
+#include "FrameView.h"
 #include "GraphicsContext.h"
 #include "HitTestResult.h"
 #include "RenderCounter.h"
@@ -127,6 +129,10 @@ void RenderWidget::destroy()
         document()->axObjectCache()->childrenChanged(this->parent());
         document()->axObjectCache()->remove(this);
     }
+
+    if (needsLayout() && frame() && frame()->view())
+        frame()->view()->removeLayoutRoot(this);
+
     remove();
 
     setWidget(0);
@@ -26,6 +26,7 @@
 namespace WebCore {
 
 class RenderTable;
+class RenderTableCell;
 
 class TableLayout : public Noncopyable {
 public:
@@ -39,6 +40,12 @@ public:
     virtual void calcPrefWidths(int& minWidth, int& maxWidth) = 0;
     virtual void layout() = 0;
 
+    // Let a layout keep per-column information between calcPrefWidths() calls. The first
+    // is called when a cell's preferred widths become dirty, before they are recomputed;
+    // the second when the grid, the col elements or the table style changed.
+    virtual void cellPrefWidthsDirtied(RenderTableCell*) { }
+    virtual void tableStructureChanged() { }
+
 protected:
     RenderTable* m_table;
 };
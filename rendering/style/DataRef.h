@@ -63,6 +63,8 @@ public:
     }
 
 private:
+    template<typename> friend class StyleDataTable;
+
     RefPtr<T> m_data;
 };
 
@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2026 The WebKit Authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.h"
+#include "StyleDataInterner.h"
+
+#include "PlatformString.h"
+#include "RenderStyle.h"
+#include "StringBuilder.h"
+#include <wtf/HashFunctions.h>
+
+namespace WebCore {
+
+static inline void addToHash(unsigned& hash, unsigned value)
+{
+    hash = WTF::intHash(static_cast<uint64_t>(hash) << 32 | value);
+}
+
+static inline void addToHash(unsigned& hash, const Length& length)
+{
+    addToHash(hash, length.rawValue());
+    addToHash(hash, length.type());
+}
+
+static inline void addFloatToHash(unsigned& hash, float value)
+{
+    addToHash(hash, static_cast<unsigned>(static_cast<int>(value * 1000)));
+}
+
+static inline void addToHash(unsigned& hash, const Color& color)
+{
+    addToHash(hash, color.isValid() ? color.rgb() : 0);
+}
+
+static inline void addToHash(unsigned& hash, const AtomicString& string)
+{
+    addToHash(hash, string.impl() ? string.impl()->hash() : 0);
+}
+
+static inline void addToHash(unsigned& hash, const LengthBox& box)
+{
+    addToHash(hash, box.top());
+    addToHash(hash, box.right());
+    addToHash(hash, box.bottom());
+    addToHash(hash, box.left());
+}
+
+static inline void addToHash(unsigned& hash, const IntSize& size)
+{
+    addToHash(hash, size.width());
+    addToHash(hash, size.height());
+}
+
+static inline void addToHash(unsigned& hash, const BorderValue& border)
+{
+    addToHash(hash, border.width());
+    addToHash(hash, border.style());
+    addToHash(hash, border.color());
+}
+
+static inline void addToHash(unsigned& hash, const FillLayer& layers)
+{
+    for (const FillLayer* layer = &layers; layer; layer = layer->next()) {
+        // Images compare by their data, which the hash has no cheap handle on.
+        addToHash(hash, !!layer->image());
+        addToHash(hash, layer->xPosition());
+        addToHash(hash, layer->yPosition());
+    }
+}
+
+// Each hash covers the members operator== compares that are plain values. Members held through
+// pointers (shadows, animations, content and so on) only contribute whether they are set, since
+// they compare by contents.
+
+unsigned styleDataHash(const StyleBoxData& data)
+{
+    unsigned hash = 0;
+    addToHash(hash, data.width());
+    addToHash(hash, data.height());
+    addToHash(hash, data.minWidth());
+    addToHash(hash, data.maxWidth());
+    addToHash(hash, data.minHeight());
+    addToHash(hash, data.maxHeight());
+    addToHash(hash, data.zIndex());
+    addToHash(hash, data.hasAutoZIndex());
+    addToHash(hash, data.boxSizing());
+    return hash;
+}
+
+unsigned styleDataHash(const StyleVisualData& data)
+{
+    unsigned hash = 0;
+    addToHash(hash, data.clip);
+    addToHash(hash, data.hasClip);
+    addToHash(hash, data.textDecoration);
+    addFloatToHash(hash, data.m_zoom);
+    return hash;
+}
+
+unsigned styleDataHash(const StyleBackgroundData& data)
+{
+    unsigned hash = 0;
+    addToHash(hash, data.background());
+    addToHash(hash, data.color());
+    const OutlineValue& outline = data.outline();
+    addToHash(hash, outline);
+    addToHash(hash, outline.offset());
+    addToHash(hash, outline.isAuto());
+    return hash;
+}
+
+unsigned styleDataHash(const StyleSurroundData& data)
+{
+    unsigned hash = 0;
+    addToHash(hash, data.offset);
+    addToHash(hash, data.margin);
+    addToHash(hash, data.padding);
+    const BorderData& border = data.border;
+    addToHash(hash, border.left());
+    addToHash(hash, border.right());
+    addToHash(hash, border.top());
+    addToHash(hash, border.bottom());
+    addToHash(hash, !!border.image().image());
+    addToHash(hash, border.topLeft());
+    addToHash(hash, border.topRight());
+    addToHash(hash, border.bottomLeft());
+    addToHash(hash, border.bottomRight());
+    return hash;
+}
+
+unsigned styleDataHash(const StyleRareNonInheritedData& data)
+{
+    unsigned hash = 0;
+    addToHash(hash, data.lineClamp.value());
+    addToHash(hash, data.lineClamp.isPercentage());
+    addFloatToHash(hash, data.opacity);
+    addToHash(hash, !!data.m_content);
+    addToHash(hash, !!data.m_counterDirectives);
+    addToHash(hash, data.userDrag);
+    addToHash(hash, data.textOverflow);
+    addToHash(hash, data.marginTopCollapse);
+    addToHash(hash, data.marginBottomCollapse);
+    addToHash(hash, data.matchNearestMailBlockquoteColor);
+    addToHash(hash, data.m_appearance);
+    addToHash(hash, data.m_borderFit);
+    addToHash(hash, data.m_counterIncrement);
+    addToHash(hash, data.m_counterReset);
+    addToHash(hash, !!data.m_boxShadow);
+    addToHash(hash, !!data.m_boxReflect);
+    addToHash(hash, !!data.m_animations);
+    addToHash(hash, !!data.m_transitions);
+    addToHash(hash, data.m_mask);
+    addToHash(hash, data.m_transformStyle3D);
+    addToHash(hash, data.m_backfaceVisibility);
+    addFloatToHash(hash, data.m_perspective);
+    addToHash(hash, data.m_perspectiveOriginX);
+    addToHash(hash, data.m_perspectiveOriginY);
+    addToHash(hash, data.m_pageSize.width());
+    addToHash(hash, data.m_pageSize.height());
+    addToHash(hash, data.m_pageSizeType);
+    return hash;
+}
+
+unsigned styleDataHash(const StyleRareInheritedData& data)
+{
+    unsigned hash = 0;
+    addToHash(hash, data.textStrokeColor);
+    addFloatToHash(hash, data.textStrokeWidth);
+    addToHash(hash, data.textFillColor);
+    addToHash(hash, !!data.textShadow);
+    addToHash(hash, data.highlight);
+    addToHash(hash, !!data.cursorData);
+    addToHash(hash, data.indent);
+    addFloatToHash(hash, data.m_effectiveZoom);
+    addToHash(hash, data.widows);
+    addToHash(hash, data.orphans);
+    addToHash(hash, data.textSecurity);
+    addToHash(hash, data.userModify);
+    addToHash(hash, data.wordBreak);
+    addToHash(hash, data.wordWrap);
+    addToHash(hash, data.nbspMode);
+    addToHash(hash, data.khtmlLineBreak);
+    addToHash(hash, data.textSizeAdjust);
+    addToHash(hash, data.resize);
+    addToHash(hash, data.userSelect);
+    addToHash(hash, data.colorSpace);
+    addToHash(hash, data.hyphens);
+    addToHash(hash, data.hyphenationString);
+    addToHash(hash, data.hyphenationLocale);
+    return hash;
+}
+
+unsigned styleDataHash(const StyleInheritedData& data)
+{
+    unsigned hash = 0;
+    addToHash(hash, data.line_height);
+    addToHash(hash, !!data.list_style_image);
+    const FontDescription& fontDescription = data.font.fontDescription();
+    addToHash(hash, fontDescription.family().family());
+    addToHash(hash, fontDescription.computedPixelSize());
+    addToHash(hash, fontDescription.weight());
+    addToHash(hash, fontDescription.italic());
+    addToHash(hash, data.font.letterSpacing());
+    addToHash(hash, data.font.wordSpacing());
+    addToHash(hash, data.color);
+    addToHash(hash, data.horizontal_border_spacing);
+    addToHash(hash, data.vertical_border_spacing);
+    return hash;
+}
+
+StyleDataInterner::StyleDataInterner()
+{
+}
+
+StyleDataInterner::~StyleDataInterner()
+{
+}
+
+void StyleDataInterner::intern(RenderStyle* style)
+{
+    m_boxData.intern(style->m_box);
+    m_visualData.intern(style->visual);
+    m_backgroundData.intern(style->m_background);
+    m_surroundData.intern(style->surround);
+    m_rareNonInheritedData.intern(style->rareNonInheritedData);
+    m_rareInheritedData.intern(style->rareInheritedData);
+    m_inheritedData.intern(style->inherited);
+}
+
+template<typename T> static void appendTableReport(StringBuilder& builder, const char* name, const StyleDataTable<T>& table)
+{
+    unsigned unique = table.uniqueCount();
+    unsigned references = table.referenceCount();
+    unsigned savedBytes = (references > unique ? references - unique : 0) * sizeof(T);
+    builder.append(String::format("%s: %u unique, %u references, %u bytes saved (%u interned, %u shared)\n",
+        name, unique, references, savedBytes, table.internCount(), table.sharedCount()));
+}
+
+String StyleDataInterner::memoryReport() const
+{
+    StringBuilder builder;
+    appendTableReport(builder, "StyleBoxData", m_boxData);
+    appendTableReport(builder, "StyleVisualData", m_visualData);
+    appendTableReport(builder, "StyleBackgroundData", m_backgroundData);
+    appendTableReport(builder, "StyleSurroundData", m_surroundData);
+    appendTableReport(builder, "StyleRareNonInheritedData", m_rareNonInheritedData);
+    appendTableReport(builder, "StyleRareInheritedData", m_rareInheritedData);
+    appendTableReport(builder, "StyleInheritedData", m_inheritedData);
+    return builder.toString();
+}
+
+} // namespace WebCore
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2026 The WebKit Authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef StyleDataInterner_h
+#define StyleDataInterner_h
+
+#include "DataRef.h"
+#include <wtf/HashSet.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/RefPtr.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+class RenderStyle;
+class String;
+class StyleBackgroundData;
+class StyleBoxData;
+class StyleInheritedData;
+class StyleRareInheritedData;
+class StyleRareNonInheritedData;
+class StyleSurroundData;
+class StyleVisualData;
+
+// Hashes of the style data groups. Objects that compare equal hash equally; every member
+// operator== compares takes part, those held through pointers only by whether they are set.
+unsigned styleDataHash(const StyleBoxData&);
+unsigned styleDataHash(const StyleVisualData&);
+unsigned styleDataHash(const StyleBackgroundData&);
+unsigned styleDataHash(const StyleSurroundData&);
+unsigned styleDataHash(const StyleRareNonInheritedData&);
+unsigned styleDataHash(const StyleRareInheritedData&);
+unsigned styleDataHash(const StyleInheritedData&);
+
+template<typename T> struct StyleDataHash {
+    static unsigned hash(const RefPtr<T>& data) { return styleDataHash(*data); }
+    static bool equal(const RefPtr<T>& a, const RefPtr<T>& b) { return a == b || *a == *b; }
+    static const bool safeToCompareToEmptyOrDeleted = false;
+};
+
+// The set of distinct objects of one data group. The table keeps a reference to every object
+// in it, so DataRef::access() always copies them before a change. Objects nobody else refers
+// to any more are swept out whenever the table has doubled in size.
+template<typename T> class StyleDataTable : public Noncopyable {
+public:
+    StyleDataTable()
+        : m_internCount(0)
+        , m_sharedCount(0)
+        , m_sweepThreshold(minimumSweepThreshold)
+    {
+    }
+
+    void intern(DataRef<T>& ref)
+    {
+        ++m_internCount;
+        std::pair<typename DataSet::iterator, bool> result = m_set.add(ref.m_data);
+        if (!result.second) {
+            if (result.first->get() != ref.m_data.get()) {
+                ref.m_data = *result.first;
+                ++m_sharedCount;
+            }
+            return;
+        }
+        if (m_set.size() >= m_sweepThreshold)
+            sweep();
+    }
+
+    void sweep()
+    {
+        Vector<T*> unused;
+        typename DataSet::iterator end = m_set.end();
+        for (typename DataSet::iterator it = m_set.begin(); it != end; ++it) {
+            if ((*it)->hasOneRef())
+                unused.append(it->get());
+        }
+        for (size_t i = 0; i < unused.size(); ++i)
+            m_set.remove(unused[i]);
+        m_sweepThreshold = std::max<unsigned>(minimumSweepThreshold, m_set.size() * 2);
+    }
+
+    // Number of distinct objects, and number of references styles hold to them.
+    unsigned uniqueCount() const { return m_set.size(); }
+    unsigned referenceCount() const
+    {
+        unsigned count = 0;
+        typename DataSet::const_iterator end = m_set.end();
+        for (typename DataSet::const_iterator it = m_set.begin(); it != end; ++it)
+            count += (*it)->refCount() - 1;
+        return count;
+    }
+    unsigned internCount() const { return m_internCount; }
+    unsigned sharedCount() const { return m_sharedCount; }
+
+private:
+    static const unsigned minimumSweepThreshold = 256;
+
+    typedef HashSet<RefPtr<T>, StyleDataHash<T> > DataSet;
+    DataSet m_set;
+    unsigned m_internCount;
+    unsigned m_sharedCount;
+    unsigned m_sweepThreshold;
+};
+
+// Per-document interning of the copy-on-write data groups of RenderStyle. Styles resolved
+// separately for different elements often end up with equal groups; once a style is
+// complete, its groups are replaced with the equal ones already in use elsewhere.
+class StyleDataInterner : public Noncopyable {
+public:
+    StyleDataInterner();
+    ~StyleDataInterner();
+
+    void intern(RenderStyle*);
+
+    // For each data group: the distinct objects kept, the references styles hold to them,
+    // and the memory saved by sharing.
+    String memoryReport() const;
+
+private:
+    StyleDataTable<StyleBoxData> m_boxData;
+    StyleDataTable<StyleVisualData> m_visualData;
+    StyleDataTable<StyleBackgroundData> m_backgroundData;
+    StyleDataTable<StyleSurroundData> m_surroundData;
+    StyleDataTable<StyleRareNonInheritedData> m_rareNonInheritedData;
+    StyleDataTable<StyleRareInheritedData> m_rareInheritedData;
+    StyleDataTable<StyleInheritedData> m_inheritedData;
+};
+
+} // namespace WebCore
+
+#endif // StyleDataInterner_h
@@ -248,6 +248,8 @@ bool AbstractDatabase::performOpenAndVerify(bool shouldSetVersionInNewDatabase,
     }
     if (!m_sqliteDatabase.turnOnIncrementalAutoVacuum())
         LOG_ERROR("Unable to turn on incremental auto-vacuum for database %s", m_filename.ascii().data());
+    if (!m_sqliteDatabase.turnOnWriteAheadLogging())
+        LOG(StorageAPI, "Database %s is not using write-ahead logging, so its transactions will not run concurrently with reads", m_filename.ascii().data());
 
     ASSERT(m_databaseAuthorizer);
     m_sqliteDatabase.setAuthorizer(m_databaseAuthorizer);
@@ -217,7 +217,7 @@ void Database::markAsDeletedAndClose()
 void Database::close()
 {
     ASSERT(m_scriptExecutionContext->databaseThread());
-    ASSERT(currentThread() == m_scriptExecutionContext->databaseThread()->getThreadID());
+    ASSERT(m_scriptExecutionContext->databaseThread()->isDatabaseThread(this));
 
     {
         MutexLocker locker(m_transactionInProgressMutex);
@@ -410,7 +410,7 @@ SecurityOrigin* Database::securityOrigin() const
 {
     if (m_scriptExecutionContext->isContextThread())
         return m_contextThreadSecurityOrigin.get();
-    if (currentThread() == m_scriptExecutionContext->databaseThread()->getThreadID())
+    if (m_scriptExecutionContext->databaseThread()->isDatabaseThread(this))
         return m_databaseThreadSecurityOrigin.get();
     return 0;
 }
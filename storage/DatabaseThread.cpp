@@ -42,12 +42,14 @@
 namespace WebCore {
 
 DatabaseThread::DatabaseThread()
-    : m_threadID(0)
+    : m_runningWorkerCount(0)
     , m_transactionClient(adoptPtr(new SQLTransactionClient()))
     , m_transactionCoordinator(adoptPtr(new SQLTransactionCoordinator()))
     , m_cleanupSync(0)
 {
     m_selfRef = this;
+    for (unsigned i = 0; i < maximumWorkerCount; ++i)
+        m_workers[i].databaseThread = this;
 }
 
 DatabaseThread::~DatabaseThread()
@@ -60,12 +62,26 @@ bool DatabaseThread::start()
 {
     MutexLocker lock(m_threadCreationMutex);
 
-    if (m_threadID)
+    // The first worker is always started, so that there is a thread to hand the cleanup to on termination.
+    return startWorker(m_workers[0]);
+}
+
+bool DatabaseThread::startWorker(Worker& worker)
+{
+    ASSERT(!m_threadCreationMutex.tryLock()); // Locked by caller.
+
+    if (worker.threadID)
         return true;
 
-    m_threadID = createThread(DatabaseThread::databaseThreadStart, this, "WebCore: Database");
+    // Once termination has been requested, the running workers may already be cleaning up.
+    if (worker.queue.killed())
+        return false;
 
-    return m_threadID;
+    worker.threadID = createThread(DatabaseThread::databaseThreadStart, &worker, "WebCore: Database");
+    if (worker.threadID)
+        ++m_runningWorkerCount;
+
+    return worker.threadID;
 }
 
 void DatabaseThread::requestTermination(DatabaseTaskSynchronizer *cleanupSync)
@@ -73,7 +89,10 @@ void DatabaseThread::requestTermination(DatabaseTaskSynchronizer *cleanupSync)
     ASSERT(!m_cleanupSync);
     m_cleanupSync = cleanupSync;
     LOG(StorageAPI, "DatabaseThread %p was asked to terminate\n", this);
-    m_queue.kill();
+
+    MutexLocker lock(m_threadCreationMutex);
+    for (unsigned i = 0; i < maximumWorkerCount; ++i)
+        m_workers[i].queue.kill();
 }
 
 bool DatabaseThread::terminationRequested(DatabaseTaskSynchronizer* taskSynchronizer) const
@@ -85,47 +104,57 @@ bool DatabaseThread::terminationRequested(DatabaseTaskSynchronizer* taskSynchron
     UNUSED_PARAM(taskSynchronizer);
 #endif
 
-    return m_queue.killed();
+    return m_workers[0].queue.killed();
 }
 
-void* DatabaseThread::databaseThreadStart(void* vDatabaseThread)
+void* DatabaseThread::databaseThreadStart(void* vWorker)
 {
-    DatabaseThread* dbThread = static_cast<DatabaseThread*>(vDatabaseThread);
-    return dbThread->databaseThread();
+    Worker* worker = static_cast<Worker*>(vWorker);
+    return worker->databaseThread->databaseThread(*worker);
 }
 
-void* DatabaseThread::databaseThread()
+void* DatabaseThread::databaseThread(Worker& worker)
 {
     {
-        // Wait for DatabaseThread::start() to complete.
+        // Wait for DatabaseThread::startWorker() to complete.
         MutexLocker lock(m_threadCreationMutex);
-        LOG(StorageAPI, "Started DatabaseThread %p", this);
+        LOG(StorageAPI, "Started worker %u of DatabaseThread %p", static_cast<unsigned>(&worker - m_workers), this);
     }
 
     AutodrainedPool pool;
-    while (OwnPtr<DatabaseTask> task = m_queue.waitForMessage()) {
+    while (OwnPtr<DatabaseTask> task = worker.queue.waitForMessage()) {
         task->performTask();
         pool.cycle();
     }
 
-    // Clean up the list of all pending transactions on this database thread
-    m_transactionCoordinator->shutdown();
-
-    LOG(StorageAPI, "About to detach thread %i and clear the ref to DatabaseThread %p, which currently has %i ref(s)", m_threadID, this, refCount());
+    // Roll back the transactions that were in progress on this worker, while still on the thread that owns their databases.
+    m_transactionCoordinator->notifyDatabaseThreadIsShuttingDown();
 
     // Close the databases that we ran transactions on. This ensures that if any transactions are still open, they are rolled back and we don't leave the database in an
     // inconsistent or locked state.
-    if (m_openDatabaseSet.size() > 0) {
+    if (worker.openDatabaseSet.size() > 0) {
         // As the call to close will modify the original set, we must take a copy to iterate over.
         DatabaseSet openSetCopy;
-        openSetCopy.swap(m_openDatabaseSet);
+        openSetCopy.swap(worker.openDatabaseSet);
         DatabaseSet::iterator end = openSetCopy.end();
         for (DatabaseSet::iterator it = openSetCopy.begin(); it != end; ++it)
             (*it)->close();
     }
 
     // Detach the thread so its resources are no longer of any concern to anyone else
-    detachThread(m_threadID);
+    detachThread(worker.threadID);
+
+    {
+        MutexLocker lock(m_threadCreationMutex);
+        ASSERT(m_runningWorkerCount);
+        if (--m_runningWorkerCount)
+            return 0;
+    }
+
+    // This was the last worker to finish, so nothing can use the pending transactions any more.
+    m_transactionCoordinator->shutdown();
+
+    LOG(StorageAPI, "About to clear the ref to DatabaseThread %p, which currently has %i ref(s)", this, refCount());
 
     DatabaseTaskSynchronizer* cleanupSync = m_cleanupSync;
 
@@ -138,32 +167,59 @@ void* DatabaseThread::databaseThread()
     return 0;
 }
 
+DatabaseThread::Worker& DatabaseThread::workerForDatabase(const Database* database)
+{
+    return m_workers[PtrHash<const Database*>::hash(database) % maximumWorkerCount];
+}
+
+const DatabaseThread::Worker& DatabaseThread::workerForDatabase(const Database* database) const
+{
+    return m_workers[PtrHash<const Database*>::hash(database) % maximumWorkerCount];
+}
+
+bool DatabaseThread::isDatabaseThread(const Database* database) const
+{
+    return currentThread() == workerForDatabase(database).threadID;
+}
+
 void DatabaseThread::recordDatabaseOpen(Database* database)
 {
-    ASSERT(currentThread() == m_threadID);
+    ASSERT(isDatabaseThread(database));
     ASSERT(database);
-    ASSERT(!m_openDatabaseSet.contains(database));
-    m_openDatabaseSet.add(database);
+    Worker& worker = workerForDatabase(database);
+    ASSERT(!worker.openDatabaseSet.contains(database));
+    worker.openDatabaseSet.add(database);
 }
 
 void DatabaseThread::recordDatabaseClosed(Database* database)
 {
-    ASSERT(currentThread() == m_threadID);
+    ASSERT(isDatabaseThread(database));
     ASSERT(database);
-    ASSERT(m_queue.killed() || m_openDatabaseSet.contains(database));
-    m_openDatabaseSet.remove(database);
+    Worker& worker = workerForDatabase(database);
+    ASSERT(worker.queue.killed() || worker.openDatabaseSet.contains(database));
+    worker.openDatabaseSet.remove(database);
 }
 
 void DatabaseThread::scheduleTask(PassOwnPtr<DatabaseTask> task)
 {
     ASSERT(!task->hasSynchronizer() || task->hasCheckedForTermination());
-    m_queue.append(task);
+    Worker& worker = workerForDatabase(task->database());
+    {
+        MutexLocker lock(m_threadCreationMutex);
+        startWorker(worker);
+    }
+    worker.queue.append(task);
 }
 
 void DatabaseThread::scheduleImmediateTask(PassOwnPtr<DatabaseTask> task)
 {
     ASSERT(!task->hasSynchronizer() || task->hasCheckedForTermination());
-    m_queue.prepend(task);
+    Worker& worker = workerForDatabase(task->database());
+    {
+        MutexLocker lock(m_threadCreationMutex);
+        startWorker(worker);
+    }
+    worker.queue.prepend(task);
 }
 
 class SameDatabasePredicate {
@@ -179,7 +235,7 @@ void DatabaseThread::unscheduleDatabaseTasks(Database* database)
     // Note that the thread loop is running, so some tasks for the database
     // may still be executed. This is unavoidable.
     SameDatabasePredicate predicate(database);
-    m_queue.removeIf(predicate);
+    workerForDatabase(database).queue.removeIf(predicate);
 }
 } // namespace WebCore
 #endif
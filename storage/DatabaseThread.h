@@ -57,13 +57,18 @@ public:
     void requestTermination(DatabaseTaskSynchronizer* cleanupSync);
     bool terminationRequested(DatabaseTaskSynchronizer* taskSynchronizer = 0) const;
 
+    // The tasks for a database always run in order on the same worker thread, the one that opened
+    // its SQLite connection. Different databases are spread across a small pool of workers, which
+    // are started the first time a database is assigned to them.
     void scheduleTask(PassOwnPtr<DatabaseTask>);
     void scheduleImmediateTask(PassOwnPtr<DatabaseTask>); // This just adds the task to the front of the queue - the caller needs to be extremely careful not to create deadlocks when waiting for completion.
     void unscheduleDatabaseTasks(Database*);
 
     void recordDatabaseOpen(Database*);
     void recordDatabaseClosed(Database*);
-    ThreadIdentifier getThreadID() { return m_threadID; }
+
+    // Whether the calling thread is the worker that runs the database's tasks.
+    bool isDatabaseThread(const Database*) const;
 
     SQLTransactionClient* transactionClient() { return m_transactionClient.get(); }
     SQLTransactionCoordinator* transactionCoordinator() { return m_transactionCoordinator.get(); }
@@ -71,19 +76,32 @@ public:
 private:
     DatabaseThread();
 
+    static const unsigned maximumWorkerCount = 4;
+
+    // This set keeps track of the open databases that have been used on a worker.
+    typedef HashSet<RefPtr<Database> > DatabaseSet;
+
+    struct Worker {
+        Worker() : databaseThread(0), threadID(0) { }
+
+        DatabaseThread* databaseThread;
+        ThreadIdentifier threadID;
+        MessageQueue<DatabaseTask> queue;
+        DatabaseSet openDatabaseSet;
+    };
+
+    Worker& workerForDatabase(const Database*);
+    const Worker& workerForDatabase(const Database*) const;
+    bool startWorker(Worker&);
+
     static void* databaseThreadStart(void*);
-    void* databaseThread();
+    void* databaseThread(Worker&);
 
     Mutex m_threadCreationMutex;
-    ThreadIdentifier m_threadID;
+    Worker m_workers[maximumWorkerCount];
+    unsigned m_runningWorkerCount;
     RefPtr<DatabaseThread> m_selfRef;
 
-    MessageQueue<DatabaseTask> m_queue;
-
-    // This set keeps track of the open databases that have been used on this thread.
-    typedef HashSet<RefPtr<Database> > DatabaseSet;
-    DatabaseSet m_openDatabaseSet;
-
     OwnPtr<SQLTransactionClient> m_transactionClient;
     OwnPtr<SQLTransactionCoordinator> m_transactionCoordinator;
     DatabaseTaskSynchronizer* m_cleanupSync;
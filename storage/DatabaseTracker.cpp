@@ -44,6 +44,7 @@
 #include "SecurityOriginHash.h"
 #include "SQLiteFileSystem.h"
 #include "SQLiteStatement.h"
+#include "SQLiteTransaction.h"
 #include <wtf/MainThread.h>
 #include <wtf/StdLibExtras.h>
 
@@ -775,6 +776,7 @@ bool DatabaseTracker::deleteOrigin(SecurityOrigin* origin)
         MutexLocker lockDatabase(m_databaseGuard);
         doneDeletingOrigin(origin);
 
+        SQLiteTransactionBatch batch(m_database);
         SQLiteStatement statement(m_database, "DELETE FROM Databases WHERE origin=?");
         if (statement.prepare() != SQLResultOk) {
             LOG_ERROR("Unable to prepare deletion of databases from origin %s from tracker", origin->databaseIdentifier().ascii().data());
@@ -800,6 +802,7 @@ bool DatabaseTracker::deleteOrigin(SecurityOrigin* origin)
             LOG_ERROR("Unable to execute deletion of databases from origin %s from tracker", origin->databaseIdentifier().ascii().data());
             return false;
         }
+        batch.commit();
 
         SQLiteFileSystem::deleteEmptyDatabaseDirectory(originPath(origin));
 
@@ -0,0 +1,458 @@
+/*
+ * Copyright (C) 2026 The WebKit Authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.h"
+#include "IDBBTree.h"
+
+#if ENABLE(INDEXED_DATABASE)
+
+#include <string.h>
+#include <wtf/StdLibExtras.h>
+
+using namespace std;
+
+namespace WebCore {
+
+// Page sizes, in entries. Small enough that shifting entries within a page stays cheap.
+static const size_t MaximumLeafEntries = 64;
+static const size_t MaximumInternalChildren = 64;
+
+static int compareBytes(const char* a, size_t aLength, const char* b, size_t bLength)
+{
+    size_t length = min(aLength, bLength);
+    if (int result = length ? memcmp(a, b, length) : 0)
+        return result;
+    if (aLength == bLength)
+        return 0;
+    return aLength < bLength ? -1 : 1;
+}
+
+static size_t commonPrefixLength(const IDBBTree::Key& a, const IDBBTree::Key& b)
+{
+    size_t length = min(a.size(), b.size());
+    size_t i = 0;
+    while (i < length && a[i] == b[i])
+        ++i;
+    return i;
+}
+
+class IDBBTree::Page : public Noncopyable {
+public:
+    explicit Page(bool isLeaf) : m_isLeaf(isLeaf) { }
+
+    bool isLeaf() const { return m_isLeaf; }
+
+private:
+    bool m_isLeaf;
+};
+
+class IDBBTree::LeafPage : public IDBBTree::Page {
+public:
+    LeafPage()
+        : Page(true)
+        , m_previous(0)
+        , m_next(0)
+    {
+    }
+
+    size_t size() const { return m_suffixes.size(); }
+
+    Key key(size_t index) const
+    {
+        Key key(m_prefix);
+        key.append(m_suffixes[index].data(), m_suffixes[index].size());
+        return key;
+    }
+
+    size_t find(const Key&, bool& found) const;
+    void insert(size_t index, const Key&, const String& value);
+    void remove(size_t index);
+    void setEntries(const Vector<Key>& keys, const Vector<String>& values, size_t begin, size_t end);
+
+    Key m_prefix;
+    Vector<Key> m_suffixes;
+    Vector<String> m_values;
+    LeafPage* m_previous;
+    LeafPage* m_next;
+};
+
+// Returns the index of the first entry not less than the key.
+size_t IDBBTree::LeafPage::find(const Key& key, bool& found) const
+{
+    found = false;
+    if (!size())
+        return 0;
+
+    // A key that doesn't share the page's prefix sorts before or after every entry on it.
+    size_t prefixLength = m_prefix.size();
+    size_t comparedLength = min(prefixLength, key.size());
+    int prefixOrder = comparedLength ? memcmp(key.data(), m_prefix.data(), comparedLength) : 0;
+    if (prefixOrder < 0 || (!prefixOrder && key.size() < prefixLength))
+        return 0;
+    if (prefixOrder > 0)
+        return size();
+
+    const char* suffix = key.data() + prefixLength;
+    size_t suffixLength = key.size() - prefixLength;
+    size_t low = 0;
+    size_t high = size();
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        int order = compareBytes(m_suffixes[middle].data(), m_suffixes[middle].size(), suffix, suffixLength);
+        if (order < 0)
+            low = middle + 1;
+        else {
+            found = !order;
+            high = middle;
+        }
+    }
+    return low;
+}
+
+void IDBBTree::LeafPage::insert(size_t index, const Key& key, const String& value)
+{
+    if (!size())
+        m_prefix = key;
+    else {
+        size_t shared = commonPrefixLength(m_prefix, key);
+        if (shared < m_prefix.size()) {
+            // Move the part of the prefix the new key doesn't share back into every suffix.
+            for (size_t i = 0; i < size(); ++i) {
+                Key suffix;
+                suffix.append(m_prefix.data() + shared, m_prefix.size() - shared);
+                suffix.append(m_suffixes[i].data(), m_suffixes[i].size());
+                m_suffixes[i].swap(suffix);
+            }
+            m_prefix.shrink(shared);
+        }
+    }
+
+    Key suffix;
+    suffix.append(key.data() + m_prefix.size(), key.size() - m_prefix.size());
+    m_suffixes.insert(index, suffix);
+    m_values.insert(index, value);
+}
+
+void IDBBTree::LeafPage::remove(size_t index)
+{
+    m_suffixes.remove(index);
+    m_values.remove(index);
+    if (!size())
+        m_prefix.clear();
+}
+
+void IDBBTree::LeafPage::setEntries(const Vector<Key>& keys, const Vector<String>& values, size_t begin, size_t end)
+{
+    m_prefix.clear();
+    m_suffixes.clear();
+    m_values.clear();
+    if (begin == end)
+        return;
+
+    // The keys are sorted, so whatever the first and last share is shared by all of them.
+    size_t shared = commonPrefixLength(keys[begin], keys[end - 1]);
+    m_prefix.append(keys[begin].data(), shared);
+    m_suffixes.reserveCapacity(end - begin);
+    m_values.reserveCapacity(end - begin);
+    for (size_t i = begin; i < end; ++i) {
+        Key suffix;
+        suffix.append(keys[i].data() + shared, keys[i].size() - shared);
+        m_suffixes.append(suffix);
+        m_values.append(values[i]);
+    }
+}
+
+class IDBBTree::InternalPage : public IDBBTree::Page {
+public:
+    InternalPage() : Page(false) { }
+
+    // m_children[i] holds the keys less than m_separators[i], m_children[i + 1] the keys not less than it.
+    size_t childIndex(const Key& key) const
+    {
+        size_t low = 0;
+        size_t high = m_separators.size();
+        while (low < high) {
+            size_t middle = low + (high - low) / 2;
+            if (compare(m_separators[middle], key) <= 0)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        return low;
+    }
+
+    Vector<Key> m_separators;
+    Vector<Page*> m_children;
+};
+
+// Moves the position past the end of empty or exhausted leaves.
+static void skipForward(const IDBBTree::LeafPage*& leaf, size_t& index)
+{
+    while (leaf && index >= leaf->size()) {
+        leaf = leaf->m_next;
+        index = 0;
+    }
+}
+
+IDBBTree::Iterator::Iterator(const LeafPage* leaf, size_t index)
+    : m_leaf(leaf)
+    , m_index(index)
+{
+}
+
+IDBBTree::Key IDBBTree::Iterator::key() const
+{
+    ASSERT(isValid());
+    return m_leaf->key(m_index);
+}
+
+const String& IDBBTree::Iterator::value() const
+{
+    ASSERT(isValid());
+    return m_leaf->m_values[m_index];
+}
+
+void IDBBTree::Iterator::next()
+{
+    ASSERT(isValid());
+    ++m_index;
+    skipForward(m_leaf, m_index);
+}
+
+void IDBBTree::Iterator::previous()
+{
+    ASSERT(m_leaf);
+    if (m_index) {
+        --m_index;
+        return;
+    }
+
+    do
+        m_leaf = m_leaf->m_previous;
+    while (m_leaf && !m_leaf->size());
+    m_index = m_leaf ? m_leaf->size() - 1 : 0;
+}
+
+IDBBTree::IDBBTree()
+    : m_root(new LeafPage)
+    , m_size(0)
+    , m_version(0)
+{
+}
+
+IDBBTree::~IDBBTree()
+{
+    deletePage(m_root);
+}
+
+void IDBBTree::deletePage(Page* page)
+{
+    if (page->isLeaf()) {
+        delete static_cast<LeafPage*>(page);
+        return;
+    }
+
+    InternalPage* internal = static_cast<InternalPage*>(page);
+    for (size_t i = 0; i < internal->m_children.size(); ++i)
+        deletePage(internal->m_children[i]);
+    delete internal;
+}
+
+int IDBBTree::compare(const Key& a, const Key& b)
+{
+    return compareBytes(a.data(), a.size(), b.data(), b.size());
+}
+
+const IDBBTree::LeafPage* IDBBTree::findLeaf(const Key& key) const
+{
+    Page* page = m_root;
+    while (!page->isLeaf()) {
+        InternalPage* internal = static_cast<InternalPage*>(page);
+        page = internal->m_children[internal->childIndex(key)];
+    }
+    return static_cast<LeafPage*>(page);
+}
+
+bool IDBBTree::get(const Key& key, String& value) const
+{
+    const LeafPage* leaf = findLeaf(key);
+    bool found;
+    size_t index = leaf->find(key, found);
+    if (!found)
+        return false;
+    value = leaf->m_values[index];
+    return true;
+}
+
+bool IDBBTree::put(const Key& key, const String& value)
+{
+    ++m_version;
+
+    Vector<pair<InternalPage*, size_t>, 8> path;
+    Page* page = m_root;
+    while (!page->isLeaf()) {
+        InternalPage* internal = static_cast<InternalPage*>(page);
+        size_t childIndex = internal->childIndex(key);
+        path.append(make_pair(internal, childIndex));
+        page = internal->m_children[childIndex];
+    }
+
+    LeafPage* leaf = static_cast<LeafPage*>(page);
+    bool found;
+    size_t index = leaf->find(key, found);
+    if (found) {
+        leaf->m_values[index] = value;
+        return false;
+    }
+
+    leaf->insert(index, key, value);
+    ++m_size;
+    if (leaf->size() <= MaximumLeafEntries)
+        return true;
+
+    // Split the leaf in half; the first key of the new right half becomes its separator.
+    Vector<Key> keys;
+    keys.reserveCapacity(leaf->size());
+    for (size_t i = 0; i < leaf->size(); ++i)
+        keys.append(leaf->key(i));
+    Vector<String> values;
+    values.swap(leaf->m_values);
+
+    size_t middle = keys.size() / 2;
+    LeafPage* rightLeaf = new LeafPage;
+    rightLeaf->setEntries(keys, values, middle, keys.size());
+    leaf->setEntries(keys, values, 0, middle);
+    rightLeaf->m_previous = leaf;
+    rightLeaf->m_next = leaf->m_next;
+    if (rightLeaf->m_next)
+        rightLeaf->m_next->m_previous = rightLeaf;
+    leaf->m_next = rightLeaf;
+
+    Key separator = keys[middle];
+    Page* newPage = rightLeaf;
+
+    while (!path.isEmpty()) {
+        InternalPage* parent = path.last().first;
+        size_t childIndex = path.last().second;
+        path.removeLast();
+
+        parent->m_separators.insert(childIndex, separator);
+        parent->m_children.insert(childIndex + 1, newPage);
+        if (parent->m_children.size() <= MaximumInternalChildren)
+            return true;
+
+        // Split the internal page; its middle separator moves up rather than being copied.
+        size_t middleSeparator = parent->m_separators.size() / 2;
+        InternalPage* rightInternal = new InternalPage;
+        rightInternal->m_separators.append(parent->m_separators.data() + middleSeparator + 1, parent->m_separators.size() - middleSeparator - 1);
+        rightInternal->m_children.append(parent->m_children.data() + middleSeparator + 1, parent->m_children.size() - middleSeparator - 1);
+        separator = parent->m_separators[middleSeparator];
+        parent->m_separators.shrink(middleSeparator);
+        parent->m_children.shrink(middleSeparator + 1);
+        newPage = rightInternal;
+    }
+
+    // The root itself was split, so the tree grows by one level.
+    InternalPage* newRoot = new InternalPage;
+    newRoot->m_separators.append(separator);
+    newRoot->m_children.append(m_root);
+    newRoot->m_children.append(newPage);
+    m_root = newRoot;
+    return true;
+}
+
+bool IDBBTree::remove(const Key& key)
+{
+    LeafPage* leaf = const_cast<LeafPage*>(findLeaf(key));
+    bool found;
+    size_t index = leaf->find(key, found);
+    if (!found)
+        return false;
+
+    ++m_version;
+    leaf->remove(index);
+    --m_size;
+    return true;
+}
+
+void IDBBTree::clear()
+{
+    ++m_version;
+    deletePage(m_root);
+    m_root = new LeafPage;
+    m_size = 0;
+}
+
+IDBBTree::Iterator IDBBTree::first() const
+{
+    Page* page = m_root;
+    while (!page->isLeaf())
+        page = static_cast<InternalPage*>(page)->m_children.first();
+
+    const LeafPage* leaf = static_cast<LeafPage*>(page);
+    size_t index = 0;
+    skipForward(leaf, index);
+    return Iterator(leaf, index);
+}
+
+IDBBTree::Iterator IDBBTree::last() const
+{
+    Page* page = m_root;
+    while (!page->isLeaf())
+        page = static_cast<InternalPage*>(page)->m_children.last();
+
+    const LeafPage* leaf = static_cast<LeafPage*>(page);
+    Iterator iterator(leaf, leaf->size());
+    iterator.previous();
+    return iterator;
+}
+
+IDBBTree::Iterator IDBBTree::lowerBound(const Key& key, bool open) const
+{
+    const LeafPage* leaf = findLeaf(key);
+    bool found;
+    size_t index = leaf->find(key, found);
+    if (found && open)
+        ++index;
+    skipForward(leaf, index);
+    return Iterator(leaf, index);
+}
+
+IDBBTree::Iterator IDBBTree::upperBound(const Key& key, bool open) const
+{
+    const LeafPage* leaf = findLeaf(key);
+    bool found;
+    size_t index = leaf->find(key, found);
+    if (found && !open)
+        return Iterator(leaf, index);
+
+    Iterator iterator(leaf, index);
+    iterator.previous();
+    return iterator;
+}
+
+} // namespace WebCore
+
+#endif // ENABLE(INDEXED_DATABASE)
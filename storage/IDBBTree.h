@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 The WebKit Authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef IDBBTree_h
+#define IDBBTree_h
+
+#if ENABLE(INDEXED_DATABASE)
+
+#include "PlatformString.h"
+#include <wtf/Noncopyable.h>
+#include <wtf/PassOwnPtr.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+// An in-memory B+-tree mapping byte string keys, ordered by memcmp, to values. Each leaf page stores
+// the prefix its keys have in common once and only the remaining suffix per entry, which keeps pages
+// of similar keys (strings sharing a path, numbers of the same magnitude) small. Leaves are linked so
+// that range scans walk them directly instead of descending from the root for every step.
+//
+// Pages are split when they overflow but are not merged on removal; empty leaves are simply skipped
+// by iteration and refilled by later inserts.
+class IDBBTree : public Noncopyable {
+public:
+    typedef Vector<char> Key;
+
+    static PassOwnPtr<IDBBTree> create() { return adoptPtr(new IDBBTree); }
+    ~IDBBTree();
+
+    size_t size() const { return m_size; }
+
+    // Bumped by every modification; iterators obtained before it changed must not be used.
+    unsigned version() const { return m_version; }
+
+    bool get(const Key&, String& value) const;
+    // Returns true if the key was not in the tree before.
+    bool put(const Key&, const String& value);
+    bool remove(const Key&);
+    void clear();
+
+    class LeafPage;
+
+    class Iterator {
+    public:
+        Iterator() : m_leaf(0), m_index(0) { }
+
+        bool isValid() const { return m_leaf; }
+        Key key() const;
+        const String& value() const;
+
+        void next();
+        void previous();
+
+    private:
+        friend class IDBBTree;
+        Iterator(const LeafPage*, size_t index);
+
+        const LeafPage* m_leaf;
+        size_t m_index;
+    };
+
+    Iterator first() const;
+    Iterator last() const;
+    // The first entry not less than the key, or greater than the key if open.
+    Iterator lowerBound(const Key&, bool open) const;
+    // The last entry not greater than the key, or less than the key if open.
+    Iterator upperBound(const Key&, bool open) const;
+
+    static int compare(const Key&, const Key&);
+
+private:
+    IDBBTree();
+
+    class Page;
+    class InternalPage;
+
+    const LeafPage* findLeaf(const Key&) const;
+    static void deletePage(Page*);
+
+    Page* m_root;
+    size_t m_size;
+    unsigned m_version;
+};
+
+} // namespace WebCore
+
+#endif // ENABLE(INDEXED_DATABASE)
+
+#endif // IDBBTree_h
@@ -38,13 +38,36 @@
 
 namespace WebCore {
 
-IDBCursorBackendImpl::IDBCursorBackendImpl(PassRefPtr<IDBObjectStoreBackendImpl> idbObjectStore, PassRefPtr<IDBKeyRange> keyRange, IDBCursor::Direction direction, PassRefPtr<IDBKey> key, PassRefPtr<SerializedScriptValue> value)
+IDBCursorBackendImpl::IDBCursorBackendImpl(PassRefPtr<IDBObjectStoreBackendImpl> idbObjectStore, PassRefPtr<IDBKeyRange> keyRange, IDBCursor::Direction direction)
     : m_idbObjectStore(idbObjectStore)
     , m_keyRange(keyRange)
     , m_direction(direction)
-    , m_key(key)
-    , m_value(IDBAny::create(value.get()))
+    , m_lowerOpen(false)
+    , m_upperOpen(false)
+    , m_recordsVersion(0)
 {
+    if (m_keyRange) {
+        unsigned short flags = m_keyRange->flags();
+        if (flags == IDBKeyRange::SINGLE) {
+            m_lowerBound = m_keyRange->left()->encode();
+            m_upperBound = m_lowerBound;
+        } else {
+            if (flags & (IDBKeyRange::LEFT_BOUND | IDBKeyRange::LEFT_OPEN)) {
+                m_lowerBound = m_keyRange->left()->encode();
+                m_lowerOpen = flags & IDBKeyRange::LEFT_OPEN;
+            }
+            if (flags & (IDBKeyRange::RIGHT_BOUND | IDBKeyRange::RIGHT_OPEN)) {
+                m_upperBound = m_keyRange->right()->encode();
+                m_upperOpen = flags & IDBKeyRange::RIGHT_OPEN;
+            }
+        }
+    }
+
+    IDBBTree* records = m_idbObjectStore->records();
+    if (isForward())
+        setPosition(m_lowerBound.isEmpty() ? records->first() : records->lowerBound(m_lowerBound, m_lowerOpen));
+    else
+        setPosition(m_upperBound.isEmpty() ? records->last() : records->upperBound(m_upperBound, m_upperOpen));
 }
 
 IDBCursorBackendImpl::~IDBCursorBackendImpl()
@@ -72,10 +95,29 @@ void IDBCursorBackendImpl::update(PassRefPtr<SerializedScriptValue>, PassRefPtr<
     ASSERT_NOT_REACHED();
 }
 
-void IDBCursorBackendImpl::continueFunction(PassRefPtr<IDBKey>, PassRefPtr<IDBCallbacks>)
+void IDBCursorBackendImpl::continueFunction(PassRefPtr<IDBKey> prpKey, PassRefPtr<IDBCallbacks> callbacks)
 {
-    // FIXME: Implement this method.
-    ASSERT_NOT_REACHED();
+    RefPtr<IDBKey> key = prpKey;
+    if (!m_key) {
+        callbacks->onSuccess();
+        return;
+    }
+
+    // Seeking only makes sense towards keys the cursor has yet to reach; anything else is a single step.
+    IDBBTree::Key target;
+    if (key)
+        target = key->encode();
+    int order = key ? IDBBTree::compare(target, m_currentKey) : 0;
+    if (isForward() ? order > 0 : order < 0)
+        seek(target, false);
+    else
+        advance();
+
+    if (!m_key) {
+        callbacks->onSuccess();
+        return;
+    }
+    callbacks->onSuccess(this);
 }
 
 void IDBCursorBackendImpl::remove(PassRefPtr<IDBCallbacks>)
@@ -84,6 +126,64 @@ void IDBCursorBackendImpl::remove(PassRefPtr<IDBCallbacks>)
     ASSERT_NOT_REACHED();
 }
 
+bool IDBCursorBackendImpl::isInRange(const IDBBTree::Key& key) const
+{
+    if (!m_lowerBound.isEmpty()) {
+        int order = IDBBTree::compare(key, m_lowerBound);
+        if (order < 0 || (!order && m_lowerOpen))
+            return false;
+    }
+    if (!m_upperBound.isEmpty()) {
+        int order = IDBBTree::compare(key, m_upperBound);
+        if (order > 0 || (!order && m_upperOpen))
+            return false;
+    }
+    return true;
+}
+
+void IDBCursorBackendImpl::seek(const IDBBTree::Key& key, bool open)
+{
+    IDBBTree* records = m_idbObjectStore->records();
+    setPosition(isForward() ? records->lowerBound(key, open) : records->upperBound(key, open));
+}
+
+void IDBCursorBackendImpl::advance()
+{
+    IDBBTree* records = m_idbObjectStore->records();
+    if (records->version() != m_recordsVersion || !m_position.isValid()) {
+        // The records changed under the cursor; find the entry after the current key again.
+        seek(m_currentKey, true);
+        return;
+    }
+
+    IDBBTree::Iterator position = m_position;
+    if (isForward())
+        position.next();
+    else
+        position.previous();
+    setPosition(position);
+}
+
+void IDBCursorBackendImpl::setPosition(const IDBBTree::Iterator& position)
+{
+    m_position = position;
+    m_recordsVersion = m_idbObjectStore->records()->version();
+
+    IDBBTree::Key key;
+    if (m_position.isValid())
+        key = m_position.key();
+    if (key.isEmpty() || !isInRange(key)) {
+        m_position = IDBBTree::Iterator();
+        m_key = 0;
+        m_value = 0;
+        return;
+    }
+
+    m_currentKey.swap(key);
+    m_key = IDBKey::decode(m_currentKey);
+    m_value = IDBAny::create(SerializedScriptValue::createFromWire(m_position.value()).get());
+}
+
 } // namespace WebCore
 
 #endif // ENABLE(INDEXED_DATABASE)
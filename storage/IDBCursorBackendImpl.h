@@ -29,6 +29,7 @@
 
 #if ENABLE(INDEXED_DATABASE)
 
+#include "IDBBTree.h"
 #include "IDBCursor.h"
 #include "IDBCursorBackendInterface.h"
 #include <wtf/RefPtr.h>
@@ -41,9 +42,10 @@ class SerializedScriptValue;
 
 class IDBCursorBackendImpl : public IDBCursorBackendInterface {
 public:
-    static PassRefPtr<IDBCursorBackendImpl> create(PassRefPtr<IDBObjectStoreBackendImpl> objectStore, PassRefPtr<IDBKeyRange> keyRange, IDBCursor::Direction direction, PassRefPtr<IDBKey> key, PassRefPtr<SerializedScriptValue> value)
+    // The cursor starts out on the first record in the range, if there is one; key() is null otherwise.
+    static PassRefPtr<IDBCursorBackendImpl> create(PassRefPtr<IDBObjectStoreBackendImpl> objectStore, PassRefPtr<IDBKeyRange> keyRange, IDBCursor::Direction direction)
     {
-        return adoptRef(new IDBCursorBackendImpl(objectStore, keyRange, direction, key, value));
+        return adoptRef(new IDBCursorBackendImpl(objectStore, keyRange, direction));
     }
     virtual ~IDBCursorBackendImpl();
 
@@ -55,13 +57,31 @@ public:
     virtual void remove(PassRefPtr<IDBCallbacks>);
 
 private:
-    IDBCursorBackendImpl(PassRefPtr<IDBObjectStoreBackendImpl>, PassRefPtr<IDBKeyRange>, IDBCursor::Direction, PassRefPtr<IDBKey>, PassRefPtr<SerializedScriptValue>);
+    IDBCursorBackendImpl(PassRefPtr<IDBObjectStoreBackendImpl>, PassRefPtr<IDBKeyRange>, IDBCursor::Direction);
+
+    bool isForward() const { return m_direction == IDBCursor::NEXT || m_direction == IDBCursor::NEXT_NO_DUPLICATE; }
+    bool isInRange(const IDBBTree::Key&) const;
+    void seek(const IDBBTree::Key&, bool open);
+    void advance();
+    void setPosition(const IDBBTree::Iterator&);
 
     RefPtr<IDBObjectStoreBackendImpl> m_idbObjectStore;
     RefPtr<IDBKeyRange> m_keyRange;
     IDBCursor::Direction m_direction;
     RefPtr<IDBKey> m_key;
     RefPtr<IDBAny> m_value;
+
+    // Encoded bounds of m_keyRange; an empty key means that side is unbounded.
+    IDBBTree::Key m_lowerBound;
+    IDBBTree::Key m_upperBound;
+    bool m_lowerOpen;
+    bool m_upperOpen;
+
+    // The position is only reused while the object store's records are unchanged; otherwise
+    // the cursor seeks past m_currentKey again.
+    IDBBTree::Iterator m_position;
+    IDBBTree::Key m_currentKey;
+    unsigned m_recordsVersion;
 };
 
 } // namespace WebCore
@@ -87,6 +87,7 @@ static bool setMetaData(SQLiteDatabase* sqliteDatabase, const String& name, cons
 
 IDBDatabaseBackendImpl::IDBDatabaseBackendImpl(const String& name, const String& description, PassOwnPtr<SQLiteDatabase> sqliteDatabase, IDBTransactionCoordinator* coordinator)
     : m_sqliteDatabase(sqliteDatabase)
+    , m_batchedWriteTimer(this, &IDBDatabaseBackendImpl::batchedWriteTimerFired)
     , m_name(name)
     , m_version("")
     , m_transactionCoordinator(coordinator)
@@ -106,6 +107,27 @@ IDBDatabaseBackendImpl::IDBDatabaseBackendImpl(const String& name, const String&
 
 IDBDatabaseBackendImpl::~IDBDatabaseBackendImpl()
 {
+    commitBatchedWrites();
+}
+
+void IDBDatabaseBackendImpl::beginBatchedWrite()
+{
+    if (m_batchedWrites)
+        return;
+
+    m_batchedWrites = adoptPtr(new SQLiteTransactionBatch(sqliteDatabase()));
+    m_batchedWriteTimer.startOneShot(0);
+}
+
+void IDBDatabaseBackendImpl::commitBatchedWrites()
+{
+    m_batchedWriteTimer.stop();
+    m_batchedWrites.clear();
+}
+
+void IDBDatabaseBackendImpl::batchedWriteTimerFired(Timer<IDBDatabaseBackendImpl>*)
+{
+    commitBatchedWrites();
 }
 
 void IDBDatabaseBackendImpl::setDescription(const String& description)
@@ -173,6 +195,7 @@ void IDBDatabaseBackendImpl::removeObjectStore(const String& name, PassRefPtr<ID
         return;
     }
 
+    commitBatchedWrites();
     SQLiteTransaction transaction(sqliteDatabase());
     transaction.begin();
     doDelete(sqliteDatabase(), "DELETE FROM ObjectStores WHERE id = ?", objectStore->id());
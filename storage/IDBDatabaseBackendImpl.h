@@ -28,6 +28,7 @@
 
 #include "IDBCallbacks.h"
 #include "IDBDatabase.h"
+#include "Timer.h"
 #include <wtf/HashMap.h>
 #include <wtf/text/StringHash.h>
 
@@ -38,6 +39,7 @@ namespace WebCore {
 class IDBObjectStoreBackendImpl;
 class IDBTransactionCoordinator;
 class SQLiteDatabase;
+class SQLiteTransactionBatch;
 
 class IDBDatabaseBackendImpl : public IDBDatabaseBackendInterface {
 public:
@@ -50,6 +52,11 @@ public:
     void setDescription(const String& description);
     SQLiteDatabase& sqliteDatabase() const { return *m_sqliteDatabase.get(); }
 
+    // Groups the writes that follow into one SQLite transaction, committed once control returns to
+    // the event loop, which is when the IDBTransaction they were made in would commit.
+    void beginBatchedWrite();
+    void commitBatchedWrites();
+
     // Implements IDBDatabase
     virtual String name() const { return m_name; }
     virtual String description() const { return m_description; }
@@ -66,8 +73,11 @@ private:
     IDBDatabaseBackendImpl(const String& name, const String& description, PassOwnPtr<SQLiteDatabase> database, IDBTransactionCoordinator*);
 
     void loadObjectStores();
+    void batchedWriteTimerFired(Timer<IDBDatabaseBackendImpl>*);
 
     OwnPtr<SQLiteDatabase> m_sqliteDatabase;
+    OwnPtr<SQLiteTransactionBatch> m_batchedWrites;
+    Timer<IDBDatabaseBackendImpl> m_batchedWriteTimer;
     String m_name;
     String m_description;
     String m_version;
@@ -53,6 +53,181 @@ IDBKey::~IDBKey()
 {
 }
 
+// Tag bytes in IndexedDB sort order, which is not the order of IDBKey::Type. Dates don't exist yet,
+// but keep their place between numbers and strings. Null keys sort last, as they always have.
+enum KeyTag {
+    NumberTag = 1,
+    DateTag = 2,
+    StringTag = 3,
+    NullTag = 4
+};
+
+static inline KeyTag tagForType(IDBKey::Type type)
+{
+    switch (type) {
+    case IDBKey::NullType:
+        return NullTag;
+    case IDBKey::StringType:
+        return StringTag;
+    case IDBKey::NumberType:
+        return NumberTag;
+    }
+
+    ASSERT_NOT_REACHED();
+    return NullTag;
+}
+
+int IDBKey::compare(const IDBKey* other) const
+{
+    if (m_type != other->m_type)
+        return tagForType(m_type) < tagForType(other->m_type) ? -1 : 1;
+
+    switch (m_type) {
+    case NullType:
+        return 0;
+    case StringType:
+        return codePointCompare(m_string, other->m_string);
+    // FIXME: Implement date.
+    case NumberType:
+        if (m_number == other->m_number)
+            return 0;
+        return m_number < other->m_number ? -1 : 1;
+    }
+
+    ASSERT_NOT_REACHED();
+    return 0;
+}
+
+// Every encoding starts with a KeyTag byte, followed by:
+//   strings: UTF-16 code units, big-endian and remapped so that unit order is code point order,
+//            with 0x00 bytes escaped as 0x00 0xFF and a 0x00 byte at the end;
+//   numbers: four bytes, big-endian with the sign bit flipped.
+// Tags stay below 0xFF, so an escaped 0x00 always sorts after the end of a shorter string.
+static const char StringTerminator = 0x00;
+static const char EscapedZeroByte = static_cast<char>(0xFF);
+
+// Surrogates (0xD800-0xDFFF) move above 0xE000-0xFFFF, which turns UTF-16 unit order into code point order.
+static inline UChar toCodePointOrder(UChar unit)
+{
+    if (unit < 0xD800)
+        return unit;
+    return unit >= 0xE000 ? unit - 0x800 : unit + 0x2000;
+}
+
+static inline UChar fromCodePointOrder(UChar unit)
+{
+    if (unit < 0xD800)
+        return unit;
+    return unit >= 0xF800 ? unit - 0x2000 : unit + 0x800;
+}
+
+static inline void appendEscapedByte(Vector<char>& encoded, char byte)
+{
+    encoded.append(byte);
+    if (byte == StringTerminator)
+        encoded.append(EscapedZeroByte);
+}
+
+void IDBKey::encode(Vector<char>& encoded) const
+{
+    encoded.append(static_cast<char>(tagForType(m_type)));
+
+    switch (m_type) {
+    case NullType:
+        return;
+    case StringType: {
+        const UChar* characters = m_string.characters();
+        unsigned length = m_string.length();
+        encoded.reserveCapacity(encoded.size() + length * 2 + 1);
+        for (unsigned i = 0; i < length; ++i) {
+            UChar unit = toCodePointOrder(characters[i]);
+            appendEscapedByte(encoded, static_cast<char>(unit >> 8));
+            appendEscapedByte(encoded, static_cast<char>(unit));
+        }
+        encoded.append(StringTerminator);
+        return;
+    }
+    // FIXME: Implement date.
+    case NumberType: {
+        uint32_t bits = static_cast<uint32_t>(m_number) ^ 0x80000000;
+        for (int shift = 24; shift >= 0; shift -= 8)
+            encoded.append(static_cast<char>(bits >> shift));
+        return;
+    }
+    }
+
+    ASSERT_NOT_REACHED();
+}
+
+Vector<char> IDBKey::encode() const
+{
+    Vector<char> encoded;
+    encode(encoded);
+    return encoded;
+}
+
+static bool readEscapedByte(const char*& data, const char* end, unsigned char& byte, bool& atTerminator)
+{
+    if (data == end)
+        return false;
+    byte = static_cast<unsigned char>(*data++);
+    atTerminator = false;
+    if (byte != static_cast<unsigned char>(StringTerminator))
+        return true;
+    if (data != end && *data == EscapedZeroByte) {
+        ++data;
+        return true;
+    }
+    atTerminator = true;
+    return true;
+}
+
+PassRefPtr<IDBKey> IDBKey::decode(const char*& data, const char* end)
+{
+    if (data == end)
+        return 0;
+
+    switch (*data++) {
+    case NullTag:
+        return IDBKey::create();
+    case StringTag: {
+        Vector<UChar> characters;
+        while (true) {
+            unsigned char high;
+            unsigned char low;
+            bool atTerminator;
+            if (!readEscapedByte(data, end, high, atTerminator))
+                return 0;
+            if (atTerminator)
+                break;
+            if (!readEscapedByte(data, end, low, atTerminator) || atTerminator)
+                return 0;
+            characters.append(fromCodePointOrder((high << 8) | low));
+        }
+        return IDBKey::create(String::adopt(characters));
+    }
+    // FIXME: Implement date.
+    case NumberTag: {
+        if (end - data < 4)
+            return 0;
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+        uint32_t bits = (static_cast<uint32_t>(bytes[0]) << 24) | (bytes[1] << 16) | (bytes[2] << 8) | bytes[3];
+        data += 4;
+        return IDBKey::create(static_cast<int32_t>(bits ^ 0x80000000));
+    }
+    }
+
+    return 0;
+}
+
+PassRefPtr<IDBKey> IDBKey::decode(const Vector<char>& encoded)
+{
+    const char* data = encoded.data();
+    const char* end = data + encoded.size();
+    RefPtr<IDBKey> key = decode(data, end);
+    return data == end ? key.release() : 0;
+}
+
 } // namespace WebCore
 
 #endif
@@ -28,6 +28,7 @@
 
 #include "PlatformString.h"
 #include <wtf/Forward.h>
+#include <wtf/Vector.h>
 
 #if ENABLE(INDEXED_DATABASE)
 
@@ -50,7 +51,7 @@ public:
     }
     ~IDBKey();
 
-    // In order of the least to the highest precedent in terms of sort order.
+    // The sort order across types is not the order of this enum; see compare().
     enum Type {
         NullType = 0,
         StringType,
@@ -71,6 +72,19 @@ public:
         return m_number;
     }
 
+    // Negative, zero or positive as this key sorts before, the same as or after the other one.
+    // Numbers sort before dates, dates before strings, and strings before null.
+    int compare(const IDBKey*) const;
+
+    // A byte string whose memcmp() order is the sort order of the keys, so that keys of every type
+    // can be stored, indexed and range-scanned as one column. Encodings are self-delimiting, which
+    // allows them to be concatenated into composite keys.
+    void encode(Vector<char>&) const;
+    Vector<char> encode() const;
+    // Returns 0 if the bytes are not a valid encoding. Otherwise consumes one encoded key and advances the pointer past it.
+    static PassRefPtr<IDBKey> decode(const char*& data, const char* end);
+    static PassRefPtr<IDBKey> decode(const Vector<char>&);
+
 private:
     IDBKey();
     explicit IDBKey(int32_t);
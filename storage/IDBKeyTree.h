@@ -100,21 +100,7 @@ IDBKeyTree<ValueType>::~IDBKeyTree()
 template <typename ValueType>
 int IDBKeyTree<ValueType>::AVLTreeAbstractor::compare_key_key(key va, key vb)
 {
-    if (va->type() != vb->type())
-        return vb->type() - va->type();
-
-    switch (va->type()) {
-    case IDBKey::NullType:
-        return 0;
-    case IDBKey::NumberType:
-        return vb->number() - va->number();
-    case IDBKey::StringType:
-        return codePointCompare(va->string(), vb->string());
-    // FIXME: Handle dates.  Oh, and test this thoroughly.
-    default:
-        ASSERT_NOT_REACHED();
-        return 0;
-    }
+    return va->compare(vb);
 }
 
 template <typename ValueType>
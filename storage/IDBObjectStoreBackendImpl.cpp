@@ -65,65 +65,20 @@ PassRefPtr<DOMStringList> IDBObjectStoreBackendImpl::indexNames() const
     return indexNames.release();
 }
 
-static String whereClause(IDBKey::Type type)
+static void bindKey(SQLiteStatement& query, int column, const IDBBTree::Key& encodedKey)
 {
-    switch (type) {
-    case IDBKey::StringType:
-        return "WHERE objectStoreId = ?  AND  keyString = ?";
-    case IDBKey::NumberType:
-        return "WHERE objectStoreId = ?  AND  keyNumber = ?";
-    // FIXME: Implement date.
-    case IDBKey::NullType:
-        return "WHERE objectStoreId = ?  AND  keyString IS NULL  AND  keyDate IS NULL  AND  keyNumber IS NULL";
-    }
-
-    ASSERT_NOT_REACHED();
-    return "";
-}
-
-// Returns number of items bound.
-static int bindKey(SQLiteStatement& query, int column, IDBKey* key)
-{
-    switch (key->type()) {
-    case IDBKey::StringType:
-        query.bindText(column, key->string());
-        return 1;
-    case IDBKey::NumberType:
-        query.bindInt(column, key->number());
-        return 1;
-    // FIXME: Implement date.
-    case IDBKey::NullType:
-        return 0;
-    }
-
-    ASSERT_NOT_REACHED();
-    return 0;
-}
-
-static void bindWhereClause(SQLiteStatement& query, int64_t id, IDBKey* key)
-{
-    query.bindInt64(1, id);
-    bindKey(query, 2, key);
+    query.bindBlob(column, encodedKey.data(), encodedKey.size());
 }
 
 void IDBObjectStoreBackendImpl::get(PassRefPtr<IDBKey> key, PassRefPtr<IDBCallbacks> callbacks)
 {
-    SQLiteStatement query(sqliteDatabase(), "SELECT keyString, keyDate, keyNumber, value FROM ObjectStoreData " + whereClause(key->type()));
-    bool ok = query.prepare() == SQLResultOk;
-    ASSERT_UNUSED(ok, ok); // FIXME: Better error handling?
-
-    bindWhereClause(query, m_id, key.get());
-    if (query.step() != SQLResultRow) {
+    String wireValue;
+    if (!records()->get(key->encode(), wireValue)) {
         callbacks->onError(IDBDatabaseError::create(IDBDatabaseException::NOT_FOUND_ERR, "Key does not exist in the object store."));
         return;
     }
 
-    ASSERT((key->type() == IDBKey::StringType) != query.isColumnNull(0));
-    // FIXME: Implement date.
-    ASSERT((key->type() == IDBKey::NumberType) != query.isColumnNull(2));
-
-    callbacks->onSuccess(SerializedScriptValue::createFromWire(query.getColumnText(3)));
-    ASSERT(query.step() != SQLResultRow);
+    callbacks->onSuccess(SerializedScriptValue::createFromWire(wireValue));
 }
 
 void IDBObjectStoreBackendImpl::put(PassRefPtr<SerializedScriptValue> prpValue, PassRefPtr<IDBKey> prpKey, bool addOnly, PassRefPtr<IDBCallbacks> callbacks)
@@ -152,66 +107,63 @@ void IDBObjectStoreBackendImpl::put(PassRefPtr<SerializedScriptValue> prpValue,
         return;
     }
 
-    SQLiteStatement getQuery(sqliteDatabase(), "SELECT id FROM ObjectStoreData " + whereClause(key->type()));
-    bool ok = getQuery.prepare() == SQLResultOk;
-    ASSERT_UNUSED(ok, ok); // FIXME: Better error handling?
-
-    bindWhereClause(getQuery, m_id, key.get());
-    bool existingValue = getQuery.step() == SQLResultRow;
+    IDBBTree::Key encodedKey = key->encode();
+    String existingWireValue;
+    bool existingValue = records()->get(encodedKey, existingWireValue);
     if (addOnly && existingValue) {
         callbacks->onError(IDBDatabaseError::create(IDBDatabaseException::CONSTRAINT_ERR, "Key already exists in the object store."));
         return;
     }
 
-    String sql = existingValue ? "UPDATE ObjectStoreData SET keyString = ?, keyDate = ?, keyNumber = ?, value = ? WHERE id = ?"
-                               : "INSERT INTO ObjectStoreData (keyString, keyDate, keyNumber, value, objectStoreId) VALUES (?, ?, ?, ?, ?)";
+    String wireValue = value->toWireString();
+    m_database->beginBatchedWrite();
+
+    String sql = existingValue ? "UPDATE ObjectStoreData SET value = ? WHERE objectStoreId = ? AND encodedKey = ?"
+                               : "INSERT INTO ObjectStoreData (value, objectStoreId, encodedKey) VALUES (?, ?, ?)";
     SQLiteStatement putQuery(sqliteDatabase(), sql);
-    ok = putQuery.prepare() == SQLResultOk;
-    ASSERT_UNUSED(ok, ok); // FIXME: Better error handling?
-    switch (key->type()) {
-    case IDBKey::StringType:
-        putQuery.bindText(1, key->string());
-        putQuery.bindNull(2);
-        putQuery.bindNull(3);
-        break;
-    // FIXME: Implement date.
-    case IDBKey::NumberType:
-        putQuery.bindNull(1);
-        putQuery.bindNull(2);
-        putQuery.bindInt(3, key->number());
-        break;
-    case IDBKey::NullType:
-        putQuery.bindNull(1);
-        putQuery.bindNull(2);
-        putQuery.bindNull(3);
-        break;
-    default:
-        ASSERT_NOT_REACHED();
+    if (putQuery.prepare() != SQLResultOk) {
+        callbacks->onError(IDBDatabaseError::create(IDBDatabaseException::UNKNOWN_ERR, "Error writing data to stable storage."));
+        return;
     }
-    putQuery.bindText(4, value->toWireString());
-    if (existingValue)
-        putQuery.bindInt(5, getQuery.getColumnInt(0));
-    else
-        putQuery.bindInt64(5, m_id);
+    putQuery.bindText(1, wireValue);
+    putQuery.bindInt64(2, m_id);
+    bindKey(putQuery, 3, encodedKey);
 
-    ok = putQuery.step() == SQLResultDone;
-    ASSERT_UNUSED(ok, ok); // FIXME: Better error handling?
+    // The records must only ever hold what is on disk.
+    if (putQuery.step() != SQLResultDone) {
+        callbacks->onError(IDBDatabaseError::create(IDBDatabaseException::UNKNOWN_ERR, "Error writing data to stable storage."));
+        return;
+    }
 
+    records()->put(encodedKey, wireValue);
     callbacks->onSuccess(key.get());
 }
 
 void IDBObjectStoreBackendImpl::remove(PassRefPtr<IDBKey> key, PassRefPtr<IDBCallbacks> callbacks)
 {
-    SQLiteStatement query(sqliteDatabase(), "DELETE FROM ObjectStoreData " + whereClause(key->type()));
-    bool ok = query.prepare() == SQLResultOk;
-    ASSERT_UNUSED(ok, ok); // FIXME: Better error handling?
+    IDBBTree::Key encodedKey = key->encode();
+    String existingWireValue;
+    if (!records()->get(encodedKey, existingWireValue)) {
+        callbacks->onError(IDBDatabaseError::create(IDBDatabaseException::NOT_FOUND_ERR, "Key does not exist in the object store."));
+        return;
+    }
+
+    m_database->beginBatchedWrite();
+
+    SQLiteStatement query(sqliteDatabase(), "DELETE FROM ObjectStoreData WHERE objectStoreId = ? AND encodedKey = ?");
+    if (query.prepare() != SQLResultOk) {
+        callbacks->onError(IDBDatabaseError::create(IDBDatabaseException::UNKNOWN_ERR, "Error removing data from stable storage."));
+        return;
+    }
 
-    bindWhereClause(query, m_id, key.get());
+    query.bindInt64(1, m_id);
+    bindKey(query, 2, encodedKey);
     if (query.step() != SQLResultDone) {
-        callbacks->onError(IDBDatabaseError::create(IDBDatabaseException::NOT_FOUND_ERR, "Key does not exist in the object store."));
+        callbacks->onError(IDBDatabaseError::create(IDBDatabaseException::UNKNOWN_ERR, "Error removing data from stable storage."));
         return;
     }
 
+    records()->remove(encodedKey);
     callbacks->onSuccess();
 }
 
@@ -267,21 +219,12 @@ void IDBObjectStoreBackendImpl::removeIndex(const String& name, PassRefPtr<IDBCa
 
 void IDBObjectStoreBackendImpl::openCursor(PassRefPtr<IDBKeyRange> range, unsigned short direction, PassRefPtr<IDBCallbacks> callbacks)
 {
-    // FIXME: Fully implement.
-
-    RefPtr<IDBKey> key = range->left();
-    SQLiteStatement query(sqliteDatabase(), "SELECT id, value FROM ObjectStoreData " + whereClause(key->type()));
-    bool ok = query.prepare() == SQLResultOk;
-    ASSERT_UNUSED(ok, ok); // FIXME: Better error handling?
-
-    bindWhereClause(query, m_id, key.get());
-    if (query.step() != SQLResultRow) {
+    RefPtr<IDBCursorBackendImpl> cursor = IDBCursorBackendImpl::create(this, range, static_cast<IDBCursor::Direction>(direction));
+    if (!cursor->key()) {
         callbacks->onSuccess();
         return;
     }
 
-    RefPtr<SerializedScriptValue> value = SerializedScriptValue::createFromWire(query.getColumnText(1));
-    RefPtr<IDBCursorBackendInterface> cursor = IDBCursorBackendImpl::create(this, range, static_cast<IDBCursor::Direction>(direction), key.release(), value.release());
     callbacks->onSuccess(cursor.release());
 }
 
@@ -308,6 +251,27 @@ SQLiteDatabase& IDBObjectStoreBackendImpl::sqliteDatabase() const
     return m_database->sqliteDatabase();
 }
 
+IDBBTree* IDBObjectStoreBackendImpl::records()
+{
+    if (m_records)
+        return m_records.get();
+
+    m_records = IDBBTree::create();
+
+    SQLiteStatement query(sqliteDatabase(), "SELECT encodedKey, value FROM ObjectStoreData WHERE objectStoreId = ? ORDER BY encodedKey");
+    bool ok = query.prepare() == SQLResultOk;
+    ASSERT_UNUSED(ok, ok); // FIXME: Better error handling?
+
+    query.bindInt64(1, m_id);
+    IDBBTree::Key encodedKey;
+    while (query.step() == SQLResultRow) {
+        query.getColumnBlobAsVector(0, encodedKey);
+        m_records->put(encodedKey, query.getColumnText(1));
+    }
+
+    return m_records.get();
+}
+
 } // namespace WebCore
 
 #endif
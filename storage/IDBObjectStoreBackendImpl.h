@@ -26,8 +26,10 @@
 #ifndef IDBObjectStoreBackendImpl_h
 #define IDBObjectStoreBackendImpl_h
 
+#include "IDBBTree.h"
 #include "IDBObjectStoreBackendInterface.h"
 #include <wtf/HashMap.h>
+#include <wtf/OwnPtr.h>
 #include <wtf/text/StringHash.h>
 
 #if ENABLE(INDEXED_DATABASE)
@@ -62,6 +64,17 @@ public:
 
     IDBDatabaseBackendImpl* database() const { return m_database.get(); }
 
+    // The object store's records keyed by IDBKey::encode(), loaded from the database on first use and
+    // kept in step with it by put() and remove(). Reads and cursors never go back to SQL.
+    //
+    // This is a full in-memory copy of the store, not a page cache: it holds every record, values
+    // included, for as long as the object store lives, and loading it reads every row once. That is
+    // what a single cursor over the store used to read anyway, and it is what lets cursor steps and
+    // get() avoid a query each. Memory use is the size of the store's data, so this suits the small
+    // to medium stores pages keep today; very large stores would need the tree to page its leaves
+    // from SQLite instead.
+    IDBBTree* records();
+
 private:
     IDBObjectStoreBackendImpl(IDBDatabaseBackendImpl*, int64_t id, const String& name, const String& keyPath, bool autoIncrement);
 
@@ -77,6 +90,8 @@ private:
 
     typedef HashMap<String, RefPtr<IDBIndexBackendInterface> > IndexMap;
     IndexMap m_indexes;
+
+    OwnPtr<IDBBTree> m_records;
 };
 
 } // namespace WebCore
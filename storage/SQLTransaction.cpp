@@ -163,7 +163,7 @@ void SQLTransaction::checkAndHandleClosedOrInterruptedDatabase()
     m_errorCallback = 0;
 
     // The next steps should be executed only if we're on the DB thread.
-    if (currentThread() != database()->scriptExecutionContext()->databaseThread()->getThreadID())
+    if (!database()->scriptExecutionContext()->databaseThread()->isDatabaseThread(database()))
         return;
 
     // The current SQLite transaction should be stopped, as well
@@ -215,7 +215,7 @@ void SQLTransaction::performPendingCallback()
 
 void SQLTransaction::notifyDatabaseThreadIsShuttingDown()
 {
-    ASSERT(currentThread() == database()->scriptExecutionContext()->databaseThread()->getThreadID());
+    ASSERT(database()->scriptExecutionContext()->databaseThread()->isDatabaseThread(database()));
 
     // If the transaction is in progress, we should roll it back here, since this is our last
     // oportunity to do something related to this transaction on the DB thread.
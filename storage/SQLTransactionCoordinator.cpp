@@ -34,7 +34,10 @@
 #if ENABLE(DATABASE)
 
 #include "Database.h"
+#include "DatabaseThread.h"
 #include "SQLTransaction.h"
+#include "SQLiteDatabase.h"
+#include "ScriptExecutionContext.h"
 #include <wtf/Deque.h>
 #include <wtf/HashMap.h>
 #include <wtf/HashSet.h>
@@ -49,6 +52,12 @@ static String getDatabaseIdentifier(SQLTransaction* transaction)
     return database->stringIdentifier();
 }
 
+static bool isOnDatabaseThread(SQLTransaction* transaction)
+{
+    Database* database = transaction->database();
+    return database->scriptExecutionContext()->databaseThread()->isDatabaseThread(database);
+}
+
 void SQLTransactionCoordinator::processPendingTransactions(CoordinationInfo& info)
 {
     if (info.activeWriteTransaction || info.pendingTransactions.isEmpty())
@@ -61,7 +70,7 @@ void SQLTransactionCoordinator::processPendingTransactions(CoordinationInfo& inf
             info.activeReadTransactions.add(firstPendingTransaction);
             firstPendingTransaction->lockAcquired();
         } while (!info.pendingTransactions.isEmpty() && info.pendingTransactions.first()->isReadOnly());
-    } else if (info.activeReadTransactions.isEmpty()) {
+    } else if (info.activeReadTransactions.isEmpty() || firstPendingTransaction->database()->sqliteDatabase().isUsingWriteAheadLogging()) {
         info.pendingTransactions.removeFirst();
         info.activeWriteTransaction = firstPendingTransaction;
         firstPendingTransaction->lockAcquired();
@@ -72,6 +81,7 @@ void SQLTransactionCoordinator::acquireLock(SQLTransaction* transaction)
 {
     String dbIdentifier = getDatabaseIdentifier(transaction);
 
+    MutexLocker locker(m_coordinationInfoMapMutex);
     CoordinationInfoMap::iterator coordinationInfoIterator = m_coordinationInfoMap.find(dbIdentifier);
     if (coordinationInfoIterator == m_coordinationInfoMap.end()) {
         // No pending transactions for this DB
@@ -85,11 +95,12 @@ void SQLTransactionCoordinator::acquireLock(SQLTransaction* transaction)
 
 void SQLTransactionCoordinator::releaseLock(SQLTransaction* transaction)
 {
+    String dbIdentifier = getDatabaseIdentifier(transaction);
+
+    MutexLocker locker(m_coordinationInfoMapMutex);
     if (m_coordinationInfoMap.isEmpty())
         return;
 
-    String dbIdentifier = getDatabaseIdentifier(transaction);
-
     CoordinationInfoMap::iterator coordinationInfoIterator = m_coordinationInfoMap.find(dbIdentifier);
     ASSERT(coordinationInfoIterator != m_coordinationInfoMap.end());
     CoordinationInfo& info = coordinationInfoIterator->second;
@@ -105,23 +116,30 @@ void SQLTransactionCoordinator::releaseLock(SQLTransaction* transaction)
     processPendingTransactions(info);
 }
 
-void SQLTransactionCoordinator::shutdown()
+void SQLTransactionCoordinator::notifyDatabaseThreadIsShuttingDown()
 {
-    // Notify all transactions in progress that the database thread is shutting down
+    MutexLocker locker(m_coordinationInfoMapMutex);
+
+    // Notify the transactions in progress on this worker that the database thread is shutting down
     for (CoordinationInfoMap::iterator coordinationInfoIterator = m_coordinationInfoMap.begin();
          coordinationInfoIterator != m_coordinationInfoMap.end(); ++coordinationInfoIterator) {
         CoordinationInfo& info = coordinationInfoIterator->second;
-        if (info.activeWriteTransaction)
+        if (info.activeWriteTransaction && isOnDatabaseThread(info.activeWriteTransaction.get()))
             info.activeWriteTransaction->notifyDatabaseThreadIsShuttingDown();
         for (HashSet<RefPtr<SQLTransaction> >::iterator activeReadTransactionsIterator =
                      info.activeReadTransactions.begin();
              activeReadTransactionsIterator != info.activeReadTransactions.end();
              ++activeReadTransactionsIterator) {
-            (*activeReadTransactionsIterator)->notifyDatabaseThreadIsShuttingDown();
+            if (isOnDatabaseThread(activeReadTransactionsIterator->get()))
+                (*activeReadTransactionsIterator)->notifyDatabaseThreadIsShuttingDown();
         }
     }
+}
 
+void SQLTransactionCoordinator::shutdown()
+{
     // Clean up all pending transactions for all databases
+    MutexLocker locker(m_coordinationInfoMapMutex);
     m_coordinationInfoMap.clear();
 }
 
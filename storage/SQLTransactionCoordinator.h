@@ -37,16 +37,22 @@
 #include <wtf/HashMap.h>
 #include <wtf/HashSet.h>
 #include <wtf/RefPtr.h>
+#include <wtf/Threading.h>
 #include <wtf/text/StringHash.h>
 
 namespace WebCore {
 
     class SQLTransaction;
 
+    // Shared by all the workers of a DatabaseThread. Read transactions run alongside each other, and
+    // on databases in write-ahead logging mode a write transaction also runs alongside the reads
+    // that were queued before it, since they keep seeing the database as it was when they began.
     class SQLTransactionCoordinator : public Noncopyable {
     public:
         void acquireLock(SQLTransaction*);
         void releaseLock(SQLTransaction*);
+        // Called by each worker as it stops, for the transactions in progress on that worker.
+        void notifyDatabaseThreadIsShuttingDown();
         void shutdown();
     private:
         typedef Deque<RefPtr<SQLTransaction> > TransactionsQueue;
@@ -58,6 +64,7 @@ namespace WebCore {
         // Maps database names to information about pending transactions
         typedef HashMap<String, CoordinationInfo> CoordinationInfoMap;
         CoordinationInfoMap m_coordinationInfoMap;
+        Mutex m_coordinationInfoMapMutex;
 
         void processPendingTransactions(CoordinationInfo& info);
     };
@@ -125,6 +125,10 @@ String StorageAreaImpl::key(unsigned index) const
 String StorageAreaImpl::getItem(const String& key) const
 {
     ASSERT(!m_isShutdown);
+
+    String value;
+    if (m_storageAreaSync && m_storageAreaSync->lookupItemDuringImport(key, value))
+        return value;
     blockUntilImportComplete();
 
     return m_storageMap->getItem(key);
@@ -206,6 +210,10 @@ bool StorageAreaImpl::clear(Frame* frame)
 bool StorageAreaImpl::contains(const String& key) const
 {
     ASSERT(!m_isShutdown);
+
+    String value;
+    if (m_storageAreaSync && m_storageAreaSync->lookupItemDuringImport(key, value))
+        return !value.isNull();
     blockUntilImportComplete();
 
     return m_storageMap->contains(key);
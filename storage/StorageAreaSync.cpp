@@ -31,12 +31,15 @@
 #include "EventNames.h"
 #include "FileSystem.h"
 #include "HTMLElement.h"
+#include "Logging.h"
 #include "SQLiteFileSystem.h"
 #include "SQLiteStatement.h"
+#include "SQLiteTransaction.h"
 #include "SecurityOrigin.h"
 #include "StorageAreaImpl.h"
 #include "StorageSyncManager.h"
 #include "SuddenTermination.h"
+#include <wtf/CurrentTime.h>
 #include <wtf/text/CString.h>
 
 namespace WebCore {
@@ -49,12 +52,27 @@ static const double StorageSyncInterval = 1.0;
 // much harder to starve the rest of LocalStorage and the OS's IO subsystem in general.
 static const int MaxiumItemsToSync = 100;
 
+// Changes are appended to ItemLog rather than rewritten in place in ItemTable. Once the log grows
+// past this many entries it is folded back into ItemTable, so that imports and point lookups only
+// ever have to look at a bounded number of log entries.
+static const unsigned MaxItemLogEntries = 1000;
+
+// The main thread looks items up in the same file while the import runs, so each side may find the
+// other holding a lock. The background thread can afford to wait; the main thread only waits briefly
+// before falling back to blocking on the import.
+static const int BackgroundBusyTimeout = 30000;
+static const int LookupBusyTimeout = 50;
+
 inline StorageAreaSync::StorageAreaSync(PassRefPtr<StorageSyncManager> storageSyncManager, PassRefPtr<StorageAreaImpl> storageArea, const String& databaseIdentifier)
     : m_syncTimer(this, &StorageAreaSync::syncTimerFired)
     , m_itemsCleared(false)
     , m_finalSyncScheduled(false)
     , m_storageArea(storageArea)
     , m_syncManager(storageSyncManager)
+    , m_itemLogEntryCount(0)
+    , m_lookupDatabaseOpenFailed(false)
+    , m_itemsLookedUpDuringImport(0)
+    , m_importScheduledTime(currentTime())
     , m_databaseIdentifier(databaseIdentifier.crossThreadString())
     , m_clearItemsWhileSyncing(false)
     , m_syncScheduled(false)
@@ -84,6 +102,7 @@ StorageAreaSync::~StorageAreaSync()
     ASSERT(isMainThread());
     ASSERT(!m_syncTimer.isActive());
     ASSERT(m_finalSyncScheduled);
+    ASSERT(!m_lookupDatabase.isOpen());
 }
 
 void StorageAreaSync::scheduleFinalSync()
@@ -228,6 +247,7 @@ void StorageAreaSync::openDatabase(OpenDatabaseParamType openingStrategy)
         m_databaseOpenFailed = true;
         return;
     }
+    m_database.setBusyTimeout(BackgroundBusyTimeout);
 
     if (!m_database.executeCommand("CREATE TABLE IF NOT EXISTS ItemTable (key TEXT UNIQUE ON CONFLICT REPLACE, value TEXT NOT NULL ON CONFLICT FAIL)")) {
         LOG_ERROR("Failed to create table ItemTable for local storage");
@@ -235,6 +255,18 @@ void StorageAreaSync::openDatabase(OpenDatabaseParamType openingStrategy)
         m_databaseOpenFailed = true;
         return;
     }
+
+    // A null value in the log records the removal of a key.
+    if (!m_database.executeCommand("CREATE TABLE IF NOT EXISTS ItemLog (sequence INTEGER PRIMARY KEY AUTOINCREMENT, key TEXT NOT NULL, value TEXT)")) {
+        LOG_ERROR("Failed to create table ItemLog for local storage");
+        markImported();
+        m_databaseOpenFailed = true;
+        return;
+    }
+
+    SQLiteStatement count(m_database, "SELECT COUNT(*) FROM ItemLog");
+    if (count.prepare() == SQLResultOk && count.step() == SQLResultRow)
+        m_itemLogEntryCount = count.getColumnInt(0);
 }
 
 void StorageAreaSync::performImport()
@@ -242,12 +274,18 @@ void StorageAreaSync::performImport()
     ASSERT(!isMainThread());
     ASSERT(!m_database.isOpen());
 
+    double startTime = currentTime();
+
     openDatabase(SkipIfNonExistent);
     if (!m_database.isOpen()) {
         markImported();
         return;
     }
 
+    // Fold any changes left in the log by a previous session into ItemTable so the import is a single scan.
+    // If that fails the log is still intact, and its latest entries are laid over ItemTable below.
+    bool logCompacted = compactItemLog();
+
     SQLiteStatement query(m_database, "SELECT key, value FROM ItemTable");
     if (query.prepare() != SQLResultOk) {
         LOG_ERROR("Unable to select items from ItemTable for local storage");
@@ -269,15 +307,50 @@ void StorageAreaSync::performImport()
         return;
     }
 
+    if (!logCompacted && !importItemLog(itemMap)) {
+        markImported();
+        return;
+    }
+
     HashMap<String, String>::iterator it = itemMap.begin();
     HashMap<String, String>::iterator end = itemMap.end();
 
     for (; it != end; ++it)
         m_storageArea->importItem(it->first, it->second);
 
+    LOG(StorageAPI, "Imported %u local storage items for %s in %.2fms, %.2fms after the import was scheduled", itemMap.size(), m_databaseIdentifier.utf8().data(),
+        (currentTime() - startTime) * 1000, (currentTime() - m_importScheduledTime) * 1000);
+
     markImported();
 }
 
+bool StorageAreaSync::importItemLog(HashMap<String, String>& itemMap)
+{
+    ASSERT(!isMainThread());
+
+    // This is what lookupItemDuringImport() answers from, so the imported items match what it returned.
+    SQLiteStatement query(m_database, "SELECT key, value FROM ItemLog WHERE sequence IN (SELECT MAX(sequence) FROM ItemLog GROUP BY key)");
+    if (query.prepare() != SQLResultOk) {
+        LOG_ERROR("Unable to select items from ItemLog for local storage");
+        return false;
+    }
+
+    int result = query.step();
+    while (result == SQLResultRow) {
+        if (query.isColumnNull(1))
+            itemMap.remove(query.getColumnText(0));
+        else
+            itemMap.set(query.getColumnText(0), query.getColumnText(1));
+        result = query.step();
+    }
+
+    if (result != SQLResultDone) {
+        LOG_ERROR("Error reading items from ItemLog for local storage");
+        return false;
+    }
+    return true;
+}
+
 void StorageAreaSync::markImported()
 {
     MutexLocker locker(m_importLock);
@@ -285,13 +358,11 @@ void StorageAreaSync::markImported()
     m_importCondition.signal();
 }
 
-// FIXME: In the future, we should allow use of StorageAreas while it's importing (when safe to do so).
-// Blocking everything until the import is complete is by far the simplest and safest thing to do, but
-// there is certainly room for safe optimization: Key/length will never be able to make use of such an
-// optimization (since the order of iteration can change as items are being added). Get can return any
-// item currently in the map. Get/remove can work whether or not it's in the map, but we'll need a list
-// of items the import should not overwrite. Clear can also work, but it'll need to kill the import
-// job first.
+// FIXME: Get and contains are answered by lookupItemDuringImport() while the import is running, but
+// everything else still blocks until the import is complete. Key/length will never be able to make use
+// of such an optimization (since the order of iteration can change as items are being added). Set/remove
+// could work whether or not the item is in the map, but we'll need a list of items the import should not
+// overwrite. Clear can also work, but it'll need to kill the import job first.
 void StorageAreaSync::blockUntilImportComplete()
 {
     ASSERT(isMainThread());
@@ -300,10 +371,107 @@ void StorageAreaSync::blockUntilImportComplete()
     if (!m_storageArea)
         return;
 
-    MutexLocker locker(m_importLock);
-    while (!m_importComplete)
-        m_importCondition.wait(m_importLock);
+    double startTime = currentTime();
+    {
+        MutexLocker locker(m_importLock);
+        while (!m_importComplete)
+            m_importCondition.wait(m_importLock);
+    }
     m_storageArea = 0;
+
+    LOG(StorageAPI, "Blocked %.2fms waiting for the local storage import of %s, %u items were looked up while importing", (currentTime() - startTime) * 1000,
+        m_databaseIdentifier.utf8().data(), m_itemsLookedUpDuringImport);
+    closeLookupDatabase();
+}
+
+bool StorageAreaSync::openLookupDatabase()
+{
+    ASSERT(isMainThread());
+    ASSERT(!m_lookupDatabase.isOpen());
+
+    String databaseFilename = m_syncManager->fullDatabaseFilename(m_databaseIdentifier);
+    if (databaseFilename.isEmpty() || !fileExists(databaseFilename) || !m_lookupDatabase.open(databaseFilename)) {
+        m_lookupDatabaseOpenFailed = true;
+        return false;
+    }
+    m_lookupDatabase.setBusyTimeout(LookupBusyTimeout);
+
+    // The log is only present in databases written since it was introduced.
+    if (m_lookupDatabase.tableExists("ItemLog")) {
+        m_lookupLogStatement = adoptPtr(new SQLiteStatement(m_lookupDatabase, "SELECT value FROM ItemLog WHERE key=? ORDER BY sequence DESC LIMIT 1"));
+        if (m_lookupLogStatement->prepare() != SQLResultOk) {
+            closeLookupDatabase();
+            m_lookupDatabaseOpenFailed = true;
+            return false;
+        }
+    }
+
+    m_lookupItemStatement = adoptPtr(new SQLiteStatement(m_lookupDatabase, "SELECT value FROM ItemTable WHERE key=?"));
+    if (m_lookupItemStatement->prepare() != SQLResultOk) {
+        closeLookupDatabase();
+        m_lookupDatabaseOpenFailed = true;
+        return false;
+    }
+
+    return true;
+}
+
+void StorageAreaSync::closeLookupDatabase()
+{
+    ASSERT(isMainThread());
+
+    // The statements must be finalized before the database handle can be closed.
+    m_lookupLogStatement.clear();
+    m_lookupItemStatement.clear();
+    m_lookupDatabase.close();
+}
+
+bool StorageAreaSync::lookupItemDuringImport(const String& key, String& value)
+{
+    ASSERT(isMainThread());
+
+    // Fast path.  We set m_storageArea to 0 only after m_importComplete being true.
+    if (!m_storageArea)
+        return false;
+
+    {
+        MutexLocker locker(m_importLock);
+        if (m_importComplete)
+            return false;
+    }
+
+    // The only write before the import completes is its compaction of the log, which doesn't change
+    // any item, so what is on disk is exactly what the import will produce (performImport() lays the
+    // log over ItemTable itself if compaction fails). The log is checked first since it holds the
+    // most recent values.
+    if (!m_lookupDatabase.isOpen() && (m_lookupDatabaseOpenFailed || !openLookupDatabase()))
+        return false;
+
+    SQLiteStatement* statements[] = { m_lookupLogStatement.get(), m_lookupItemStatement.get() };
+    for (size_t i = 0; i < sizeof(statements) / sizeof(statements[0]); ++i) {
+        SQLiteStatement* statement = statements[i];
+        if (!statement)
+            continue;
+
+        statement->bindText(1, key);
+        int result = statement->step();
+        if (result == SQLResultRow)
+            value = statement->isColumnNull(0) ? String() : statement->getColumnText(0);
+        statement->reset();
+
+        if (result == SQLResultRow) {
+            ++m_itemsLookedUpDuringImport;
+            return true;
+        }
+
+        // The background thread may be holding a write lock while it compacts the log; fall back to blocking.
+        if (result != SQLResultDone)
+            return false;
+    }
+
+    ++m_itemsLookedUpDuringImport;
+    value = String();
+    return true;
 }
 
 void StorageAreaSync::sync(bool clearItems, const HashMap<String, String>& items)
@@ -319,53 +487,104 @@ void StorageAreaSync::sync(bool clearItems, const HashMap<String, String>& items
     if (!m_database.isOpen())
         return;
 
+    double startTime = currentTime();
+
+    // Write the whole batch in a single transaction rather than committing every item on its own.
+    SQLiteTransaction transaction(m_database);
+    transaction.begin();
+    if (!transaction.inProgress()) {
+        LOG_ERROR("Failed to begin transaction - cannot write to local storage database");
+        return;
+    }
+
     // If the clear flag is set, then we clear all items out before we write any new ones in.
     if (clearItems) {
-        SQLiteStatement clear(m_database, "DELETE FROM ItemTable");
-        if (clear.prepare() != SQLResultOk) {
-            LOG_ERROR("Failed to prepare clear statement - cannot write to local storage database");
+        if (!m_database.executeCommand("DELETE FROM ItemTable") || !m_database.executeCommand("DELETE FROM ItemLog")) {
+            LOG_ERROR("Failed to clear all items in the local storage database - %i", m_database.lastError());
             return;
         }
+    }
 
-        int result = clear.step();
-        if (result != SQLResultDone) {
-            LOG_ERROR("Failed to clear all items in the local storage database - %i", result);
+    if (!m_appendStatement) {
+        m_appendStatement = adoptPtr(new SQLiteStatement(m_database, "INSERT INTO ItemLog (key, value) VALUES (?, ?)"));
+        if (m_appendStatement->prepare() != SQLResultOk) {
+            LOG_ERROR("Failed to prepare append statement - cannot write to local storage database");
+            m_appendStatement.clear();
             return;
         }
     }
 
-    SQLiteStatement insert(m_database, "INSERT INTO ItemTable VALUES (?, ?)");
-    if (insert.prepare() != SQLResultOk) {
-        LOG_ERROR("Failed to prepare insert statement - cannot write to local storage database");
-        return;
-    }
-
-    SQLiteStatement remove(m_database, "DELETE FROM ItemTable WHERE key=?");
-    if (remove.prepare() != SQLResultOk) {
-        LOG_ERROR("Failed to prepare delete statement - cannot write to local storage database");
-        return;
-    }
-
+    unsigned removedItems = 0;
+    unsigned appendedItems = 0;
     HashMap<String, String>::const_iterator end = items.end();
 
     for (HashMap<String, String>::const_iterator it = items.begin(); it != end; ++it) {
-        // Based on the null-ness of the second argument, decide whether this is an insert or a delete.
-        SQLiteStatement& query = it->second.isNull() ? remove : insert;
+        m_appendStatement->bindText(1, it->first);
 
-        query.bindText(1, it->first);
+        // A null value records the removal of the key.
+        if (it->second.isNull()) {
+            m_appendStatement->bindNull(2);
+            ++removedItems;
+        } else
+            m_appendStatement->bindText(2, it->second);
 
-        // If the second argument is non-null, we're doing an insert, so bind it as the value.
-        if (!it->second.isNull())
-            query.bindText(2, it->second);
-
-        int result = query.step();
+        int result = m_appendStatement->step();
+        m_appendStatement->reset();
         if (result != SQLResultDone) {
             LOG_ERROR("Failed to update item in the local storage database - %i", result);
             break;
         }
 
-        query.reset();
+        ++appendedItems;
+    }
+
+    transaction.commit();
+    if (transaction.inProgress()) {
+        LOG_ERROR("Failed to commit items to the local storage database - %i", m_database.lastError());
+        return;
+    }
+
+    // Only count the entries once they are really in the log.
+    if (clearItems)
+        m_itemLogEntryCount = 0;
+    m_itemLogEntryCount += appendedItems;
+
+    LOG(StorageAPI, "Synced %u local storage items (%u removals%s) for %s in %.2fms, %u entries in the item log", items.size(), removedItems,
+        clearItems ? ", after clearing" : "", m_databaseIdentifier.utf8().data(), (currentTime() - startTime) * 1000, m_itemLogEntryCount);
+
+    if (m_itemLogEntryCount >= MaxItemLogEntries)
+        compactItemLog();
+}
+
+bool StorageAreaSync::compactItemLog()
+{
+    ASSERT(!isMainThread());
+    ASSERT(m_database.isOpen());
+
+    if (!m_itemLogEntryCount)
+        return true;
+
+    double startTime = currentTime();
+
+    SQLiteTransaction transaction(m_database);
+    transaction.begin();
+
+    // Only the most recent entry for each key matters; removals simply drop the key from ItemTable.
+    if (!transaction.inProgress()
+        || !m_database.executeCommand("DELETE FROM ItemTable WHERE key IN (SELECT key FROM ItemLog)")
+        || !m_database.executeCommand("INSERT INTO ItemTable SELECT key, value FROM ItemLog WHERE sequence IN (SELECT MAX(sequence) FROM ItemLog GROUP BY key) AND value IS NOT NULL")
+        || !m_database.executeCommand("DELETE FROM ItemLog")) {
+        LOG_ERROR("Failed to compact the item log of the local storage database - %i", m_database.lastError());
+        return false;
     }
+
+    transaction.commit();
+    if (transaction.inProgress())
+        return false;
+
+    LOG(StorageAPI, "Compacted %u item log entries for %s in %.2fms", m_itemLogEntryCount, m_databaseIdentifier.utf8().data(), (currentTime() - startTime) * 1000);
+    m_itemLogEntryCount = 0;
+    return true;
 }
 
 void StorageAreaSync::performSync()
@@ -405,6 +624,15 @@ void StorageAreaSync::deleteEmptyDatabase()
     if (!m_database.isOpen())
         return;
 
+    // This is the last task for this area, so leave everything in ItemTable for the next session.
+    // If that fails, ItemTable says nothing about whether the area is empty; the next import
+    // reads what is still in ItemLog.
+    m_appendStatement.clear();
+    if (!compactItemLog()) {
+        LOG_ERROR("Unable to compact the item log of local storage, keeping the database");
+        return;
+    }
+
     SQLiteStatement query(m_database, "SELECT COUNT(*) FROM ItemTable");
     if (query.prepare() != SQLResultOk) {
         LOG_ERROR("Unable to count number of rows in ItemTable for local storage");
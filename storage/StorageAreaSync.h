@@ -31,11 +31,13 @@
 #include "SQLiteDatabase.h"
 #include "Timer.h"
 #include <wtf/HashMap.h>
+#include <wtf/OwnPtr.h>
 #include <wtf/text/StringHash.h>
 
 namespace WebCore {
 
     class Frame;
+    class SQLiteStatement;
     class StorageAreaImpl;
     class StorageSyncManager;
 
@@ -47,6 +49,12 @@ namespace WebCore {
         void scheduleFinalSync();
         void blockUntilImportComplete();
 
+        // Reads a single item straight from disk while the background import is still running,
+        // so that getItem() does not have to wait for the whole area to be loaded. Returns false
+        // if the import has already completed or the lookup failed, in which case the caller
+        // should block and read from the imported map instead.
+        bool lookupItemDuringImport(const String& key, String& value);
+
         void scheduleItemForSync(const String& key, const String& value);
         void scheduleClear();
 
@@ -55,6 +63,9 @@ namespace WebCore {
 
         void dispatchStorageEvent(const String& key, const String& oldValue, const String& newValue, Frame* sourceFrame);
 
+        bool openLookupDatabase();
+        void closeLookupDatabase();
+
         Timer<StorageAreaSync> m_syncTimer;
         HashMap<String, String> m_changedItems;
         bool m_itemsCleared;
@@ -66,6 +77,16 @@ namespace WebCore {
 
         // The database handle will only ever be opened and used on the background thread.
         SQLiteDatabase m_database;
+        OwnPtr<SQLiteStatement> m_appendStatement;
+        unsigned m_itemLogEntryCount;
+
+        // A second handle, used on the main thread only to read items while the import is running.
+        SQLiteDatabase m_lookupDatabase;
+        OwnPtr<SQLiteStatement> m_lookupLogStatement;
+        OwnPtr<SQLiteStatement> m_lookupItemStatement;
+        bool m_lookupDatabaseOpenFailed;
+        unsigned m_itemsLookedUpDuringImport;
+        double m_importScheduledTime;
 
     // The following members are subject to thread synchronization issues.
     public:
@@ -83,6 +104,8 @@ namespace WebCore {
         void syncTimerFired(Timer<StorageAreaSync>*);
         void openDatabase(OpenDatabaseParamType openingStrategy);
         void sync(bool clearItems, const HashMap<String, String>& items);
+        bool compactItemLog();
+        bool importItemLog(HashMap<String, String>&);
 
         const String m_databaseIdentifier;
 
@@ -58,7 +58,7 @@ SVGElement::SVGElement(const QualifiedName& tagName, Document* document)
 
 PassRefPtr<SVGElement> SVGElement::create(const QualifiedName& tagName, Document* document)
 {
-    return new SVGElement(tagName, document);
+    return new (document) SVGElement(tagName, document);
 }
 
 SVGElement::~SVGElement()
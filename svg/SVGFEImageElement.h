@@ -40,6 +40,10 @@ class SVGFEImageElement : public SVGFilterPrimitiveStandardAttributes,
                           public SVGExternalResourcesRequired,
                           public CachedResourceClient {
 public:
+    // CachedResourceClient brings in the fastMalloc allocation functions too; nodes use the DOM arena.
+    using Node::operator new;
+    using Node::operator delete;
+
     SVGFEImageElement(const QualifiedName&, Document*);
     virtual ~SVGFEImageElement();
 
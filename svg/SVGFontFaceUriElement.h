@@ -32,6 +32,10 @@ namespace WebCore {
 
     class SVGFontFaceUriElement : public SVGElement, public CachedResourceClient {
     public:
+        // CachedResourceClient brings in the fastMalloc allocation functions too; nodes use the DOM arena.
+        using Node::operator new;
+        using Node::operator delete;
+
         SVGFontFaceUriElement(const QualifiedName&, Document*);
         ~SVGFontFaceUriElement();
         